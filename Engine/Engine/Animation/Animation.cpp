@@ -1,40 +1,480 @@
 #include "Animation.h"
 
 #include "BakedAnimation.h"
+#include "BlendSpace1D.h"
+#include "PoseCache.h"
 #include "../Time/TimeManager.h"
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <cmath>
 
 Animation::Animation(const BakedAnimation& ba) :
-	playback(0.0f),
-	speed(0.0f),
 	bakedAnimation(ba),
-	index(0U)
+	layers(std::vector<Layer>()),
+	fadeRequests(std::vector<FadeRequest>()),
+	pose(ba.GetRestPose()),
+	identity(ba.GetRestPose().Size()),
+	ones(std::vector<float>(ba.GetRestPose().Size(), 1.0f)),
+	blended(),
+	jointWeights(std::vector<float>()),
+	sharePoses(true),
+	pendingTime(0.0f),
+	fromPalette(std::vector<glm::mat4>()),
+	toPalette(std::vector<glm::mat4>()),
+	lodInterval(0U),
+	lodStep(0U)
 {
+	AddLayer(CreateSource(&ba, nullptr, BlendMode::Override), BlendMode::Override, 1.0f);
 }
 
 Animation::~Animation()
 {
 }
 
-void Animation::Update(glm::mat4* posePalette)
+void Animation::Update(glm::mat4* posePalette, AnimationLOD::Level level, bool leafJointsAtRest)
 {
-	playback += TimeManager::DeltaTime();
-	if (playback >= ANIMATION_PLAYBACK_FRAME_TIME)
+	StartRequestedFades();
+
+	const float deltaTime = TimeManager::DeltaTime();
+	const unsigned int interval = AnimationLOD::GetUpdateInterval(level);
+
+	pendingTime += deltaTime;
+
+	if (interval == 0U)
+	{
+		// The time a frozen animation misses is caught up with when it is evaluated again.
+		lodInterval = 0U;
+		return;
+	}
+
+	if (interval == 1U)
 	{
-		for (unsigned int i = 0; i < bakedAnimation.GetPoseAtIndex(index).size(); ++i)
+		Evaluate(pendingTime, posePalette, leafJointsAtRest);
+		pendingTime = 0.0f;
+		lodInterval = 1U;
+		return;
+	}
+
+	const unsigned int jointCount = pose.Size();
+
+	if (lodStep >= lodInterval || lodInterval != interval)
+	{
+		if (lodInterval != interval)
 		{
-			posePalette[i] = bakedAnimation.GetPoseAtIndex(index)[i];
+			// Starts from whatever was shown last.
+			fromPalette.assign(posePalette, posePalette + jointCount);
 		}
+		else
+		{
+			fromPalette.swap(toPalette);
+		}
+
+		// The pose is evaluated where it will be when the next evaluation is due and blended towards until then.
+		const float ahead = deltaTime * static_cast<float>(interval - 1U);
+
+		toPalette.resize(jointCount);
+		Evaluate(pendingTime + ahead, toPalette.data(), leafJointsAtRest);
+
+		pendingTime = -ahead;
+		lodInterval = interval;
+		lodStep = 0U;
+	}
+
+	lodStep++;
+
+	const float t = static_cast<float>(lodStep) / static_cast<float>(lodInterval);
+
+	for (unsigned int joint = 0; joint < jointCount; joint++)
+	{
+		posePalette[joint] = fromPalette[joint] * (1.0f - t) + toPalette[joint] * t;
+	}
+}
+
+void Animation::Step(float deltaTime, glm::mat4* posePalette, bool leafJointsAtRest)
+{
+	StartRequestedFades();
+	Evaluate(deltaTime, posePalette, leafJointsAtRest);
+}
+
+void Animation::Evaluate(float deltaTime, glm::mat4* posePalette, bool leafJointsAtRest)
+{
+	Source& base = layers[0].current;
 
-		++index += static_cast<unsigned int>(speed);
-		if (index >= bakedAnimation.GetFrameCount())
+	if (sharePoses && layers.size() == 1U && !IsFading() && base.clip != nullptr)
+	{
+		Advance(base, deltaTime);
+
+		if (const glm::mat4* const sharedMatrices = PoseCache::GetJointMatrices(*base.clip, base.time))
+		{
+			std::copy(sharedMatrices, sharedMatrices + pose.Size(), posePalette);
+			return;
+		}
+
+		// Without a cache the clip is sampled here, its time has already moved on.
+		Sample(base, layers[0].mode, leafJointsAtRest);
+		pose.SetLocalTransforms(base.transforms);
+		pose.GetJointMatrices(posePalette);
+		return;
+	}
+
+	for (Layer& layer : layers)
+	{
+		EvaluateLayer(layer, deltaTime, leafJointsAtRest);
+	}
+
+	blended = layers[0].output;
+
+	const unsigned int jointCount = pose.Size();
+	jointWeights.resize(jointCount);
+
+	for (unsigned int i = 1; i < layers.size(); i++)
+	{
+		const Layer& layer = layers[i];
+
+		if (layer.weight <= 0.0f || layer.output.Size() != jointCount)
 		{
-			index = 0;
+			continue;
 		}
-		playback = 0;
+
+		for (unsigned int joint = 0; joint < jointCount; joint++)
+		{
+			jointWeights[joint] = layer.weight * (joint < layer.mask.size() ? layer.mask[joint] : 1.0f);
+		}
+
+		// Every layer is blended over all joints in one batch, masked joints just get a weight of 0.
+		if (layer.mode == BlendMode::Additive)
+		{
+			Math::TransformSoA::Add(blended, layer.output, identity, jointWeights.data(), blended);
+		}
+		else
+		{
+			Math::TransformSoA::Mix(blended, layer.output, jointWeights.data(), jointWeights.data(), jointWeights.data(), blended);
+		}
+	}
+
+	pose.SetLocalTransforms(blended);
+	pose.GetJointMatrices(posePalette);
+}
+
+void Animation::SetSpeed(float newSpeed, unsigned int layer)
+{
+	if (!IsLayer(layer, "SetSpeed"))
+	{
+		return;
+	}
+
+	layers[layer].current.speed = newSpeed;
+}
+
+float Animation::GetSpeed(unsigned int layer) const
+{
+	if (!IsLayer(layer, "GetSpeed"))
+	{
+		return 0.0f;
+	}
+
+	return layers[layer].current.speed;
+}
+
+void Animation::SetTime(float time, unsigned int layer)
+{
+	if (!IsLayer(layer, "SetTime"))
+	{
+		return;
+	}
+
+	Source& source = layers[layer].current;
+
+	if (source.clip != nullptr)
+	{
+		source.time = source.clip->AdjustTimeToFitRange(time);
+	}
+	else
+	{
+		source.time = time - std::floor(time);
+	}
+}
+
+float Animation::GetTime(unsigned int layer) const
+{
+	if (!IsLayer(layer, "GetTime"))
+	{
+		return 0.0f;
 	}
+
+	return layers[layer].current.time;
+}
+
+void Animation::CrossFade(const BakedAnimation& clip, float fadeDuration, unsigned int layer)
+{
+	std::lock_guard<std::mutex> guard(fadeRequestsMutex);
+	fadeRequests.push_back({ &clip, nullptr, fadeDuration, layer });
 }
 
-void Animation::SetSpeed(float newSpeed)
+void Animation::CrossFade(const BlendSpace1D& blendSpace, float fadeDuration, unsigned int layer)
 {
-	speed = newSpeed;
+	std::lock_guard<std::mutex> guard(fadeRequestsMutex);
+	fadeRequests.push_back({ nullptr, &blendSpace, fadeDuration, layer });
+}
+
+bool Animation::IsFading(unsigned int layer) const
+{
+	if (!IsLayer(layer, "IsFading"))
+	{
+		return false;
+	}
+
+	return layers[layer].fadeDuration > 0.0f;
+}
+
+unsigned int Animation::AddLayer(const BakedAnimation& clip, BlendMode mode, float weight)
+{
+	return AddLayer(CreateSource(&clip, nullptr, mode), mode, weight);
+}
+
+unsigned int Animation::AddLayer(const BlendSpace1D& blendSpace, BlendMode mode, float weight)
+{
+	return AddLayer(CreateSource(nullptr, &blendSpace, mode), mode, weight);
+}
+
+void Animation::RemoveLayer(unsigned int layer)
+{
+	if (layer == 0U)
+	{
+		Logger::Log(std::string("Calling Animation::RemoveLayer() on the base layer, which cannot be removed."), Logger::Category::Warning);
+		return;
+	}
+
+	if (IsLayer(layer, "RemoveLayer"))
+	{
+		layers.erase(layers.begin() + layer);
+	}
+}
+
+unsigned int Animation::GetLayerCount() const
+{
+	return static_cast<unsigned int>(layers.size());
+}
+
+void Animation::SetLayerWeight(unsigned int layer, float weight)
+{
+	if (!IsLayer(layer, "SetLayerWeight"))
+	{
+		return;
+	}
+
+	layers[layer].weight = weight;
+}
+
+float Animation::GetLayerWeight(unsigned int layer) const
+{
+	if (!IsLayer(layer, "GetLayerWeight"))
+	{
+		return 0.0f;
+	}
+
+	return layers[layer].weight;
+}
+
+void Animation::SetLayerMask(unsigned int layer, const std::vector<float>& jointWeights)
+{
+	if (!IsLayer(layer, "SetLayerMask"))
+	{
+		return;
+	}
+
+	layers[layer].mask = jointWeights;
+}
+
+void Animation::SetBlendParameter(float parameter, unsigned int layer)
+{
+	if (!IsLayer(layer, "SetBlendParameter"))
+	{
+		return;
+	}
+
+	Layer& target = layers[layer];
+	target.current.parameter = parameter;
+
+	if (target.mode == BlendMode::Additive && target.current.blendSpace != nullptr)
+	{
+		SampleReference(target.current);
+	}
+}
+
+void Animation::SetPoseSharing(bool share)
+{
+	sharePoses = share;
+}
+
+bool Animation::IsPoseSharing() const
+{
+	return sharePoses;
+}
+
+bool Animation::IsLayer(unsigned int layer, const char* caller) const
+{
+	if (layer < layers.size())
+	{
+		return true;
+	}
+
+	Logger::Log(std::string("Calling Animation::") + caller + "() with layer " + std::to_string(layer) + " of an animation with " + std::to_string(layers.size()) + " layers.", Logger::Category::Warning);
+	return false;
+}
+
+Animation::Source Animation::CreateSource(const BakedAnimation* clip, const BlendSpace1D* blendSpace, BlendMode mode) const
+{
+	Source source;
+	source.clip = clip;
+	source.blendSpace = blendSpace;
+	source.keyCursors.resize(blendSpace != nullptr ? blendSpace->GetClipCount() : 1U);
+
+	if (mode == BlendMode::Additive)
+	{
+		SampleReference(source);
+	}
+
+	return source;
+}
+
+void Animation::CrossFade(Source&& source, float fadeDuration, unsigned int layer)
+{
+	Layer& target = layers[layer];
+	const float speed = target.current.speed;
+
+	if (fadeDuration <= 0.0f)
+	{
+		target.previous = Source();
+		target.fadeDuration = 0.0f;
+	}
+	else if (IsFading(layer))
+	{
+		// Fading out of a blend of two sources would need both, so the blend is frozen where it is instead.
+		target.previous = Source();
+		target.previous.transforms = target.output;
+	}
+	else
+	{
+		target.previous = std::move(target.current);
+	}
+
+	target.current = std::move(source);
+	target.current.speed = speed;
+	target.fadeTime = 0.0f;
+	target.fadeDuration = std::max(fadeDuration, 0.0f);
+}
+
+void Animation::StartRequestedFades()
+{
+	std::vector<FadeRequest> requests;
+
+	{
+		std::lock_guard<std::mutex> guard(fadeRequestsMutex);
+		requests.swap(fadeRequests);
+	}
+
+	for (const FadeRequest& request : requests)
+	{
+		if (IsLayer(request.layer, "CrossFade"))
+		{
+			CrossFade(CreateSource(request.clip, request.blendSpace, layers[request.layer].mode), request.fadeDuration, request.layer);
+		}
+	}
+}
+
+unsigned int Animation::AddLayer(Source&& source, BlendMode mode, float weight)
+{
+	Layer layer;
+	layer.current = std::move(source);
+	layer.mode = mode;
+	layer.weight = weight;
+
+	layers.push_back(std::move(layer));
+
+	return static_cast<unsigned int>(layers.size()) - 1U;
+}
+
+void Animation::SampleReference(Source& source) const
+{
+	if (source.clip != nullptr)
+	{
+		source.clip->SamplePose(0.0f, source.reference);
+	}
+	else if (source.blendSpace != nullptr)
+	{
+		// Cursors of its own leave the playing ones where they are.
+		std::vector<std::vector<unsigned int>> referenceCursors;
+		source.blendSpace->Sample(source.parameter, 0.0f, source.reference, referenceCursors);
+	}
+}
+
+void Animation::Advance(Source& source, float deltaTime) const
+{
+	if (source.clip != nullptr)
+	{
+		// Wrapping the accumulated time keeps it precise however long the animation plays.
+		source.time = source.clip->AdjustTimeToFitRange(source.time + deltaTime * source.speed);
+	}
+	else if (source.blendSpace != nullptr)
+	{
+		// Blend spaces advance in cycles, at the rate of the clips around the parameter.
+		const float duration = source.blendSpace->GetDuration(source.parameter);
+		const float phase = duration > 0.0f ? source.time + deltaTime * source.speed / duration : 0.0f;
+		source.time = phase - std::floor(phase);
+	}
+}
+
+void Animation::Sample(Source& source, BlendMode mode, bool leafJointsAtRest) const
+{
+	if (source.clip != nullptr)
+	{
+		source.clip->SamplePose(source.time, source.transforms, &source.keyCursors[0], leafJointsAtRest);
+	}
+	else if (source.blendSpace != nullptr)
+	{
+		source.blendSpace->Sample(source.parameter, source.time, source.transforms, source.keyCursors, leafJointsAtRest);
+	}
+	else
+	{
+		return;
+	}
+
+	// Additive sources are turned into their difference from the reference right away, so fading between two of them
+	// blends differences rather than clips measured against different first frames.
+	if (mode == BlendMode::Additive)
+	{
+		Math::TransformSoA::Add(identity, source.transforms, source.reference, ones.data(), source.transforms);
+	}
+}
+
+void Animation::EvaluateLayer(Layer& layer, float deltaTime, bool leafJointsAtRest)
+{
+	Advance(layer.current, deltaTime);
+	Sample(layer.current, layer.mode, leafJointsAtRest);
+	layer.output = layer.current.transforms;
+
+	if (layer.fadeDuration <= 0.0f)
+	{
+		return;
+	}
+
+	Advance(layer.previous, deltaTime);
+	Sample(layer.previous, layer.mode, leafJointsAtRest);
+
+	layer.fadeTime += deltaTime;
+	const float fade = layer.fadeTime / layer.fadeDuration;
+
+	if (fade >= 1.0f)
+	{
+		layer.previous = Source();
+		layer.fadeDuration = 0.0f;
+		return;
+	}
+
+	if (layer.previous.transforms.Size() == layer.output.Size())
+	{
+		Math::TransformSoA::Mix(layer.previous.transforms, layer.output, fade, layer.output);
+	}
 }
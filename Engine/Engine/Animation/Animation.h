@@ -1,15 +1,32 @@
 #ifndef ANIMATION_H
 #define ANIMATION_H
 
+#include "Pose.h"
+#include "AnimationLOD.h"
+#include "../Math/TransformSoA.h"
+
 #include <vector>
+#include <mutex>
 #include <glm/glm.hpp>
 
 class BakedAnimation;
+class BlendSpace1D;
 
+// Plays one or more layers of clips and blends them into a pose. Layer 0 is the base pose, every later layer is
+// evaluated over the result of the ones before it. Any layer can cross-fade to another clip or blend space.
 class Animation
 {
 public:
 
+	enum class BlendMode
+	{
+		// Replaces the pose below by the layer's weight.
+		Override,
+
+		// Adds the clip's difference from its first frame to the pose below, scaled by the layer's weight.
+		Additive
+	};
+
 	Animation(const BakedAnimation& bakedAnimation);
 
 	Animation() = delete;
@@ -24,23 +41,174 @@ public:
 
 	Animation& operator=(Animation&&) = delete;
 
-	void Update(glm::mat4* posePalette);
+	// Below AnimationLOD::Level::Full the pose is evaluated every few updates and interpolated in between, Frozen leaves
+	// posePalette as it is. leafJointsAtRest leaves joints without children at their rest transform, except for a pose
+	// shared through the PoseCache, which is evaluated in full once for everyone showing it.
+	void Update(glm::mat4* posePalette, AnimationLOD::Level level = AnimationLOD::Level::Full, bool leafJointsAtRest = false);
+
+	// Moves the animation on by deltaTime instead of the frame time and evaluates the whole pose, for animations driven
+	// by a clock of their own like the simulation step. Not to be mixed with Update() on the same animation.
+	void Step(float deltaTime, glm::mat4* posePalette, bool leafJointsAtRest = false);
+
+	// Multiplies the playback rate, 1 plays the clip in real time and negative values play it backwards.
+	void SetSpeed(float newSpeed, unsigned int layer = 0U);
+
+	float GetSpeed(unsigned int layer = 0U) const;
+
+	// Seconds since the start of the clip, or the normalized phase when the layer plays a blend space.
+	void SetTime(float time, unsigned int layer = 0U);
+
+	float GetTime(unsigned int layer = 0U) const;
+
+	// Starts playing clip on layer and fades it in over fadeDuration seconds while what the layer played fades out. A
+	// fadeDuration of 0 switches at once. Safe to call from any thread, the fade starts with the next Update() or Step().
+	void CrossFade(const BakedAnimation& clip, float fadeDuration, unsigned int layer = 0U);
+
+	void CrossFade(const BlendSpace1D& blendSpace, float fadeDuration, unsigned int layer = 0U);
+
+	bool IsFading(unsigned int layer = 0U) const;
+
+	// Returns the index of the new layer. Clips and blend spaces must use the base clip's armature.
+	unsigned int AddLayer(const BakedAnimation& clip, BlendMode mode, float weight = 1.0f);
+
+	unsigned int AddLayer(const BlendSpace1D& blendSpace, BlendMode mode, float weight = 1.0f);
+
+	// The base layer cannot be removed, later layers move down one index.
+	void RemoveLayer(unsigned int layer);
+
+	unsigned int GetLayerCount() const;
 
-	void SetSpeed(float newSpeed);
+	// Ignored for the base layer, which always covers the whole pose.
+	void SetLayerWeight(unsigned int layer, float weight);
+
+	float GetLayerWeight(unsigned int layer) const;
+
+	// One weight per joint multiplying the layer's weight, so a layer can drive only the upper body for example. An empty
+	// mask covers every joint.
+	void SetLayerMask(unsigned int layer, const std::vector<float>& jointWeights);
+
+	// Where on its blend space the layer samples.
+	void SetBlendParameter(float parameter, unsigned int layer = 0U);
+
+	// While only the base layer plays a single clip, its pose comes from the PoseCache, shared with every other
+	// animation on the same clip and baked frame. On by default.
+	void SetPoseSharing(bool share);
+
+	bool IsPoseSharing() const;
 
 private:
 
-	float frameTimeAdvance;
+	// What a layer plays, a clip or a blend space. A source with neither holds the pose a fade was interrupted at.
+	struct Source
+	{
+		const BakedAnimation* clip = nullptr;
+
+		const BlendSpace1D* blendSpace = nullptr;
+
+		float time = 0.0f;
+
+		float speed = 1.0f;
+
+		float parameter = 0.0f;
+
+		// One cursor list per clip of the blend space, or one for the clip.
+		std::vector<std::vector<unsigned int>> keyCursors;
+
+		// The first frame additive layers measure the clip against.
+		Math::TransformSoA reference;
+
+		Math::TransformSoA transforms;
+	};
+
+	struct FadeRequest
+	{
+		const BakedAnimation* clip = nullptr;
+
+		const BlendSpace1D* blendSpace = nullptr;
+
+		float fadeDuration = 0.0f;
 
-	float playback;
+		unsigned int layer = 0U;
+	};
 
-	float speed;
+	struct Layer
+	{
+		Source current;
 
-	unsigned int index;
+		Source previous;
+
+		float fadeTime = 0.0f;
+
+		// 0 when the layer is not fading.
+		float fadeDuration = 0.0f;
+
+		BlendMode mode = BlendMode::Override;
+
+		float weight = 1.0f;
+
+		std::vector<float> mask;
+
+		// The layer's result this update. Additive layers hold the difference from the reference.
+		Math::TransformSoA output;
+	};
+
+	// Logs a warning naming caller when layer is out of range.
+	bool IsLayer(unsigned int layer, const char* caller) const;
+
+	Source CreateSource(const BakedAnimation* clip, const BlendSpace1D* blendSpace, BlendMode mode) const;
+
+	void CrossFade(Source&& source, float fadeDuration, unsigned int layer);
+
+	// Starts the fades requested since the last call, on the thread evaluating the animation.
+	void StartRequestedFades();
+
+	unsigned int AddLayer(Source&& source, BlendMode mode, float weight);
+
+	void SampleReference(Source& source) const;
+
+	void Advance(Source& source, float deltaTime) const;
+
+	void Sample(Source& source, BlendMode mode, bool leafJointsAtRest) const;
+
+	void EvaluateLayer(Layer& layer, float deltaTime, bool leafJointsAtRest);
+
+	// Moves every layer on by deltaTime and writes the blended pose's joint matrices.
+	void Evaluate(float deltaTime, glm::mat4* posePalette, bool leafJointsAtRest);
 
 	const BakedAnimation& bakedAnimation;
 
+	std::vector<Layer> layers;
+
+	std::vector<FadeRequest> fadeRequests;
+
+	std::mutex fadeRequestsMutex;
+
+	Pose pose;
+
+	// Identity transforms and weights of 1, for additive layers.
+	Math::TransformSoA identity;
+
+	std::vector<float> ones;
+
+	Math::TransformSoA blended;
+
+	std::vector<float> jointWeights;
+
+	bool sharePoses;
+
+	// Time passed that the layers have not been moved on by, negative after evaluating ahead for interpolation.
+	float pendingTime;
+
+	// Interpolation between evaluations at reduced update rates.
+	std::vector<glm::mat4> fromPalette;
+
+	std::vector<glm::mat4> toPalette;
+
+	unsigned int lodInterval;
+
+	unsigned int lodStep;
+
 };
 
 
-#endif // ANIMATION_H
\ No newline at end of file
+#endif // ANIMATION_H
@@ -0,0 +1,130 @@
+#include "AnimationLOD.h"
+
+#include "../Renderer/Cameras/Camera.h"
+#include "../Renderer/Model/Model.h"
+
+#include <glm/gtc/matrix_access.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+AnimationLOD::Settings AnimationLOD::settings = AnimationLOD::Settings();
+
+std::atomic<unsigned int> AnimationLOD::counts[static_cast<unsigned int>(Level::Count)] = {};
+
+unsigned int AnimationLOD::lastCounts[static_cast<unsigned int>(Level::Count)] = {};
+
+AnimationLOD::Level AnimationLOD::Select(const Camera& camera, const glm::vec3& center, float radius, bool& outLeafJointsAtRest)
+{
+	Level level = Level::Full;
+	outLeafJointsAtRest = false;
+
+	// Frustum planes straight from the view projection matrix, each as a normal and a distance.
+	const glm::mat4 viewProjection = camera.GetProjection() * camera.GetView();
+	const glm::vec4 row[4] = { glm::row(viewProjection, 0), glm::row(viewProjection, 1), glm::row(viewProjection, 2), glm::row(viewProjection, 3) };
+	const glm::vec4 planes[6] = { row[3] + row[0], row[3] - row[0], row[3] + row[1], row[3] - row[1], row[3] + row[2], row[3] - row[2] };
+
+	for (const glm::vec4& plane : planes)
+	{
+		const float length = glm::length(glm::vec3(plane));
+
+		if (length > 0.0f && (glm::dot(glm::vec3(plane), center) + plane.w) / length < -radius)
+		{
+			level = Level::Frozen;
+			break;
+		}
+	}
+
+	if (level != Level::Frozen)
+	{
+		const float screenSize = GetScreenSize(camera, center, radius);
+
+		if (screenSize < settings.eighthRateBelow)
+		{
+			level = Level::Eighth;
+		}
+		else if (screenSize < settings.quarterRateBelow)
+		{
+			level = Level::Quarter;
+		}
+		else if (screenSize < settings.halfRateBelow)
+		{
+			level = Level::Half;
+		}
+
+		outLeafJointsAtRest = screenSize < settings.leafJointsAtRestBelow;
+	}
+
+	counts[static_cast<unsigned int>(level)]++;
+
+	return level;
+}
+
+AnimationLOD::Level AnimationLOD::Select(const Camera& camera, const Model& model, const glm::mat4& modelMatrix, bool& outLeafJointsAtRest)
+{
+	const glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(model.GetBoundingSphereCenter(), 1.0f));
+	const float scale = std::max(glm::length(glm::vec3(modelMatrix[0])), std::max(glm::length(glm::vec3(modelMatrix[1])), glm::length(glm::vec3(modelMatrix[2]))));
+
+	return Select(camera, center, model.GetBoundingSphereRadius() * scale, outLeafJointsAtRest);
+}
+
+float AnimationLOD::GetScreenSize(const Camera& camera, const glm::vec3& center, float radius)
+{
+	// The vertical scale of the projection maps a size at depth 1 to a fraction of half the view's height.
+	const float verticalScale = std::fabs(camera.GetProjection()[1][1]);
+
+	if (camera.GetType() == Camera::Type::ORTHOGRAPHIC)
+	{
+		return radius * verticalScale;
+	}
+
+	const float depth = -(camera.GetView() * glm::vec4(center, 1.0f)).z;
+
+	if (depth <= radius)
+	{
+		return std::numeric_limits<float>::max();
+	}
+
+	return radius * verticalScale / depth;
+}
+
+unsigned int AnimationLOD::GetUpdateInterval(Level level)
+{
+	switch (level)
+	{
+	case Level::Full:
+		return 1U;
+	case Level::Half:
+		return 2U;
+	case Level::Quarter:
+		return 4U;
+	case Level::Eighth:
+		return 8U;
+	default:
+		return 0U;
+	}
+}
+
+void AnimationLOD::SetSettings(const Settings& newSettings)
+{
+	settings = newSettings;
+}
+
+const AnimationLOD::Settings& AnimationLOD::GetSettings()
+{
+	return settings;
+}
+
+void AnimationLOD::BeginFrame()
+{
+	for (unsigned int level = 0; level < static_cast<unsigned int>(Level::Count); level++)
+	{
+		lastCounts[level] = counts[level].exchange(0U);
+	}
+}
+
+unsigned int AnimationLOD::GetCount(Level level)
+{
+	return lastCounts[static_cast<unsigned int>(level)];
+}
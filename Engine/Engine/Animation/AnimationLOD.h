@@ -0,0 +1,85 @@
+#ifndef ANIMATIONLOD_H
+#define ANIMATIONLOD_H
+
+#include <atomic>
+#include <glm/glm.hpp>
+
+class Camera;
+class Model;
+
+// Picks how much work an animated object gets from how large it appears to a camera. Small objects update at a
+// fraction of the frame rate and interpolate in between, very small ones also leave their leaf joints at rest where
+// their pose is sampled for them alone, and objects outside the view are not animated at all.
+class AnimationLOD
+{
+
+public:
+
+	enum class Level
+	{
+		Full,
+		Half,
+		Quarter,
+		Eighth,
+		// Off screen, the pose is left as it is.
+		Frozen,
+		Count
+	};
+
+	// Thresholds are the fraction of the view's height the bounding sphere's diameter covers.
+	struct Settings
+	{
+		float halfRateBelow = 0.3f;
+
+		float quarterRateBelow = 0.12f;
+
+		float eighthRateBelow = 0.05f;
+
+		float leafJointsAtRestBelow = 0.15f;
+	};
+
+	// The level for a bounding sphere in world space. Counted towards GetCount for the current frame.
+	static Level Select(const Camera& camera, const glm::vec3& center, float radius, bool& outLeafJointsAtRest);
+
+	// The level for model's bounding sphere placed by modelMatrix, scaled by the largest axis scale.
+	static Level Select(const Camera& camera, const Model& model, const glm::mat4& modelMatrix, bool& outLeafJointsAtRest);
+
+	// Fraction of the view's height the sphere's diameter covers, above 1 when the camera is inside it.
+	static float GetScreenSize(const Camera& camera, const glm::vec3& center, float radius);
+
+	// Frames between pose evaluations, 0 for Frozen.
+	static unsigned int GetUpdateInterval(Level level);
+
+	static void SetSettings(const Settings& newSettings);
+
+	static const Settings& GetSettings();
+
+	// Starts counting a new frame. Call before the objects update.
+	static void BeginFrame();
+
+	// Objects selected at level during the last frame.
+	static unsigned int GetCount(Level level);
+
+private:
+
+	AnimationLOD() = delete;
+
+	~AnimationLOD() = delete;
+
+	AnimationLOD(const AnimationLOD&) = delete;
+
+	AnimationLOD& operator=(const AnimationLOD&) = delete;
+
+	AnimationLOD(AnimationLOD&&) = delete;
+
+	AnimationLOD& operator=(AnimationLOD&&) = delete;
+
+	static Settings settings;
+
+	static std::atomic<unsigned int> counts[static_cast<unsigned int>(Level::Count)];
+
+	static unsigned int lastCounts[static_cast<unsigned int>(Level::Count)];
+
+};
+
+#endif // ANIMATIONLOD_H
@@ -2,43 +2,495 @@
 
 #include "Armature.h"
 #include "Clip.h"
+#include "../Math/TransformSoA.h"
+#include "../Utils/Logger.h"
 
-BakedAnimation::BakedAnimation(Clip* c, Armature* const armature) :
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <execution>
+
+namespace
+{
+	// Largest error a removed key may introduce, in model units for positions and scales and quaternion components for rotations.
+	const float positionTolerance = 0.0001f;
+
+	const float rotationTolerance = 0.0001f;
+
+	const float scaleTolerance = 0.0001f;
+
+	// Keeps the greedy key reduction linear in the clip length.
+	const unsigned int maxKeySpan = 255U;
+
+	const float quantizedMax = static_cast<float>(std::numeric_limits<uint16_t>::max());
+
+	// Rotations use smallest three encoding, 15 bits per component leave room for the index of the dropped component.
+	const float rotationQuantizedMax = 32767.0f;
+
+	const float sqrtHalf = 0.70710678f;
+
+	// Frames sampled by one baking task, enough that the task outweighs starting its track cursors cold.
+	const unsigned int framesPerBakeTask = 256U;
+}
+
+BakedAnimation::BakedAnimation(Clip* clip, Armature* const armature) :
+	channels(std::vector<ChannelKeys>()),
+	keys(std::vector<Key>()),
 	animatedPose(armature->GetRestPose()),
-	clip(c),
-	bakedPoses(std::vector<std::vector<glm::mat4>>())
+	frameCount(0U),
+	duration(clip->GetDuration()),
+	looping(clip->IsLooping()),
+	id(0U),
+	leafJoints(std::vector<unsigned char>())
 {
-	unsigned int bakedPoseCount = static_cast<unsigned int>(clip->GetDuration() / MAX_ANIMATION_FRAME_TIME);
-	bakedPoses.resize(bakedPoseCount);
-	for (std::vector<glm::mat4>& posePalette : bakedPoses)
+	static std::atomic<uint64_t> nextId(1U);
+	id = nextId.fetch_add(1U);
+
+	frameCount = static_cast<unsigned int>(clip->GetDuration() / MAX_ANIMATION_FRAME_TIME);
+
+	if (frameCount > std::numeric_limits<uint16_t>::max())
+	{
+		Logger::Log(std::string("Clip ") + clip->GetName() + " is too long to bake, it is cut to " + std::to_string(std::numeric_limits<uint16_t>::max()) + " frames.", Logger::Category::Warning);
+		frameCount = std::numeric_limits<uint16_t>::max();
+	}
+
+	const unsigned int jointCount = animatedPose.Size();
+	const unsigned int sampleCount = std::max(frameCount, 1U);
+
+	const unsigned int channelCount = jointCount * ChannelCount;
+
+	// Every channel's samples back to back in one allocation, channel i starting at i * sampleCount.
+	std::vector<glm::vec4> samples(static_cast<size_t>(channelCount) * sampleCount);
+
+	std::vector<unsigned int> frameRanges((sampleCount + framesPerBakeTask - 1U) / framesPerBakeTask);
+	std::iota(frameRanges.begin(), frameRanges.end(), 0U);
+
+	// Frame ranges are sampled in parallel, each from its own pose. Within a range the clip plays forward, so the track
+	// cursors turn every frame lookup into a constant time step.
+	std::for_each(std::execution::par, frameRanges.begin(), frameRanges.end(),
+		[&](unsigned int range)
+		{
+			Pose pose(armature->GetRestPose());
+			std::vector<TransformTrack::Cursor> trackCursors;
+
+			const unsigned int firstFrame = range * framesPerBakeTask;
+			const unsigned int lastFrame = std::min(firstFrame + framesPerBakeTask, sampleCount);
+
+			for (unsigned int i = firstFrame; i < lastFrame; i++)
+			{
+				clip->Sample(pose, i * MAX_ANIMATION_FRAME_TIME, trackCursors);
+
+				for (unsigned int joint = 0; joint < jointCount; joint++)
+				{
+					const Math::Transform& local = pose.GetLocalTransform(joint);
+					const glm::quat& rotation = local.Rotation();
+
+					glm::vec4* const jointSamples = &samples[static_cast<size_t>(joint) * ChannelCount * sampleCount + i];
+					jointSamples[PositionChannel * sampleCount] = glm::vec4(local.Position(), 0.0f);
+					jointSamples[RotationChannel * sampleCount] = glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w);
+					jointSamples[ScaleChannel * sampleCount] = glm::vec4(local.Scale(), 0.0f);
+				}
+			}
+		});
+
+	leafJoints.assign(jointCount, 1U);
+	for (unsigned int joint = 0; joint < jointCount; joint++)
+	{
+		const int parent = static_cast<int>(animatedPose.GetParent(joint));
+		if (parent >= 0 && parent < static_cast<int>(jointCount))
+		{
+			leafJoints[parent] = 0U;
+		}
+	}
+
+	// Channels compress independently into their own keys, which are then packed into one array in channel order.
+	channels.resize(channelCount);
+	std::vector<std::vector<Key>> channelKeys(channelCount);
+
+	std::vector<unsigned int> channelIndices(channelCount);
+	std::iota(channelIndices.begin(), channelIndices.end(), 0U);
+
+	std::for_each(std::execution::par, channelIndices.begin(), channelIndices.end(),
+		[&](unsigned int i)
+		{
+			Compress(static_cast<Channel>(i % ChannelCount), &samples[static_cast<size_t>(i) * sampleCount], sampleCount, channels[i], channelKeys[i]);
+		});
+
+	size_t keyCount = 0;
+	for (const std::vector<Key>& compressed : channelKeys)
 	{
-		posePalette.resize(animatedPose.Size());
+		keyCount += compressed.size();
 	}
 
-	for (unsigned int i = 0; i < bakedPoseCount; i++)
+	keys.reserve(keyCount);
+	for (unsigned int i = 0; i < channelCount; i++)
 	{
-		clip->Sample(animatedPose, i * MAX_ANIMATION_FRAME_TIME);
-		animatedPose.GetJointMatrices(bakedPoses[i]);
+		channels[i].firstKey = static_cast<uint32_t>(keys.size());
+		keys.insert(keys.end(), channelKeys[i].begin(), channelKeys[i].end());
 	}
 }
 
-const std::vector<glm::mat4>& BakedAnimation::GetPoseAtIndex(unsigned int index) const
+void BakedAnimation::SamplePose(float time, Pose& outPose, std::vector<unsigned int>* keyCursors) const
+{
+	thread_local Math::TransformSoA sampled;
+
+	SamplePose(time, sampled, keyCursors);
+	outPose.SetLocalTransforms(sampled);
+}
+
+void BakedAnimation::SamplePose(float time, Math::TransformSoA& outTransforms, std::vector<unsigned int>* keyCursors, bool leafJointsAtRest) const
 {
-	static std::vector<glm::mat4> defaultReturn;
+	const float lastFrame = static_cast<float>(std::max(frameCount, 1U) - 1U);
+	const float frame = std::clamp(time / MAX_ANIMATION_FRAME_TIME, 0.0f, lastFrame);
 
-	if (index < bakedPoses.size())
+	const unsigned int jointCount = static_cast<unsigned int>(channels.size() / ChannelCount);
+
+	// The keys around frame are decoded for every joint first, then all joints are interpolated in one batch.
+	thread_local Math::TransformSoA from;
+	thread_local Math::TransformSoA to;
+	thread_local std::vector<float> times[ChannelCount];
+
+	from.Resize(jointCount);
+	to.Resize(jointCount);
+
+	if (keyCursors != nullptr && keyCursors->size() != channels.size())
 	{
-		return bakedPoses[index];
+		keyCursors->assign(channels.size(), 0U);
 	}
 
-	return defaultReturn;
+	const Math::TransformSoA::Component firstComponents[ChannelCount] = { Math::TransformSoA::PositionX, Math::TransformSoA::RotationX, Math::TransformSoA::ScaleX };
+	const unsigned int componentCounts[ChannelCount] = { 3U, 4U, 3U };
+
+	for (unsigned int channel = 0; channel < ChannelCount; channel++)
+	{
+		times[channel].resize(jointCount);
+
+		for (unsigned int joint = 0; joint < jointCount; joint++)
+		{
+			if (leafJointsAtRest && leafJoints[joint] != 0U)
+			{
+				// Mixing the rest transform with itself leaves it as it is.
+				const Math::Transform& rest = animatedPose.GetLocalTransform(joint);
+				const glm::vec4 restValue = channel == PositionChannel ? glm::vec4(rest.Position(), 0.0f) : channel == ScaleChannel ? glm::vec4(rest.Scale(), 0.0f) : glm::vec4(rest.Rotation().x, rest.Rotation().y, rest.Rotation().z, rest.Rotation().w);
+
+				for (unsigned int component = 0; component < componentCounts[channel]; component++)
+				{
+					from.GetComponent(static_cast<Math::TransformSoA::Component>(firstComponents[channel] + component))[joint] = restValue[component];
+					to.GetComponent(static_cast<Math::TransformSoA::Component>(firstComponents[channel] + component))[joint] = restValue[component];
+				}
+
+				times[channel][joint] = 0.0f;
+				continue;
+			}
+
+			const ChannelKeys& channelKeys = channels[joint * ChannelCount + channel];
+
+			const Key* previous = nullptr;
+			const Key* next = nullptr;
+			unsigned int* const cursor = keyCursors != nullptr ? &(*keyCursors)[joint * ChannelCount + channel] : nullptr;
+			FindKeys(channelKeys, frame, cursor, previous, next, times[channel][joint]);
+
+			const glm::vec4 fromValue = Decode(static_cast<Channel>(channel), channelKeys, *previous);
+			const glm::vec4 toValue = Decode(static_cast<Channel>(channel), channelKeys, *next);
+
+			for (unsigned int component = 0; component < componentCounts[channel]; component++)
+			{
+				from.GetComponent(static_cast<Math::TransformSoA::Component>(firstComponents[channel] + component))[joint] = fromValue[component];
+				to.GetComponent(static_cast<Math::TransformSoA::Component>(firstComponents[channel] + component))[joint] = toValue[component];
+			}
+		}
+	}
+
+	Math::TransformSoA::Mix(from, to, times[PositionChannel].data(), times[RotationChannel].data(), times[ScaleChannel].data(), outTransforms);
+}
+
+void BakedAnimation::GetPoseAtIndex(unsigned int index, Pose& scratchPose, std::vector<glm::mat4>& outMatrices) const
+{
+	SamplePose(index * MAX_ANIMATION_FRAME_TIME, scratchPose);
+	scratchPose.GetJointMatrices(outMatrices);
+}
+
+const Pose& BakedAnimation::GetRestPose() const
+{
+	return animatedPose;
 }
 
 unsigned int BakedAnimation::GetFrameCount() const
 {
-	return static_cast<unsigned int>(bakedPoses.size());
+	return frameCount;
+}
+
+float BakedAnimation::GetDuration() const
+{
+	return duration;
+}
+
+bool BakedAnimation::IsLooping() const
+{
+	return looping;
+}
+
+float BakedAnimation::AdjustTimeToFitRange(float time) const
+{
+	if (duration <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	if (looping)
+	{
+		time = std::fmod(time, duration);
+
+		if (time < 0.0f)
+		{
+			time += duration;
+		}
+
+		return time;
+	}
+
+	return std::clamp(time, 0.0f, duration);
+}
+
+size_t BakedAnimation::GetSizeInBytes() const
+{
+	return keys.capacity() * sizeof(Key) + channels.capacity() * sizeof(ChannelKeys);
+}
+
+uint64_t BakedAnimation::GetId() const
+{
+	return id;
+}
+
+void BakedAnimation::Compress(Channel channel, const glm::vec4* samples, unsigned int sampleCount, ChannelKeys& outChannel, std::vector<Key>& outKeys) const
+{
+	outChannel.firstKey = 0U;
+	outChannel.rangeMin = glm::vec3(0.0f);
+	outChannel.rangeExtent = glm::vec3(0.0f);
+
+	float tolerance = rotationTolerance;
+
+	if (channel != RotationChannel)
+	{
+		glm::vec3 rangeMax = glm::vec3(samples[0]);
+		outChannel.rangeMin = rangeMax;
+
+		for (unsigned int i = 0; i < sampleCount; i++)
+		{
+			outChannel.rangeMin = glm::min(outChannel.rangeMin, glm::vec3(samples[i]));
+			rangeMax = glm::max(rangeMax, glm::vec3(samples[i]));
+		}
+
+		outChannel.rangeExtent = rangeMax - outChannel.rangeMin;
+
+		// The tolerance can never be tighter than the quantization step.
+		const float step = std::max(outChannel.rangeExtent.x, std::max(outChannel.rangeExtent.y, outChannel.rangeExtent.z)) / quantizedMax;
+		tolerance = (channel == PositionChannel ? positionTolerance : scaleTolerance) + step;
+	}
+
+	std::vector<Key> encoded(sampleCount);
+	std::vector<glm::vec4> decoded(sampleCount);
+	for (unsigned int i = 0; i < sampleCount; i++)
+	{
+		encoded[i] = Encode(channel, outChannel, static_cast<uint16_t>(i), samples[i]);
+		decoded[i] = Decode(channel, outChannel, encoded[i]);
+	}
+
+	// A channel the clip does not animate keeps a single key.
+	bool constant = true;
+	for (unsigned int i = 1; i < sampleCount && constant; i++)
+	{
+		constant = Error(channel, decoded[0], samples[i]) <= tolerance;
+	}
+
+	outKeys.push_back(encoded[0]);
+
+	if (!constant)
+	{
+		// Extend each segment for as long as interpolating its end keys reproduces every sample in between.
+		auto segmentFits = [&](unsigned int first, unsigned int last)
+		{
+			for (unsigned int i = first + 1; i < last; i++)
+			{
+				const float t = static_cast<float>(i - first) / static_cast<float>(last - first);
+				if (Error(channel, Interpolate(channel, decoded[first], decoded[last], t), samples[i]) > tolerance)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		};
+
+		unsigned int segmentStart = 0U;
+		unsigned int segmentEnd = 1U;
+
+		while (segmentEnd < sampleCount - 1U)
+		{
+			if (segmentEnd + 1U - segmentStart <= maxKeySpan && segmentFits(segmentStart, segmentEnd + 1U))
+			{
+				segmentEnd++;
+			}
+			else
+			{
+				outKeys.push_back(encoded[segmentEnd]);
+				segmentStart = segmentEnd;
+				segmentEnd = segmentStart + 1U;
+			}
+		}
+
+		outKeys.push_back(encoded[sampleCount - 1U]);
+	}
+
+	outChannel.keyCount = static_cast<uint32_t>(outKeys.size());
+}
+
+BakedAnimation::Key BakedAnimation::Encode(Channel channel, const ChannelKeys& channelKeys, uint16_t frame, const glm::vec4& value)
+{
+	Key key;
+	key.frame = frame;
+
+	if (channel == RotationChannel)
+	{
+		glm::vec4 rotation = glm::normalize(value);
+
+		unsigned int largest = 0U;
+		for (unsigned int i = 1; i < 4; i++)
+		{
+			if (std::fabs(rotation[i]) > std::fabs(rotation[largest]))
+			{
+				largest = i;
+			}
+		}
+
+		// q and -q are the same rotation, so the dropped component can always be rebuilt as positive.
+		if (rotation[largest] < 0.0f)
+		{
+			rotation = -rotation;
+		}
+
+		unsigned int component = 0U;
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			if (i != largest)
+			{
+				const float normalized = std::clamp(rotation[i] / sqrtHalf * 0.5f + 0.5f, 0.0f, 1.0f);
+				key.value[component++] = static_cast<uint16_t>(std::lround(normalized * rotationQuantizedMax));
+			}
+		}
+
+		key.value[0] |= static_cast<uint16_t>((largest & 1U) << 15);
+		key.value[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+	}
+	else
+	{
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			const float normalized = channelKeys.rangeExtent[i] > 0.0f ? (value[i] - channelKeys.rangeMin[i]) / channelKeys.rangeExtent[i] : 0.0f;
+			key.value[i] = static_cast<uint16_t>(std::lround(std::clamp(normalized, 0.0f, 1.0f) * quantizedMax));
+		}
+	}
+
+	return key;
+}
+
+glm::vec4 BakedAnimation::Decode(Channel channel, const ChannelKeys& channelKeys, const Key& key)
+{
+	if (channel == RotationChannel)
+	{
+		const unsigned int largest = (key.value[0] >> 15) | ((key.value[1] >> 15) << 1);
+
+		glm::vec4 rotation(0.0f);
+		float sumOfSquares = 0.0f;
+		unsigned int component = 0U;
+
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			if (i != largest)
+			{
+				const float normalized = static_cast<float>(key.value[component++] & 0x7FFF) / rotationQuantizedMax;
+				rotation[i] = (normalized * 2.0f - 1.0f) * sqrtHalf;
+				sumOfSquares += rotation[i] * rotation[i];
+			}
+		}
+
+		rotation[largest] = std::sqrt(std::max(0.0f, 1.0f - sumOfSquares));
+
+		return rotation;
+	}
+
+	glm::vec4 result(0.0f);
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		result[i] = channelKeys.rangeMin[i] + static_cast<float>(key.value[i]) / quantizedMax * channelKeys.rangeExtent[i];
+	}
+
+	return result;
+}
+
+void BakedAnimation::FindKeys(const ChannelKeys& channelKeys, float frame, unsigned int* cursor, const Key*& outPrevious, const Key*& outNext, float& outTime) const
+{
+	const Key* const first = keys.data() + channelKeys.firstKey;
+	const Key* const last = first + channelKeys.keyCount;
+
+	const Key* next = nullptr;
+
+	if (cursor != nullptr)
+	{
+		// Playing forward, frame is almost always after the cursor's key or the one after it.
+		for (unsigned int key = *cursor; key < channelKeys.keyCount && key <= *cursor + 1U && next == nullptr; key++)
+		{
+			if (static_cast<float>(first[key].frame) <= frame && (key + 1U == channelKeys.keyCount || frame < static_cast<float>(first[key + 1U].frame)))
+			{
+				next = first + key + 1U;
+			}
+		}
+	}
+
+	if (next == nullptr)
+	{
+		next = std::upper_bound(first, last, frame, [](float value, const Key& key) { return value < static_cast<float>(key.frame); });
+	}
+
+	if (cursor != nullptr)
+	{
+		*cursor = next == first ? 0U : static_cast<unsigned int>(next - first) - 1U;
+	}
+
+	outTime = 0.0f;
+
+	if (next == first || next == last)
+	{
+		// Before the first or after the last key the channel holds its value.
+		outPrevious = outNext = (next == first) ? first : last - 1;
+		return;
+	}
+
+	outPrevious = next - 1;
+	outNext = next;
+	outTime = (frame - static_cast<float>(outPrevious->frame)) / static_cast<float>(outNext->frame - outPrevious->frame);
+}
+
+glm::vec4 BakedAnimation::Interpolate(Channel channel, const glm::vec4& a, const glm::vec4& b, float t)
+{
+	if (channel == RotationChannel)
+	{
+		// nlerp through the shorter arc.
+		const glm::vec4 end = glm::dot(a, b) < 0.0f ? -b : b;
+		return glm::normalize(a + (end - a) * t);
+	}
+
+	return a + (b - a) * t;
+}
+
+float BakedAnimation::Error(Channel channel, const glm::vec4& a, const glm::vec4& b)
+{
+	const glm::vec4 difference = (channel == RotationChannel && glm::dot(a, b) < 0.0f) ? a + b : a - b;
+	return std::max(std::max(std::fabs(difference.x), std::fabs(difference.y)), std::max(std::fabs(difference.z), std::fabs(difference.w)));
 }
 
 BakedAnimation::~BakedAnimation()
 {
-}
\ No newline at end of file
+}
@@ -2,17 +2,19 @@
 #define BAKEDANIMATION_H
 
 #define MAX_ANIMATION_FRAME_TIME 0.0041666f
-#define ANIMATION_PLAYBACK_FRAME_TIME 0.0041666f
 
 #include "Pose.h"
 
 #include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 class Clip;
 class Pose;
 class Armature;
 
+// A clip sampled every MAX_ANIMATION_FRAME_TIME and stored compressed: per joint position, rotation and scale keys with
+// quantized values, keeping only the keys that linear interpolation cannot reproduce within tolerance. Poses are evaluated on demand.
 class BakedAnimation
 {
 public:
@@ -31,17 +33,95 @@ public:
 
 	BakedAnimation& operator=(BakedAnimation&&) = default;
 
-	const std::vector<glm::mat4>& GetPoseAtIndex(unsigned int index) const;
+	// Writes the local transform of every joint at time seconds after the start of the clip. outPose must have GetRestPose()'s hierarchy.
+	// keyCursors, when given, holds one key cursor per channel for a playback and makes playing forward skip the key search.
+	void SamplePose(float time, Pose& outPose, std::vector<unsigned int>* keyCursors = nullptr) const;
+
+	// SamplePose into one transform per joint, the form poses are blended in. With leafJointsAtRest, joints without
+	// children are not sampled and keep their rest transform, for objects too small to show them.
+	void SamplePose(float time, Math::TransformSoA& outTransforms, std::vector<unsigned int>* keyCursors = nullptr, bool leafJointsAtRest = false) const;
+
+	// Convenience for SamplePose at a baked frame followed by Pose::GetJointMatrices.
+	void GetPoseAtIndex(unsigned int index, Pose& scratchPose, std::vector<glm::mat4>& outMatrices) const;
+
+	const Pose& GetRestPose() const;
 
 	unsigned int GetFrameCount() const;
 
+	float GetDuration() const;
+
+	bool IsLooping() const;
+
+	// Wraps time into [0, duration) for looping clips and clamps it to [0, duration] otherwise, like Clip::AdjustTimeToFitRange.
+	float AdjustTimeToFitRange(float time) const;
+
+	size_t GetSizeInBytes() const;
+
+	// Unique to the clip this was baked from, so caches are not fooled by a new bake at a reused address.
+	uint64_t GetId() const;
+
 private:
 
-	std::vector<std::vector<glm::mat4>> bakedPoses;
+	enum Channel
+	{
+		PositionChannel,
+		RotationChannel,
+		ScaleChannel,
+		ChannelCount
+	};
+
+	struct Key
+	{
+		uint16_t frame;
+
+		uint16_t value[3];
+	};
+
+	struct ChannelKeys
+	{
+		uint32_t firstKey;
+
+		uint32_t keyCount;
+
+		// Positions and scales are stored relative to the range the channel covers.
+		glm::vec3 rangeMin;
+
+		glm::vec3 rangeExtent;
+	};
+
+	// Appends the keys of one channel to outKeys, firstKey is left for the caller to set when it packs them.
+	void Compress(Channel channel, const glm::vec4* samples, unsigned int sampleCount, ChannelKeys& outChannel, std::vector<Key>& outKeys) const;
+
+	// The keys around frame and how far between them it is. Both keys are the same one before the first or after the last key.
+	// cursor, if not null, is the key found last time for this channel and is updated.
+	void FindKeys(const ChannelKeys& channelKeys, float frame, unsigned int* cursor, const Key*& outPrevious, const Key*& outNext, float& outTime) const;
+
+	static glm::vec4 Decode(Channel channel, const ChannelKeys& channelKeys, const Key& key);
+
+	static Key Encode(Channel channel, const ChannelKeys& channelKeys, uint16_t frame, const glm::vec4& value);
+
+	static glm::vec4 Interpolate(Channel channel, const glm::vec4& a, const glm::vec4& b, float t);
+
+	static float Error(Channel channel, const glm::vec4& a, const glm::vec4& b);
+
+	std::vector<ChannelKeys> channels;
+
+	std::vector<Key> keys;
+
 	Pose animatedPose;
-	Clip* clip;
+
+	unsigned int frameCount;
+
+	float duration;
+
+	bool looping;
+
+	uint64_t id;
+
+	// 1 for joints no other joint is parented to.
+	std::vector<unsigned char> leafJoints;
 
 };
 
 
-#endif // BAKEDANIMATION_H
\ No newline at end of file
+#endif // BAKEDANIMATION_H
@@ -0,0 +1,122 @@
+#include "BakedJointMatrices.h"
+
+#include "BakedAnimation.h"
+#include "Pose.h"
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <cmath>
+
+BakedJointMatrices::BakedJointMatrices(const std::vector<const BakedAnimation*>& clips, const std::vector<glm::mat4>& invBindPose, float fps) :
+	rows(),
+	clipRanges(),
+	jointCount(static_cast<unsigned int>(invBindPose.size())),
+	frameCount(0U),
+	framesPerSecond(fps)
+{
+	for (const BakedAnimation* const clip : clips)
+	{
+		ClipRange range = {};
+		range.firstFrame = frameCount;
+		range.frameCount = std::max(1U, static_cast<unsigned int>(std::ceil(clip->GetDuration() * framesPerSecond)) + 1U);
+		range.duration = clip->GetDuration();
+		range.looping = clip->IsLooping() ? 1U : 0U;
+
+		clipRanges.push_back(range);
+		frameCount += range.frameCount;
+	}
+
+	rows.resize(static_cast<size_t>(frameCount) * jointCount * 3U);
+
+	for (unsigned int c = 0; c < clips.size(); c++)
+	{
+		const BakedAnimation& clip = *clips[c];
+		const ClipRange& range = clipRanges[c];
+
+		std::vector<unsigned int> frames(range.frameCount);
+		std::iota(frames.begin(), frames.end(), 0U);
+
+		// Frames are spread evenly over the clip, the first at 0 and the last at its duration, so the shader finds them by scaling the normalized time.
+		std::for_each(std::execution::par, frames.begin(), frames.end(),
+			[this, &clip, &range, &invBindPose](unsigned int frame)
+			{
+				const float time = (range.frameCount > 1U) ? range.duration * static_cast<float>(frame) / static_cast<float>(range.frameCount - 1U) : 0.0f;
+
+				Pose pose(clip.GetRestPose());
+				clip.SamplePose(time, pose);
+
+				std::vector<glm::mat4> matrices;
+				pose.GetJointMatrices(matrices);
+
+				glm::vec4* const out = &rows[(static_cast<size_t>(range.firstFrame + frame) * jointCount) * 3U];
+				const unsigned int joints = std::min(jointCount, static_cast<unsigned int>(matrices.size()));
+
+				for (unsigned int j = 0; j < jointCount; j++)
+				{
+					const glm::mat4 skin = (j < joints) ? matrices[j] * invBindPose[j] : glm::mat4(1.0f);
+
+					for (unsigned int r = 0; r < 3; r++)
+					{
+						out[j * 3U + r] = glm::vec4(skin[0][r], skin[1][r], skin[2][r], skin[3][r]);
+					}
+				}
+			});
+	}
+}
+
+BakedJointMatrices::~BakedJointMatrices()
+{
+
+}
+
+const std::vector<glm::vec4>& BakedJointMatrices::GetRows() const
+{
+	return rows;
+}
+
+const std::vector<BakedJointMatrices::ClipRange>& BakedJointMatrices::GetClips() const
+{
+	return clipRanges;
+}
+
+unsigned int BakedJointMatrices::GetJointCount() const
+{
+	return jointCount;
+}
+
+unsigned int BakedJointMatrices::GetFrameCount() const
+{
+	return frameCount;
+}
+
+float BakedJointMatrices::GetFramesPerSecond() const
+{
+	return framesPerSecond;
+}
+
+glm::mat4 BakedJointMatrices::GetMatrix(unsigned int frame, unsigned int joint) const
+{
+	if (frame >= frameCount || joint >= jointCount)
+	{
+		return glm::mat4(1.0f);
+	}
+
+	const glm::vec4* const jointRows = &rows[(static_cast<size_t>(frame) * jointCount + joint) * 3U];
+
+	glm::mat4 matrix(1.0f);
+	for (unsigned int r = 0; r < 3; r++)
+	{
+		matrix[0][r] = jointRows[r].x;
+		matrix[1][r] = jointRows[r].y;
+		matrix[2][r] = jointRows[r].z;
+		matrix[3][r] = jointRows[r].w;
+	}
+
+	return matrix;
+}
+
+size_t BakedJointMatrices::GetSizeInBytes() const
+{
+	return rows.size() * sizeof(glm::vec4) + clipRanges.size() * sizeof(ClipRange);
+}
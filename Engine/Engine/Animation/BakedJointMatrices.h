@@ -0,0 +1,72 @@
+#ifndef BAKEDJOINTMATRICES_H
+#define BAKEDJOINTMATRICES_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class BakedAnimation;
+
+// The skinning matrices of a set of clips sampled at a fixed rate and laid out for the GPU, so instances can be animated
+// in the vertex shader from a clip index and a time alone. Each frame holds three rows per joint, the affine part of
+// pose * invBindPose, and frames of a clip are contiguous.
+class BakedJointMatrices
+{
+public:
+
+	// Matches the std430 layout of the clip table in the crowd shaders.
+	struct ClipRange
+	{
+		uint32_t firstFrame;
+
+		uint32_t frameCount;
+
+		float duration;
+
+		uint32_t looping;
+	};
+
+	BakedJointMatrices() = delete;
+
+	BakedJointMatrices(const std::vector<const BakedAnimation*>& clips, const std::vector<glm::mat4>& invBindPose, float framesPerSecond = 30.0f);
+
+	~BakedJointMatrices();
+
+	BakedJointMatrices(const BakedJointMatrices&) = delete;
+
+	BakedJointMatrices& operator=(const BakedJointMatrices&) = delete;
+
+	BakedJointMatrices(BakedJointMatrices&&) = delete;
+
+	BakedJointMatrices& operator=(BakedJointMatrices&&) = delete;
+
+	const std::vector<glm::vec4>& GetRows() const;
+
+	const std::vector<ClipRange>& GetClips() const;
+
+	unsigned int GetJointCount() const;
+
+	unsigned int GetFrameCount() const;
+
+	float GetFramesPerSecond() const;
+
+	// The skinning matrix of joint at frame, put back together from its rows.
+	glm::mat4 GetMatrix(unsigned int frame, unsigned int joint) const;
+
+	size_t GetSizeInBytes() const;
+
+private:
+
+	std::vector<glm::vec4> rows;
+
+	std::vector<ClipRange> clipRanges;
+
+	unsigned int jointCount;
+
+	unsigned int frameCount;
+
+	float framesPerSecond;
+
+};
+
+#endif // BAKEDJOINTMATRICES_H
@@ -0,0 +1,93 @@
+#include "BlendSpace1D.h"
+
+#include "BakedAnimation.h"
+
+#include <algorithm>
+
+BlendSpace1D::BlendSpace1D() :
+	entries(std::vector<Entry>())
+{
+}
+
+BlendSpace1D::~BlendSpace1D()
+{
+}
+
+void BlendSpace1D::AddClip(const BakedAnimation& clip, float parameter)
+{
+	const Entry entry = { &clip, parameter };
+	entries.insert(std::upper_bound(entries.begin(), entries.end(), parameter, [](float value, const Entry& e) { return value < e.parameter; }), entry);
+}
+
+unsigned int BlendSpace1D::GetClipCount() const
+{
+	return static_cast<unsigned int>(entries.size());
+}
+
+float BlendSpace1D::GetDuration(float parameter) const
+{
+	if (entries.empty())
+	{
+		return 0.0f;
+	}
+
+	unsigned int first = 0U;
+	unsigned int second = 0U;
+	float time = 0.0f;
+	FindClips(parameter, first, second, time);
+
+	return entries[first].clip->GetDuration() * (1.0f - time) + entries[second].clip->GetDuration() * time;
+}
+
+void BlendSpace1D::Sample(float parameter, float phase, Math::TransformSoA& outTransforms, std::vector<std::vector<unsigned int>>& keyCursors, bool leafJointsAtRest) const
+{
+	if (entries.empty())
+	{
+		return;
+	}
+
+	if (keyCursors.size() != entries.size())
+	{
+		keyCursors.resize(entries.size());
+	}
+
+	unsigned int first = 0U;
+	unsigned int second = 0U;
+	float time = 0.0f;
+	FindClips(parameter, first, second, time);
+
+	const BakedAnimation& firstClip = *entries[first].clip;
+	firstClip.SamplePose(phase * firstClip.GetDuration(), outTransforms, &keyCursors[first], leafJointsAtRest);
+
+	if (first == second || time <= 0.0f)
+	{
+		return;
+	}
+
+	thread_local Math::TransformSoA secondTransforms;
+
+	const BakedAnimation& secondClip = *entries[second].clip;
+	secondClip.SamplePose(phase * secondClip.GetDuration(), secondTransforms, &keyCursors[second], leafJointsAtRest);
+
+	Math::TransformSoA::Mix(outTransforms, secondTransforms, time, outTransforms);
+}
+
+void BlendSpace1D::FindClips(float parameter, unsigned int& outFirst, unsigned int& outSecond, float& outTime) const
+{
+	const unsigned int last = static_cast<unsigned int>(entries.size()) - 1U;
+	const unsigned int next = static_cast<unsigned int>(std::upper_bound(entries.begin(), entries.end(), parameter, [](float value, const Entry& e) { return value < e.parameter; }) - entries.begin());
+
+	outTime = 0.0f;
+
+	if (next == 0U || next > last)
+	{
+		outFirst = outSecond = (next == 0U) ? 0U : last;
+		return;
+	}
+
+	outFirst = next - 1U;
+	outSecond = next;
+
+	const float range = entries[outSecond].parameter - entries[outFirst].parameter;
+	outTime = range > 0.0f ? (parameter - entries[outFirst].parameter) / range : 0.0f;
+}
@@ -0,0 +1,58 @@
+#ifndef BLENDSPACE1D_H
+#define BLENDSPACE1D_H
+
+#include "../Math/TransformSoA.h"
+
+#include <vector>
+
+class BakedAnimation;
+
+// Clips placed along one parameter, like a walk at speed 1 and a run at speed 4. Sampling blends the two clips around
+// the parameter at the same normalized time so their cycles stay in step.
+class BlendSpace1D
+{
+public:
+
+	BlendSpace1D();
+
+	~BlendSpace1D();
+
+	BlendSpace1D(const BlendSpace1D&) = delete;
+
+	BlendSpace1D& operator=(const BlendSpace1D&) = delete;
+
+	BlendSpace1D(BlendSpace1D&&) = delete;
+
+	BlendSpace1D& operator=(BlendSpace1D&&) = delete;
+
+	// Clips can be added in any order but must share one armature.
+	void AddClip(const BakedAnimation& clip, float parameter);
+
+	unsigned int GetClipCount() const;
+
+	// Seconds one cycle lasts at parameter.
+	float GetDuration(float parameter) const;
+
+	// Samples every joint at phase, from 0 at the start of the cycle to 1 at its end. keyCursors holds one cursor list per
+	// clip, leafJointsAtRest is passed on to BakedAnimation::SamplePose.
+	void Sample(float parameter, float phase, Math::TransformSoA& outTransforms, std::vector<std::vector<unsigned int>>& keyCursors, bool leafJointsAtRest = false) const;
+
+private:
+
+	// The clips around parameter and how far from the first to the second it is. Both are the same clip past either end.
+	void FindClips(float parameter, unsigned int& outFirst, unsigned int& outSecond, float& outTime) const;
+
+	struct Entry
+	{
+		const BakedAnimation* clip;
+
+		float parameter;
+	};
+
+	// Sorted by parameter.
+	std::vector<Entry> entries;
+
+};
+
+
+#endif // BLENDSPACE1D_H
@@ -64,6 +64,31 @@ float Clip::Sample(Pose& outPose, float time)
     return time;
 }
 
+float Clip::Sample(Pose& outPose, float time, std::vector<TransformTrack::Cursor>& cursors)
+{
+    if (GetDuration() == 0.0f)
+    {
+        return 0.0f;
+    }
+
+    time = AdjustTimeToFitRange(time);
+
+    unsigned int size = static_cast<unsigned int>(tracks.size());
+    if (cursors.size() != size)
+    {
+        cursors.resize(size);
+    }
+
+    for (unsigned int i = 0; i < size; i++)
+    {
+        unsigned int j = tracks[i].GetId(); // Joint
+        Math::Transform local = outPose.GetLocalTransform(j);
+        Math::Transform animated = tracks[i].Sample(local, time, isLooping, cursors[i]);
+        outPose.SetLocalTransform(j, animated);
+    }
+    return time;
+}
+
 void Clip::RecalculateDuration()
 {
     startTime = 0;
@@ -35,6 +35,9 @@ public:
 
 	float Sample(Pose& outPose, float time);
 
+	// Sample for a playback that keeps its frame cursors between calls, which makes playing forward a constant time lookup.
+	float Sample(Pose& outPose, float time, std::vector<TransformTrack::Cursor>& cursors);
+
 	void RecalculateDuration();
 
 	const std::string& GetName() const;
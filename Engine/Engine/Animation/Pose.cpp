@@ -1,5 +1,11 @@
 #include "Pose.h"
 
+#include "../Math/TransformSoA.h"
+
+#include <algorithm>
+#include <numeric>
+#include <execution>
+
 Pose::Pose()
 {
 }
@@ -45,6 +51,8 @@ Pose& Pose::operator=(const Pose& other)
 		memcpy(joints.data(), other.joints.data(), sizeof(Math::Transform) * joints.size());
 	}
 
+	evaluationOrder = other.evaluationOrder;
+
 	return *this;
 }
 
@@ -96,7 +104,9 @@ Math::Transform Pose::GetGlobalTransform(unsigned int index) const
 void Pose::Resize(unsigned int size)
 {
 	joints.resize(size);
-	parents.resize(size);
+	parents.resize(size, -1);
+
+	UpdateEvaluationOrder();
 }
 
 unsigned int Pose::Size() const
@@ -112,6 +122,8 @@ unsigned int Pose::GetParent(unsigned int index) const
 void Pose::SetParent(unsigned int index, int parent)
 {
 	parents[index] = parent;
+
+	UpdateEvaluationOrder();
 }
 
 const Math::Transform& Pose::GetLocalTransform(unsigned int index) const
@@ -124,6 +136,16 @@ void Pose::SetLocalTransform(unsigned int index, const Math::Transform& transfor
 	joints[index] = transform;
 }
 
+void Pose::SetLocalTransforms(const Math::TransformSoA& transforms)
+{
+	const unsigned int count = std::min(transforms.Size(), Size());
+
+	for (unsigned int joint = 0; joint < count; joint++)
+	{
+		joints[joint] = transforms.Get(joint);
+	}
+}
+
 void Pose::GetJointMatrices(std::vector<glm::mat4>& outMatrices) const
 {
 	unsigned int size = Size();
@@ -133,8 +155,69 @@ void Pose::GetJointMatrices(std::vector<glm::mat4>& outMatrices) const
 		outMatrices.resize(Size());
 	}
 
-	for (unsigned int i = 0; i < size; i++)
+	GetJointMatrices(outMatrices.data());
+}
+
+void Pose::GetJointMatrices(const std::vector<const Pose*>& poses, std::vector<glm::mat4>& outMatrices)
+{
+	if (poses.empty())
 	{
-		outMatrices[i] = GetGlobalTransform(i).ToMat4();
+		outMatrices.clear();
+		return;
 	}
+
+	const unsigned int jointCount = poses[0]->Size();
+	outMatrices.resize(poses.size() * jointCount);
+
+	std::vector<unsigned int> poseIndices(poses.size());
+	std::iota(poseIndices.begin(), poseIndices.end(), 0U);
+
+	std::for_each(std::execution::par, poseIndices.begin(), poseIndices.end(),
+		[&poses, &outMatrices, jointCount](unsigned int poseIndex)
+		{
+			if (poses[poseIndex]->Size() == jointCount)
+			{
+				poses[poseIndex]->GetJointMatrices(outMatrices.data() + static_cast<size_t>(poseIndex) * jointCount);
+			}
+		});
+}
+
+void Pose::GetJointMatrices(glm::mat4* outMatrices) const
+{
+	const int size = static_cast<int>(Size());
+
+	// Reused between calls so evaluating a pose does not allocate.
+	thread_local Math::TransformSoA globalTransforms;
+	globalTransforms.Resize(size);
+
+	for (unsigned int joint : evaluationOrder)
+	{
+		const int parent = parents[joint];
+
+		globalTransforms.Set(joint, (parent >= 0 && parent < size) ? Math::Transform::Combine(globalTransforms.Get(parent), joints[joint]) : joints[joint]);
+	}
+
+	// The hierarchy has to be walked in order, converting to matrices does not.
+	Math::TransformSoA::ToMat4(globalTransforms, outMatrices);
+}
+
+void Pose::UpdateEvaluationOrder()
+{
+	const int size = static_cast<int>(Size());
+
+	std::vector<int> depths(size);
+	for (int joint = 0; joint < size; joint++)
+	{
+		int depth = 0;
+		for (int parent = parents[joint]; parent >= 0 && parent < size && depth <= size; parent = parents[parent])
+		{
+			depth++;
+		}
+
+		depths[joint] = depth;
+	}
+
+	evaluationOrder.resize(size);
+	std::iota(evaluationOrder.begin(), evaluationOrder.end(), 0U);
+	std::stable_sort(evaluationOrder.begin(), evaluationOrder.end(), [&depths](unsigned int a, unsigned int b) { return depths[a] < depths[b]; });
 }
@@ -2,6 +2,7 @@
 #define POSE_H
 
 #include "../Math/Transform.h"
+#include "../Math/TransformSoA.h"
 
 #include <vector>
 
@@ -45,14 +46,29 @@ public:
 
 	void SetLocalTransform(unsigned int index, const Math::Transform& transform);
 
+	// Sets the first transforms.Size() local transforms.
+	void SetLocalTransforms(const Math::TransformSoA& transforms);
+
+	// Global matrix of every joint in one pass, each joint combined with its parent's already computed global transform.
 	void GetJointMatrices(std::vector<glm::mat4>& outMatrices) const;
 
+	// GetJointMatrices for poses sharing one hierarchy, written back to back into outMatrices and evaluated in parallel.
+	static void GetJointMatrices(const std::vector<const Pose*>& poses, std::vector<glm::mat4>& outMatrices);
+
+	// GetJointMatrices into an array of at least Size() matrices, such as a uniform buffer's palette.
+	void GetJointMatrices(glm::mat4* outMatrices) const;
+
 private:
 
+	void UpdateEvaluationOrder();
+
 	std::vector<Math::Transform> joints;
 
 	std::vector<int> parents;
 
+	// Joint indices sorted so every parent comes before its children.
+	std::vector<unsigned int> evaluationOrder;
+
 };
 
 
@@ -0,0 +1,150 @@
+#include "PoseCache.h"
+
+#include "BakedAnimation.h"
+#include "Pose.h"
+#include "../Utils/Logger.h"
+
+#include <cmath>
+
+PoseCache* PoseCache::instance = nullptr;
+
+std::mutex PoseCache::instanceMutex = std::mutex();
+
+void PoseCache::Initialize()
+{
+	std::lock_guard<std::mutex> guard(instanceMutex);
+
+	if (instance == nullptr)
+	{
+		instance = new PoseCache();
+		Logger::Log(std::string("Initialized PoseCache"), Logger::Category::Success);
+	}
+	else
+	{
+		Logger::Log(std::string("Calling PoseCache::Initialize() before PoseCache::Terminate()."), Logger::Category::Warning);
+	}
+}
+
+void PoseCache::Terminate()
+{
+	std::lock_guard<std::mutex> guard(instanceMutex);
+
+	if (instance != nullptr)
+	{
+		delete instance;
+		instance = nullptr;
+	}
+	else
+	{
+		Logger::Log(std::string("Calling PoseCache::Terminate() before PoseCache::Initialize()"), Logger::Category::Warning);
+	}
+}
+
+void PoseCache::BeginFrame()
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	std::unique_lock<std::shared_mutex> guard(instance->entriesMutex);
+
+	instance->lastEvaluatedPoseCount = instance->evaluatedPoseCount.exchange(0U);
+	instance->lastRequestCount = instance->requestCount.exchange(0U);
+
+	// Poses nobody asked for last frame are dropped, everything playing moves to another frame anyway.
+	for (auto entry = instance->entries.begin(); entry != instance->entries.end();)
+	{
+		if (entry->second->evaluatedFrame.load() != instance->frame)
+		{
+			entry = instance->entries.erase(entry);
+		}
+		else
+		{
+			++entry;
+		}
+	}
+
+	instance->frame++;
+}
+
+const glm::mat4* PoseCache::GetJointMatrices(const BakedAnimation& clip, float time)
+{
+	if (instance == nullptr)
+	{
+		return nullptr;
+	}
+
+	const uint32_t bakedFrame = static_cast<uint32_t>(std::lround(std::max(time, 0.0f) / MAX_ANIMATION_FRAME_TIME));
+	const uint64_t key = (clip.GetId() << 32) | bakedFrame;
+
+	Entry* entry = nullptr;
+
+	{
+		std::shared_lock<std::shared_mutex> guard(instance->entriesMutex);
+
+		auto found = instance->entries.find(key);
+		if (found != instance->entries.end())
+		{
+			entry = found->second.get();
+		}
+	}
+
+	if (entry == nullptr)
+	{
+		std::unique_lock<std::shared_mutex> guard(instance->entriesMutex);
+
+		std::unique_ptr<Entry>& slot = instance->entries[key];
+		if (slot == nullptr)
+		{
+			slot = std::make_unique<Entry>();
+		}
+
+		entry = slot.get();
+	}
+
+	instance->requestCount++;
+
+	// BeginFrame is the only place entries are removed and it does not run while objects update.
+	if (entry->evaluatedFrame.load(std::memory_order_acquire) != instance->frame)
+	{
+		std::lock_guard<std::mutex> guard(entry->evaluateMutex);
+
+		if (entry->evaluatedFrame.load(std::memory_order_relaxed) != instance->frame)
+		{
+			thread_local Pose scratchPose;
+			scratchPose = clip.GetRestPose();
+
+			clip.GetPoseAtIndex(bakedFrame, scratchPose, entry->jointMatrices);
+
+			entry->evaluatedFrame.store(instance->frame, std::memory_order_release);
+			instance->evaluatedPoseCount++;
+		}
+	}
+
+	return entry->jointMatrices.data();
+}
+
+unsigned int PoseCache::GetEvaluatedPoseCount()
+{
+	return instance != nullptr ? instance->lastEvaluatedPoseCount : 0U;
+}
+
+unsigned int PoseCache::GetRequestCount()
+{
+	return instance != nullptr ? instance->lastRequestCount : 0U;
+}
+
+PoseCache::PoseCache() :
+	entries(std::unordered_map<uint64_t, std::unique_ptr<Entry>>()),
+	frame(1U),
+	evaluatedPoseCount(0U),
+	requestCount(0U),
+	lastEvaluatedPoseCount(0U),
+	lastRequestCount(0U)
+{
+}
+
+PoseCache::~PoseCache()
+{
+}
@@ -0,0 +1,84 @@
+#ifndef POSECACHE_H
+#define POSECACHE_H
+
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class BakedAnimation;
+
+// Joint matrices shared by every animation playing the same clip at the same baked frame. Each unique pose is
+// evaluated once per frame however many instances show it, so crowds cost as much as their distinct poses.
+class PoseCache
+{
+
+public:
+
+	static void Initialize();
+
+	static void Terminate();
+
+	// Starts a new frame, poses evaluated before are evaluated again when next requested. Not thread safe, call it
+	// before the objects update.
+	static void BeginFrame();
+
+	// The joint matrices of clip at time, rounded to the nearest baked frame. Returns nullptr if the cache is not
+	// initialized. The matrices stay valid until the next BeginFrame.
+	static const glm::mat4* GetJointMatrices(const BakedAnimation& clip, float time);
+
+	// Poses evaluated and requested during the last frame.
+	static unsigned int GetEvaluatedPoseCount();
+
+	static unsigned int GetRequestCount();
+
+private:
+
+	PoseCache();
+
+	~PoseCache();
+
+	PoseCache(const PoseCache&) = delete;
+
+	PoseCache& operator=(const PoseCache&) = delete;
+
+	PoseCache(PoseCache&&) = delete;
+
+	PoseCache& operator=(PoseCache&&) = delete;
+
+	struct Entry
+	{
+		std::vector<glm::mat4> jointMatrices;
+
+		// The frame jointMatrices were evaluated in.
+		std::atomic<uint64_t> evaluatedFrame = 0U;
+
+		std::mutex evaluateMutex;
+	};
+
+	static PoseCache* instance;
+
+	static std::mutex instanceMutex;
+
+	// Clip id in the high bits and baked frame in the low 32.
+	std::unordered_map<uint64_t, std::unique_ptr<Entry>> entries;
+
+	std::shared_mutex entriesMutex;
+
+	uint64_t frame;
+
+	std::atomic<unsigned int> evaluatedPoseCount;
+
+	std::atomic<unsigned int> requestCount;
+
+	unsigned int lastEvaluatedPoseCount;
+
+	unsigned int lastRequestCount;
+
+};
+
+#endif // POSECACHE_H
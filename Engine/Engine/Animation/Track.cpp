@@ -2,6 +2,8 @@
 
 #include "../Math/Math.h"
 #include <glm/gtx/quaternion.hpp>
+#include <algorithm>
+#include <cmath>
 
 template Track<float, 1>;
 template Track<glm::vec3, 3>;
@@ -139,22 +141,26 @@ inline float Track<T, N>::AdjustTimeToFitTrack(float time, float isLooping) cons
 
 	if (isLooping)
 	{
-		time = fmod(time - startTime, duration);
-
-		if (time < 0.0f)
+		// Clip::Sample already wraps the time, most calls are in range.
+		if (time < startTime || time >= endTime)
 		{
-			time += duration;
-		}
+			time = fmod(time - startTime, duration);
+
+			if (time < 0.0f)
+			{
+				time += duration;
+			}
 
-		time += startTime;
+			time += startTime;
+		}
 	}
 	else
 	{
-		if (time < 0.0f)
+		if (time < startTime)
 		{
 			time = startTime;
 		}
-		else if (time > duration)
+		else if (time > endTime)
 		{
 			time = endTime;
 		}
@@ -181,11 +187,9 @@ template<> glm::quat Track<glm::quat, 4>::Cast(float* value) const
 }
 
 template<typename T, size_t N>
-inline T Track<T, N>::SampleConstant(float time, bool isLooping)
+inline T Track<T, N>::SampleConstant(float trackTime, unsigned int frame)
 {
-	unsigned int frame = FrameIndex(time, isLooping);
-
-	if (frame < 0 || frame >= Size())
+	if (frame >= Size())
 	{
 		return T();
 	}
@@ -194,18 +198,15 @@ inline T Track<T, N>::SampleConstant(float time, bool isLooping)
 }
 
 template<typename T, size_t N>
-inline T Track<T, N>::SampleLinear(float time, bool isLooping)
+inline T Track<T, N>::SampleLinear(float trackTime, unsigned int thisFrame)
 {
-	unsigned int thisFrame = FrameIndex(time, isLooping);
-
-	if (thisFrame < 0 || thisFrame >= Size() - 1)
+	if (thisFrame >= Size() - 1)
 	{
 		return T();
 	}
 
 	unsigned int nextFrame = thisFrame + 1;
 
-	float trackTime = AdjustTimeToFitTrack(time, isLooping);
 	float thisTime = frames[thisFrame].GetTime();
 	float frameDelta = frames[nextFrame].GetTime() - thisTime;
 
@@ -223,18 +224,15 @@ inline T Track<T, N>::SampleLinear(float time, bool isLooping)
 }
 
 template<typename T, size_t N>
-inline T Track<T, N>::SampleCubic(float time, bool isLooping)
+inline T Track<T, N>::SampleCubic(float trackTime, unsigned int thisFrame)
 {
-	unsigned int thisFrame = FrameIndex(time, isLooping);
-
-	if (thisFrame <= 0 || thisFrame >= Size() - 1)
+	if (thisFrame >= Size() - 1)
 	{
 		return T();
 	}
 
 	unsigned int nextFrame = thisFrame + 1;
 
-	float trackTime = AdjustTimeToFitTrack(time, isLooping);
 	float thisTime = frames[thisFrame].GetTime();
 	float frameDelta = frames[nextFrame].GetTime() - thisTime;
 
@@ -243,6 +241,7 @@ inline T Track<T, N>::SampleCubic(float time, bool isLooping)
 		return T();
 	}
 
+	// The curve runs from 0 at this frame to 1 at the next, the tangents are scaled to the segment's length to match.
 	float t = (trackTime - thisTime) / frameDelta;
 
 	T point1 = Cast(&frames[thisFrame].GetValue()[0]);
@@ -255,20 +254,20 @@ inline T Track<T, N>::SampleCubic(float time, bool isLooping)
 	memcpy(&tangent2, frames[nextFrame].GetInTangent(), N * sizeof(float));
 	tangent2 = tangent2 * frameDelta;
 
-	return Hermite(time, point1, point2, tangent1, tangent2);
+	return Hermite(t, point1, point2, tangent1, tangent2);
 }
 
 template<typename T, size_t N>
-inline T Track<T, N>::Sample(float time, bool isLooping)
+inline T Track<T, N>::SampleFrame(float trackTime, unsigned int frame)
 {
 	switch (interpolation)
 	{
 	case Interpolation::Constant:
-		return SampleConstant(time, isLooping);
+		return SampleConstant(trackTime, frame);
 	case Interpolation::Linear:
-		return SampleLinear(time, isLooping);
+		return SampleLinear(trackTime, frame);
 	case Interpolation::Cubic:
-		return SampleCubic(time, isLooping);
+		return SampleCubic(trackTime, frame);
 	default:
 		break;
 	};
@@ -276,6 +275,20 @@ inline T Track<T, N>::Sample(float time, bool isLooping)
 	return T();
 }
 
+template<typename T, size_t N>
+inline T Track<T, N>::Sample(float time, bool isLooping)
+{
+	float trackTime = AdjustTimeToFitTrack(time, isLooping);
+	return SampleFrame(trackTime, FrameIndex(trackTime, isLooping));
+}
+
+template<typename T, size_t N>
+inline T Track<T, N>::Sample(float time, bool isLooping, unsigned int& cursor)
+{
+	float trackTime = AdjustTimeToFitTrack(time, isLooping);
+	return SampleFrame(trackTime, FrameIndex(trackTime, isLooping, cursor));
+}
+
 template<typename T, size_t N>
 inline T Track<T, N>::Hermite(float time, const T& p0, const T& p1, const T& t0, const T& t1) const
 {
@@ -286,11 +299,11 @@ inline T Track<T, N>::Hermite(float time, const T& p0, const T& p1, const T& t0,
 	TrackHelpers::Neighborhood(p0, _p1);
 
 	float h1 = 2.0f * time3 - 3.0f * time2 + 1.0f;
-	float h2 = -2.0f * time3 * 3.0f * time2;
+	float h2 = -2.0f * time3 + 3.0f * time2;
 	float h3 = time3 - 2.0f * time2 + time;
 	float h4 = time3 - time2;
 
-	T result = p0 * h1 + p1 * h2 + t0 * h3 + t1 * h4;
+	T result = p0 * h1 + _p1 * h2 + t0 * h3 + t1 * h4;
 
 	return TrackHelpers::AdjustHermiteResult(result);
 }
@@ -303,43 +316,48 @@ inline unsigned int Track<T, N>::FrameIndex(float time, bool isLooping) const
 		return static_cast<unsigned int>(-1);
 	}
 
-	if (isLooping)
+	float trackTime = AdjustTimeToFitTrack(time, isLooping);
+
+	return SearchFrameIndex(trackTime);
+}
+
+template<typename T, size_t N>
+inline unsigned int Track<T, N>::FrameIndex(float time, bool isLooping, unsigned int& cursor) const
+{
+	if (frames.size() < 2)
 	{
-		float startTime = GetStartTime();
-		float endTime = GetEndTime();
-		float duration = endTime - startTime;
+		return static_cast<unsigned int>(-1);
+	}
 
-		time = fmod(time - startTime, duration);
+	float trackTime = AdjustTimeToFitTrack(time, isLooping);
 
-		if (time < 0.0f)
-		{
-			time += duration;
-		}
+	const unsigned int lastSegment = Size() - 2U;
 
-		time += startTime;
-	}
-	else
+	// Playing forward the time is almost always in the cursor's segment or the next one.
+	for (unsigned int frame = cursor; frame <= lastSegment && frame <= cursor + 1U; frame++)
 	{
-		if (time < 0)
-		{
-			return 0;
-		}
-		else if (time > frames[frames.size() - 2].GetTime())
+		if (trackTime >= frames[frame].GetTime() && (trackTime < frames[frame + 1].GetTime() || frame == lastSegment))
 		{
-			return Size() - 2U;
+			return cursor = frame;
 		}
 	}
 
-	for (unsigned int i = Size() - 1; i >= 0; --i)
+	// Seeks, loops and backwards playback.
+	return cursor = SearchFrameIndex(trackTime);
+}
+
+template<typename T, size_t N>
+inline unsigned int Track<T, N>::SearchFrameIndex(float trackTime) const
+{
+	// The last frame that starts at or before trackTime, kept to a segment that has a next frame.
+	auto next = std::upper_bound(frames.begin(), frames.end(), trackTime, [](float time, const Frame<N>& frame) { return time < frame.GetTime(); });
+
+	if (next == frames.begin())
 	{
-		if (time >= frames[i].GetTime())
-		{
-			return i;
-		}
+		return 0U;
 	}
 
-	return -1;
-
+	return std::min(static_cast<unsigned int>(std::distance(frames.begin(), next)) - 1U, Size() - 2U);
 }
 
 typedef Track<float, 1> ScalarTrack;
@@ -42,21 +42,32 @@ public:
 
 	T Sample(float time, bool isLooping);
 
+	// Sample for a playback that remembers where it was. cursor is the frame found by the previous call, playing forward
+	// it is reused or advanced by one instead of searched for. Start a playback with a cursor of 0.
+	T Sample(float time, bool isLooping, unsigned int& cursor);
+
 	T Hermite(float time, const T& p0, const T& p1, const T& t0, const T& t1) const;
 
+	// Binary search for the frame that starts the segment holding time.
 	unsigned int FrameIndex(float time, bool isLooping) const;
 
+	unsigned int FrameIndex(float time, bool isLooping, unsigned int& cursor) const;
+
 	float AdjustTimeToFitTrack(float time, float isLooping) const;
 
 	T Cast(float* value) const;
 
 private:
 
-	T SampleConstant(float time, bool isLooping);
+	T SampleFrame(float trackTime, unsigned int frame);
+
+	T SampleConstant(float trackTime, unsigned int frame);
 	
-	T SampleLinear(float time, bool isLooping);
+	T SampleLinear(float trackTime, unsigned int frame);
 	
-	T SampleCubic(float time, bool isLooping);
+	T SampleCubic(float trackTime, unsigned int frame);
+
+	unsigned int SearchFrameIndex(float trackTime) const;
 
 	Interpolation interpolation;
 
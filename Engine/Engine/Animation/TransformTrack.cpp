@@ -131,3 +131,25 @@ Math::Transform TransformTrack::Sample(const Math::Transform& refTransform, floa
 
 	return result;
 }
+
+Math::Transform TransformTrack::Sample(const Math::Transform& refTransform, float time, bool isLooping, Cursor& cursor)
+{
+	Math::Transform result = refTransform;
+
+	if (position.Size() > 1)
+	{
+		result.Position() = position.Sample(time, isLooping, cursor.position);
+	}
+
+	if (rotation.Size() > 1)
+	{
+		result.Rotation() = rotation.Sample(time, isLooping, cursor.rotation);
+	}
+
+	if (scale.Size() > 1)
+	{
+		result.Scale() = scale.Sample(time, isLooping, cursor.scale);
+	}
+
+	return result;
+}
@@ -9,6 +9,16 @@ class TransformTrack
 
 public:
 
+	// Frame cursors of one playback of the track, see Track::Sample.
+	struct Cursor
+	{
+		unsigned int position = 0U;
+
+		unsigned int rotation = 0U;
+
+		unsigned int scale = 0U;
+	};
+
 	TransformTrack();
 
 	~TransformTrack();
@@ -39,6 +49,8 @@ public:
 
 	Math::Transform Sample(const Math::Transform& transform, float time, bool isLooping);
 
+	Math::Transform Sample(const Math::Transform& transform, float time, bool isLooping, Cursor& cursor);
+
 private:
 
 	unsigned int id;
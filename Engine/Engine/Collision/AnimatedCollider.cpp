@@ -1,14 +1,30 @@
 #include "AnimatedCollider.h"
 
-#include "OrientedBoundingBoxWithVisualization.h"
-#include "SphereWithVisualization.h"
+#include "ShapeVisualization.h"
+#include "ConvexShape.h"
 #include "../Renderer/GraphicsObjects/TexturedAnimatedGraphicsObject.h"
 #include "../Renderer/Model/Model.h"
-#include "../Renderer/Model/Vertex.h"
-#include "../Animation/Armature.h"
+#include "../Math/Shapes/OrientedBoundingBox.h"
+#include "../Math/Shapes/AxisAlignedBoundingBox.h"
+#include "../Math/Shapes/Sphere.h"
 
 AnimatedCollider::AnimatedCollider(TexturedAnimatedGraphicsObject* const graphicsObject) :
-	wrapedGraphics(graphicsObject)
+	wrapedGraphics(graphicsObject),
+	model(graphicsObject->GetModel()),
+	sphere(nullptr),
+	jointBoxResults(nullptr),
+	jointCaches(nullptr)
+{
+	InitializeSphere();
+	InitializeOBBs();
+}
+
+AnimatedCollider::AnimatedCollider(const Model* const m) :
+	wrapedGraphics(nullptr),
+	model(m),
+	sphere(nullptr),
+	jointBoxResults(nullptr),
+	jointCaches(nullptr)
 {
 	InitializeSphere();
 	InitializeOBBs();
@@ -16,100 +32,248 @@ AnimatedCollider::AnimatedCollider(TexturedAnimatedGraphicsObject* const graphic
 
 AnimatedCollider::~AnimatedCollider()
 {
-	for (const OrientedBoundingBoxWithVisualization* const obb : obbs)
+	DeleteShapes();
+}
+
+void AnimatedCollider::OnModelReloaded()
+{
+	const bool visualized = !visualizations.empty();
+	const bool visible = visualized && visualizations.back()->IsVisible();
+
+	DeleteShapes();
+
+	InitializeSphere();
+	InitializeOBBs();
+
+	if (visualized)
+	{
+		ToggleVisibility();
+
+		if (!visible)
+		{
+			ToggleVisibility();
+		}
+	}
+}
+
+void AnimatedCollider::DeleteShapes()
+{
+	for (const ShapeVisualization* const visualization : visualizations)
+	{
+		delete visualization;
+	}
+
+	visualizations.clear();
+
+	for (const OrientedBoundingBox* const obb : obbs)
 	{
 		delete obb;
 	}
+
+	obbs.clear();
+	jointBoxOwners.clear();
+
+	delete sphere;
+	sphere = nullptr;
+
+	delete[] jointBoxResults;
+	jointBoxResults = nullptr;
+
+	delete[] jointCaches;
+	jointCaches = nullptr;
 }
 
 void AnimatedCollider::InitializeOBBs()
 {
-	std::unordered_map<std::string, std::vector<Vertex>> jointsVertices;
+	// Fitted once when the model was loaded rather than for every collider.
+	const std::vector<Model::JointBox>& modelBoxes = model->GetJointBoxes();
 
-	const Armature* const arms = wrapedGraphics->GetModel()->GetArmature();
+	obbs.resize(modelBoxes.size(), nullptr);
 
-	const std::vector<std::string>& jointNames = arms->GetJointNames();
+	for (unsigned int i = 0; i < modelBoxes.size(); i++)
+	{
+		const Model::JointBox& box = modelBoxes[i];
 
-	const std::vector<Vertex>& vertices = wrapedGraphics->GetModel()->GetVertices();
+		if (box.vertexCount > 0)
+		{
+			obbs[i] = new OrientedBoundingBox(box.center, box.halfSize, glm::mat4(box.axes));
+		}
+	}
 
-	for (const Vertex& vert : vertices)
+	for (OrientedBoundingBox* const obb : obbs)
 	{
-		unsigned int jointWithMostInfluence = 0;
-		float influence = vert.GetWeights()[jointWithMostInfluence];
-		for (unsigned int i = 1; i < 4; ++i)
+		if (obb != nullptr)
 		{
-			if (vert.GetWeights()[i] > influence)
-			{
-				jointWithMostInfluence = i;
-				influence = vert.GetWeights()[i];
-			}
+			jointBoxOwners.push_back(obb);
 		}
-
-		jointsVertices[jointNames[vert.GetInfluences()[jointWithMostInfluence]]].push_back(vert);
 	}
 
-	obbs.resize(jointNames.size());
+	jointBoxes.Resize(static_cast<unsigned int>(jointBoxOwners.size()));
+	jointBoxResults = new bool[jointBoxOwners.size() + 1];
+	jointCaches = new GJK::Cache[jointBoxOwners.size() + 1];
 
-	for (const std::pair<std::string, std::vector<Vertex>>& jointVerts : jointsVertices)
-	{
-		OrientedBoundingBoxWithVisualization* newObb = new OrientedBoundingBoxWithVisualization(jointVerts.second);
+	UpdateJointBoxes();
+}
 
-		for (unsigned int i = 0; i < jointNames.size(); ++i)
-		{
-			if (jointNames[i] == jointVerts.first)
-			{
-				obbs[i] = newObb;
-			}
-		}
+void AnimatedCollider::UpdateJointBoxes()
+{
+	for (unsigned int i = 0; i < jointBoxOwners.size(); i++)
+	{
+		jointBoxes.Set(i, *jointBoxOwners[i]);
 	}
 }
 
 void AnimatedCollider::InitializeSphere()
 {
-	sphere = new SphereWithVisualization(wrapedGraphics);
+	sphere = new Sphere(model->GetBoundingSphereCenter(), model->GetBoundingSphereRadius());
 }
 
 void AnimatedCollider::ToggleVisibility()
 {
-	for (const auto& obb : obbs)
+	if (visualizations.empty())
 	{
-		if(obb != nullptr)
-			obb->ToggleVisibility();
+		// Created visible, so the first toggle shows the boxes.
+		for (const OrientedBoundingBox* const obb : jointBoxOwners)
+		{
+			visualizations.push_back(new ShapeVisualization(*obb));
+		}
+
+		visualizations.push_back(new ShapeVisualization(*sphere));
+		return;
+	}
+
+	for (ShapeVisualization* const visualization : visualizations)
+	{
+		visualization->ToggleVisibility();
 	}
 }
 
 void AnimatedCollider::Update()
 {
-	unsigned int i = 0;
-	for (OrientedBoundingBoxWithVisualization* const obb : obbs)
+	if (wrapedGraphics != nullptr)
 	{
-		if(obb!= nullptr)
-			obb->Update(wrapedGraphics->GetTransform() * wrapedGraphics->GetAnimPoseArray()[i] * wrapedGraphics->GetAnimInvBindPoseArray()[i]);
-		i++;
+		Update(wrapedGraphics->GetTransform(), wrapedGraphics->GetAnimPoseArray(), wrapedGraphics->GetAnimInvBindPoseArray());
+	}
+}
+
+void AnimatedCollider::Update(const glm::mat4& world, const glm::mat4* const pose, const glm::mat4* const invBindPose)
+{
+	for (unsigned int i = 0; i < obbs.size(); i++)
+	{
+		if (obbs[i] != nullptr)
+		{
+			obbs[i]->Transform(world * pose[i] * invBindPose[i]);
+		}
 	}
 
-	sphere->Update(wrapedGraphics->GetTransform());
+	UpdateJointBoxes();
+
+	sphere->Transform(world);
+
+	for (ShapeVisualization* const visualization : visualizations)
+	{
+		visualization->Update();
+	}
 }
 
 bool AnimatedCollider::Intersect(const OrientedBoundingBox& other) const
 {
-	bool intersect = false;
-	for (OrientedBoundingBoxWithVisualization* const obb : obbs)
+	const unsigned int hits = OrientedBoundingBoxSoA::Intersect(other, jointBoxes, jointBoxResults);
+
+	for (unsigned int i = 0; i < jointBoxOwners.size() && i < visualizations.size(); i++)
 	{
-		if (obb != nullptr)
+		visualizations[i]->SetColor(jointBoxResults[i] ? glm::vec4(1.0f, 0.0f, 0.0f, 1.0f) : glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+	}
+
+	return hits > 0U;
+}
+
+bool AnimatedCollider::Intersect(const Sphere& other) const
+{
+	for (const OrientedBoundingBox* const obb : obbs)
+	{
+		if (obb != nullptr && other.OrientedBoundingBoxIntersect(*obb))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool AnimatedCollider::Intersect(const AxisAlignedBoundingBox& other) const
+{
+	for (const OrientedBoundingBox* const obb : obbs)
+	{
+		if (obb != nullptr && other.OrientedBoundingBoxIntersect(*obb))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool AnimatedCollider::Intersect(const AnimatedCollider& other) const
+{
+	// Each joint box against all of the other's at once, in the other's scratch.
+	for (const OrientedBoundingBox* const obb : jointBoxOwners)
+	{
+		if (OrientedBoundingBoxSoA::Intersect(*obb, other.jointBoxes, other.jointBoxResults) > 0U)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+unsigned int AnimatedCollider::Contacts(const ConvexShape& other, std::vector<GJK::Manifold>& manifolds) const
+{
+	unsigned int count = 0;
+
+	GJK::Manifold manifold;
+
+	for (unsigned int i = 0; i < jointBoxOwners.size(); i++)
+	{
+		if (GJK::Penetration(*jointBoxOwners[i], other, manifold, &jointCaches[i]))
 		{
-			if (obb->OrientedBoundingBoxIntersect(other))
-			{
-				obb->SetColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
-				intersect = true;
-			}
-			else
-			{
-				obb->SetColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
-			}
-			
+			manifolds.push_back(manifold);
+			count++;
 		}
 	}
 
-	return intersect;
+	return count;
+}
+
+bool AnimatedCollider::GetBounds(glm::vec3& min, glm::vec3& max) const
+{
+	bool found = false;
+
+	for (const OrientedBoundingBox* const obb : obbs)
+	{
+		if (obb == nullptr)
+		{
+			continue;
+		}
+
+		const glm::mat3& axes = obb->GetAxes();
+		const glm::vec3& size = obb->GetSize();
+
+		const glm::vec3 extent = glm::abs(axes[0]) * size.x + glm::abs(axes[1]) * size.y + glm::abs(axes[2]) * size.z;
+
+		const glm::vec3 obbMin = obb->GetOrigin() - extent;
+		const glm::vec3 obbMax = obb->GetOrigin() + extent;
+
+		min = found ? glm::min(min, obbMin) : obbMin;
+		max = found ? glm::max(max, obbMax) : obbMax;
+		found = true;
+	}
+
+	return found;
+}
+
+const Sphere& AnimatedCollider::GetSphere() const
+{
+	return *sphere;
 }
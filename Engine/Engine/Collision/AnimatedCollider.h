@@ -2,37 +2,80 @@
 #define ANIMATEDCOLLIDER_H
 
 #include "Collider.h"
+#include "GJK.h"
+#include "../Math/Shapes/OrientedBoundingBoxSoA.h"
 
 #include <unordered_map>
 #include <vector>
 #include <string>
 
+#include <glm/glm.hpp>
+
 class TexturedAnimatedGraphicsObject;
-class ColoredStaticGraphicsObject;
-class OrientedBoundingBoxWithVisualization;
+class Model;
 class OrientedBoundingBox;
-class SphereWithVisualization;
+class AxisAlignedBoundingBox;
+class Sphere;
+class ShapeVisualization;
+class ConvexShape;
 
+// A box per joint of an animated model, moved with the joints. The boxes are plain shapes updated from matrices, the
+// wireframe drawing of them is only created when visibility is first toggled on.
 class AnimatedCollider : public Collider
 {
 public:
 
 	AnimatedCollider(TexturedAnimatedGraphicsObject* const graphicsObject);
 
+	// For colliders that are not tied to a graphics object, like ones updated on a simulation thread.
+	// Update() does nothing for these, they are moved with the Update() that takes the matrices.
+	AnimatedCollider(const Model* const model);
+
 	~AnimatedCollider();
 
+	// Moves the boxes with the graphics object's transform and the pose it last drew. Animation LOD evaluates that pose
+	// less often, or not at all off screen, so colliders that must follow the clip step an Animation of their own and use
+	// the Update() that takes the matrices.
 	void Update() override;
 
+	// pose and invBindPose hold a matrix for each joint of the model's armature.
+	void Update(const glm::mat4& world, const glm::mat4* const pose, const glm::mat4* const invBindPose);
+
 	void ToggleVisibility() override;
 
+	// Refits the boxes and the sphere to the model's new data, from wherever they are moved. They stay in model space until
+	// the next Update().
+	void OnModelReloaded();
+
 	bool Intersect(const OrientedBoundingBox& other) const;
 
+	// Unlike the oriented box test these leave the joint boxes' colors alone.
+	bool Intersect(const Sphere& other) const;
+
+	bool Intersect(const AxisAlignedBoundingBox& other) const;
+
+	bool Intersect(const AnimatedCollider& other) const;
+
+	// Appends the contact of each joint box touching other, normals from the joint box toward other, and returns how many
+	// were appended. Each joint box keeps the GJK cache of its last query, so calling this for the same shape every step
+	// is what warm starts it.
+	unsigned int Contacts(const ConvexShape& other, std::vector<GJK::Manifold>& manifolds) const;
+
+	// The world space box around every joint box as of the last Update(). Returns false if there are no joint boxes.
+	bool GetBounds(glm::vec3& min, glm::vec3& max) const;
+
+	const Sphere& GetSphere() const;
+
 private:
 
 	void InitializeOBBs();
 
 	void InitializeSphere();
 
+	void UpdateJointBoxes();
+
+	void DeleteShapes();
+
 	AnimatedCollider() = delete;
 
 	AnimatedCollider(const AnimatedCollider&) = delete;
@@ -45,11 +88,26 @@ private:
 
 	TexturedAnimatedGraphicsObject* wrapedGraphics;
 
-	SphereWithVisualization* sphere;
+	const Model* model;
+
+	Sphere* sphere;
+
+	// A box per joint, null for joints that no vertex follows most.
+	std::vector<OrientedBoundingBox*> obbs;
+
+	// The joints that have a box, with their world boxes packed for batched tests.
+	std::vector<OrientedBoundingBox*> jointBoxOwners;
+
+	OrientedBoundingBoxSoA jointBoxes;
 
-	std::vector<OrientedBoundingBoxWithVisualization*> obbs;
+	// Scratch for the batched tests, so Intersect() is not safe to call from several threads at once.
+	bool* jointBoxResults;
 
+	// A GJK cache per joint box, also scratch.
+	GJK::Cache* jointCaches;
 
+	// One per joint box and then the sphere, empty until visibility is first toggled.
+	std::vector<ShapeVisualization*> visualizations;
 
 };
 
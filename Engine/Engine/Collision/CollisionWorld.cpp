@@ -0,0 +1,470 @@
+#include "CollisionWorld.h"
+
+#include "AnimatedCollider.h"
+#include "ConvexShape.h"
+#include "../Math/Shapes/Sphere.h"
+#include "../Math/Shapes/AxisAlignedBoundingBox.h"
+#include "../Math/Shapes/OrientedBoundingBox.h"
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+	bool Overlap(const glm::vec3& aMin, const glm::vec3& aMax, const glm::vec3& bMin, const glm::vec3& bMax)
+	{
+		return aMin.x <= bMax.x && aMax.x >= bMin.x &&
+			aMin.y <= bMax.y && aMax.y >= bMin.y &&
+			aMin.z <= bMax.z && aMax.z >= bMin.z;
+	}
+}
+
+CollisionWorld::CollisionWorld(float margin) :
+	tree(margin),
+	colliders(std::vector<Entry>()),
+	freeColliders(invalidCollider)
+{
+}
+
+CollisionWorld::~CollisionWorld()
+{
+}
+
+CollisionWorld::ColliderId CollisionWorld::Add(const Sphere* const sphere, void* const userData)
+{
+	Entry collider = {};
+	collider.type = ShapeType::Sphere;
+	collider.sphere = sphere;
+	collider.userData = userData;
+	return AddCollider(collider);
+}
+
+CollisionWorld::ColliderId CollisionWorld::Add(const AxisAlignedBoundingBox* const aabb, void* const userData)
+{
+	Entry collider = {};
+	collider.type = ShapeType::AxisAlignedBoundingBox;
+	collider.aabb = aabb;
+	collider.userData = userData;
+	return AddCollider(collider);
+}
+
+CollisionWorld::ColliderId CollisionWorld::Add(const OrientedBoundingBox* const obb, void* const userData)
+{
+	Entry collider = {};
+	collider.type = ShapeType::OrientedBoundingBox;
+	collider.obb = obb;
+	collider.userData = userData;
+	return AddCollider(collider);
+}
+
+CollisionWorld::ColliderId CollisionWorld::Add(const AnimatedCollider* const animatedCollider, void* const userData)
+{
+	Entry collider = {};
+	collider.type = ShapeType::Animated;
+	collider.animated = animatedCollider;
+	collider.userData = userData;
+	return AddCollider(collider);
+}
+
+void CollisionWorld::Remove(ColliderId id)
+{
+	if (!IsAlive(id))
+	{
+		Logger::Log(std::string("Calling CollisionWorld::Remove() with a collider that is not in the world."), Logger::Category::Warning);
+		return;
+	}
+
+	Entry& collider = colliders[id];
+
+	if (collider.proxy != DynamicAABBTree::nullNode)
+	{
+		tree.Remove(collider.proxy);
+	}
+
+	auto removed = [this, id](const Pair& pair)
+	{
+		if (pair.a != id && pair.b != id)
+		{
+			return false;
+		}
+
+		if (pair.touching)
+		{
+			pendingEvents.push_back({ Event::Type::End, pair.a, pair.b });
+		}
+
+		return true;
+	};
+
+	pairs.erase(std::remove_if(pairs.begin(), pairs.end(), removed), pairs.end());
+
+	// The id may be handed out again, so contacts and impacts of this Step() must not keep pointing at it.
+	contacts.erase(std::remove_if(contacts.begin(), contacts.end(), [id](const Contact& contact) { return contact.a == id || contact.b == id; }), contacts.end());
+	impacts.erase(std::remove_if(impacts.begin(), impacts.end(), [id](const Impact& impact) { return impact.a == id || impact.b == id; }), impacts.end());
+
+	collider.alive = false;
+	collider.proxy = DynamicAABBTree::nullNode;
+	collider.userData = nullptr;
+	collider.nextFree = freeColliders;
+	freeColliders = id;
+}
+
+void* CollisionWorld::GetUserData(ColliderId id) const
+{
+	return IsAlive(id) ? colliders[id].userData : nullptr;
+}
+
+void CollisionWorld::SetContinuous(ColliderId id, bool continuous)
+{
+	if (!IsAlive(id))
+	{
+		Logger::Log(std::string("Calling CollisionWorld::SetContinuous() with a collider that is not in the world."), Logger::Category::Warning);
+		return;
+	}
+
+	colliders[id].continuous = continuous;
+}
+
+void CollisionWorld::Step()
+{
+	events.swap(pendingEvents);
+	pendingEvents.clear();
+
+	// Refresh the fat boxes, only colliders that left theirs need new pairs.
+	moved.clear();
+
+	for (ColliderId id = 0; id < colliders.size(); id++)
+	{
+		Entry& collider = colliders[id];
+
+		glm::vec3 min;
+		glm::vec3 max;
+
+		if (!collider.alive)
+		{
+			continue;
+		}
+
+		if (!GetBounds(collider, min, max))
+		{
+			// Without bounds, like an animated collider with no joint boxes, it leaves the tree until it has them again.
+			if (collider.proxy != DynamicAABBTree::nullNode)
+			{
+				tree.Remove(collider.proxy);
+				collider.proxy = DynamicAABBTree::nullNode;
+			}
+
+			continue;
+		}
+
+		const glm::vec3 center = (min + max) * 0.5f;
+
+		collider.motion = (collider.proxy == DynamicAABBTree::nullNode) ? glm::vec3(0.0f) : center - collider.center;
+
+		if (collider.continuous)
+		{
+			min = glm::min(min, min - collider.motion);
+			max = glm::max(max, max - collider.motion);
+		}
+
+		if (collider.proxy == DynamicAABBTree::nullNode)
+		{
+			collider.proxy = tree.Insert(min, max, id);
+			moved.push_back(id);
+		}
+		else if (tree.Move(collider.proxy, min, max, collider.motion))
+		{
+			moved.push_back(id);
+		}
+
+		collider.center = center;
+	}
+
+	candidates.clear();
+
+	for (ColliderId id : moved)
+	{
+		const int proxy = colliders[id].proxy;
+
+		tree.Query(tree.GetFatMin(proxy), tree.GetFatMax(proxy), [this, id](int otherProxy)
+			{
+				const ColliderId other = tree.GetUserData(otherProxy);
+
+				if (other != id)
+				{
+					candidates.push_back({ std::min(id, other), std::max(id, other), false });
+				}
+
+				return true;
+			});
+	}
+
+	std::sort(candidates.begin(), candidates.end());
+	candidates.erase(std::unique(candidates.begin(), candidates.end(), [](const Pair& first, const Pair& second) { return first.a == second.a && first.b == second.b; }), candidates.end());
+
+	// Pairs already known come first, so they keep whether they were touching.
+	std::vector<Pair> merged;
+	merged.reserve(pairs.size() + candidates.size());
+	std::set_union(pairs.begin(), pairs.end(), candidates.begin(), candidates.end(), std::back_inserter(merged));
+	pairs.swap(merged);
+
+	contacts.clear();
+	impacts.clear();
+
+	unsigned int kept = 0U;
+	for (Pair& pair : pairs)
+	{
+		const int proxyA = colliders[pair.a].proxy;
+		const int proxyB = colliders[pair.b].proxy;
+
+		const bool overlapping = proxyA != DynamicAABBTree::nullNode && proxyB != DynamicAABBTree::nullNode &&
+			Overlap(tree.GetFatMin(proxyA), tree.GetFatMax(proxyA), tree.GetFatMin(proxyB), tree.GetFatMax(proxyB));
+		const bool touching = overlapping && TestPair(pair.a, pair.b);
+
+		if (touching != pair.touching)
+		{
+			events.push_back({ touching ? Event::Type::Begin : Event::Type::End, pair.a, pair.b });
+			pair.touching = touching;
+		}
+
+		if (touching)
+		{
+			contacts.push_back({ pair.a, pair.b });
+		}
+
+		if (overlapping && (colliders[pair.a].continuous || colliders[pair.b].continuous))
+		{
+			Impact impact = { pair.a, pair.b, Sweep::Hit() };
+
+			if (SweepPair(pair.a, pair.b, impact.hit))
+			{
+				impacts.push_back(impact);
+			}
+		}
+
+		if (overlapping)
+		{
+			pairs[kept++] = pair;
+		}
+	}
+
+	pairs.resize(kept);
+}
+
+const std::vector<CollisionWorld::Contact>& CollisionWorld::GetContacts() const
+{
+	return contacts;
+}
+
+const std::vector<CollisionWorld::Event>& CollisionWorld::GetEvents() const
+{
+	return events;
+}
+
+const std::vector<CollisionWorld::Impact>& CollisionWorld::GetImpacts() const
+{
+	return impacts;
+}
+
+void CollisionWorld::Query(const glm::vec3& min, const glm::vec3& max, std::vector<ColliderId>& result) const
+{
+	tree.Query(min, max, [this, &result](int proxy)
+		{
+			result.push_back(tree.GetUserData(proxy));
+			return true;
+		});
+}
+
+unsigned int CollisionWorld::GetPairCount() const
+{
+	return static_cast<unsigned int>(pairs.size());
+}
+
+const DynamicAABBTree& CollisionWorld::GetTree() const
+{
+	return tree;
+}
+
+CollisionWorld::ColliderId CollisionWorld::AddCollider(const Entry& collider)
+{
+	ColliderId id = freeColliders;
+
+	if (id == invalidCollider)
+	{
+		id = static_cast<ColliderId>(colliders.size());
+		colliders.push_back(collider);
+	}
+	else
+	{
+		freeColliders = colliders[id].nextFree;
+		colliders[id] = collider;
+	}
+
+	// The collider enters the tree on the next Step(), once its shape has been updated.
+	colliders[id].proxy = DynamicAABBTree::nullNode;
+	colliders[id].alive = true;
+	colliders[id].nextFree = invalidCollider;
+
+	return id;
+}
+
+bool CollisionWorld::GetBounds(const Entry& collider, glm::vec3& min, glm::vec3& max) const
+{
+	switch (collider.type)
+	{
+	case ShapeType::Sphere:
+	{
+		const glm::vec3 radius(collider.sphere->GetRadius());
+		min = collider.sphere->GetOrigin() - radius;
+		max = collider.sphere->GetOrigin() + radius;
+		return true;
+	}
+	case ShapeType::AxisAlignedBoundingBox:
+		min = collider.aabb->GetMin();
+		max = collider.aabb->GetMax();
+		return true;
+	case ShapeType::OrientedBoundingBox:
+	{
+		const glm::mat3& axes = collider.obb->GetAxes();
+		const glm::vec3& size = collider.obb->GetSize();
+
+		const glm::vec3 extent = glm::abs(axes[0]) * size.x + glm::abs(axes[1]) * size.y + glm::abs(axes[2]) * size.z;
+
+		min = collider.obb->GetOrigin() - extent;
+		max = collider.obb->GetOrigin() + extent;
+		return true;
+	}
+	case ShapeType::Animated:
+		return collider.animated->GetBounds(min, max);
+	default:
+		return false;
+	}
+}
+
+bool CollisionWorld::TestPair(ColliderId a, ColliderId b) const
+{
+	const Entry* first = &colliders[a];
+	const Entry* second = &colliders[b];
+
+	// Each combination is handled once, with the lower shape type first.
+	if (first->type > second->type)
+	{
+		std::swap(first, second);
+	}
+
+	switch (first->type)
+	{
+	case ShapeType::Sphere:
+		switch (second->type)
+		{
+		case ShapeType::Sphere:
+			return first->sphere->SphereIntersect(*second->sphere);
+		case ShapeType::AxisAlignedBoundingBox:
+			return first->sphere->AxisAlignedBoundingBoxIntersect(*second->aabb);
+		case ShapeType::OrientedBoundingBox:
+			return first->sphere->OrientedBoundingBoxIntersect(*second->obb);
+		case ShapeType::Animated:
+			return second->animated->Intersect(*first->sphere);
+		default:
+			return false;
+		}
+	case ShapeType::AxisAlignedBoundingBox:
+		switch (second->type)
+		{
+		case ShapeType::AxisAlignedBoundingBox:
+			return first->aabb->AxisAlignedBoundingBoxIntersect(*second->aabb);
+		case ShapeType::OrientedBoundingBox:
+			return first->aabb->OrientedBoundingBoxIntersect(*second->obb);
+		case ShapeType::Animated:
+			return second->animated->Intersect(*first->aabb);
+		default:
+			return false;
+		}
+	case ShapeType::OrientedBoundingBox:
+		switch (second->type)
+		{
+		case ShapeType::OrientedBoundingBox:
+			return first->obb->OrientedBoundingBoxIntersect(*second->obb);
+		case ShapeType::Animated:
+			return second->animated->Intersect(*first->obb);
+		default:
+			return false;
+		}
+	case ShapeType::Animated:
+		return first->animated->Intersect(*second->animated);
+	default:
+		return false;
+	}
+}
+
+bool CollisionWorld::SweepPair(ColliderId a, ColliderId b, Sweep::Hit& hit) const
+{
+	const Entry& first = colliders[a];
+	const Entry& second = colliders[b];
+
+	if (first.type == ShapeType::Animated || second.type == ShapeType::Animated)
+	{
+		return false;
+	}
+
+	// A sphere against a box has an exact sweep, done with the box where it is now and the sphere moving relative to it.
+	auto sweepSphere = [&hit](const Entry& sphereCollider, const Entry& boxCollider)
+	{
+		const glm::vec3 relativeMotion = sphereCollider.motion - boxCollider.motion;
+		const Sphere start(sphereCollider.sphere->GetOrigin() - relativeMotion, sphereCollider.sphere->GetRadius());
+
+		const bool found = (boxCollider.type == ShapeType::AxisAlignedBoundingBox) ?
+			Sweep::SphereAxisAlignedBoundingBox(start, relativeMotion, *boxCollider.aabb, hit) :
+			Sweep::SphereOrientedBoundingBox(start, relativeMotion, *boxCollider.obb, hit);
+
+		if (found)
+		{
+			hit.point -= boxCollider.motion * (1.0f - hit.time);
+		}
+
+		return found;
+	};
+
+	if (first.type == ShapeType::Sphere && second.type != ShapeType::Sphere)
+	{
+		return sweepSphere(first, second);
+	}
+
+	if (second.type == ShapeType::Sphere && first.type != ShapeType::Sphere)
+	{
+		if (!sweepSphere(second, first))
+		{
+			return false;
+		}
+
+		hit.normal = -hit.normal;
+		return true;
+	}
+
+	auto shapeOf = [](const Entry& collider)
+	{
+		switch (collider.type)
+		{
+		case ShapeType::Sphere:
+			return ConvexShape(*collider.sphere);
+		case ShapeType::AxisAlignedBoundingBox:
+			return ConvexShape(*collider.aabb);
+		default:
+			return ConvexShape(*collider.obb);
+		}
+	};
+
+	// Both back where they were at the last Step().
+	ConvexShape shapeA = shapeOf(first);
+	ConvexShape shapeB = shapeOf(second);
+	shapeA.SetTranslation(-first.motion);
+	shapeB.SetTranslation(-second.motion);
+
+	return Sweep::TimeOfImpact(shapeA, first.motion, shapeB, second.motion, hit);
+}
+
+bool CollisionWorld::IsAlive(ColliderId id) const
+{
+	return id < colliders.size() && colliders[id].alive;
+}
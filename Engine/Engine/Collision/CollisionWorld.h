@@ -0,0 +1,199 @@
+#ifndef COLLISIONWORLD_H
+#define COLLISIONWORLD_H
+
+#include "DynamicAABBTree.h"
+#include "Sweep.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class Sphere;
+class AxisAlignedBoundingBox;
+class OrientedBoundingBox;
+class AnimatedCollider;
+
+// Tests many colliders against each other without testing every pair. Each collider has a fat box in a dynamic tree, Step()
+// only queries the tree for colliders whose box left its fat box and keeps the resulting pairs until their fat boxes separate.
+// The pairs left are handed to the shapes' own intersect functions. The world does not own the shapes, which must be
+// removed before they are deleted, and it is not thread safe.
+// Continuous colliders are swept instead. Their box in the tree covers everything they passed through since the last Step(),
+// and each of their pairs gets a time of impact, so a fast mover is caught even when it ends the step past what it hit.
+class CollisionWorld
+{
+public:
+
+	typedef unsigned int ColliderId;
+
+	static const ColliderId invalidCollider = 0xFFFFFFFFU;
+
+	// A pair of colliders intersecting as of the last Step(), a is always less than b.
+	struct Contact
+	{
+		ColliderId a;
+
+		ColliderId b;
+	};
+
+	struct Event
+	{
+		enum class Type
+		{
+			Begin,
+			End
+		};
+
+		Type type;
+
+		ColliderId a;
+
+		ColliderId b;
+	};
+
+	// A continuous pair that touched at some point during the last Step(), a is always less than b. The motion of each
+	// collider is how far its box moved since the Step() before, and the hit is for b being hit by a.
+	struct Impact
+	{
+		ColliderId a;
+
+		ColliderId b;
+
+		Sweep::Hit hit;
+	};
+
+	CollisionWorld(float margin = 0.1f);
+
+	~CollisionWorld();
+
+	CollisionWorld(const CollisionWorld&) = delete;
+
+	CollisionWorld& operator=(const CollisionWorld&) = delete;
+
+	CollisionWorld(CollisionWorld&&) = delete;
+
+	CollisionWorld& operator=(CollisionWorld&&) = delete;
+
+	ColliderId Add(const Sphere* const sphere, void* const userData = nullptr);
+
+	ColliderId Add(const AxisAlignedBoundingBox* const aabb, void* const userData = nullptr);
+
+	ColliderId Add(const OrientedBoundingBox* const obb, void* const userData = nullptr);
+
+	ColliderId Add(const AnimatedCollider* const animatedCollider, void* const userData = nullptr);
+
+	// Touching pairs with the collider get an End event on the next Step().
+	void Remove(ColliderId id);
+
+	void* GetUserData(ColliderId id) const;
+
+	// Sweeps the collider from the next Step() on. Animated colliders are only swept in the tree, their joint boxes get no
+	// time of impact.
+	void SetContinuous(ColliderId id, bool continuous);
+
+	// Reads every collider's current world state, updates the tree and refreshes the contacts and events.
+	void Step();
+
+	const std::vector<Contact>& GetContacts() const;
+
+	// The contacts that started or ended in the last Step().
+	const std::vector<Event>& GetEvents() const;
+
+	const std::vector<Impact>& GetImpacts() const;
+
+	// Appends every collider whose fat box overlaps min and max.
+	void Query(const glm::vec3& min, const glm::vec3& max, std::vector<ColliderId>& result) const;
+
+	// Pairs whose fat boxes overlap, each of them gets a narrowphase test per Step().
+	unsigned int GetPairCount() const;
+
+	const DynamicAABBTree& GetTree() const;
+
+private:
+
+	enum class ShapeType
+	{
+		Sphere,
+		AxisAlignedBoundingBox,
+		OrientedBoundingBox,
+		Animated
+	};
+
+	struct Entry
+	{
+		ShapeType type;
+
+		union
+		{
+			const Sphere* sphere;
+			const AxisAlignedBoundingBox* aabb;
+			const OrientedBoundingBox* obb;
+			const AnimatedCollider* animated;
+		};
+
+		void* userData;
+
+		int proxy;
+
+		// The center of the tight box at the last Step(), to stretch the fat box in the direction of motion.
+		glm::vec3 center;
+
+		// How far center moved in the last Step().
+		glm::vec3 motion;
+
+		bool continuous;
+
+		bool alive;
+
+		// The next free id while the collider is removed.
+		ColliderId nextFree;
+	};
+
+	struct Pair
+	{
+		ColliderId a;
+
+		ColliderId b;
+
+		bool touching;
+
+		bool operator<(const Pair& other) const
+		{
+			return (a != other.a) ? a < other.a : b < other.b;
+		}
+	};
+
+	ColliderId AddCollider(const Entry& collider);
+
+	bool GetBounds(const Entry& collider, glm::vec3& min, glm::vec3& max) const;
+
+	bool TestPair(ColliderId a, ColliderId b) const;
+
+	bool SweepPair(ColliderId a, ColliderId b, Sweep::Hit& hit) const;
+
+	bool IsAlive(ColliderId id) const;
+
+	DynamicAABBTree tree;
+
+	std::vector<Entry> colliders;
+
+	ColliderId freeColliders;
+
+	// Sorted, so new candidates are merged in without duplicates.
+	std::vector<Pair> pairs;
+
+	std::vector<ColliderId> moved;
+
+	std::vector<Pair> candidates;
+
+	std::vector<Contact> contacts;
+
+	std::vector<Event> events;
+
+	std::vector<Impact> impacts;
+
+	// End events of removed colliders, reported on the next Step().
+	std::vector<Event> pendingEvents;
+
+};
+
+#endif // COLLISIONWORLD_H
@@ -0,0 +1,207 @@
+#include "ConvexShape.h"
+
+#include "../Math/Shapes/Sphere.h"
+#include "../Math/Shapes/AxisAlignedBoundingBox.h"
+#include "../Math/Shapes/OrientedBoundingBox.h"
+#include "../Math/Shapes/ConvexHull.h"
+#include "../Math/Shapes/Triangle.h"
+
+namespace
+{
+	// How close to a face's plane a point must be to count as part of the face, and how closely a triangle must face a
+	// direction to be returned whole.
+	const float faceTolerance = 1e-3f;
+
+	const float faceAlignment = 0.99f;
+
+	glm::vec3 BoxSupport(const glm::vec3& center, const glm::mat3& axes, const glm::vec3& halfSize, const glm::vec3& direction)
+	{
+		glm::vec3 result = center;
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			result += axes[i] * (glm::dot(axes[i], direction) >= 0.0f ? halfSize[i] : -halfSize[i]);
+		}
+
+		return result;
+	}
+
+	void BoxFace(const glm::vec3& center, const glm::mat3& axes, const glm::vec3& halfSize, const glm::vec3& direction, std::vector<glm::vec3>& polygon)
+	{
+		unsigned int axis = 0;
+		float alignment = -1.0f;
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			const float axisAlignment = fabsf(glm::dot(axes[i], direction));
+
+			if (axisAlignment > alignment)
+			{
+				axis = i;
+				alignment = axisAlignment;
+			}
+		}
+
+		const float side = glm::dot(axes[axis], direction) >= 0.0f ? 1.0f : -1.0f;
+		const glm::vec3 faceCenter = center + axes[axis] * (halfSize[axis] * side);
+		const glm::vec3 u = axes[(axis + 1) % 3] * halfSize[(axis + 1) % 3];
+		const glm::vec3 v = axes[(axis + 2) % 3] * halfSize[(axis + 2) % 3];
+
+		polygon = { faceCenter + u + v, faceCenter - u + v, faceCenter - u - v, faceCenter + u - v };
+	}
+}
+
+ConvexShape::ConvexShape(const Sphere& s) :
+	type(Type::Sphere),
+	sphere(&s),
+	translation(0.0f)
+{
+}
+
+ConvexShape::ConvexShape(const AxisAlignedBoundingBox& box) :
+	type(Type::AxisAlignedBoundingBox),
+	aabb(&box),
+	translation(0.0f)
+{
+}
+
+ConvexShape::ConvexShape(const OrientedBoundingBox& box) :
+	type(Type::OrientedBoundingBox),
+	obb(&box),
+	translation(0.0f)
+{
+}
+
+ConvexShape::ConvexShape(const ConvexHull& convexHull) :
+	type(Type::ConvexHull),
+	hull(&convexHull),
+	translation(0.0f)
+{
+}
+
+ConvexShape::ConvexShape(const Triangle& t) :
+	type(Type::Triangle),
+	triangle(&t),
+	translation(0.0f)
+{
+}
+
+ConvexShape::~ConvexShape()
+{
+}
+
+glm::vec3 ConvexShape::Support(const glm::vec3& direction) const
+{
+	return ShapeSupport(direction) + translation;
+}
+
+glm::vec3 ConvexShape::GetCenter() const
+{
+	return ShapeCenter() + translation;
+}
+
+void ConvexShape::SupportFace(const glm::vec3& direction, std::vector<glm::vec3>& polygon) const
+{
+	ShapeSupportFace(direction, polygon);
+
+	for (glm::vec3& point : polygon)
+	{
+		point += translation;
+	}
+}
+
+void ConvexShape::SetTranslation(const glm::vec3& newTranslation)
+{
+	translation = newTranslation;
+}
+
+const glm::vec3& ConvexShape::GetTranslation() const
+{
+	return translation;
+}
+
+glm::vec3 ConvexShape::ShapeSupport(const glm::vec3& direction) const
+{
+	switch (type)
+	{
+	case Type::Sphere:
+	{
+		const float length = glm::length(direction);
+		return (length > 0.0f) ? sphere->GetOrigin() + direction * (sphere->GetRadius() / length) : sphere->GetOrigin();
+	}
+	case Type::AxisAlignedBoundingBox:
+		return BoxSupport(aabb->GetOrigin(), glm::mat3(1.0f), aabb->GetSize(), direction);
+	case Type::OrientedBoundingBox:
+		return BoxSupport(obb->GetOrigin(), obb->GetAxes(), obb->GetSize(), direction);
+	case Type::ConvexHull:
+		return hull->Support(direction);
+	case Type::Triangle:
+	{
+		const float d0 = glm::dot(triangle->GetPoint0(), direction);
+		const float d1 = glm::dot(triangle->GetPoint1(), direction);
+		const float d2 = glm::dot(triangle->GetPoint2(), direction);
+
+		if (d0 >= d1 && d0 >= d2)
+			return triangle->GetPoint0();
+
+		return (d1 >= d2) ? triangle->GetPoint1() : triangle->GetPoint2();
+	}
+	default:
+		return glm::vec3(0.0f);
+	}
+}
+
+glm::vec3 ConvexShape::ShapeCenter() const
+{
+	switch (type)
+	{
+	case Type::Sphere:
+		return sphere->GetOrigin();
+	case Type::AxisAlignedBoundingBox:
+		return aabb->GetOrigin();
+	case Type::OrientedBoundingBox:
+		return obb->GetOrigin();
+	case Type::ConvexHull:
+		return hull->GetOrigin();
+	case Type::Triangle:
+		return (triangle->GetPoint0() + triangle->GetPoint1() + triangle->GetPoint2()) / 3.0f;
+	default:
+		return glm::vec3(0.0f);
+	}
+}
+
+void ConvexShape::ShapeSupportFace(const glm::vec3& direction, std::vector<glm::vec3>& polygon) const
+{
+	switch (type)
+	{
+	case Type::AxisAlignedBoundingBox:
+		BoxFace(aabb->GetOrigin(), glm::mat3(1.0f), aabb->GetSize(), direction, polygon);
+		break;
+	case Type::OrientedBoundingBox:
+		BoxFace(obb->GetOrigin(), obb->GetAxes(), obb->GetSize(), direction, polygon);
+		break;
+	case Type::ConvexHull:
+		hull->SupportFace(direction, faceTolerance, polygon);
+		break;
+	case Type::Triangle:
+	{
+		const glm::vec3 normal = glm::cross(triangle->GetPoint1() - triangle->GetPoint0(), triangle->GetPoint2() - triangle->GetPoint0());
+		const float lengths = glm::length(normal) * glm::length(direction);
+
+		// Either side of a triangle is a face.
+		if (lengths > 0.0f && fabsf(glm::dot(normal, direction)) >= lengths * faceAlignment)
+		{
+			polygon = { triangle->GetPoint0(), triangle->GetPoint1(), triangle->GetPoint2() };
+		}
+		else
+		{
+			polygon = { ShapeSupport(direction) };
+		}
+
+		break;
+	}
+	default:
+		polygon = { ShapeSupport(direction) };
+		break;
+	}
+}
@@ -0,0 +1,78 @@
+#ifndef CONVEXSHAPE_H
+#define CONVEXSHAPE_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class Sphere;
+class AxisAlignedBoundingBox;
+class OrientedBoundingBox;
+class ConvexHull;
+class Triangle;
+
+// Any of the convex shapes as GJK sees them, a support function and a point inside. Made on the stack around a shape for
+// each query, it does not own the shape and reads its world state as of the query.
+class ConvexShape
+{
+public:
+
+	ConvexShape(const Sphere& sphere);
+
+	ConvexShape(const AxisAlignedBoundingBox& aabb);
+
+	ConvexShape(const OrientedBoundingBox& obb);
+
+	ConvexShape(const ConvexHull& hull);
+
+	ConvexShape(const Triangle& triangle);
+
+	~ConvexShape();
+
+	// The point of the shape furthest along direction, which need not be normalized.
+	glm::vec3 Support(const glm::vec3& direction) const;
+
+	glm::vec3 GetCenter() const;
+
+	// The face of the shape whose normal is closest to direction as an ordered convex polygon, the corners of a box's face or
+	// a triangle facing that way. A single point for spheres and where the shape has no face facing that way.
+	void SupportFace(const glm::vec3& direction, std::vector<glm::vec3>& polygon) const;
+
+	// Moves the shape as GJK sees it without touching the shape, for sweeping it along a motion.
+	void SetTranslation(const glm::vec3& newTranslation);
+
+	const glm::vec3& GetTranslation() const;
+
+private:
+
+	glm::vec3 ShapeSupport(const glm::vec3& direction) const;
+
+	glm::vec3 ShapeCenter() const;
+
+	void ShapeSupportFace(const glm::vec3& direction, std::vector<glm::vec3>& polygon) const;
+
+	enum class Type
+	{
+		Sphere,
+		AxisAlignedBoundingBox,
+		OrientedBoundingBox,
+		ConvexHull,
+		Triangle
+	};
+
+	Type type;
+
+	union
+	{
+		const Sphere* sphere;
+		const AxisAlignedBoundingBox* aabb;
+		const OrientedBoundingBox* obb;
+		const ConvexHull* hull;
+		const Triangle* triangle;
+	};
+
+	glm::vec3 translation;
+
+};
+
+#endif // CONVEXSHAPE_H
@@ -0,0 +1,496 @@
+#include "DynamicAABBTree.h"
+
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// How many times the last displacement the fat box is stretched by, so steady motion skips several updates.
+	const float displacementMultiplier = 4.0f;
+
+	bool Overlap(const glm::vec3& aMin, const glm::vec3& aMax, const glm::vec3& bMin, const glm::vec3& bMax)
+	{
+		return aMin.x <= bMax.x && aMax.x >= bMin.x &&
+			aMin.y <= bMax.y && aMax.y >= bMin.y &&
+			aMin.z <= bMax.z && aMax.z >= bMin.z;
+	}
+
+	bool Contains(const glm::vec3& outerMin, const glm::vec3& outerMax, const glm::vec3& innerMin, const glm::vec3& innerMax)
+	{
+		return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z &&
+			outerMax.x >= innerMax.x && outerMax.y >= innerMax.y && outerMax.z >= innerMax.z;
+	}
+}
+
+DynamicAABBTree::DynamicAABBTree(float m) :
+	nodes(std::vector<Node>()),
+	root(nullNode),
+	freeList(nullNode),
+	proxyCount(0U),
+	margin(m)
+{
+}
+
+DynamicAABBTree::~DynamicAABBTree()
+{
+}
+
+int DynamicAABBTree::Insert(const glm::vec3& min, const glm::vec3& max, unsigned int userData)
+{
+	const int proxy = AllocateNode();
+
+	nodes[proxy].min = min - glm::vec3(margin);
+	nodes[proxy].max = max + glm::vec3(margin);
+	nodes[proxy].userData = userData;
+	nodes[proxy].height = 0;
+
+	InsertLeaf(proxy);
+	proxyCount++;
+
+	return proxy;
+}
+
+void DynamicAABBTree::Remove(int proxy)
+{
+	if (proxy < 0 || proxy >= static_cast<int>(nodes.size()) || !nodes[proxy].IsLeaf() || nodes[proxy].height < 0)
+	{
+		Logger::Log(std::string("Calling DynamicAABBTree::Remove() with a proxy that is not in the tree."), Logger::Category::Warning);
+		return;
+	}
+
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	proxyCount--;
+}
+
+bool DynamicAABBTree::Move(int proxy, const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement)
+{
+	Node& node = nodes[proxy];
+
+	glm::vec3 fatMin = min - glm::vec3(margin);
+	glm::vec3 fatMax = max + glm::vec3(margin);
+
+	const glm::vec3 stretch = displacement * displacementMultiplier;
+	fatMin += glm::min(stretch, glm::vec3(0.0f));
+	fatMax += glm::max(stretch, glm::vec3(0.0f));
+
+	if (Contains(node.min, node.max, min, max))
+	{
+		// Shrink the fat box again once it is well past the one the current motion would get, so it does not stay
+		// stretched after the object slows down. Measured against the stretched box, and letting the old box trail
+		// behind by as much as it is stretched ahead, steady motion is left alone.
+		const glm::vec3 largeMin = fatMin - glm::vec3(margin * 4.0f) - glm::max(stretch, glm::vec3(0.0f));
+		const glm::vec3 largeMax = fatMax + glm::vec3(margin * 4.0f) - glm::min(stretch, glm::vec3(0.0f));
+
+		if (Contains(largeMin, largeMax, node.min, node.max))
+		{
+			return false;
+		}
+	}
+
+	RemoveLeaf(proxy);
+
+	nodes[proxy].min = fatMin;
+	nodes[proxy].max = fatMax;
+
+	InsertLeaf(proxy);
+
+	return true;
+}
+
+unsigned int DynamicAABBTree::GetUserData(int proxy) const
+{
+	return nodes[proxy].userData;
+}
+
+const glm::vec3& DynamicAABBTree::GetFatMin(int proxy) const
+{
+	return nodes[proxy].min;
+}
+
+const glm::vec3& DynamicAABBTree::GetFatMax(int proxy) const
+{
+	return nodes[proxy].max;
+}
+
+void DynamicAABBTree::Query(const glm::vec3& min, const glm::vec3& max, const std::function<bool(int)>& callback) const
+{
+	if (root == nullNode)
+	{
+		return;
+	}
+
+	std::vector<int> stack;
+	stack.reserve(64);
+	stack.push_back(root);
+
+	while (!stack.empty())
+	{
+		const int index = stack.back();
+		stack.pop_back();
+
+		const Node& node = nodes[index];
+
+		if (!Overlap(node.min, node.max, min, max))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (!callback(index))
+			{
+				return;
+			}
+		}
+		else
+		{
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+void DynamicAABBTree::RayCast(const glm::vec3& start, const glm::vec3& end, const std::function<bool(int)>& callback) const
+{
+	if (root == nullNode)
+	{
+		return;
+	}
+
+	const glm::vec3 direction = end - start;
+	const glm::vec3 inverseDirection = 1.0f / direction;
+
+	// Slab test against the segment, parallel axes give infinities that compare correctly.
+	auto hits = [&start, &inverseDirection](const Node& node)
+	{
+		const glm::vec3 t0 = (node.min - start) * inverseDirection;
+		const glm::vec3 t1 = (node.max - start) * inverseDirection;
+
+		const glm::vec3 tNear = glm::min(t0, t1);
+		const glm::vec3 tFar = glm::max(t0, t1);
+
+		const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, 1.0f));
+
+		return enter <= exit;
+	};
+
+	std::vector<int> stack;
+	stack.reserve(64);
+	stack.push_back(root);
+
+	while (!stack.empty())
+	{
+		const int index = stack.back();
+		stack.pop_back();
+
+		const Node& node = nodes[index];
+
+		if (!hits(node))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (!callback(index))
+			{
+				return;
+			}
+		}
+		else
+		{
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+unsigned int DynamicAABBTree::GetHeight() const
+{
+	return (root == nullNode) ? 0U : static_cast<unsigned int>(nodes[root].height);
+}
+
+unsigned int DynamicAABBTree::GetProxyCount() const
+{
+	return proxyCount;
+}
+
+float DynamicAABBTree::GetAreaRatio() const
+{
+	if (root == nullNode)
+	{
+		return 0.0f;
+	}
+
+	const float rootArea = SurfaceArea(nodes[root].min, nodes[root].max);
+
+	float totalArea = 0.0f;
+	for (const Node& node : nodes)
+	{
+		if (node.height > 0)
+		{
+			totalArea += SurfaceArea(node.min, node.max);
+		}
+	}
+
+	return (rootArea > 0.0f) ? totalArea / rootArea : 0.0f;
+}
+
+int DynamicAABBTree::AllocateNode()
+{
+	if (freeList == nullNode)
+	{
+		nodes.push_back(Node());
+		nodes.back().height = -1;
+		nodes.back().parent = freeList;
+		freeList = static_cast<int>(nodes.size()) - 1;
+	}
+
+	const int node = freeList;
+	freeList = nodes[node].parent;
+
+	nodes[node].parent = nullNode;
+	nodes[node].child1 = nullNode;
+	nodes[node].child2 = nullNode;
+	nodes[node].height = 0;
+	nodes[node].userData = 0U;
+
+	return node;
+}
+
+void DynamicAABBTree::FreeNode(int node)
+{
+	nodes[node].parent = freeList;
+	nodes[node].height = -1;
+	freeList = node;
+}
+
+void DynamicAABBTree::InsertLeaf(int leaf)
+{
+	if (root == nullNode)
+	{
+		root = leaf;
+		nodes[root].parent = nullNode;
+		return;
+	}
+
+	const glm::vec3 leafMin = nodes[leaf].min;
+	const glm::vec3 leafMax = nodes[leaf].max;
+
+	// Walk down to the sibling that grows the tree's surface area the least.
+	int index = root;
+	while (!nodes[index].IsLeaf())
+	{
+		const Node& node = nodes[index];
+
+		const float area = SurfaceArea(node.min, node.max);
+		const float combinedArea = SurfaceArea(glm::min(node.min, leafMin), glm::max(node.max, leafMax));
+
+		// Cost of making a new parent for this node and the leaf, and the least cost pushed down to the children.
+		const float cost = 2.0f * combinedArea;
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto childCost = [this, &leafMin, &leafMax, inheritanceCost](int child)
+		{
+			const Node& childNode = nodes[child];
+			const float newArea = SurfaceArea(glm::min(childNode.min, leafMin), glm::max(childNode.max, leafMax));
+
+			if (childNode.IsLeaf())
+			{
+				return newArea + inheritanceCost;
+			}
+
+			return newArea - SurfaceArea(childNode.min, childNode.max) + inheritanceCost;
+		};
+
+		const float cost1 = childCost(node.child1);
+		const float cost2 = childCost(node.child2);
+
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+
+		index = (cost1 < cost2) ? node.child1 : node.child2;
+	}
+
+	const int sibling = index;
+
+	const int oldParent = nodes[sibling].parent;
+	const int newParent = AllocateNode();
+
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].min = glm::min(leafMin, nodes[sibling].min);
+	nodes[newParent].max = glm::max(leafMax, nodes[sibling].max);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leaf;
+
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	if (oldParent != nullNode)
+	{
+		if (nodes[oldParent].child1 == sibling)
+		{
+			nodes[oldParent].child1 = newParent;
+		}
+		else
+		{
+			nodes[oldParent].child2 = newParent;
+		}
+	}
+	else
+	{
+		root = newParent;
+	}
+
+	Refit(nodes[leaf].parent);
+}
+
+void DynamicAABBTree::RemoveLeaf(int leaf)
+{
+	if (leaf == root)
+	{
+		root = nullNode;
+		return;
+	}
+
+	const int parent = nodes[leaf].parent;
+	const int grandParent = nodes[parent].parent;
+	const int sibling = (nodes[parent].child1 == leaf) ? nodes[parent].child2 : nodes[parent].child1;
+
+	if (grandParent != nullNode)
+	{
+		// The sibling takes the parent's place.
+		if (nodes[grandParent].child1 == parent)
+		{
+			nodes[grandParent].child1 = sibling;
+		}
+		else
+		{
+			nodes[grandParent].child2 = sibling;
+		}
+
+		nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		Refit(grandParent);
+	}
+	else
+	{
+		root = sibling;
+		nodes[sibling].parent = nullNode;
+		FreeNode(parent);
+	}
+}
+
+void DynamicAABBTree::Refit(int index)
+{
+	while (index != nullNode)
+	{
+		index = Balance(index);
+
+		const int child1 = nodes[index].child1;
+		const int child2 = nodes[index].child2;
+
+		nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+		nodes[index].min = glm::min(nodes[child1].min, nodes[child2].min);
+		nodes[index].max = glm::max(nodes[child1].max, nodes[child2].max);
+
+		index = nodes[index].parent;
+	}
+}
+
+int DynamicAABBTree::Balance(int a)
+{
+	Node& nodeA = nodes[a];
+	if (nodeA.IsLeaf() || nodeA.height < 2)
+	{
+		return a;
+	}
+
+	const int b = nodeA.child1;
+	const int c = nodeA.child2;
+
+	const int balance = nodes[c].height - nodes[b].height;
+
+	// Promotes the taller child of a, which becomes the parent of a and keeps one of its own children.
+	auto rotate = [this, a](int tall, int other)
+	{
+		Node& nodeA = nodes[a];
+		Node& nodeTall = nodes[tall];
+
+		const int f = nodeTall.child1;
+		const int g = nodeTall.child2;
+
+		nodeTall.child1 = a;
+		nodeTall.parent = nodeA.parent;
+		nodeA.parent = tall;
+
+		if (nodeTall.parent != nullNode)
+		{
+			if (nodes[nodeTall.parent].child1 == a)
+			{
+				nodes[nodeTall.parent].child1 = tall;
+			}
+			else
+			{
+				nodes[nodeTall.parent].child2 = tall;
+			}
+		}
+		else
+		{
+			root = tall;
+		}
+
+		// The taller grandchild stays under the promoted node, the other replaces it under a.
+		const int keep = (nodes[f].height > nodes[g].height) ? f : g;
+		const int move = (keep == f) ? g : f;
+
+		nodeTall.child2 = keep;
+
+		if (nodeA.child1 == tall)
+		{
+			nodeA.child1 = move;
+		}
+		else
+		{
+			nodeA.child2 = move;
+		}
+
+		nodes[move].parent = a;
+
+		nodeA.min = glm::min(nodes[other].min, nodes[move].min);
+		nodeA.max = glm::max(nodes[other].max, nodes[move].max);
+		nodeA.height = 1 + std::max(nodes[other].height, nodes[move].height);
+
+		nodeTall.min = glm::min(nodeA.min, nodes[keep].min);
+		nodeTall.max = glm::max(nodeA.max, nodes[keep].max);
+		nodeTall.height = 1 + std::max(nodeA.height, nodes[keep].height);
+
+		return tall;
+	};
+
+	if (balance > 1)
+	{
+		return rotate(c, b);
+	}
+
+	if (balance < -1)
+	{
+		return rotate(b, c);
+	}
+
+	return a;
+}
+
+float DynamicAABBTree::SurfaceArea(const glm::vec3& min, const glm::vec3& max)
+{
+	const glm::vec3 extent = max - min;
+	return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
@@ -0,0 +1,112 @@
+#ifndef DYNAMICAABBTREE_H
+#define DYNAMICAABBTREE_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <functional>
+
+// A bounding volume hierarchy of axis aligned boxes that is updated incrementally as its boxes move. Leaves store fat boxes,
+// grown by a margin and the last displacement, so an object moving a little inside its fat box does not touch the tree.
+// Inserts pick the sibling with the least surface area cost and rotations keep the tree balanced.
+class DynamicAABBTree
+{
+public:
+
+	static const int nullNode = -1;
+
+	DynamicAABBTree(float margin = 0.1f);
+
+	~DynamicAABBTree();
+
+	DynamicAABBTree(const DynamicAABBTree&) = delete;
+
+	DynamicAABBTree& operator=(const DynamicAABBTree&) = delete;
+
+	DynamicAABBTree(DynamicAABBTree&&) = delete;
+
+	DynamicAABBTree& operator=(DynamicAABBTree&&) = delete;
+
+	// Returns the proxy for the box, valid until it is removed.
+	int Insert(const glm::vec3& min, const glm::vec3& max, unsigned int userData);
+
+	void Remove(int proxy);
+
+	// Updates the tight box of proxy. The leaf is only reinserted, and true returned, when the box left its fat box or the
+	// fat box is far larger than the motion needs.
+	// displacement is how far the object moved since the last update, the fat box is stretched in that direction.
+	bool Move(int proxy, const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement = glm::vec3(0.0f));
+
+	unsigned int GetUserData(int proxy) const;
+
+	const glm::vec3& GetFatMin(int proxy) const;
+
+	const glm::vec3& GetFatMax(int proxy) const;
+
+	// Calls callback with the proxy of every leaf whose fat box overlaps min and max, stopping if it returns false.
+	void Query(const glm::vec3& min, const glm::vec3& max, const std::function<bool(int)>& callback) const;
+
+	// Every leaf hit by the segment from start to end, for picking and line of sight tests.
+	void RayCast(const glm::vec3& start, const glm::vec3& end, const std::function<bool(int)>& callback) const;
+
+	unsigned int GetHeight() const;
+
+	unsigned int GetProxyCount() const;
+
+	// Sum of the surface areas of all inner nodes over that of the root, lower is a better tree.
+	float GetAreaRatio() const;
+
+private:
+
+	struct Node
+	{
+		glm::vec3 min;
+
+		glm::vec3 max;
+
+		// The parent while in the tree, the next free node while on the free list.
+		int parent;
+
+		int child1;
+
+		int child2;
+
+		// 0 for leaves, -1 for free nodes.
+		int height;
+
+		unsigned int userData;
+
+		bool IsLeaf() const
+		{
+			return child1 == nullNode;
+		}
+	};
+
+	int AllocateNode();
+
+	void FreeNode(int node);
+
+	void InsertLeaf(int leaf);
+
+	void RemoveLeaf(int leaf);
+
+	// Rotates the subtree at node if its children's heights differ by more than one. Returns the new subtree root.
+	int Balance(int node);
+
+	void Refit(int node);
+
+	static float SurfaceArea(const glm::vec3& min, const glm::vec3& max);
+
+	std::vector<Node> nodes;
+
+	int root;
+
+	int freeList;
+
+	unsigned int proxyCount;
+
+	float margin;
+
+};
+
+#endif // DYNAMICAABBTREE_H
@@ -0,0 +1,879 @@
+#include "GJK.h"
+
+#include "ConvexShape.h"
+
+#include <vector>
+#include <cfloat>
+#include <algorithm>
+
+namespace
+{
+	const unsigned int maxIterations = 64;
+
+	// GJK has found the closest point once a new support point brings it closer by less than this fraction.
+	const float relativeTolerance = 1e-6f;
+
+	// How close to the boundary of the difference EPA's polytope gets, in world units.
+	const float expandTolerance = 1e-4f;
+
+	const unsigned int maxExpandFaces = 256;
+
+	// A reference face less aligned with the contact normal than this makes an edge contact, with a single point.
+	const float referenceAlignment = 0.9f;
+
+	// A point of the Minkowski difference a - b with the points of a and b it came from.
+	struct SupportPoint
+	{
+		glm::vec3 point;
+
+		glm::vec3 a;
+
+		glm::vec3 b;
+
+		glm::vec3 direction;
+	};
+
+	struct Simplex
+	{
+		SupportPoint points[4];
+
+		// Of the closest point to the origin, for the closest points on the shapes.
+		float weights[4];
+
+		unsigned int count = 0;
+	};
+
+	struct Face
+	{
+		unsigned int vertices[3];
+
+		glm::vec3 normal;
+
+		float distance;
+	};
+
+	SupportPoint MakeSupport(const ConvexShape& a, const ConvexShape& b, const glm::vec3& direction)
+	{
+		SupportPoint support;
+		support.a = a.Support(direction);
+		support.b = b.Support(-direction);
+		support.point = support.a - support.b;
+		support.direction = direction;
+		return support;
+	}
+
+	void Keep(Simplex& simplex, unsigned int i0, float w0)
+	{
+		simplex.points[0] = simplex.points[i0];
+		simplex.weights[0] = w0;
+		simplex.count = 1;
+	}
+
+	void Keep(Simplex& simplex, unsigned int i0, unsigned int i1, float w0, float w1)
+	{
+		const SupportPoint p0 = simplex.points[i0];
+		const SupportPoint p1 = simplex.points[i1];
+		simplex.points[0] = p0;
+		simplex.points[1] = p1;
+		simplex.weights[0] = w0;
+		simplex.weights[1] = w1;
+		simplex.count = 2;
+	}
+
+	// The point of the segment closest to the origin, the simplex reduced to the points it is made of.
+	glm::vec3 SolveSegment(Simplex& simplex)
+	{
+		const glm::vec3& a = simplex.points[0].point;
+		const glm::vec3 ab = simplex.points[1].point - a;
+
+		const float lengthSquared = glm::dot(ab, ab);
+		const float t = (lengthSquared > 0.0f) ? -glm::dot(a, ab) / lengthSquared : 0.0f;
+
+		if (t <= 0.0f)
+		{
+			Keep(simplex, 0, 1.0f);
+			return simplex.points[0].point;
+		}
+
+		if (t >= 1.0f)
+		{
+			Keep(simplex, 1, 1.0f);
+			return simplex.points[0].point;
+		}
+
+		simplex.weights[0] = 1.0f - t;
+		simplex.weights[1] = t;
+		return a + ab * t;
+	}
+
+	// Ericson's closest point on a triangle by Voronoi regions, for the origin.
+	glm::vec3 SolveTriangle(Simplex& simplex)
+	{
+		const glm::vec3 a = simplex.points[0].point;
+		const glm::vec3 b = simplex.points[1].point;
+		const glm::vec3 c = simplex.points[2].point;
+		const glm::vec3 ab = b - a;
+		const glm::vec3 ac = c - a;
+
+		const float d1 = -glm::dot(ab, a);
+		const float d2 = -glm::dot(ac, a);
+
+		if (d1 <= 0.0f && d2 <= 0.0f)
+		{
+			Keep(simplex, 0, 1.0f);
+			return a;
+		}
+
+		const float d3 = -glm::dot(ab, b);
+		const float d4 = -glm::dot(ac, b);
+
+		if (d3 >= 0.0f && d4 <= d3)
+		{
+			Keep(simplex, 1, 1.0f);
+			return b;
+		}
+
+		const float vc = d1 * d4 - d3 * d2;
+
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+		{
+			const float v = d1 / (d1 - d3);
+			Keep(simplex, 0, 1, 1.0f - v, v);
+			return a + ab * v;
+		}
+
+		const float d5 = -glm::dot(ab, c);
+		const float d6 = -glm::dot(ac, c);
+
+		if (d6 >= 0.0f && d5 <= d6)
+		{
+			Keep(simplex, 2, 1.0f);
+			return c;
+		}
+
+		const float vb = d5 * d2 - d1 * d6;
+
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+		{
+			const float w = d2 / (d2 - d6);
+			Keep(simplex, 0, 2, 1.0f - w, w);
+			return a + ac * w;
+		}
+
+		const float va = d3 * d6 - d5 * d4;
+
+		if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+		{
+			const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			Keep(simplex, 1, 2, 1.0f - w, w);
+			return b + (c - b) * w;
+		}
+
+		const float sum = va + vb + vc;
+
+		// A triangle flattened to a segment, its longest edge stands in for it.
+		if (sum <= FLT_MIN)
+		{
+			const float lengthAB = glm::dot(ab, ab);
+			const float lengthAC = glm::dot(ac, ac);
+			const float lengthBC = glm::dot(c - b, c - b);
+
+			if (lengthAB >= lengthAC && lengthAB >= lengthBC)
+				Keep(simplex, 0, 1, 1.0f, 0.0f);
+			else if (lengthAC >= lengthBC)
+				Keep(simplex, 0, 2, 1.0f, 0.0f);
+			else
+				Keep(simplex, 1, 2, 1.0f, 0.0f);
+
+			return SolveSegment(simplex);
+		}
+
+		const float v = vb / sum;
+		const float w = vc / sum;
+		simplex.weights[0] = 1.0f - v - w;
+		simplex.weights[1] = v;
+		simplex.weights[2] = w;
+		return a + ab * v + ac * w;
+	}
+
+	// The closest point of whichever faces the origin is outside of, or the origin itself when the tetrahedron holds it.
+	glm::vec3 SolveTetrahedron(Simplex& simplex, bool& containsOrigin)
+	{
+		static const unsigned int faces[4][4] =
+		{
+			{ 0, 1, 2, 3 },
+			{ 0, 2, 3, 1 },
+			{ 0, 3, 1, 2 },
+			{ 1, 3, 2, 0 }
+		};
+
+		containsOrigin = true;
+
+		float bestDistance = FLT_MAX;
+		Simplex best;
+		glm::vec3 bestPoint(0.0f);
+
+		for (const unsigned int* face : faces)
+		{
+			const glm::vec3& a = simplex.points[face[0]].point;
+			const glm::vec3 normal = glm::cross(simplex.points[face[1]].point - a, simplex.points[face[2]].point - a);
+
+			const float originSide = -glm::dot(normal, a);
+			const float oppositeSide = glm::dot(normal, simplex.points[face[3]].point - a);
+
+			// A flat tetrahedron has no inside, every face is tried.
+			if (originSide * oppositeSide > 0.0f && fabsf(oppositeSide) > FLT_MIN)
+			{
+				continue;
+			}
+
+			containsOrigin = false;
+
+			Simplex triangle;
+			triangle.points[0] = simplex.points[face[0]];
+			triangle.points[1] = simplex.points[face[1]];
+			triangle.points[2] = simplex.points[face[2]];
+			triangle.count = 3;
+
+			const glm::vec3 point = SolveTriangle(triangle);
+			const float distance = glm::dot(point, point);
+
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				best = triangle;
+				bestPoint = point;
+			}
+		}
+
+		if (containsOrigin)
+		{
+			return glm::vec3(0.0f);
+		}
+
+		simplex = best;
+		return bestPoint;
+	}
+
+	glm::vec3 Solve(Simplex& simplex, bool& containsOrigin)
+	{
+		containsOrigin = false;
+
+		switch (simplex.count)
+		{
+		case 1:
+			simplex.weights[0] = 1.0f;
+			return simplex.points[0].point;
+		case 2:
+			return SolveSegment(simplex);
+		case 3:
+			return SolveTriangle(simplex);
+		default:
+			return SolveTetrahedron(simplex, containsOrigin);
+		}
+	}
+
+	bool Contains(const Simplex& simplex, const glm::vec3& point)
+	{
+		for (unsigned int i = 0; i < simplex.count; i++)
+		{
+			const glm::vec3 difference = simplex.points[i].point - point;
+
+			if (glm::dot(difference, difference) <= FLT_EPSILON * FLT_EPSILON * glm::dot(point, point) + FLT_MIN)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// GJK on the difference a - b. Returns whether the shapes intersect, leaving the simplex closest to the origin and its
+	// closest point in closest. With stopWhenSeparated it returns as soon as a separating direction is found, which is all
+	// an intersection test needs.
+	bool Run(const ConvexShape& a, const ConvexShape& b, Simplex& simplex, glm::vec3& closest, bool stopWhenSeparated, GJK::Cache* cache)
+	{
+		simplex.count = 0;
+
+		if (cache != nullptr)
+		{
+			for (unsigned int i = 0; i < cache->count; i++)
+			{
+				const SupportPoint support = MakeSupport(a, b, cache->directions[i]);
+
+				if (!Contains(simplex, support.point))
+				{
+					simplex.points[simplex.count++] = support;
+				}
+			}
+		}
+
+		if (simplex.count == 0)
+		{
+			glm::vec3 direction = a.GetCenter() - b.GetCenter();
+
+			if (glm::dot(direction, direction) <= FLT_MIN)
+			{
+				direction = glm::vec3(1.0f, 0.0f, 0.0f);
+			}
+
+			simplex.points[simplex.count++] = MakeSupport(a, b, direction);
+		}
+
+		bool intersecting = false;
+		closest = Solve(simplex, intersecting);
+
+		for (unsigned int iteration = 0; iteration < maxIterations && !intersecting; iteration++)
+		{
+			const float distanceSquared = glm::dot(closest, closest);
+
+			// The origin on the simplex, to within what its points can resolve.
+			float largestSquared = 0.0f;
+
+			for (unsigned int i = 0; i < simplex.count; i++)
+			{
+				largestSquared = std::max(largestSquared, glm::dot(simplex.points[i].point, simplex.points[i].point));
+			}
+
+			if (distanceSquared <= 16.0f * FLT_EPSILON * FLT_EPSILON * largestSquared + FLT_MIN)
+			{
+				intersecting = true;
+				break;
+			}
+
+			const SupportPoint support = MakeSupport(a, b, -closest);
+			const float progress = distanceSquared - glm::dot(closest, support.point);
+
+			// Nothing of the difference lies past the plane through the origin facing closest.
+			if (stopWhenSeparated && glm::dot(support.point, closest) > 0.0f)
+			{
+				break;
+			}
+
+			if (progress <= relativeTolerance * distanceSquared || Contains(simplex, support.point))
+			{
+				break;
+			}
+
+			simplex.points[simplex.count++] = support;
+			closest = Solve(simplex, intersecting);
+		}
+
+		if (cache != nullptr)
+		{
+			cache->count = simplex.count;
+
+			for (unsigned int i = 0; i < simplex.count; i++)
+			{
+				cache->directions[i] = simplex.points[i].direction;
+			}
+		}
+
+		return intersecting;
+	}
+
+	bool AddFace(const std::vector<SupportPoint>& vertices, const glm::vec3& inside, unsigned int i0, unsigned int i1, unsigned int i2, std::vector<Face>& faces)
+	{
+		const glm::vec3& a = vertices[i0].point;
+		glm::vec3 normal = glm::cross(vertices[i1].point - a, vertices[i2].point - a);
+		const float length = glm::length(normal);
+
+		if (length <= FLT_MIN)
+		{
+			return false;
+		}
+
+		normal /= length;
+
+		Face face = { { i0, i1, i2 }, normal, glm::dot(normal, a) };
+
+		// Outward, away from a point that stays inside the polytope as it grows.
+		if (glm::dot(normal, a - inside) < 0.0f)
+		{
+			face.vertices[1] = i2;
+			face.vertices[2] = i1;
+			face.normal = -normal;
+			face.distance = -face.distance;
+		}
+
+		faces.push_back(face);
+		return true;
+	}
+
+	// Grows a simplex that touches the origin but is not a tetrahedron into one, false when the difference is flat there.
+	bool BlowUp(const ConvexShape& a, const ConvexShape& b, std::vector<SupportPoint>& vertices)
+	{
+		static const glm::vec3 axes[6] =
+		{
+			glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+			glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+			glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+		};
+
+		const float epsilon = expandTolerance * expandTolerance;
+
+		if (vertices.size() == 1)
+		{
+			for (const glm::vec3& axis : axes)
+			{
+				const SupportPoint support = MakeSupport(a, b, axis);
+				const glm::vec3 difference = support.point - vertices[0].point;
+
+				if (glm::dot(difference, difference) > epsilon)
+				{
+					vertices.push_back(support);
+					break;
+				}
+			}
+		}
+
+		if (vertices.size() == 2)
+		{
+			const glm::vec3 line = glm::normalize(vertices[1].point - vertices[0].point);
+
+			const glm::vec3 first = glm::cross(line, fabsf(line.x) < 0.57735f ? axes[0] : axes[2]);
+			const glm::vec3 second = glm::cross(line, first);
+			const glm::vec3 directions[4] = { first, second, -first, -second };
+
+			for (const glm::vec3& direction : directions)
+			{
+				const SupportPoint support = MakeSupport(a, b, direction);
+				const glm::vec3 offLine = glm::cross(support.point - vertices[0].point, line);
+
+				if (glm::dot(offLine, offLine) > epsilon)
+				{
+					vertices.push_back(support);
+					break;
+				}
+			}
+		}
+
+		if (vertices.size() == 3)
+		{
+			const glm::vec3 normal = glm::normalize(glm::cross(vertices[1].point - vertices[0].point, vertices[2].point - vertices[0].point));
+
+			for (const glm::vec3& direction : { normal, -normal })
+			{
+				const SupportPoint support = MakeSupport(a, b, direction);
+
+				if (fabsf(glm::dot(support.point - vertices[0].point, normal)) > expandTolerance)
+				{
+					vertices.push_back(support);
+					break;
+				}
+			}
+		}
+
+		if (vertices.size() < 4)
+		{
+			return false;
+		}
+
+		const float volume = glm::dot(vertices[1].point - vertices[0].point, glm::cross(vertices[2].point - vertices[0].point, vertices[3].point - vertices[0].point));
+		return fabsf(volume) > epsilon * expandTolerance;
+	}
+
+	// EPA from GJK's final simplex. Fills the normal, depth and a single contact point.
+	bool Expand(const ConvexShape& a, const ConvexShape& b, const Simplex& simplex, GJK::Manifold& manifold)
+	{
+		std::vector<SupportPoint> vertices(simplex.points, simplex.points + simplex.count);
+
+		if (!BlowUp(a, b, vertices))
+		{
+			return false;
+		}
+
+		const glm::vec3 inside = (vertices[0].point + vertices[1].point + vertices[2].point + vertices[3].point) * 0.25f;
+
+		std::vector<Face> faces;
+		AddFace(vertices, inside, 0, 1, 2, faces);
+		AddFace(vertices, inside, 0, 3, 1, faces);
+		AddFace(vertices, inside, 0, 2, 3, faces);
+		AddFace(vertices, inside, 1, 3, 2, faces);
+
+		std::vector<std::pair<unsigned int, unsigned int>> horizon;
+
+		auto closestFace = [&faces]()
+		{
+			unsigned int closest = 0;
+
+			for (unsigned int i = 1; i < faces.size(); i++)
+			{
+				if (faces[i].distance < faces[closest].distance)
+				{
+					closest = i;
+				}
+			}
+
+			return closest;
+		};
+
+		for (unsigned int iteration = 0; iteration < maxIterations && faces.size() < maxExpandFaces; iteration++)
+		{
+			const Face face = faces[closestFace()];
+			const SupportPoint support = MakeSupport(a, b, face.normal);
+
+			if (glm::dot(support.point, face.normal) - face.distance < expandTolerance)
+			{
+				break;
+			}
+
+			const unsigned int newVertex = static_cast<unsigned int>(vertices.size());
+			vertices.push_back(support);
+
+			// The faces the new point sees are replaced by a fan from it to the edge of the hole they leave.
+			horizon.clear();
+
+			for (unsigned int i = static_cast<unsigned int>(faces.size()); i-- > 0;)
+			{
+				const Face& visible = faces[i];
+
+				if (glm::dot(visible.normal, support.point - vertices[visible.vertices[0]].point) <= 0.0f)
+				{
+					continue;
+				}
+
+				for (unsigned int edge = 0; edge < 3; edge++)
+				{
+					const std::pair<unsigned int, unsigned int> newEdge(visible.vertices[edge], visible.vertices[(edge + 1) % 3]);
+					const auto shared = std::find(horizon.begin(), horizon.end(), std::make_pair(newEdge.second, newEdge.first));
+
+					if (shared != horizon.end())
+					{
+						horizon.erase(shared);
+					}
+					else
+					{
+						horizon.push_back(newEdge);
+					}
+				}
+
+				faces[i] = faces.back();
+				faces.pop_back();
+			}
+
+			if (horizon.empty())
+			{
+				break;
+			}
+
+			for (const std::pair<unsigned int, unsigned int>& edge : horizon)
+			{
+				AddFace(vertices, inside, edge.first, edge.second, newVertex, faces);
+			}
+
+			if (faces.empty())
+			{
+				return false;
+			}
+		}
+
+		const Face& face = faces[closestFace()];
+		const SupportPoint& p0 = vertices[face.vertices[0]];
+		const SupportPoint& p1 = vertices[face.vertices[1]];
+		const SupportPoint& p2 = vertices[face.vertices[2]];
+
+		// The weights of the origin projected onto the face.
+		const glm::vec3 projection = face.normal * face.distance;
+		const glm::vec3 e0 = p1.point - p0.point;
+		const glm::vec3 e1 = p2.point - p0.point;
+		const glm::vec3 toProjection = projection - p0.point;
+
+		const float d00 = glm::dot(e0, e0);
+		const float d01 = glm::dot(e0, e1);
+		const float d11 = glm::dot(e1, e1);
+		const float d20 = glm::dot(toProjection, e0);
+		const float d21 = glm::dot(toProjection, e1);
+		const float denominator = d00 * d11 - d01 * d01;
+
+		float v = 0.0f;
+		float w = 0.0f;
+
+		if (fabsf(denominator) > FLT_MIN)
+		{
+			v = (d11 * d20 - d01 * d21) / denominator;
+			w = (d00 * d21 - d01 * d20) / denominator;
+		}
+
+		const float u = 1.0f - v - w;
+
+		manifold.normal = face.normal;
+		manifold.depth = std::max(face.distance, 0.0f);
+		manifold.points[0].pointA = p0.a * u + p1.a * v + p2.a * w;
+		manifold.points[0].pointB = p0.b * u + p1.b * v + p2.b * w;
+		manifold.points[0].depth = manifold.depth;
+		manifold.pointCount = 1;
+
+		return true;
+	}
+
+	// Newell's normal of a polygon, turned to face direction.
+	glm::vec3 PolygonNormal(const std::vector<glm::vec3>& polygon, const glm::vec3& direction)
+	{
+		glm::vec3 normal(0.0f);
+
+		for (unsigned int i = 0; i < polygon.size(); i++)
+		{
+			const glm::vec3& current = polygon[i];
+			const glm::vec3& next = polygon[(i + 1) % polygon.size()];
+
+			normal.x += (current.y - next.y) * (current.z + next.z);
+			normal.y += (current.z - next.z) * (current.x + next.x);
+			normal.z += (current.x - next.x) * (current.y + next.y);
+		}
+
+		const float length = glm::length(normal);
+
+		if (length <= FLT_MIN)
+		{
+			return glm::vec3(0.0f);
+		}
+
+		return (glm::dot(normal, direction) < 0.0f) ? -normal / length : normal / length;
+	}
+
+	// Sutherland-Hodgman, keeping the part of polygon behind the plane.
+	void Clip(const std::vector<glm::vec3>& polygon, const glm::vec3& planePoint, const glm::vec3& planeNormal, std::vector<glm::vec3>& result)
+	{
+		result.clear();
+
+		for (unsigned int i = 0; i < polygon.size(); i++)
+		{
+			const glm::vec3& current = polygon[i];
+			const glm::vec3& next = polygon[(i + 1) % polygon.size()];
+
+			const float currentDistance = glm::dot(current - planePoint, planeNormal);
+			const float nextDistance = glm::dot(next - planePoint, planeNormal);
+
+			if (currentDistance <= 0.0f)
+			{
+				result.push_back(current);
+			}
+
+			if ((currentDistance < 0.0f && nextDistance > 0.0f) || (currentDistance > 0.0f && nextDistance < 0.0f))
+			{
+				result.push_back(current + (next - current) * (currentDistance / (currentDistance - nextDistance)));
+			}
+
+			// A segment is a polygon of two points, its way back would add every point twice.
+			if (polygon.size() == 2)
+			{
+				break;
+			}
+		}
+
+		if (polygon.size() == 2 && result.size() < 2 && glm::dot(polygon[1] - planePoint, planeNormal) <= 0.0f)
+		{
+			result.push_back(polygon[1]);
+		}
+	}
+
+	// Up to four of the contacts, the deepest and those spreading furthest from it, which is what holds a box steady.
+	void ReduceContacts(std::vector<GJK::ContactPoint>& contacts)
+	{
+		if (contacts.size() <= 4)
+		{
+			return;
+		}
+
+		std::vector<GJK::ContactPoint> kept;
+
+		auto takeBest = [&contacts, &kept](const auto& score)
+		{
+			unsigned int best = 0;
+			float bestScore = -FLT_MAX;
+
+			for (unsigned int i = 0; i < contacts.size(); i++)
+			{
+				const float contactScore = score(contacts[i]);
+
+				if (contactScore > bestScore)
+				{
+					best = i;
+					bestScore = contactScore;
+				}
+			}
+
+			kept.push_back(contacts[best]);
+			contacts.erase(contacts.begin() + best);
+		};
+
+		takeBest([](const GJK::ContactPoint& contact) { return contact.depth; });
+
+		takeBest([&kept](const GJK::ContactPoint& contact)
+		{
+			const glm::vec3 difference = contact.pointB - kept[0].pointB;
+			return glm::dot(difference, difference);
+		});
+
+		takeBest([&kept](const GJK::ContactPoint& contact)
+		{
+			return glm::length(glm::cross(kept[1].pointB - kept[0].pointB, contact.pointB - kept[0].pointB));
+		});
+
+		takeBest([&kept](const GJK::ContactPoint& contact)
+		{
+			float distances = 0.0f;
+
+			for (const GJK::ContactPoint& keptContact : kept)
+			{
+				const glm::vec3 difference = contact.pointB - keptContact.pointB;
+				distances += glm::dot(difference, difference);
+			}
+
+			return distances;
+		});
+
+		contacts = kept;
+	}
+
+	// Clips the face of one shape touching the other against it for the contact points. The single point EPA found is
+	// kept for edge contacts and round shapes.
+	void BuildManifold(const ConvexShape& a, const ConvexShape& b, GJK::Manifold& manifold)
+	{
+		const glm::vec3& normal = manifold.normal;
+
+		std::vector<glm::vec3> faceA;
+		std::vector<glm::vec3> faceB;
+		a.SupportFace(normal, faceA);
+		b.SupportFace(-normal, faceB);
+
+		const glm::vec3 normalA = (faceA.size() >= 3) ? PolygonNormal(faceA, normal) : glm::vec3(0.0f);
+		const glm::vec3 normalB = (faceB.size() >= 3) ? PolygonNormal(faceB, -normal) : glm::vec3(0.0f);
+
+		const float alignmentA = glm::dot(normalA, normal);
+		const float alignmentB = -glm::dot(normalB, normal);
+
+		if (std::max(alignmentA, alignmentB) < referenceAlignment)
+		{
+			return;
+		}
+
+		const bool referenceIsA = alignmentA >= alignmentB;
+		const std::vector<glm::vec3>& reference = referenceIsA ? faceA : faceB;
+		const glm::vec3& referenceNormal = referenceIsA ? normalA : normalB;
+
+		glm::vec3 referenceCenter(0.0f);
+
+		for (const glm::vec3& point : reference)
+		{
+			referenceCenter += point;
+		}
+
+		referenceCenter /= static_cast<float>(reference.size());
+
+		std::vector<glm::vec3> clipped = referenceIsA ? faceB : faceA;
+		std::vector<glm::vec3> scratch;
+
+		for (unsigned int i = 0; i < reference.size() && !clipped.empty(); i++)
+		{
+			const glm::vec3& start = reference[i];
+			const glm::vec3& end = reference[(i + 1) % reference.size()];
+
+			glm::vec3 sideNormal = glm::cross(end - start, referenceNormal);
+
+			if (glm::dot(sideNormal, referenceCenter - start) > 0.0f)
+			{
+				sideNormal = -sideNormal;
+			}
+
+			Clip(clipped, start, sideNormal, scratch);
+			std::swap(clipped, scratch);
+		}
+
+		std::vector<GJK::ContactPoint> contacts;
+
+		for (const glm::vec3& point : clipped)
+		{
+			const float separation = glm::dot(point - reference[0], referenceNormal);
+
+			if (separation > expandTolerance)
+			{
+				continue;
+			}
+
+			const glm::vec3 onReference = point - referenceNormal * separation;
+
+			GJK::ContactPoint contact;
+			contact.pointA = referenceIsA ? onReference : point;
+			contact.pointB = referenceIsA ? point : onReference;
+			contact.depth = std::max(-separation, 0.0f);
+			contacts.push_back(contact);
+		}
+
+		if (contacts.empty())
+		{
+			return;
+		}
+
+		ReduceContacts(contacts);
+
+		manifold.pointCount = static_cast<unsigned int>(contacts.size());
+
+		for (unsigned int i = 0; i < contacts.size(); i++)
+		{
+			manifold.points[i] = contacts[i];
+		}
+	}
+}
+
+bool GJK::Intersect(const ConvexShape& a, const ConvexShape& b, Cache* cache)
+{
+	Simplex simplex;
+	glm::vec3 closest;
+
+	return Run(a, b, simplex, closest, true, cache);
+}
+
+float GJK::Distance(const ConvexShape& a, const ConvexShape& b, glm::vec3& closestA, glm::vec3& closestB, Cache* cache)
+{
+	Simplex simplex;
+	glm::vec3 closest;
+
+	if (Run(a, b, simplex, closest, false, cache))
+	{
+		closestA = closestB = a.Support(b.GetCenter() - a.GetCenter());
+		return 0.0f;
+	}
+
+	closestA = glm::vec3(0.0f);
+	closestB = glm::vec3(0.0f);
+
+	for (unsigned int i = 0; i < simplex.count; i++)
+	{
+		closestA += simplex.points[i].a * simplex.weights[i];
+		closestB += simplex.points[i].b * simplex.weights[i];
+	}
+
+	return glm::length(closest);
+}
+
+bool GJK::Penetration(const ConvexShape& a, const ConvexShape& b, Manifold& manifold, Cache* cache)
+{
+	Simplex simplex;
+	glm::vec3 closest;
+
+	manifold = Manifold();
+
+	if (!Run(a, b, simplex, closest, true, cache))
+	{
+		return false;
+	}
+
+	if (!Expand(a, b, simplex, manifold))
+	{
+		// Touching without overlap, or a difference too flat to expand, a contact of no depth between the centers.
+		glm::vec3 direction = b.GetCenter() - a.GetCenter();
+		manifold.normal = (glm::dot(direction, direction) > FLT_MIN) ? glm::normalize(direction) : glm::vec3(0.0f, 1.0f, 0.0f);
+		manifold.depth = 0.0f;
+		manifold.points[0].pointA = a.Support(manifold.normal);
+		manifold.points[0].pointB = manifold.points[0].pointA;
+		manifold.points[0].depth = 0.0f;
+		manifold.pointCount = 1;
+		return true;
+	}
+
+	BuildManifold(a, b, manifold);
+
+	return true;
+}
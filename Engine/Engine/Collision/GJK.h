@@ -0,0 +1,73 @@
+#ifndef GJK_H
+#define GJK_H
+
+#include <glm/glm.hpp>
+
+class ConvexShape;
+
+// Narrowphase for any pair of convex shapes through their support functions alone, so a new shape needs a support function
+// and no new pair tests. GJK finds whether and how far apart the shapes are. EPA, started from GJK's final simplex, finds
+// how deep they are along which normal, and the faces the shapes touch with are clipped against each other for up to four
+// contact points.
+class GJK
+{
+public:
+
+	// The directions the simplex of a query was found along. Kept by the caller for a pair of shapes from one frame to the
+	// next, the next query starts from the support points along them, which is close to the answer for shapes that have
+	// moved a little. Any cache is a valid start, a stale one just costs iterations.
+	struct Cache
+	{
+		glm::vec3 directions[4];
+
+		unsigned int count = 0;
+	};
+
+	struct ContactPoint
+	{
+		// On the surface of a, inside b.
+		glm::vec3 pointA;
+
+		// On the surface of b, inside a.
+		glm::vec3 pointB;
+
+		float depth;
+	};
+
+	struct Manifold
+	{
+		// From a toward b. Moving a by -normal * depth separates the shapes.
+		glm::vec3 normal = glm::vec3(0.0f);
+
+		float depth = 0.0f;
+
+		ContactPoint points[4];
+
+		unsigned int pointCount = 0;
+	};
+
+	static bool Intersect(const ConvexShape& a, const ConvexShape& b, Cache* cache = nullptr);
+
+	// The distance between the shapes and their closest points, zero when they intersect.
+	static float Distance(const ConvexShape& a, const ConvexShape& b, glm::vec3& closestA, glm::vec3& closestB, Cache* cache = nullptr);
+
+	// Whether the shapes intersect, and when they do the manifold of the contact.
+	static bool Penetration(const ConvexShape& a, const ConvexShape& b, Manifold& manifold, Cache* cache = nullptr);
+
+private:
+
+	GJK() = delete;
+
+	~GJK() = delete;
+
+	GJK(const GJK&) = delete;
+
+	GJK& operator=(const GJK&) = delete;
+
+	GJK(GJK&&) = delete;
+
+	GJK& operator=(GJK&&) = delete;
+
+};
+
+#endif // GJK_H
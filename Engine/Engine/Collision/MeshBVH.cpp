@@ -0,0 +1,813 @@
+#include "MeshBVH.h"
+
+#include "../Renderer/Model/Vertex.h"
+#include "../Math/Shapes/Ray.h"
+#include "../Math/Lanes.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Math::Lanes;
+
+namespace
+{
+	const unsigned int binCount = 16U;
+
+	// Leaves are made smaller than this whatever the surface area cost says.
+	const unsigned int maxLeafSize = 8U;
+
+	// Deeper than any real mesh gets, it bounds the traversal stacks.
+	const unsigned int maxDepth = 64U;
+
+	float SurfaceArea(const glm::vec3& min, const glm::vec3& max)
+	{
+		const glm::vec3 extent = max - min;
+		return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+	}
+
+	// Where the ray enters the box, or FLT_MAX if it misses it or enters past nearest. Parallel axes give infinities that
+	// compare correctly.
+	inline float SlabEnter(const glm::vec3& min, const glm::vec3& max, const glm::vec3& origin, const glm::vec3& inverseDirection, float nearest)
+	{
+		const glm::vec3 t0 = (min - origin) * inverseDirection;
+		const glm::vec3 t1 = (max - origin) * inverseDirection;
+
+		const glm::vec3 tNear = glm::min(t0, t1);
+		const glm::vec3 tFar = glm::max(t0, t1);
+
+		const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, nearest));
+
+		return (enter <= exit) ? enter : FLT_MAX;
+	}
+
+	inline float BoxDistanceSq(const glm::vec3& min, const glm::vec3& max, const glm::vec3& point)
+	{
+		const glm::vec3 outside = glm::max(glm::max(min - point, point - max), glm::vec3(0.0f));
+		return glm::dot(outside, outside);
+	}
+
+	// Moller-Trumbore, hitting both sides of the triangle. u and v are the weights of the second and third points.
+	inline bool IntersectTriangle(const glm::vec3& point0, const glm::vec3& edge1, const glm::vec3& edge2, const glm::vec3& origin, const glm::vec3& direction, float& t, float& u, float& v)
+	{
+		const glm::vec3 p = glm::cross(direction, edge2);
+		const float determinant = glm::dot(edge1, p);
+
+		if (std::fabs(determinant) < 1e-12f)
+		{
+			return false;
+		}
+
+		const float inverseDeterminant = 1.0f / determinant;
+		const glm::vec3 s = origin - point0;
+
+		u = glm::dot(s, p) * inverseDeterminant;
+		if (u < 0.0f || u > 1.0f)
+		{
+			return false;
+		}
+
+		const glm::vec3 q = glm::cross(s, edge1);
+
+		v = glm::dot(direction, q) * inverseDeterminant;
+		if (v < 0.0f || u + v > 1.0f)
+		{
+			return false;
+		}
+
+		t = glm::dot(edge2, q) * inverseDeterminant;
+		return t >= 0.0f;
+	}
+
+	// Real-Time Collision Detection 5.1.5, with the weights of a, b and c at the returned point.
+	glm::vec3 ClosestPointOnTriangle(const glm::vec3& point, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, glm::vec3& barycentrics)
+	{
+		const glm::vec3 ab = b - a;
+		const glm::vec3 ac = c - a;
+		const glm::vec3 ap = point - a;
+
+		const float d1 = glm::dot(ab, ap);
+		const float d2 = glm::dot(ac, ap);
+		if (d1 <= 0.0f && d2 <= 0.0f)
+		{
+			barycentrics = glm::vec3(1.0f, 0.0f, 0.0f);
+			return a;
+		}
+
+		const glm::vec3 bp = point - b;
+		const float d3 = glm::dot(ab, bp);
+		const float d4 = glm::dot(ac, bp);
+		if (d3 >= 0.0f && d4 <= d3)
+		{
+			barycentrics = glm::vec3(0.0f, 1.0f, 0.0f);
+			return b;
+		}
+
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+		{
+			const float v = d1 / (d1 - d3);
+			barycentrics = glm::vec3(1.0f - v, v, 0.0f);
+			return a + ab * v;
+		}
+
+		const glm::vec3 cp = point - c;
+		const float d5 = glm::dot(ab, cp);
+		const float d6 = glm::dot(ac, cp);
+		if (d6 >= 0.0f && d5 <= d6)
+		{
+			barycentrics = glm::vec3(0.0f, 0.0f, 1.0f);
+			return c;
+		}
+
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+		{
+			const float w = d2 / (d2 - d6);
+			barycentrics = glm::vec3(1.0f - w, 0.0f, w);
+			return a + ac * w;
+		}
+
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+		{
+			const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			barycentrics = glm::vec3(0.0f, 1.0f - w, w);
+			return b + (c - b) * w;
+		}
+
+		const float denominator = 1.0f / (va + vb + vc);
+		const float v = vb * denominator;
+		const float w = vc * denominator;
+
+		barycentrics = glm::vec3(1.0f - v - w, v, w);
+		return a + ab * v + ac * w;
+	}
+}
+
+MeshBVH::MeshBVH()
+{
+}
+
+MeshBVH::MeshBVH(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	Build(vertices, indices);
+}
+
+MeshBVH::~MeshBVH()
+{
+}
+
+void MeshBVH::Build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	nodes.clear();
+	triangles.clear();
+	triangleIds.clear();
+
+	const unsigned int triangleCount = static_cast<unsigned int>(indices.size() / 3);
+
+	std::vector<BuildTriangle> buildTriangles;
+	buildTriangles.reserve(triangleCount);
+
+	for (unsigned int i = 0; i < triangleCount; i++)
+	{
+		const glm::vec3& point0 = vertices[indices[i * 3]].GetPosition();
+		const glm::vec3& point1 = vertices[indices[i * 3 + 1]].GetPosition();
+		const glm::vec3& point2 = vertices[indices[i * 3 + 2]].GetPosition();
+
+		BuildTriangle triangle;
+		triangle.min = glm::min(point0, glm::min(point1, point2));
+		triangle.max = glm::max(point0, glm::max(point1, point2));
+		triangle.centroid = (point0 + point1 + point2) / 3.0f;
+		triangle.id = i;
+
+		buildTriangles.push_back(triangle);
+	}
+
+	if (buildTriangles.empty())
+	{
+		return;
+	}
+
+	nodes.reserve(triangleCount * 2U);
+	Subdivide(buildTriangles, 0U, triangleCount, 0U);
+
+	triangles.resize(triangleCount);
+	triangleIds.resize(triangleCount);
+
+	for (unsigned int i = 0; i < triangleCount; i++)
+	{
+		const unsigned int id = buildTriangles[i].id;
+
+		const glm::vec3& point0 = vertices[indices[id * 3]].GetPosition();
+		const glm::vec3& point1 = vertices[indices[id * 3 + 1]].GetPosition();
+		const glm::vec3& point2 = vertices[indices[id * 3 + 2]].GetPosition();
+
+		triangles[i] = { point0, point1 - point0, point2 - point0 };
+		triangleIds[i] = id;
+	}
+}
+
+void MeshBVH::Subdivide(std::vector<BuildTriangle>& buildTriangles, unsigned int first, unsigned int count, unsigned int depth)
+{
+	const unsigned int index = static_cast<unsigned int>(nodes.size());
+	nodes.push_back(Node());
+
+	glm::vec3 min(FLT_MAX);
+	glm::vec3 max(-FLT_MAX);
+	glm::vec3 centroidMin(FLT_MAX);
+	glm::vec3 centroidMax(-FLT_MAX);
+
+	for (unsigned int i = first; i < first + count; i++)
+	{
+		min = glm::min(min, buildTriangles[i].min);
+		max = glm::max(max, buildTriangles[i].max);
+		centroidMin = glm::min(centroidMin, buildTriangles[i].centroid);
+		centroidMax = glm::max(centroidMax, buildTriangles[i].centroid);
+	}
+
+	nodes[index].min = min;
+	nodes[index].max = max;
+
+	auto makeLeaf = [this, index, first, count]()
+	{
+		nodes[index].offset = first;
+		nodes[index].count = count;
+	};
+
+	const float area = SurfaceArea(min, max);
+
+	if (count <= 2U || depth + 1U >= maxDepth || area <= 0.0f)
+	{
+		makeLeaf();
+		return;
+	}
+
+	// Costs relative to intersecting one triangle, with a node visit costing about the same.
+	float bestCost = FLT_MAX;
+	int bestAxis = -1;
+	unsigned int bestSplit = 0U;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const float extent = centroidMax[axis] - centroidMin[axis];
+
+		if (extent <= 0.0f)
+		{
+			continue;
+		}
+
+		glm::vec3 binMin[binCount];
+		glm::vec3 binMax[binCount];
+		unsigned int binTriangles[binCount] = {};
+
+		std::fill(binMin, binMin + binCount, glm::vec3(FLT_MAX));
+		std::fill(binMax, binMax + binCount, glm::vec3(-FLT_MAX));
+
+		const float scale = static_cast<float>(binCount) / extent;
+
+		for (unsigned int i = first; i < first + count; i++)
+		{
+			const unsigned int bin = std::min(binCount - 1U, static_cast<unsigned int>((buildTriangles[i].centroid[axis] - centroidMin[axis]) * scale));
+
+			binMin[bin] = glm::min(binMin[bin], buildTriangles[i].min);
+			binMax[bin] = glm::max(binMax[bin], buildTriangles[i].max);
+			binTriangles[bin]++;
+		}
+
+		// Sweep from the right to know the cost of everything past each split, then from the left to compare.
+		float rightArea[binCount];
+		unsigned int rightTriangles[binCount];
+
+		glm::vec3 sweepMin(FLT_MAX);
+		glm::vec3 sweepMax(-FLT_MAX);
+		unsigned int sweepTriangles = 0U;
+
+		for (unsigned int bin = binCount - 1U; bin > 0U; bin--)
+		{
+			sweepMin = glm::min(sweepMin, binMin[bin]);
+			sweepMax = glm::max(sweepMax, binMax[bin]);
+			sweepTriangles += binTriangles[bin];
+
+			rightArea[bin] = (sweepTriangles > 0U) ? SurfaceArea(sweepMin, sweepMax) : 0.0f;
+			rightTriangles[bin] = sweepTriangles;
+		}
+
+		sweepMin = glm::vec3(FLT_MAX);
+		sweepMax = glm::vec3(-FLT_MAX);
+		sweepTriangles = 0U;
+
+		// Split s puts bins below s on the left.
+		for (unsigned int split = 1U; split < binCount; split++)
+		{
+			sweepMin = glm::min(sweepMin, binMin[split - 1U]);
+			sweepMax = glm::max(sweepMax, binMax[split - 1U]);
+			sweepTriangles += binTriangles[split - 1U];
+
+			if (sweepTriangles == 0U || rightTriangles[split] == 0U)
+			{
+				continue;
+			}
+
+			const float cost = 1.0f + (SurfaceArea(sweepMin, sweepMax) * sweepTriangles + rightArea[split] * rightTriangles[split]) / area;
+
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = split;
+			}
+		}
+	}
+
+	if (bestAxis < 0 || (bestCost >= static_cast<float>(count) && count <= maxLeafSize))
+	{
+		makeLeaf();
+		return;
+	}
+
+	const float scale = static_cast<float>(binCount) / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+	const float axisMin = centroidMin[bestAxis];
+
+	// The same bin computation as above, so both sides get the triangles counted for them.
+	const auto middle = std::partition(buildTriangles.begin() + first, buildTriangles.begin() + first + count, [bestAxis, bestSplit, scale, axisMin](const BuildTriangle& triangle)
+	{
+		return std::min(binCount - 1U, static_cast<unsigned int>((triangle.centroid[bestAxis] - axisMin) * scale)) < bestSplit;
+	});
+
+	const unsigned int leftCount = static_cast<unsigned int>(middle - (buildTriangles.begin() + first));
+
+	nodes[index].count = 0U;
+
+	Subdivide(buildTriangles, first, leftCount, depth + 1U);
+
+	nodes[index].offset = static_cast<unsigned int>(nodes.size());
+
+	Subdivide(buildTriangles, first + leftCount, count - leftCount, depth + 1U);
+}
+
+bool MeshBVH::Trace(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, bool anyHit, Hit& hit) const
+{
+	if (nodes.empty())
+	{
+		return false;
+	}
+
+	const glm::vec3 inverseDirection = 1.0f / direction;
+
+	float nearest = maxDistance;
+	unsigned int nearestTriangle = invalidTriangle;
+	float nearestU = 0.0f;
+	float nearestV = 0.0f;
+
+	struct Entry
+	{
+		unsigned int node;
+
+		float enter;
+	};
+
+	Entry stack[maxDepth];
+	unsigned int stackSize = 0U;
+
+	const float rootEnter = SlabEnter(nodes[0].min, nodes[0].max, origin, inverseDirection, nearest);
+	if (rootEnter != FLT_MAX)
+	{
+		stack[stackSize++] = { 0U, rootEnter };
+	}
+
+	while (stackSize > 0U)
+	{
+		const Entry entry = stack[--stackSize];
+
+		// Something nearer was hit after this node was pushed.
+		if (entry.enter > nearest)
+		{
+			continue;
+		}
+
+		unsigned int index = entry.node;
+		bool missed = false;
+
+		// Walks down the nearer child, leaving the farther one on the stack.
+		while (nodes[index].count == 0U)
+		{
+			const unsigned int left = index + 1U;
+			const unsigned int right = nodes[index].offset;
+
+			float leftEnter = SlabEnter(nodes[left].min, nodes[left].max, origin, inverseDirection, nearest);
+			float rightEnter = SlabEnter(nodes[right].min, nodes[right].max, origin, inverseDirection, nearest);
+
+			unsigned int nearChild = left;
+			unsigned int farChild = right;
+
+			if (rightEnter < leftEnter)
+			{
+				std::swap(leftEnter, rightEnter);
+				std::swap(nearChild, farChild);
+			}
+
+			if (leftEnter == FLT_MAX)
+			{
+				missed = true;
+				break;
+			}
+
+			if (rightEnter != FLT_MAX)
+			{
+				stack[stackSize++] = { farChild, rightEnter };
+			}
+
+			index = nearChild;
+		}
+
+		if (missed)
+		{
+			continue;
+		}
+
+		const Node& leaf = nodes[index];
+
+		for (unsigned int i = leaf.offset; i < leaf.offset + leaf.count; i++)
+		{
+			const PackedTriangle& triangle = triangles[i];
+
+			float t;
+			float u;
+			float v;
+
+			if (IntersectTriangle(triangle.point0, triangle.edge1, triangle.edge2, origin, direction, t, u, v) && t < nearest)
+			{
+				nearest = t;
+				nearestTriangle = i;
+				nearestU = u;
+				nearestV = v;
+
+				if (anyHit)
+				{
+					stackSize = 0U;
+					break;
+				}
+			}
+		}
+	}
+
+	if (nearestTriangle == invalidTriangle)
+	{
+		return false;
+	}
+
+	hit.triangle = triangleIds[nearestTriangle];
+	hit.barycentrics = glm::vec3(1.0f - nearestU - nearestV, nearestU, nearestV);
+	hit.point = origin + direction * nearest;
+	hit.distance = nearest;
+
+	return true;
+}
+
+bool MeshBVH::Raycast(const glm::vec3& origin, const glm::vec3& direction, Hit& hit, float maxDistance) const
+{
+	return Trace(origin, direction, maxDistance, false, hit);
+}
+
+bool MeshBVH::Raycast(const Ray& ray, Hit& hit, float maxDistance) const
+{
+	return Trace(ray.GetOrigin(), ray.GetDirection(), maxDistance, false, hit);
+}
+
+bool MeshBVH::SegmentIntersect(const glm::vec3& start, const glm::vec3& end, Hit& hit) const
+{
+	const float length = glm::length(end - start);
+
+	if (length <= 0.0f)
+	{
+		return false;
+	}
+
+	return Trace(start, (end - start) / length, length, false, hit);
+}
+
+bool MeshBVH::SegmentOccluded(const glm::vec3& start, const glm::vec3& end) const
+{
+	const float length = glm::length(end - start);
+
+	if (length <= 0.0f)
+	{
+		return false;
+	}
+
+	Hit hit;
+	return Trace(start, (end - start) / length, length, true, hit);
+}
+
+unsigned int MeshBVH::SphereQuery(const glm::vec3& center, float radius, std::vector<unsigned int>& found) const
+{
+	if (nodes.empty())
+	{
+		return 0U;
+	}
+
+	const float radiusSq = radius * radius;
+	const size_t initialSize = found.size();
+
+	unsigned int stack[maxDepth * 2U];
+	unsigned int stackSize = 0U;
+	stack[stackSize++] = 0U;
+
+	while (stackSize > 0U)
+	{
+		const unsigned int index = stack[--stackSize];
+		const Node& node = nodes[index];
+
+		if (BoxDistanceSq(node.min, node.max, center) > radiusSq)
+		{
+			continue;
+		}
+
+		if (node.count == 0U)
+		{
+			stack[stackSize++] = node.offset;
+			stack[stackSize++] = index + 1U;
+			continue;
+		}
+
+		for (unsigned int i = node.offset; i < node.offset + node.count; i++)
+		{
+			const PackedTriangle& triangle = triangles[i];
+
+			glm::vec3 barycentrics;
+			const glm::vec3 closest = ClosestPointOnTriangle(center, triangle.point0, triangle.point0 + triangle.edge1, triangle.point0 + triangle.edge2, barycentrics);
+			const glm::vec3 toClosest = closest - center;
+
+			if (glm::dot(toClosest, toClosest) <= radiusSq)
+			{
+				found.push_back(triangleIds[i]);
+			}
+		}
+	}
+
+	return static_cast<unsigned int>(found.size() - initialSize);
+}
+
+bool MeshBVH::ClosestPoint(const glm::vec3& point, Hit& hit, float maxDistance) const
+{
+	if (nodes.empty())
+	{
+		return false;
+	}
+
+	float nearestSq = (maxDistance < FLT_MAX) ? maxDistance * maxDistance : FLT_MAX;
+	unsigned int nearestTriangle = invalidTriangle;
+	glm::vec3 nearestPoint(0.0f);
+	glm::vec3 nearestBarycentrics(0.0f);
+
+	struct Entry
+	{
+		unsigned int node;
+
+		float distanceSq;
+	};
+
+	Entry stack[maxDepth * 2U];
+	unsigned int stackSize = 0U;
+	stack[stackSize++] = { 0U, BoxDistanceSq(nodes[0].min, nodes[0].max, point) };
+
+	while (stackSize > 0U)
+	{
+		const Entry entry = stack[--stackSize];
+
+		if (entry.distanceSq > nearestSq)
+		{
+			continue;
+		}
+
+		const Node& node = nodes[entry.node];
+
+		if (node.count == 0U)
+		{
+			// The nearer child goes on top so it is searched first and shrinks nearestSq for the other.
+			const unsigned int left = entry.node + 1U;
+			const unsigned int right = node.offset;
+
+			const Entry leftEntry = { left, BoxDistanceSq(nodes[left].min, nodes[left].max, point) };
+			const Entry rightEntry = { right, BoxDistanceSq(nodes[right].min, nodes[right].max, point) };
+
+			if (leftEntry.distanceSq < rightEntry.distanceSq)
+			{
+				stack[stackSize++] = rightEntry;
+				stack[stackSize++] = leftEntry;
+			}
+			else
+			{
+				stack[stackSize++] = leftEntry;
+				stack[stackSize++] = rightEntry;
+			}
+
+			continue;
+		}
+
+		for (unsigned int i = node.offset; i < node.offset + node.count; i++)
+		{
+			const PackedTriangle& triangle = triangles[i];
+
+			glm::vec3 barycentrics;
+			const glm::vec3 closest = ClosestPointOnTriangle(point, triangle.point0, triangle.point0 + triangle.edge1, triangle.point0 + triangle.edge2, barycentrics);
+			const glm::vec3 toClosest = closest - point;
+			const float distanceSq = glm::dot(toClosest, toClosest);
+
+			if (distanceSq <= nearestSq)
+			{
+				nearestSq = distanceSq;
+				nearestTriangle = i;
+				nearestPoint = closest;
+				nearestBarycentrics = barycentrics;
+			}
+		}
+	}
+
+	if (nearestTriangle == invalidTriangle)
+	{
+		return false;
+	}
+
+	hit.triangle = triangleIds[nearestTriangle];
+	hit.barycentrics = nearestBarycentrics;
+	hit.point = nearestPoint;
+	hit.distance = std::sqrt(nearestSq);
+
+	return true;
+}
+
+template<typename L>
+void MeshBVH::RaycastPacket(const glm::vec3* origins, const glm::vec3* directions, Hit* hits, float maxDistance) const
+{
+	const unsigned int width = L::width;
+
+	float originValues[3][width];
+	float inverseDirectionValues[3][width];
+	float nearest[width];
+	float activeValues[width];
+
+	for (unsigned int lane = 0; lane < width; lane++)
+	{
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			originValues[axis][lane] = origins[lane][axis];
+			inverseDirectionValues[axis][lane] = 1.0f / directions[lane][axis];
+		}
+
+		nearest[lane] = maxDistance;
+		hits[lane] = Hit();
+	}
+
+	L origin[3];
+	L inverseDirection[3];
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		origin[axis] = L::Load(originValues[axis]);
+		inverseDirection[axis] = L::Load(inverseDirectionValues[axis]);
+	}
+
+	const L zero = L::Set(0.0f);
+	const L one = L::Set(1.0f);
+
+	unsigned int stack[maxDepth * 2U];
+	unsigned int stackSize = 0U;
+	stack[stackSize++] = 0U;
+
+	while (stackSize > 0U)
+	{
+		const unsigned int index = stack[--stackSize];
+		const Node& node = nodes[index];
+
+		// The slab test for every ray at once against what each has hit so far.
+		L enter = zero;
+		L exit = L::Load(nearest);
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			const L t0 = (L::Set(node.min[axis]) - origin[axis]) * inverseDirection[axis];
+			const L t1 = (L::Set(node.max[axis]) - origin[axis]) * inverseDirection[axis];
+
+			enter = Max(enter, Min(t0, t1));
+			exit = Min(exit, Max(t0, t1));
+		}
+
+		IfLess(exit, enter, zero, one).Store(activeValues);
+
+		bool anyActive = false;
+		for (unsigned int lane = 0; lane < width; lane++)
+		{
+			anyActive = anyActive || activeValues[lane] != 0.0f;
+		}
+
+		if (!anyActive)
+		{
+			continue;
+		}
+
+		if (node.count == 0U)
+		{
+			// Rays of a packet go roughly the same way, so the first one orders the children for all of them.
+			const unsigned int left = index + 1U;
+			const unsigned int right = node.offset;
+
+			const glm::vec3 leftToRight = (nodes[right].min + nodes[right].max) - (nodes[left].min + nodes[left].max);
+
+			if (glm::dot(leftToRight, directions[0]) >= 0.0f)
+			{
+				stack[stackSize++] = right;
+				stack[stackSize++] = left;
+			}
+			else
+			{
+				stack[stackSize++] = left;
+				stack[stackSize++] = right;
+			}
+
+			continue;
+		}
+
+		for (unsigned int lane = 0; lane < width; lane++)
+		{
+			if (activeValues[lane] == 0.0f)
+			{
+				continue;
+			}
+
+			const glm::vec3& rayOrigin = origins[lane];
+			const glm::vec3& rayDirection = directions[lane];
+
+			for (unsigned int i = node.offset; i < node.offset + node.count; i++)
+			{
+				const PackedTriangle& triangle = triangles[i];
+
+				float t;
+				float u;
+				float v;
+
+				if (IntersectTriangle(triangle.point0, triangle.edge1, triangle.edge2, rayOrigin, rayDirection, t, u, v) && t < nearest[lane])
+				{
+					nearest[lane] = t;
+
+					hits[lane].triangle = triangleIds[i];
+					hits[lane].barycentrics = glm::vec3(1.0f - u - v, u, v);
+					hits[lane].point = rayOrigin + rayDirection * t;
+					hits[lane].distance = t;
+				}
+			}
+		}
+	}
+}
+
+unsigned int MeshBVH::Raycast(const glm::vec3* origins, const glm::vec3* directions, unsigned int count, Hit* hits, float maxDistance) const
+{
+	ForEachLane(count, [&](auto lane, unsigned int i)
+	{
+		typedef decltype(lane) L;
+
+		if constexpr (L::width == 1)
+		{
+			hits[i] = Hit();
+			Trace(origins[i], directions[i], maxDistance, false, hits[i]);
+		}
+		else
+		{
+			RaycastPacket<WideLane>(origins + i, directions + i, hits + i, maxDistance);
+		}
+	});
+
+	unsigned int hitCount = 0U;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		hitCount += (hits[i].triangle != invalidTriangle) ? 1U : 0U;
+	}
+
+	return hitCount;
+}
+
+unsigned int MeshBVH::GetTriangleCount() const
+{
+	return static_cast<unsigned int>(triangles.size());
+}
+
+unsigned int MeshBVH::GetNodeCount() const
+{
+	return static_cast<unsigned int>(nodes.size());
+}
+
+size_t MeshBVH::GetSizeInBytes() const
+{
+	return nodes.size() * sizeof(Node) + triangles.size() * sizeof(PackedTriangle) + triangleIds.size() * sizeof(unsigned int);
+}
+
+glm::vec3 MeshBVH::GetMin() const
+{
+	return nodes.empty() ? glm::vec3(0.0f) : nodes[0].min;
+}
+
+glm::vec3 MeshBVH::GetMax() const
+{
+	return nodes.empty() ? glm::vec3(0.0f) : nodes[0].max;
+}
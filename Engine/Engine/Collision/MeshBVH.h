@@ -0,0 +1,139 @@
+#ifndef MESHBVH_H
+#define MESHBVH_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cfloat>
+
+class Vertex;
+class Ray;
+
+// A static bounding volume hierarchy over the triangles of a mesh, for ray, segment, sphere and closest point queries
+// against real geometry. Built once with binned surface area splits into a flat array of 32 byte nodes, each inner node's
+// first child right after it, and leaves pointing into the triangles stored in the same order.
+// Queries are in the space of the vertices it was built from and are safe to run from several threads at once.
+class MeshBVH
+{
+public:
+
+	static const unsigned int invalidTriangle = 0xFFFFFFFF;
+
+	struct Hit
+	{
+		// The triangle's position in the index list divided by three.
+		unsigned int triangle = invalidTriangle;
+
+		// The weights of the triangle's three vertices at point.
+		glm::vec3 barycentrics = glm::vec3(0.0f);
+
+		glm::vec3 point = glm::vec3(0.0f);
+
+		// Along the ray for ray and segment queries, from the query point for closest point queries.
+		float distance = 0.0f;
+	};
+
+	MeshBVH();
+
+	MeshBVH(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+	~MeshBVH();
+
+	MeshBVH(const MeshBVH&) = delete;
+
+	MeshBVH& operator=(const MeshBVH&) = delete;
+
+	MeshBVH(MeshBVH&&) = delete;
+
+	MeshBVH& operator=(MeshBVH&&) = delete;
+
+	// Replaces the tree with one over the triangles of indices.
+	void Build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+	// The nearest triangle along direction, which must be normalized, no further than maxDistance.
+	bool Raycast(const glm::vec3& origin, const glm::vec3& direction, Hit& hit, float maxDistance = FLT_MAX) const;
+
+	bool Raycast(const Ray& ray, Hit& hit, float maxDistance = FLT_MAX) const;
+
+	// The triangle nearest start between start and end.
+	bool SegmentIntersect(const glm::vec3& start, const glm::vec3& end, Hit& hit) const;
+
+	// Whether any triangle lies between start and end. Stops at the first one found, for line of sight checks.
+	bool SegmentOccluded(const glm::vec3& start, const glm::vec3& end) const;
+
+	// Appends every triangle touching the sphere to triangles and returns how many were appended.
+	unsigned int SphereQuery(const glm::vec3& center, float radius, std::vector<unsigned int>& triangles) const;
+
+	// The point on the mesh nearest point, if one is within maxDistance.
+	bool ClosestPoint(const glm::vec3& point, Hit& hit, float maxDistance = FLT_MAX) const;
+
+	// Raycast for count rays. Rays are traced in packets that share their node visits, which pays off when they are
+	// coherent like picking around a cursor or line of sight from one eye. hits[i] is left with an invalid triangle when
+	// ray i misses. Returns how many rays hit.
+	unsigned int Raycast(const glm::vec3* origins, const glm::vec3* directions, unsigned int count, Hit* hits, float maxDistance = FLT_MAX) const;
+
+	unsigned int GetTriangleCount() const;
+
+	unsigned int GetNodeCount() const;
+
+	size_t GetSizeInBytes() const;
+
+	// The box around every triangle, empty at the origin for meshes without any.
+	glm::vec3 GetMin() const;
+
+	glm::vec3 GetMax() const;
+
+private:
+
+	struct Node
+	{
+		glm::vec3 min;
+
+		// The first triangle of a leaf or the second child of an inner node.
+		unsigned int offset;
+
+		glm::vec3 max;
+
+		// Zero for inner nodes.
+		unsigned int count;
+	};
+
+	// The form Moller-Trumbore wants.
+	struct PackedTriangle
+	{
+		glm::vec3 point0;
+
+		glm::vec3 edge1;
+
+		glm::vec3 edge2;
+	};
+
+	struct BuildTriangle
+	{
+		glm::vec3 min;
+
+		glm::vec3 max;
+
+		glm::vec3 centroid;
+
+		unsigned int id;
+	};
+
+	void Subdivide(std::vector<BuildTriangle>& buildTriangles, unsigned int first, unsigned int count, unsigned int depth);
+
+	// The nearest hit within maxDistance, or with anyHit the first one found.
+	bool Trace(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, bool anyHit, Hit& hit) const;
+
+	template<typename L>
+	void RaycastPacket(const glm::vec3* origins, const glm::vec3* directions, Hit* hits, float maxDistance) const;
+
+	std::vector<Node> nodes;
+
+	std::vector<PackedTriangle> triangles;
+
+	// The original triangle of each packed one.
+	std::vector<unsigned int> triangleIds;
+
+};
+
+#endif // MESHBVH_H
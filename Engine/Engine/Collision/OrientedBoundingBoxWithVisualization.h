@@ -3,8 +3,9 @@
 
 #include "../Math/Shapes/OrientedBoundingBox.h"
 
-class ColoredStaticGraphicsObject;
+class ShapeVisualization;
 
+// An oriented box that draws itself. The box is updated from the transform and the drawing follows it, never the other way.
 class OrientedBoundingBoxWithVisualization : public OrientedBoundingBox
 {
 public:
@@ -15,6 +16,7 @@ public:
 
 	~OrientedBoundingBoxWithVisualization();
 
+	// Transforms the box and then the drawing to match.
 	void Update(const glm::mat4& transform);
 
 	void ToggleVisibility();
@@ -23,9 +25,7 @@ public:
 
 private:
 
-	void CreateGraphics();
-
-	ColoredStaticGraphicsObject* graphics;
+	ShapeVisualization* visualization;
 
 };
 
@@ -0,0 +1,96 @@
+#include "ShapeVisualization.h"
+
+#include "../Math/Shapes/OrientedBoundingBox.h"
+#include "../Math/Shapes/Sphere.h"
+#include "../Renderer/DebugDraw/DebugDraw.h"
+
+ShapeVisualization::ShapeVisualization(const OrientedBoundingBox& box, const glm::vec4& initialColor) :
+	obb(&box),
+	sphere(nullptr),
+	center(0.0f),
+	axes(1.0f),
+	halfSize(0.0f),
+	color(initialColor),
+	visible(true),
+	draw(nullptr)
+{
+	Update();
+
+	draw = new std::function<void()>([this]()
+		{
+			std::lock_guard<std::mutex> guard(stateMutex);
+
+			if (visible)
+			{
+				DebugDraw::Box(center, axes, halfSize, color);
+			}
+		});
+
+	DebugDraw::AddSource(draw);
+}
+
+ShapeVisualization::ShapeVisualization(const Sphere& s, const glm::vec4& initialColor) :
+	obb(nullptr),
+	sphere(&s),
+	center(0.0f),
+	axes(1.0f),
+	halfSize(0.0f),
+	color(initialColor),
+	visible(true),
+	draw(nullptr)
+{
+	Update();
+
+	draw = new std::function<void()>([this]()
+		{
+			std::lock_guard<std::mutex> guard(stateMutex);
+
+			if (visible)
+			{
+				DebugDraw::Sphere(center, halfSize.x, color);
+			}
+		});
+
+	DebugDraw::AddSource(draw);
+}
+
+ShapeVisualization::~ShapeVisualization()
+{
+	DebugDraw::RemoveSource(draw);
+	delete draw;
+}
+
+void ShapeVisualization::Update()
+{
+	std::lock_guard<std::mutex> guard(stateMutex);
+
+	if (obb != nullptr)
+	{
+		center = obb->GetOrigin();
+		axes = obb->GetAxes();
+		halfSize = obb->GetSize();
+	}
+	else
+	{
+		center = sphere->GetOrigin();
+		halfSize = glm::vec3(sphere->GetRadius());
+	}
+}
+
+void ShapeVisualization::ToggleVisibility()
+{
+	std::lock_guard<std::mutex> guard(stateMutex);
+	visible = !visible;
+}
+
+void ShapeVisualization::SetColor(const glm::vec4& newColor)
+{
+	std::lock_guard<std::mutex> guard(stateMutex);
+	color = newColor;
+}
+
+bool ShapeVisualization::IsVisible() const
+{
+	std::lock_guard<std::mutex> guard(stateMutex);
+	return visible;
+}
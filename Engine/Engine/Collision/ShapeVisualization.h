@@ -0,0 +1,67 @@
+#ifndef SHAPEVISUALIZATION_H
+#define SHAPEVISUALIZATION_H
+
+#include <glm/glm.hpp>
+
+#include <functional>
+#include <mutex>
+
+class OrientedBoundingBox;
+class Sphere;
+
+// A wireframe debug view of a collision shape. It only reads the shape and has no graphics of its own. Update() copies
+// the shape's world state, which DebugDraw draws on the render thread every frame while the view is visible, so a shape
+// moved on the simulation step stays up between steps. Update(), ToggleVisibility() and SetColor() can be called from any
+// thread.
+class ShapeVisualization
+{
+public:
+
+	ShapeVisualization(const OrientedBoundingBox& obb, const glm::vec4& color = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+
+	ShapeVisualization(const Sphere& sphere, const glm::vec4& color = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+
+	~ShapeVisualization();
+
+	ShapeVisualization(const ShapeVisualization&) = delete;
+
+	ShapeVisualization& operator=(const ShapeVisualization&) = delete;
+
+	ShapeVisualization(ShapeVisualization&&) = delete;
+
+	ShapeVisualization& operator=(ShapeVisualization&&) = delete;
+
+	// Copies the shape as it is now for drawing. Called by the thread that moves the shape.
+	void Update();
+
+	void ToggleVisibility();
+
+	void SetColor(const glm::vec4& newColor);
+
+	bool IsVisible() const;
+
+private:
+
+	const OrientedBoundingBox* obb;
+
+	const Sphere* sphere;
+
+	// The copy that is drawn, a sphere's radius is halfSize.x.
+	glm::vec3 center;
+
+	glm::mat3 axes;
+
+	glm::vec3 halfSize;
+
+	glm::vec4 color;
+
+	bool visible;
+
+	mutable std::mutex stateMutex;
+
+	// The DebugDraw source drawing the copy.
+	std::function<void()>* draw;
+
+};
+
+#endif // SHAPEVISUALIZATION_H
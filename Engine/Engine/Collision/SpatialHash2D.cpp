@@ -0,0 +1,438 @@
+#include "SpatialHash2D.h"
+
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+namespace
+{
+	const int proxyInUse = -2;
+
+	bool Overlap(const glm::vec2& aMin, const glm::vec2& aMax, const glm::vec2& bMin, const glm::vec2& bMax)
+	{
+		return aMin.x <= bMax.x && aMax.x >= bMin.x &&
+			aMin.y <= bMax.y && aMax.y >= bMin.y;
+	}
+}
+
+SpatialHash2D::SpatialHash2D(float size) :
+	cells(std::unordered_map<uint64_t, std::vector<int>>()),
+	proxies(std::vector<Proxy>()),
+	largeProxies(std::vector<int>()),
+	freeList(nullProxy),
+	proxyCount(0U),
+	cellSize(size),
+	inverseCellSize(1.0f / size),
+	queryStamp(0U)
+{
+}
+
+SpatialHash2D::~SpatialHash2D()
+{
+}
+
+int SpatialHash2D::Insert(const glm::vec2& min, const glm::vec2& max, void* const userData)
+{
+	int proxy = freeList;
+
+	if (proxy == nullProxy)
+	{
+		proxy = static_cast<int>(proxies.size());
+		proxies.push_back(Proxy());
+	}
+	else
+	{
+		freeList = proxies[proxy].nextFree;
+	}
+
+	Proxy& newProxy = proxies[proxy];
+	newProxy.min = min;
+	newProxy.max = max;
+	newProxy.userData = userData;
+	newProxy.queryStamp = 0U;
+	newProxy.nextFree = proxyInUse;
+
+	AddToCells(proxy);
+	proxyCount++;
+
+	return proxy;
+}
+
+void SpatialHash2D::Remove(int proxy)
+{
+	if (proxy < 0 || proxy >= static_cast<int>(proxies.size()) || proxies[proxy].nextFree != proxyInUse)
+	{
+		Logger::Log(std::string("Calling SpatialHash2D::Remove() with a proxy that is not in the hash."), Logger::Category::Warning);
+		return;
+	}
+
+	RemoveFromCells(proxy);
+
+	proxies[proxy].userData = nullptr;
+	proxies[proxy].nextFree = freeList;
+	freeList = proxy;
+	proxyCount--;
+}
+
+bool SpatialHash2D::Move(int proxy, const glm::vec2& min, const glm::vec2& max)
+{
+	Proxy& moving = proxies[proxy];
+
+	const glm::ivec2 cellMin = CellOf(min);
+	const glm::ivec2 cellMax = CellOf(max);
+
+	const int64_t cellCount = static_cast<int64_t>(cellMax.x - cellMin.x + 1) * static_cast<int64_t>(cellMax.y - cellMin.y + 1);
+	const bool large = cellCount > maxCellsPerProxy;
+
+	moving.min = min;
+	moving.max = max;
+
+	if ((moving.large && large) || (!moving.large && !large && cellMin == moving.cellMin && cellMax == moving.cellMax))
+	{
+		return false;
+	}
+
+	RemoveFromCells(proxy);
+	AddToCells(proxy);
+
+	return true;
+}
+
+void* SpatialHash2D::GetUserData(int proxy) const
+{
+	return proxies[proxy].userData;
+}
+
+const glm::vec2& SpatialHash2D::GetMin(int proxy) const
+{
+	return proxies[proxy].min;
+}
+
+const glm::vec2& SpatialHash2D::GetMax(int proxy) const
+{
+	return proxies[proxy].max;
+}
+
+void SpatialHash2D::QueryPoint(const glm::vec2& point, const std::function<bool(int)>& callback) const
+{
+	const unsigned int stamp = NextQuery();
+
+	auto contains = [&point](const Proxy& proxy)
+	{
+		return point.x >= proxy.min.x && point.x <= proxy.max.x && point.y >= proxy.min.y && point.y <= proxy.max.y;
+	};
+
+	for (int proxy : largeProxies)
+	{
+		if (!Visit(proxy, stamp, contains, callback))
+		{
+			return;
+		}
+	}
+
+	const glm::ivec2 cell = CellOf(point);
+	const auto found = cells.find(Key(cell.x, cell.y));
+
+	if (found == cells.end())
+	{
+		return;
+	}
+
+	for (int proxy : found->second)
+	{
+		if (!Visit(proxy, stamp, contains, callback))
+		{
+			return;
+		}
+	}
+}
+
+void SpatialHash2D::Query(const glm::vec2& min, const glm::vec2& max, const std::function<bool(int)>& callback) const
+{
+	const unsigned int stamp = NextQuery();
+
+	auto overlaps = [&min, &max](const Proxy& proxy)
+	{
+		return Overlap(proxy.min, proxy.max, min, max);
+	};
+
+	for (int proxy : largeProxies)
+	{
+		if (!Visit(proxy, stamp, overlaps, callback))
+		{
+			return;
+		}
+	}
+
+	const glm::ivec2 cellMin = CellOf(min);
+	const glm::ivec2 cellMax = CellOf(max);
+
+	// A query box larger than the cells in use is cheaper to answer from the cells than cell by cell.
+	const uint64_t queryCells = static_cast<uint64_t>(cellMax.x - cellMin.x + 1) * static_cast<uint64_t>(cellMax.y - cellMin.y + 1);
+
+	if (queryCells > cells.size())
+	{
+		for (const auto& cell : cells)
+		{
+			for (int proxy : cell.second)
+			{
+				if (!Visit(proxy, stamp, overlaps, callback))
+				{
+					return;
+				}
+			}
+		}
+
+		return;
+	}
+
+	for (int y = cellMin.y; y <= cellMax.y; y++)
+	{
+		for (int x = cellMin.x; x <= cellMax.x; x++)
+		{
+			const auto found = cells.find(Key(x, y));
+
+			if (found == cells.end())
+			{
+				continue;
+			}
+
+			for (int proxy : found->second)
+			{
+				if (!Visit(proxy, stamp, overlaps, callback))
+				{
+					return;
+				}
+			}
+		}
+	}
+}
+
+void SpatialHash2D::QuerySegment(const glm::vec2& start, const glm::vec2& end, const std::function<bool(int)>& callback) const
+{
+	const unsigned int stamp = NextQuery();
+
+	const glm::vec2 direction = end - start;
+
+	// Slab test against the segment. An axis the segment does not move along is a test of where it starts instead, since
+	// dividing by its zero direction would give 0 * infinity when the start is on the box's edge.
+	auto hits = [&start, &direction](const Proxy& proxy)
+	{
+		float enter = 0.0f;
+		float exit = 1.0f;
+
+		for (unsigned int axis = 0; axis < 2; axis++)
+		{
+			if (direction[axis] == 0.0f)
+			{
+				if (start[axis] < proxy.min[axis] || start[axis] > proxy.max[axis])
+				{
+					return false;
+				}
+
+				continue;
+			}
+
+			const float t0 = (proxy.min[axis] - start[axis]) / direction[axis];
+			const float t1 = (proxy.max[axis] - start[axis]) / direction[axis];
+
+			enter = std::max(enter, std::min(t0, t1));
+			exit = std::min(exit, std::max(t0, t1));
+		}
+
+		return enter <= exit;
+	};
+
+	for (int proxy : largeProxies)
+	{
+		if (!Visit(proxy, stamp, hits, callback))
+		{
+			return;
+		}
+	}
+
+	// Walks the cells the segment passes through, stepping across whichever cell boundary it reaches first.
+	glm::ivec2 cell = CellOf(start);
+	const glm::ivec2 endCell = CellOf(end);
+
+	glm::ivec2 step;
+	glm::vec2 nextBoundary;
+	glm::vec2 boundaryStep;
+
+	for (unsigned int axis = 0; axis < 2; axis++)
+	{
+		if (direction[axis] > 0.0f)
+		{
+			step[axis] = 1;
+			nextBoundary[axis] = (static_cast<float>(cell[axis] + 1) * cellSize - start[axis]) / direction[axis];
+			boundaryStep[axis] = cellSize / direction[axis];
+		}
+		else if (direction[axis] < 0.0f)
+		{
+			step[axis] = -1;
+			nextBoundary[axis] = (static_cast<float>(cell[axis]) * cellSize - start[axis]) / direction[axis];
+			boundaryStep[axis] = -cellSize / direction[axis];
+		}
+		else
+		{
+			step[axis] = 0;
+			nextBoundary[axis] = FLT_MAX;
+			boundaryStep[axis] = FLT_MAX;
+		}
+	}
+
+	const int cellCount = std::abs(endCell.x - cell.x) + std::abs(endCell.y - cell.y) + 1;
+
+	for (int visited = 0; visited < cellCount; visited++)
+	{
+		const auto found = cells.find(Key(cell.x, cell.y));
+
+		if (found != cells.end())
+		{
+			for (int proxy : found->second)
+			{
+				if (!Visit(proxy, stamp, hits, callback))
+				{
+					return;
+				}
+			}
+		}
+
+		if (cell == endCell)
+		{
+			return;
+		}
+
+		const unsigned int axis = (nextBoundary.x < nextBoundary.y) ? 0 : 1;
+		cell[axis] += step[axis];
+		nextBoundary[axis] += boundaryStep[axis];
+	}
+}
+
+unsigned int SpatialHash2D::GetProxyCount() const
+{
+	return proxyCount;
+}
+
+unsigned int SpatialHash2D::GetCellCount() const
+{
+	return static_cast<unsigned int>(cells.size());
+}
+
+float SpatialHash2D::GetCellSize() const
+{
+	return cellSize;
+}
+
+glm::ivec2 SpatialHash2D::CellOf(const glm::vec2& point) const
+{
+	return glm::ivec2(static_cast<int>(std::floor(point.x * inverseCellSize)), static_cast<int>(std::floor(point.y * inverseCellSize)));
+}
+
+uint64_t SpatialHash2D::Key(int x, int y)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(y));
+}
+
+void SpatialHash2D::AddToCells(int proxy)
+{
+	Proxy& adding = proxies[proxy];
+
+	adding.cellMin = CellOf(adding.min);
+	adding.cellMax = CellOf(adding.max);
+
+	const int64_t cellCount = static_cast<int64_t>(adding.cellMax.x - adding.cellMin.x + 1) * static_cast<int64_t>(adding.cellMax.y - adding.cellMin.y + 1);
+	adding.large = cellCount > maxCellsPerProxy;
+
+	if (adding.large)
+	{
+		largeProxies.push_back(proxy);
+		return;
+	}
+
+	for (int y = adding.cellMin.y; y <= adding.cellMax.y; y++)
+	{
+		for (int x = adding.cellMin.x; x <= adding.cellMax.x; x++)
+		{
+			cells[Key(x, y)].push_back(proxy);
+		}
+	}
+}
+
+void SpatialHash2D::RemoveFromCells(int proxy)
+{
+	const Proxy& removing = proxies[proxy];
+
+	auto removeFrom = [proxy](std::vector<int>& list)
+	{
+		const auto found = std::find(list.begin(), list.end(), proxy);
+
+		if (found != list.end())
+		{
+			*found = list.back();
+			list.pop_back();
+		}
+	};
+
+	if (removing.large)
+	{
+		removeFrom(largeProxies);
+		return;
+	}
+
+	for (int y = removing.cellMin.y; y <= removing.cellMax.y; y++)
+	{
+		for (int x = removing.cellMin.x; x <= removing.cellMax.x; x++)
+		{
+			const auto found = cells.find(Key(x, y));
+
+			if (found == cells.end())
+			{
+				continue;
+			}
+
+			removeFrom(found->second);
+
+			// Cells are only kept while something is in them, so moving boxes do not leave a trail of empty ones.
+			if (found->second.empty())
+			{
+				cells.erase(found);
+			}
+		}
+	}
+}
+
+unsigned int SpatialHash2D::NextQuery() const
+{
+	queryStamp++;
+
+	// The stamps wrapped around, clear them so an old one cannot match.
+	if (queryStamp == 0U)
+	{
+		for (const Proxy& proxy : proxies)
+		{
+			proxy.queryStamp = 0U;
+		}
+
+		queryStamp = 1U;
+	}
+
+	return queryStamp;
+}
+
+template<typename Test>
+bool SpatialHash2D::Visit(int proxy, unsigned int stamp, const Test& test, const std::function<bool(int)>& callback) const
+{
+	const Proxy& visiting = proxies[proxy];
+
+	if (visiting.queryStamp == stamp)
+	{
+		return true;
+	}
+
+	visiting.queryStamp = stamp;
+
+	return !test(visiting) || callback(proxy);
+}
@@ -0,0 +1,123 @@
+#ifndef SPATIALHASH2D_H
+#define SPATIALHASH2D_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+// A uniform grid over 2D boxes, like UI items and sprites in window space, with only the cells in use stored in a hash map.
+// A point query looks at one cell and a box or segment query at the cells it covers, so with the cell size near the size
+// of a typical box they cost the same however many boxes there are. Boxes covering too many cells are kept in one list
+// every query checks instead, for backgrounds and other boxes the size of the window.
+// Queries mark what they have visited in the boxes, so they are not safe to run from several threads at once.
+class SpatialHash2D
+{
+public:
+
+	static const int nullProxy = -1;
+
+	SpatialHash2D(float cellSize = 64.0f);
+
+	~SpatialHash2D();
+
+	SpatialHash2D(const SpatialHash2D&) = delete;
+
+	SpatialHash2D& operator=(const SpatialHash2D&) = delete;
+
+	SpatialHash2D(SpatialHash2D&&) = delete;
+
+	SpatialHash2D& operator=(SpatialHash2D&&) = delete;
+
+	// Returns the proxy for the box, valid until it is removed.
+	int Insert(const glm::vec2& min, const glm::vec2& max, void* const userData);
+
+	void Remove(int proxy);
+
+	// Updates the box of proxy. Returns true when it moved to other cells, which is the only time the cells are touched.
+	bool Move(int proxy, const glm::vec2& min, const glm::vec2& max);
+
+	void* GetUserData(int proxy) const;
+
+	const glm::vec2& GetMin(int proxy) const;
+
+	const glm::vec2& GetMax(int proxy) const;
+
+	// Calls callback with every proxy whose box holds point, stopping if it returns false.
+	void QueryPoint(const glm::vec2& point, const std::function<bool(int)>& callback) const;
+
+	// Every proxy whose box overlaps min and max.
+	void Query(const glm::vec2& min, const glm::vec2& max, const std::function<bool(int)>& callback) const;
+
+	// Every proxy whose box the segment from start to end touches. Only the cells the segment passes through are visited.
+	void QuerySegment(const glm::vec2& start, const glm::vec2& end, const std::function<bool(int)>& callback) const;
+
+	unsigned int GetProxyCount() const;
+
+	unsigned int GetCellCount() const;
+
+	float GetCellSize() const;
+
+private:
+
+	// A box covering more cells than this goes in the list of large proxies.
+	static const int maxCellsPerProxy = 64;
+
+	struct Proxy
+	{
+		glm::vec2 min;
+
+		glm::vec2 max;
+
+		void* userData;
+
+		// The range of cells the proxy is in, empty for large proxies.
+		glm::ivec2 cellMin;
+
+		glm::ivec2 cellMax;
+
+		bool large;
+
+		// The last query that visited the proxy, so one in several cells is reported once.
+		mutable unsigned int queryStamp;
+
+		// The next free proxy while on the free list, -2 while in use.
+		int nextFree;
+	};
+
+	glm::ivec2 CellOf(const glm::vec2& point) const;
+
+	static uint64_t Key(int x, int y);
+
+	void AddToCells(int proxy);
+
+	void RemoveFromCells(int proxy);
+
+	// Starts a query, returns the stamp it marks proxies with.
+	unsigned int NextQuery() const;
+
+	// Reports proxy to callback if this query has not yet and it passes test. Returns false to stop the query.
+	template<typename Test>
+	bool Visit(int proxy, unsigned int stamp, const Test& test, const std::function<bool(int)>& callback) const;
+
+	std::unordered_map<uint64_t, std::vector<int>> cells;
+
+	std::vector<Proxy> proxies;
+
+	std::vector<int> largeProxies;
+
+	int freeList;
+
+	unsigned int proxyCount;
+
+	float cellSize;
+
+	float inverseCellSize;
+
+	mutable unsigned int queryStamp;
+
+};
+
+#endif // SPATIALHASH2D_H
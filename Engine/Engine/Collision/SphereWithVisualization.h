@@ -4,8 +4,10 @@
 #include "../Math/Shapes/Sphere.h"
 
 class GraphicsObject;
-class ColoredStaticGraphicsObject;
+class ShapeVisualization;
 
+// A sphere around a graphics object's model that draws itself. Like OrientedBoundingBoxWithVisualization the drawing
+// only follows the sphere.
 class SphereWithVisualization : public Sphere
 {
 public:
@@ -16,6 +18,8 @@ public:
 
 	void Update(const glm::mat4& transform);
 
+	void ToggleVisibility();
+
 private:
 
 	SphereWithVisualization() = delete;
@@ -30,7 +34,7 @@ private:
 
 	GraphicsObject* wrapedGraphics;
 
-	ColoredStaticGraphicsObject* graphics;
+	ShapeVisualization* visualization;
 
 };
 
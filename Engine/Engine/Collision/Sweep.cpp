@@ -0,0 +1,448 @@
+#include "Sweep.h"
+
+#include "GJK.h"
+#include "ConvexShape.h"
+#include "../Math/Shapes/Sphere.h"
+#include "../Math/Shapes/AxisAlignedBoundingBox.h"
+#include "../Math/Shapes/OrientedBoundingBox.h"
+#include "../Math/Shapes/Triangle.h"
+
+#include <cfloat>
+#include <algorithm>
+
+namespace
+{
+	const unsigned int maxAdvancements = 32;
+
+	// The first time in [0, 1] that origin + motion * t is within radius of center.
+	bool SweepPoint(const glm::vec3& origin, const glm::vec3& motion, const glm::vec3& center, float radius, float& time)
+	{
+		const glm::vec3 offset = origin - center;
+
+		const float a = glm::dot(motion, motion);
+		const float b = glm::dot(offset, motion);
+		const float c = glm::dot(offset, offset) - radius * radius;
+
+		if (c <= 0.0f)
+		{
+			time = 0.0f;
+			return true;
+		}
+
+		if (b >= 0.0f || a <= FLT_MIN)
+		{
+			return false;
+		}
+
+		const float discriminant = b * b - a * c;
+
+		if (discriminant < 0.0f)
+		{
+			return false;
+		}
+
+		time = (-b - sqrtf(discriminant)) / a;
+		return time <= 1.0f;
+	}
+
+	// Against the capsule of radius around the segment from start to end, the side first and the caps where it misses.
+	bool SweepSegment(const glm::vec3& origin, const glm::vec3& motion, const glm::vec3& start, const glm::vec3& end, float radius, float& time)
+	{
+		const glm::vec3 segment = end - start;
+		const glm::vec3 offset = origin - start;
+
+		const float segmentLengthSquared = glm::dot(segment, segment);
+		const float offsetAlong = glm::dot(offset, segment);
+		const float motionAlong = glm::dot(motion, segment);
+
+		const float a = segmentLengthSquared * glm::dot(motion, motion) - motionAlong * motionAlong;
+		const float c = segmentLengthSquared * (glm::dot(offset, offset) - radius * radius) - offsetAlong * offsetAlong;
+
+		// Parallel to the segment, or not moving, and only a cap can be hit.
+		if (a > FLT_EPSILON * segmentLengthSquared * glm::dot(motion, motion) && segmentLengthSquared > FLT_MIN)
+		{
+			const float b = segmentLengthSquared * glm::dot(offset, motion) - motionAlong * offsetAlong;
+			const float discriminant = b * b - a * c;
+
+			if (discriminant >= 0.0f)
+			{
+				const float sideTime = (c <= 0.0f) ? 0.0f : (-b - sqrtf(discriminant)) / a;
+				const float along = (offsetAlong + sideTime * motionAlong) / segmentLengthSquared;
+
+				if (sideTime >= 0.0f && sideTime <= 1.0f && along >= 0.0f && along <= 1.0f)
+				{
+					time = sideTime;
+					return true;
+				}
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		float startTime = FLT_MAX;
+		float endTime = FLT_MAX;
+
+		const bool hitsStart = SweepPoint(origin, motion, start, radius, startTime);
+		const bool hitsEnd = SweepPoint(origin, motion, end, radius, endTime);
+
+		if (!hitsStart && !hitsEnd)
+		{
+			return false;
+		}
+
+		time = std::min(hitsStart ? startTime : FLT_MAX, hitsEnd ? endTime : FLT_MAX);
+		return true;
+	}
+
+	glm::vec3 ClosestOnSegment(const glm::vec3& point, const glm::vec3& start, const glm::vec3& end)
+	{
+		const glm::vec3 segment = end - start;
+		const float lengthSquared = glm::dot(segment, segment);
+
+		if (lengthSquared <= FLT_MIN)
+		{
+			return start;
+		}
+
+		return start + segment * glm::clamp(glm::dot(point - start, segment) / lengthSquared, 0.0f, 1.0f);
+	}
+
+	// The hit normal from the point touched toward the sphere's center, or fallback when the center is on the surface.
+	glm::vec3 NormalToward(const glm::vec3& center, const glm::vec3& point, const glm::vec3& fallback)
+	{
+		const glm::vec3 difference = center - point;
+		const float length = glm::length(difference);
+
+		return (length > FLT_MIN) ? difference / length : fallback;
+	}
+
+	// A sphere against a box centered on the origin along the axes, in the box's space. The box grown by radius is hit
+	// first, and where that lands on one of its edges or corners, which are rounded on the real swept shape, the capsules
+	// around the box's edges there decide.
+	bool SweepBox(const glm::vec3& center, const glm::vec3& motion, float radius, const glm::vec3& halfSize, Sweep::Hit& hit)
+	{
+		const glm::vec3 closest = glm::clamp(center, -halfSize, halfSize);
+
+		if (glm::dot(center - closest, center - closest) <= radius * radius)
+		{
+			glm::vec3 fallback(0.0f);
+
+			// A center inside the box leaves through the nearest face.
+			unsigned int nearest = 0;
+
+			for (unsigned int axis = 1; axis < 3; axis++)
+			{
+				if (halfSize[axis] - fabsf(center[axis]) < halfSize[nearest] - fabsf(center[nearest]))
+				{
+					nearest = axis;
+				}
+			}
+
+			fallback[nearest] = (center[nearest] < 0.0f) ? -1.0f : 1.0f;
+
+			hit.time = 0.0f;
+			hit.point = closest;
+			hit.normal = NormalToward(center, closest, fallback);
+			return true;
+		}
+
+		float enter = 0.0f;
+		float exit = 1.0f;
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			const float extent = halfSize[axis] + radius;
+
+			if (fabsf(motion[axis]) <= FLT_MIN)
+			{
+				if (fabsf(center[axis]) > extent)
+				{
+					return false;
+				}
+
+				continue;
+			}
+
+			float near = (-extent - center[axis]) / motion[axis];
+			float far = (extent - center[axis]) / motion[axis];
+
+			if (near > far)
+			{
+				std::swap(near, far);
+			}
+
+			enter = std::max(enter, near);
+			exit = std::min(exit, far);
+
+			if (enter > exit)
+			{
+				return false;
+			}
+		}
+
+		const glm::vec3 entry = center + motion * enter;
+
+		unsigned int outsideCount = 0;
+		unsigned int insideAxis = 0;
+		glm::vec3 corner;
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			corner[axis] = (entry[axis] < 0.0f) ? -halfSize[axis] : halfSize[axis];
+
+			if (fabsf(entry[axis]) > halfSize[axis])
+			{
+				outsideCount++;
+			}
+			else
+			{
+				insideAxis = axis;
+			}
+		}
+
+		float time = enter;
+
+		if (outsideCount == 2)
+		{
+			glm::vec3 start = corner;
+			glm::vec3 end = corner;
+			start[insideAxis] = -halfSize[insideAxis];
+			end[insideAxis] = halfSize[insideAxis];
+
+			if (!SweepSegment(center, motion, start, end, radius, time))
+			{
+				return false;
+			}
+		}
+		else if (outsideCount == 3)
+		{
+			bool found = false;
+			time = FLT_MAX;
+
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				glm::vec3 end = corner;
+				end[axis] = -corner[axis];
+
+				float edgeTime;
+
+				if (SweepSegment(center, motion, corner, end, radius, edgeTime) && edgeTime < time)
+				{
+					time = edgeTime;
+					found = true;
+				}
+			}
+
+			if (!found)
+			{
+				return false;
+			}
+		}
+
+		const glm::vec3 touching = center + motion * time;
+
+		hit.time = time;
+		hit.point = glm::clamp(touching, -halfSize, halfSize);
+		hit.normal = NormalToward(touching, hit.point, -glm::normalize(motion));
+		return true;
+	}
+
+	bool InsideTriangle(const glm::vec3& point, const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& normal)
+	{
+		return glm::dot(glm::cross(p1 - p0, point - p0), normal) >= 0.0f &&
+			glm::dot(glm::cross(p2 - p1, point - p1), normal) >= 0.0f &&
+			glm::dot(glm::cross(p0 - p2, point - p2), normal) >= 0.0f;
+	}
+}
+
+bool Sweep::SphereTriangle(const Sphere& sphere, const glm::vec3& motion, const Triangle& triangle, Hit& hit)
+{
+	const glm::vec3& center = sphere.GetOrigin();
+	const float radius = sphere.GetRadius();
+
+	const glm::vec3& p0 = triangle.GetPoint0();
+	const glm::vec3& p1 = triangle.GetPoint1();
+	const glm::vec3& p2 = triangle.GetPoint2();
+
+	glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+	const float normalLength = glm::length(normal);
+
+	// The face first, the sphere touching the triangle's plane inside the triangle.
+	if (normalLength > FLT_MIN)
+	{
+		normal /= normalLength;
+
+		// The winding test needs the normal the points wind around, whichever side the sphere is on.
+		const glm::vec3 faceNormal = normal;
+
+		float distance = glm::dot(center - p0, normal);
+
+		if (distance < 0.0f)
+		{
+			normal = -normal;
+			distance = -distance;
+		}
+
+		const float approach = -glm::dot(motion, normal);
+
+		float planeTime = 0.0f;
+
+		if (distance > radius)
+		{
+			// Never reaching the plane means never reaching the edges in it either.
+			if (approach <= 0.0f || distance - radius > approach)
+			{
+				return false;
+			}
+
+			planeTime = (distance - radius) / approach;
+		}
+
+		const glm::vec3 touching = center + motion * planeTime;
+		const glm::vec3 onPlane = touching - normal * glm::dot(touching - p0, normal);
+
+		if (InsideTriangle(onPlane, p0, p1, p2, faceNormal))
+		{
+			hit.time = planeTime;
+			hit.point = onPlane;
+			hit.normal = normal;
+			return true;
+		}
+	}
+
+	// Then the edges and corners, as the capsules around the edges.
+	const glm::vec3* const edges[3][2] = { { &p0, &p1 }, { &p1, &p2 }, { &p2, &p0 } };
+
+	bool found = false;
+	float time = FLT_MAX;
+	unsigned int edgeHit = 0;
+
+	for (unsigned int edge = 0; edge < 3; edge++)
+	{
+		float edgeTime;
+
+		if (SweepSegment(center, motion, *edges[edge][0], *edges[edge][1], radius, edgeTime) && edgeTime < time)
+		{
+			time = edgeTime;
+			edgeHit = edge;
+			found = true;
+		}
+	}
+
+	if (!found)
+	{
+		return false;
+	}
+
+	const glm::vec3 touching = center + motion * time;
+
+	hit.time = time;
+	hit.point = ClosestOnSegment(touching, *edges[edgeHit][0], *edges[edgeHit][1]);
+	hit.normal = NormalToward(touching, hit.point, normal);
+	return true;
+}
+
+bool Sweep::SphereAxisAlignedBoundingBox(const Sphere& sphere, const glm::vec3& motion, const AxisAlignedBoundingBox& aabb, Hit& hit)
+{
+	const glm::vec3 halfSize = (aabb.GetMax() - aabb.GetMin()) * 0.5f;
+	const glm::vec3 boxCenter = (aabb.GetMax() + aabb.GetMin()) * 0.5f;
+
+	if (!SweepBox(sphere.GetOrigin() - boxCenter, motion, sphere.GetRadius(), halfSize, hit))
+	{
+		return false;
+	}
+
+	hit.point += boxCenter;
+	return true;
+}
+
+bool Sweep::SphereOrientedBoundingBox(const Sphere& sphere, const glm::vec3& motion, const OrientedBoundingBox& obb, Hit& hit)
+{
+	const glm::mat3& axes = obb.GetAxes();
+	const glm::mat3 toLocal = glm::transpose(axes);
+
+	if (!SweepBox(toLocal * (sphere.GetOrigin() - obb.GetOrigin()), toLocal * motion, sphere.GetRadius(), obb.GetSize(), hit))
+	{
+		return false;
+	}
+
+	hit.point = obb.GetOrigin() + axes * hit.point;
+	hit.normal = axes * hit.normal;
+	return true;
+}
+
+bool Sweep::TimeOfImpact(const ConvexShape& a, const glm::vec3& motionA, const ConvexShape& b, const glm::vec3& motionB, Hit& hit, float tolerance)
+{
+	const glm::vec3 relativeMotion = motionA - motionB;
+
+	ConvexShape movedA = a;
+	ConvexShape movedB = b;
+
+	GJK::Cache cache;
+
+	glm::vec3 normal(0.0f);
+	float time = 0.0f;
+
+	for (unsigned int advancement = 0; advancement < maxAdvancements; advancement++)
+	{
+		movedA.SetTranslation(a.GetTranslation() + motionA * time);
+		movedB.SetTranslation(b.GetTranslation() + motionB * time);
+
+		glm::vec3 closestA;
+		glm::vec3 closestB;
+		const float distance = GJK::Distance(movedA, movedB, closestA, closestB, &cache);
+
+		if (distance <= tolerance)
+		{
+			// Overlapping from the start, the normal of least penetration stands in for the direction of approach.
+			if (distance <= 0.0f && time == 0.0f)
+			{
+				GJK::Manifold manifold;
+				GJK::Penetration(movedA, movedB, manifold, &cache);
+				normal = manifold.normal;
+				closestB = manifold.points[0].pointB;
+			}
+			else if (distance > 0.0f)
+			{
+				normal = (closestB - closestA) / distance;
+			}
+
+			hit.time = time;
+			hit.point = closestB;
+			hit.normal = -normal;
+			return true;
+		}
+
+		normal = (closestB - closestA) / distance;
+
+		// Every point of b - a is at least distance along normal, so they cannot touch before closing that much along it.
+		const float closing = glm::dot(relativeMotion, normal);
+
+		if (closing <= 0.0f)
+		{
+			return false;
+		}
+
+		time += distance / closing;
+
+		if (time > 1.0f)
+		{
+			return false;
+		}
+	}
+
+	// Still closing in after every advancement, which is as good as touching for keeping shapes from passing through.
+	movedA.SetTranslation(a.GetTranslation() + motionA * time);
+	movedB.SetTranslation(b.GetTranslation() + motionB * time);
+
+	glm::vec3 closestA;
+	glm::vec3 closestB;
+	GJK::Distance(movedA, movedB, closestA, closestB, &cache);
+
+	hit.time = time;
+	hit.point = closestB;
+	hit.normal = -normal;
+	return true;
+}
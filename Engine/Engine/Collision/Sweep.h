@@ -0,0 +1,59 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <glm/glm.hpp>
+
+class Sphere;
+class AxisAlignedBoundingBox;
+class OrientedBoundingBox;
+class Triangle;
+class ConvexShape;
+
+// Continuous collision, for shapes that move far enough in a step to pass through thin geometry between two static tests.
+// Each query takes the shapes where they are at the start of the step and how far they move during it, and finds the
+// first time they touch. Motion is a straight line and shapes do not rotate during a sweep.
+class Sweep
+{
+public:
+
+	struct Hit
+	{
+		// The fraction of the motion done when the shapes first touch. 0 means they already touch at the start.
+		float time = 1.0f;
+
+		// Where the shapes touch, on the surface of the shape that is hit.
+		glm::vec3 point = glm::vec3(0.0f);
+
+		// Out of the shape that is hit, toward the moving one.
+		glm::vec3 normal = glm::vec3(0.0f);
+	};
+
+	// The sphere moving by motion against a shape that stays put. The triangle can be hit from either side.
+	static bool SphereTriangle(const Sphere& sphere, const glm::vec3& motion, const Triangle& triangle, Hit& hit);
+
+	static bool SphereAxisAlignedBoundingBox(const Sphere& sphere, const glm::vec3& motion, const AxisAlignedBoundingBox& aabb, Hit& hit);
+
+	static bool SphereOrientedBoundingBox(const Sphere& sphere, const glm::vec3& motion, const OrientedBoundingBox& obb, Hit& hit);
+
+	// Conservative advancement for any two convex shapes that both move, like a pair of boxes. GJK finds the distance
+	// between the shapes, and they are moved together by the time they cannot close that distance in, until they are
+	// within tolerance of each other. Hit is for b being hit by a.
+	static bool TimeOfImpact(const ConvexShape& a, const glm::vec3& motionA, const ConvexShape& b, const glm::vec3& motionB, Hit& hit, float tolerance = 1e-3f);
+
+private:
+
+	Sweep() = delete;
+
+	~Sweep() = delete;
+
+	Sweep(const Sweep&) = delete;
+
+	Sweep& operator=(const Sweep&) = delete;
+
+	Sweep(Sweep&&) = delete;
+
+	Sweep& operator=(Sweep&&) = delete;
+
+};
+
+#endif // SWEEP_H
@@ -5,6 +5,7 @@
 #include "Renderer/Windows//WindowManager.h"
 #include "Renderer/Windows/Window.h"
 #include "Time/TimeManager.h"
+#include "Simulation/Simulation.h"
 #include "Scene/SceneManager.h"
 #include "Network/NetworkManager.h"
 #include "Input/InputManager.h"
@@ -55,6 +56,7 @@ void Engine::Start()
 		while (instance->shouldUpdate)
 		{
 			TimeManager::RecordUpdateTime();
+			Simulation::Interpolate();
 			Renderer::Update();
 		};
 	}
@@ -131,6 +133,7 @@ Engine::Engine(const std::string& gn, const Version& gv) :
 	toggleEditorFunction(nullptr)
 {
 	TimeManager::Initialize();
+	Simulation::Initialize();
 	//NetworkManager::Initialize();
 	SceneManager::Initialize();
 }
@@ -149,7 +152,9 @@ Engine::~Engine()
 		delete thread.second;
 	}
 
+	// The scenes' objects deregister their step callbacks and unfollow their graphics as they are deleted.
 	SceneManager::Terminate();
+	Simulation::Terminate();
 	InputManager::Terminate();
 	Renderer::Terminate();
 	//NetworkManager::Terminate();
@@ -0,0 +1,152 @@
+#ifndef LANES_H
+#define LANES_H
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MATH_LANES_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MATH_LANES_NEON
+#endif
+
+namespace Math
+{
+	namespace Lanes
+	{
+		// SIMD kernels are written once against these lane types. The widest one the target supports runs over the
+		// bulk of a batch and ScalarLane handles the remainder, which is also the fallback on other targets.
+		struct ScalarLane
+		{
+			static const unsigned int width = 1;
+
+			float v;
+
+			static ScalarLane Load(const float* p) { return { *p }; }
+
+			static ScalarLane Set(float f) { return { f }; }
+
+			void Store(float* p) const { *p = v; }
+		};
+
+		inline ScalarLane operator+(ScalarLane a, ScalarLane b) { return { a.v + b.v }; }
+		inline ScalarLane operator-(ScalarLane a, ScalarLane b) { return { a.v - b.v }; }
+		inline ScalarLane operator*(ScalarLane a, ScalarLane b) { return { a.v * b.v }; }
+		inline ScalarLane operator/(ScalarLane a, ScalarLane b) { return { a.v / b.v }; }
+		inline ScalarLane Sqrt(ScalarLane a) { return { std::sqrt(a.v) }; }
+		inline ScalarLane IfLess(ScalarLane a, ScalarLane b, ScalarLane thenValue, ScalarLane elseValue) { return a.v < b.v ? thenValue : elseValue; }
+		inline ScalarLane Abs(ScalarLane a) { return { std::fabs(a.v) }; }
+		inline ScalarLane Max(ScalarLane a, ScalarLane b) { return { std::max(a.v, b.v) }; }
+		inline ScalarLane Min(ScalarLane a, ScalarLane b) { return { std::min(a.v, b.v) }; }
+
+#if defined(__AVX2__)
+
+		struct WideLane
+		{
+			static const unsigned int width = 8;
+
+			__m256 v;
+
+			static WideLane Load(const float* p) { return { _mm256_loadu_ps(p) }; }
+
+			static WideLane Set(float f) { return { _mm256_set1_ps(f) }; }
+
+			void Store(float* p) const { _mm256_storeu_ps(p, v); }
+		};
+
+		inline WideLane operator+(WideLane a, WideLane b) { return { _mm256_add_ps(a.v, b.v) }; }
+		inline WideLane operator-(WideLane a, WideLane b) { return { _mm256_sub_ps(a.v, b.v) }; }
+		inline WideLane operator*(WideLane a, WideLane b) { return { _mm256_mul_ps(a.v, b.v) }; }
+		inline WideLane operator/(WideLane a, WideLane b) { return { _mm256_div_ps(a.v, b.v) }; }
+		inline WideLane Sqrt(WideLane a) { return { _mm256_sqrt_ps(a.v) }; }
+		inline WideLane IfLess(WideLane a, WideLane b, WideLane thenValue, WideLane elseValue) { return { _mm256_blendv_ps(elseValue.v, thenValue.v, _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)) }; }
+		inline WideLane Abs(WideLane a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+		inline WideLane Max(WideLane a, WideLane b) { return { _mm256_max_ps(a.v, b.v) }; }
+		inline WideLane Min(WideLane a, WideLane b) { return { _mm256_min_ps(a.v, b.v) }; }
+
+#elif defined(MATH_LANES_SSE2)
+
+		struct WideLane
+		{
+			static const unsigned int width = 4;
+
+			__m128 v;
+
+			static WideLane Load(const float* p) { return { _mm_loadu_ps(p) }; }
+
+			static WideLane Set(float f) { return { _mm_set1_ps(f) }; }
+
+			void Store(float* p) const { _mm_storeu_ps(p, v); }
+		};
+
+		inline WideLane operator+(WideLane a, WideLane b) { return { _mm_add_ps(a.v, b.v) }; }
+		inline WideLane operator-(WideLane a, WideLane b) { return { _mm_sub_ps(a.v, b.v) }; }
+		inline WideLane operator*(WideLane a, WideLane b) { return { _mm_mul_ps(a.v, b.v) }; }
+		inline WideLane operator/(WideLane a, WideLane b) { return { _mm_div_ps(a.v, b.v) }; }
+		inline WideLane Sqrt(WideLane a) { return { _mm_sqrt_ps(a.v) }; }
+
+		inline WideLane IfLess(WideLane a, WideLane b, WideLane thenValue, WideLane elseValue)
+		{
+			const __m128 mask = _mm_cmplt_ps(a.v, b.v);
+			return { _mm_or_ps(_mm_and_ps(mask, thenValue.v), _mm_andnot_ps(mask, elseValue.v)) };
+		}
+
+		inline WideLane Abs(WideLane a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+		inline WideLane Max(WideLane a, WideLane b) { return { _mm_max_ps(a.v, b.v) }; }
+		inline WideLane Min(WideLane a, WideLane b) { return { _mm_min_ps(a.v, b.v) }; }
+
+#elif defined(MATH_LANES_NEON)
+
+		struct WideLane
+		{
+			static const unsigned int width = 4;
+
+			float32x4_t v;
+
+			static WideLane Load(const float* p) { return { vld1q_f32(p) }; }
+
+			static WideLane Set(float f) { return { vdupq_n_f32(f) }; }
+
+			void Store(float* p) const { vst1q_f32(p, v); }
+		};
+
+		inline WideLane operator+(WideLane a, WideLane b) { return { vaddq_f32(a.v, b.v) }; }
+		inline WideLane operator-(WideLane a, WideLane b) { return { vsubq_f32(a.v, b.v) }; }
+		inline WideLane operator*(WideLane a, WideLane b) { return { vmulq_f32(a.v, b.v) }; }
+		inline WideLane operator/(WideLane a, WideLane b) { return { vdivq_f32(a.v, b.v) }; }
+		inline WideLane Sqrt(WideLane a) { return { vsqrtq_f32(a.v) }; }
+		inline WideLane IfLess(WideLane a, WideLane b, WideLane thenValue, WideLane elseValue) { return { vbslq_f32(vcltq_f32(a.v, b.v), thenValue.v, elseValue.v) }; }
+		inline WideLane Abs(WideLane a) { return { vabsq_f32(a.v) }; }
+		inline WideLane Max(WideLane a, WideLane b) { return { vmaxq_f32(a.v, b.v) }; }
+		inline WideLane Min(WideLane a, WideLane b) { return { vminq_f32(a.v, b.v) }; }
+
+#else
+
+		typedef ScalarLane WideLane;
+
+#endif
+
+		// Runs kernel over [0, size) in WideLane steps and finishes the remainder with ScalarLane.
+		template<typename Kernel>
+		inline void ForEachLane(unsigned int size, const Kernel& kernel)
+		{
+			unsigned int i = 0;
+
+			for (; i + WideLane::width <= size; i += WideLane::width)
+			{
+				kernel(WideLane(), i);
+			}
+
+			for (; i < size; i++)
+			{
+				kernel(ScalarLane(), i);
+			}
+		}
+	}
+}
+
+#endif // LANES_H
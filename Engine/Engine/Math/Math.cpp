@@ -58,6 +58,51 @@ void Math::ModelSpaceToWorldSpace(const glm::mat4& view, const glm::mat4& projec
 	outWorldSpacePoint = projection * view * model * point;
 }
 
+void Math::WindowSpacePointToRay(const glm::mat4& view, const glm::mat4& projection, const glm::vec2& point, const glm::vec2& windowDimensions, glm::vec3& outOrigin, glm::vec3& outDirection)
+{
+	const glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+	const glm::vec2 ndc = (point / windowDimensions) * 2.0f - 1.0f;
+
+#ifdef GLM_FORCE_DEPTH_ZERO_TO_ONE
+	const float nearDepth = 0.0f;
+#else
+	const float nearDepth = -1.0f;
+#endif
+
+	const glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc, nearDepth, 1.0f);
+	const glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+
+	outOrigin = glm::vec3(nearPoint) / nearPoint.w;
+	outDirection = glm::normalize(glm::vec3(farPoint) / farPoint.w - outOrigin);
+}
+
+bool Math::RaycastModel(const Model* const model, const glm::mat4& modelMat, const glm::vec3& origin, const glm::vec3& direction, MeshBVH::Hit& outHit, float maxDistance)
+{
+	// The ray is taken into model space instead of the triangles into world space. Distances scale by how much the model
+	// matrix stretches the direction.
+	const glm::mat4 inverseModel = glm::inverse(modelMat);
+	const glm::vec3 modelOrigin = inverseModel * glm::vec4(origin, 1.0f);
+	const glm::vec3 modelDirection = inverseModel * glm::vec4(direction, 0.0f);
+	const float scale = glm::length(modelDirection);
+
+	if (scale <= 0.0f)
+	{
+		return false;
+	}
+
+	const float modelMaxDistance = (maxDistance < FLT_MAX) ? maxDistance * scale : FLT_MAX;
+
+	if (!model->GetBVH().Raycast(modelOrigin, modelDirection / scale, outHit, modelMaxDistance))
+	{
+		return false;
+	}
+
+	outHit.point = modelMat * glm::vec4(outHit.point, 1.0f);
+	outHit.distance /= scale;
+
+	return true;
+}
+
 bool Math::PointIn2DModel(const Model* const model, const glm::mat4& view, const glm::mat4& projection, const glm::mat4& modelMat, const glm::vec2& point, const glm::vec2& windowDimensions, const glm::vec2& offset)
 {
 	const std::vector<Vertex>& vertices = model->GetVertices();
@@ -87,6 +132,29 @@ bool Math::PointIn2DModel(const Model* const model, const glm::mat4& view, const
 	return false;
 }
 
+void Math::Model2DWindowBounds(const Model* const model, const glm::mat4& view, const glm::mat4& projection, const glm::mat4& modelMat, const glm::vec2& windowDimensions, glm::vec2& outMin, glm::vec2& outMax)
+{
+	const std::vector<Vertex>& vertices = model->GetVertices();
+	const glm::mat4 modelViewProjection = projection * view * modelMat;
+
+	outMin = glm::vec2(FLT_MAX);
+	outMax = glm::vec2(-FLT_MAX);
+
+	for (const Vertex& vertex : vertices)
+	{
+		glm::vec2 windowSpacePoint;
+		Math::WorldSpacePointToWindowSpace(modelViewProjection * glm::vec4(vertex.GetPosition(), 1.0f), windowDimensions, glm::vec2(0.0f, 0.0f), windowSpacePoint);
+
+		outMin = glm::min(outMin, windowSpacePoint);
+		outMax = glm::max(outMax, windowSpacePoint);
+	}
+
+	if (vertices.empty())
+	{
+		outMin = outMax = glm::vec2(0.0f);
+	}
+}
+
 float Math::ChangeRange(float currentBegin, float currentEnd, float newBegin, float newEnd, float value)
 {
 	float oldRange = (currentEnd - currentBegin);
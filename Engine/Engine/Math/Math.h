@@ -2,6 +2,7 @@
 #define MATH_H
 
 #include "../Renderer/Model/Model.h"
+#include "../Collision/MeshBVH.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -24,8 +25,18 @@ namespace Math
 
 	void ModelSpaceToWorldSpace(const glm::mat4& view, const glm::mat4& projection, const glm::mat4& model, const glm::vec4& point, glm::vec4& outWorldSpacePoint);
 
+	// The world space ray under a window space point, where window space is what WorldSpacePointToWindowSpace maps to.
+	void WindowSpacePointToRay(const glm::mat4& view, const glm::mat4& projection, const glm::vec2& point, const glm::vec2& windowDimensions, glm::vec3& outOrigin, glm::vec3& outDirection);
+
+	// Raycasts the triangles of a model placed by modelMat through its BVH. direction must be normalized, the hit point and
+	// distance are in world space.
+	bool RaycastModel(const Model* const model, const glm::mat4& modelMat, const glm::vec3& origin, const glm::vec3& direction, MeshBVH::Hit& outHit, float maxDistance = FLT_MAX);
+
 	bool PointIn2DModel(const Model* const model, const glm::mat4& view, const glm::mat4& projection, const glm::mat4& modelMat, const glm::vec2& point, const glm::vec2& windowDimensions, const glm::vec2& offset = glm::vec2(0.0f));
 
+	// The window space box around a model drawn the way PointIn2DModel tests it.
+	void Model2DWindowBounds(const Model* const model, const glm::mat4& view, const glm::mat4& projection, const glm::mat4& modelMat, const glm::vec2& windowDimensions, glm::vec2& outMin, glm::vec2& outMax);
+
 	float ChangeRange(float currentBegin, float currentEnd, float newBegin, float newEnd, float value);
 
 	float ProjLength(const glm::vec3& v, const  glm::vec3& w);
@@ -0,0 +1,394 @@
+#include "PositionSoA.h"
+
+#include "Lanes.h"
+#include "../Renderer/Model/Vertex.h"
+
+#include <cfloat>
+#include <type_traits>
+
+using namespace Math;
+using namespace Math::Lanes;
+
+namespace
+{
+	// A running value for each lane type ForEachLane hands a kernel, folded into one at the end.
+	struct Accumulator
+	{
+		Accumulator(float initial) :
+			wide(WideLane::Set(initial)),
+			scalar(ScalarLane::Set(initial))
+		{
+		}
+
+		template<typename L>
+		L& Get()
+		{
+			if constexpr (std::is_same_v<L, WideLane>)
+			{
+				return wide;
+			}
+			else
+			{
+				return scalar;
+			}
+		}
+
+		template<typename Combine>
+		float Reduce(const Combine& combine) const
+		{
+			float values[WideLane::width];
+			wide.Store(values);
+
+			float result = scalar.v;
+
+			for (unsigned int i = 0; i < WideLane::width; i++)
+			{
+				result = combine(result, values[i]);
+			}
+
+			return result;
+		}
+
+		WideLane wide;
+
+		ScalarLane scalar;
+	};
+
+	// The index held next to the best value, largest when greater is set and smallest otherwise.
+	unsigned int ReduceIndex(const Accumulator& value, const Accumulator& index, bool greater)
+	{
+		float values[WideLane::width];
+		float indices[WideLane::width];
+		value.wide.Store(values);
+		index.wide.Store(indices);
+
+		float best = value.scalar.v;
+		float bestIndex = index.scalar.v;
+
+		for (unsigned int i = 0; i < WideLane::width; i++)
+		{
+			if (greater ? values[i] > best : values[i] < best)
+			{
+				best = values[i];
+				bestIndex = indices[i];
+			}
+		}
+
+		return static_cast<unsigned int>(bestIndex);
+	}
+
+	template<typename L>
+	inline L LaneIndices(unsigned int i)
+	{
+		static const float offsets[8] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+		return L::Set(static_cast<float>(i)) + L::Load(offsets);
+	}
+
+	float Sum(float a, float b)
+	{
+		return a + b;
+	}
+
+	float Minimum(float a, float b)
+	{
+		return std::min(a, b);
+	}
+
+	float Maximum(float a, float b)
+	{
+		return std::max(a, b);
+	}
+}
+
+PositionSoA::PositionSoA()
+{
+}
+
+PositionSoA::PositionSoA(const std::vector<Vertex>& vertices)
+{
+	Reserve(static_cast<unsigned int>(vertices.size()));
+
+	for (const Vertex& vertex : vertices)
+	{
+		Add(vertex.GetPosition());
+	}
+}
+
+PositionSoA::PositionSoA(const std::vector<glm::vec3>& points)
+{
+	Reserve(static_cast<unsigned int>(points.size()));
+
+	for (const glm::vec3& point : points)
+	{
+		Add(point);
+	}
+}
+
+PositionSoA::~PositionSoA()
+{
+}
+
+void PositionSoA::Reserve(unsigned int capacity)
+{
+	for (std::vector<float>& component : components)
+	{
+		component.reserve(capacity);
+	}
+}
+
+void PositionSoA::Add(const glm::vec3& point)
+{
+	components[X].push_back(point.x);
+	components[Y].push_back(point.y);
+	components[Z].push_back(point.z);
+}
+
+void PositionSoA::Clear()
+{
+	for (std::vector<float>& component : components)
+	{
+		component.clear();
+	}
+}
+
+unsigned int PositionSoA::Size() const
+{
+	return static_cast<unsigned int>(components[X].size());
+}
+
+glm::vec3 PositionSoA::Get(unsigned int index) const
+{
+	return glm::vec3(components[X][index], components[Y][index], components[Z][index]);
+}
+
+void PositionSoA::GetBounds(glm::vec3& min, glm::vec3& max) const
+{
+	if (Size() == 0)
+	{
+		min = max = glm::vec3(0.0f);
+		return;
+	}
+
+	Accumulator minimums[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	Accumulator maximums[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	ForEachLane(Size(), [&](auto lane, unsigned int i)
+	{
+		using L = decltype(lane);
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			const L value = L::Load(components[axis].data() + i);
+			minimums[axis].Get<L>() = Min(minimums[axis].Get<L>(), value);
+			maximums[axis].Get<L>() = Max(maximums[axis].Get<L>(), value);
+		}
+	});
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		min[axis] = minimums[axis].Reduce(Minimum);
+		max[axis] = maximums[axis].Reduce(Maximum);
+	}
+}
+
+void PositionSoA::GetCovariance(glm::vec3& mean, glm::mat3& covariance) const
+{
+	mean = glm::vec3(0.0f);
+	covariance = glm::mat3(0.0f);
+
+	if (Size() == 0)
+	{
+		return;
+	}
+
+	Accumulator sums[3] = { 0.0f, 0.0f, 0.0f };
+
+	ForEachLane(Size(), [&](auto lane, unsigned int i)
+	{
+		using L = decltype(lane);
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			sums[axis].Get<L>() = sums[axis].Get<L>() + L::Load(components[axis].data() + i);
+		}
+	});
+
+	const float inverseCount = 1.0f / static_cast<float>(Size());
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		mean[axis] = sums[axis].Reduce(Sum) * inverseCount;
+	}
+
+	// Around the mean rather than from raw sums, which lose too much precision for meshes far from their origin.
+	Accumulator products[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+	ForEachLane(Size(), [&](auto lane, unsigned int i)
+	{
+		using L = decltype(lane);
+
+		const L x = L::Load(components[X].data() + i) - L::Set(mean.x);
+		const L y = L::Load(components[Y].data() + i) - L::Set(mean.y);
+		const L z = L::Load(components[Z].data() + i) - L::Set(mean.z);
+
+		products[0].Get<L>() = products[0].Get<L>() + x * x;
+		products[1].Get<L>() = products[1].Get<L>() + y * y;
+		products[2].Get<L>() = products[2].Get<L>() + z * z;
+		products[3].Get<L>() = products[3].Get<L>() + x * y;
+		products[4].Get<L>() = products[4].Get<L>() + x * z;
+		products[5].Get<L>() = products[5].Get<L>() + y * z;
+	});
+
+	covariance[0][0] = products[0].Reduce(Sum) * inverseCount;
+	covariance[1][1] = products[1].Reduce(Sum) * inverseCount;
+	covariance[2][2] = products[2].Reduce(Sum) * inverseCount;
+	covariance[0][1] = covariance[1][0] = products[3].Reduce(Sum) * inverseCount;
+	covariance[0][2] = covariance[2][0] = products[4].Reduce(Sum) * inverseCount;
+	covariance[1][2] = covariance[2][1] = products[5].Reduce(Sum) * inverseCount;
+}
+
+void PositionSoA::Project(const glm::mat3& axes, glm::vec3& min, glm::vec3& max) const
+{
+	if (Size() == 0)
+	{
+		min = max = glm::vec3(0.0f);
+		return;
+	}
+
+	Accumulator minimums[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	Accumulator maximums[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	ForEachLane(Size(), [&](auto lane, unsigned int i)
+	{
+		using L = decltype(lane);
+
+		const L x = L::Load(components[X].data() + i);
+		const L y = L::Load(components[Y].data() + i);
+		const L z = L::Load(components[Z].data() + i);
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			const L projection = x * L::Set(axes[axis].x) + y * L::Set(axes[axis].y) + z * L::Set(axes[axis].z);
+			minimums[axis].Get<L>() = Min(minimums[axis].Get<L>(), projection);
+			maximums[axis].Get<L>() = Max(maximums[axis].Get<L>(), projection);
+		}
+	});
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		min[axis] = minimums[axis].Reduce(Minimum);
+		max[axis] = maximums[axis].Reduce(Maximum);
+	}
+}
+
+unsigned int PositionSoA::GetFarthest(const glm::vec3& point, float& distanceSquared) const
+{
+	distanceSquared = 0.0f;
+
+	if (Size() == 0)
+	{
+		return 0;
+	}
+
+	Accumulator best = -1.0f;
+	Accumulator bestIndex = 0.0f;
+
+	ForEachLane(Size(), [&](auto lane, unsigned int i)
+	{
+		using L = decltype(lane);
+
+		const L x = L::Load(components[X].data() + i) - L::Set(point.x);
+		const L y = L::Load(components[Y].data() + i) - L::Set(point.y);
+		const L z = L::Load(components[Z].data() + i) - L::Set(point.z);
+		const L lengthSquared = x * x + y * y + z * z;
+
+		bestIndex.Get<L>() = IfLess(best.Get<L>(), lengthSquared, LaneIndices<L>(i), bestIndex.Get<L>());
+		best.Get<L>() = Max(best.Get<L>(), lengthSquared);
+	});
+
+	const unsigned int index = ReduceIndex(best, bestIndex, true);
+	const glm::vec3 toFarthest = Get(index) - point;
+	distanceSquared = glm::dot(toFarthest, toFarthest);
+
+	return index;
+}
+
+unsigned int PositionSoA::GetSupport(const glm::vec3& direction, float& distance) const
+{
+	distance = 0.0f;
+
+	if (Size() == 0)
+	{
+		return 0;
+	}
+
+	Accumulator best = -FLT_MAX;
+	Accumulator bestIndex = 0.0f;
+
+	ForEachLane(Size(), [&](auto lane, unsigned int i)
+	{
+		using L = decltype(lane);
+
+		const L projection = L::Load(components[X].data() + i) * L::Set(direction.x) + L::Load(components[Y].data() + i) * L::Set(direction.y) + L::Load(components[Z].data() + i) * L::Set(direction.z);
+
+		bestIndex.Get<L>() = IfLess(best.Get<L>(), projection, LaneIndices<L>(i), bestIndex.Get<L>());
+		best.Get<L>() = Max(best.Get<L>(), projection);
+	});
+
+	const unsigned int index = ReduceIndex(best, bestIndex, true);
+	distance = glm::dot(Get(index), direction);
+
+	return index;
+}
+
+void PositionSoA::GetExtremes(unsigned int minIndices[3], unsigned int maxIndices[3]) const
+{
+	if (Size() == 0)
+	{
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			minIndices[axis] = maxIndices[axis] = 0;
+		}
+
+		return;
+	}
+
+	Accumulator minimums[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	Accumulator maximums[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	Accumulator minimumIndices[3] = { 0.0f, 0.0f, 0.0f };
+	Accumulator maximumIndices[3] = { 0.0f, 0.0f, 0.0f };
+
+	ForEachLane(Size(), [&](auto lane, unsigned int i)
+	{
+		using L = decltype(lane);
+
+		const L indices = LaneIndices<L>(i);
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			const L value = L::Load(components[axis].data() + i);
+
+			minimumIndices[axis].Get<L>() = IfLess(value, minimums[axis].Get<L>(), indices, minimumIndices[axis].Get<L>());
+			minimums[axis].Get<L>() = Min(minimums[axis].Get<L>(), value);
+
+			maximumIndices[axis].Get<L>() = IfLess(maximums[axis].Get<L>(), value, indices, maximumIndices[axis].Get<L>());
+			maximums[axis].Get<L>() = Max(maximums[axis].Get<L>(), value);
+		}
+	});
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		minIndices[axis] = ReduceIndex(minimums[axis], minimumIndices[axis], false);
+		maxIndices[axis] = ReduceIndex(maximums[axis], maximumIndices[axis], true);
+	}
+}
+
+float* PositionSoA::GetComponent(Component component)
+{
+	return components[component].data();
+}
+
+const float* PositionSoA::GetComponent(Component component) const
+{
+	return components[component].data();
+}
@@ -0,0 +1,84 @@
+#ifndef POSITIONSOA_H
+#define POSITIONSOA_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class Vertex;
+
+namespace Math
+{
+	// Points stored one array per coordinate so the passes that fit bounding volumes to them can run over several points at
+	// a time with SIMD, the way TransformSoA does for transforms.
+	class PositionSoA
+	{
+
+	public:
+
+		PositionSoA();
+
+		PositionSoA(const std::vector<Vertex>& vertices);
+
+		PositionSoA(const std::vector<glm::vec3>& points);
+
+		~PositionSoA();
+
+		PositionSoA(const PositionSoA&) = default;
+
+		PositionSoA& operator=(const PositionSoA&) = default;
+
+		PositionSoA(PositionSoA&&) = default;
+
+		PositionSoA& operator=(PositionSoA&&) = default;
+
+		void Reserve(unsigned int capacity);
+
+		void Add(const glm::vec3& point);
+
+		void Clear();
+
+		unsigned int Size() const;
+
+		glm::vec3 Get(unsigned int index) const;
+
+		// The box around every point, zero sized at the origin when there are none.
+		void GetBounds(glm::vec3& min, glm::vec3& max) const;
+
+		// The mean of the points and their covariance around it.
+		void GetCovariance(glm::vec3& mean, glm::mat3& covariance) const;
+
+		// The smallest and largest dot(point, axes[i]) for each of the three axes.
+		void Project(const glm::mat3& axes, glm::vec3& min, glm::vec3& max) const;
+
+		// The index of the point furthest from point and its squared distance. Indices are carried in float lanes, so this
+		// is exact for up to 2^24 points.
+		unsigned int GetFarthest(const glm::vec3& point, float& distanceSquared) const;
+
+		// The index of the point furthest along direction and how far along it is, the support point of the hull of the
+		// points. Same limit as GetFarthest.
+		unsigned int GetSupport(const glm::vec3& direction, float& distance) const;
+
+		// The indices of the points with the smallest and largest x, y and z, with the same limit as GetFarthest.
+		void GetExtremes(unsigned int minIndices[3], unsigned int maxIndices[3]) const;
+
+		enum Component
+		{
+			X,
+			Y,
+			Z,
+			ComponentCount
+		};
+
+		float* GetComponent(Component component);
+
+		const float* GetComponent(Component component) const;
+
+	private:
+
+		std::vector<float> components[ComponentCount];
+
+	};
+};
+
+#endif // POSITIONSOA_H
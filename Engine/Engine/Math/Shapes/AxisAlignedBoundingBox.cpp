@@ -3,7 +3,6 @@
 #include "Sphere.h"
 #include "OrientedBoundingBox.h"
 #include "Plane.h"
-#include "../SAT/Interval3D.h"
 
 AxisAlignedBoundingBox::AxisAlignedBoundingBox(const glm::vec3& initialOrigin, const glm::vec3& initialSize) :
 	origin(initialOrigin),
@@ -18,7 +17,7 @@ AxisAlignedBoundingBox::~AxisAlignedBoundingBox()
 void AxisAlignedBoundingBox::FromMinAndMax(const glm::vec3& min, const glm::vec3& max)
 {
 	origin = (min + max) * 0.5f;
-	size = max - min * 0.5f;
+	size = (max - min) * 0.5f;
 }
 
 const glm::vec3& AxisAlignedBoundingBox::GetOrigin() const
@@ -91,32 +90,7 @@ bool AxisAlignedBoundingBox::AxisAlignedBoundingBoxIntersect(const AxisAlignedBo
 
 bool AxisAlignedBoundingBox::OrientedBoundingBoxIntersect(const OrientedBoundingBox& obb) const
 {
-	const glm::mat4& orientation = obb.GetOrientation();
-
-	glm::vec3 test[15] =
-	{
-		glm::vec3(1.0f, 0.0f, 0.0f),
-		glm::vec3(0.0f, 1.0f, 0.0f),
-		glm::vec3(0.0f, 0.0f, 1.0f),
-		orientation[0],
-		orientation[1],
-		orientation[2]
-	};
-
-	for (unsigned int i = 0; i < 3U; ++i)
-	{
-		test[6 + i * 3 + 0] = glm::cross(test[i], test[0]);
-		test[6 + i * 3 + 1] = glm::cross(test[i], test[1]);
-		test[6 + i * 3 + 2] = glm::cross(test[i], test[2]);
-	}
-
-	for (unsigned int i = 0; i < 15; ++i)
-	{
-		if (!OverlapOnAxis(obb, test[i]))
-			return false;
-	}
-
-	return true;
+	return OrientedBoundingBox::SeparatingAxisTest(origin, glm::mat3(1.0f), glm::abs(size), obb.GetOrigin(), obb.GetAxes(), obb.GetSize());
 }
 
 bool AxisAlignedBoundingBox::PlaneIntersect(const Plane& plane) const
@@ -140,20 +114,13 @@ glm::vec3 AxisAlignedBoundingBox::ClosestPoint(const glm::vec3& point) const
 
 	glm::vec3 closestPoint = point;
 
-	closestPoint.x = (min.x > point.x) ? min.x : point.x;
-	closestPoint.y = (min.y > point.y) ? min.y : point.y;
-	closestPoint.z = (min.x > point.z) ? min.z : point.z;
+	closestPoint.x = (min.x > closestPoint.x) ? min.x : closestPoint.x;
+	closestPoint.y = (min.y > closestPoint.y) ? min.y : closestPoint.y;
+	closestPoint.z = (min.z > closestPoint.z) ? min.z : closestPoint.z;
 
-	closestPoint.x = (max.x < point.x) ? max.x : point.x;
-	closestPoint.y = (max.y < point.y) ? max.y : point.y;
-	closestPoint.z = (max.z < point.z) ? max.z : point.z;
+	closestPoint.x = (max.x < closestPoint.x) ? max.x : closestPoint.x;
+	closestPoint.y = (max.y < closestPoint.y) ? max.y : closestPoint.y;
+	closestPoint.z = (max.z < closestPoint.z) ? max.z : closestPoint.z;
 
 	return closestPoint;
 }
-
-bool AxisAlignedBoundingBox::OverlapOnAxis(const OrientedBoundingBox& obb, const glm::vec3& axis) const
-{
-	Interval3D a(*this, axis);
-	Interval3D b(obb, axis);
-	return ((b.GetMin() <= a.GetMax()) && (a.GetMin() <= b.GetMax()));
-}
@@ -39,8 +39,6 @@ public:
 
 private:
 
-	bool OverlapOnAxis(const OrientedBoundingBox& obb, const glm::vec3& axis) const;
-
 	AxisAlignedBoundingBox(const AxisAlignedBoundingBox&) = delete;
 
 	AxisAlignedBoundingBox& operator=(const AxisAlignedBoundingBox&) = delete;
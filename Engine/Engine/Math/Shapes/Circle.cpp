@@ -29,6 +29,12 @@ float Circle::GetRadius() const
 	return radius;
 }
 
+void Circle::GetBounds(glm::vec2& min, glm::vec2& max) const
+{
+	min = center - glm::vec2(radius);
+	max = center + glm::vec2(radius);
+}
+
 bool Circle::PointIntersect(const glm::vec2& point) const
 {
 	glm::vec2 lengthVector(point - center);
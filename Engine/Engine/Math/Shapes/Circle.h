@@ -21,6 +21,9 @@ public:
 
 	float GetRadius() const;
 
+	// The axis aligned box around the circle.
+	void GetBounds(glm::vec2& min, glm::vec2& max) const;
+
 	bool PointIntersect(const glm::vec2& point) const;
 
 	bool LineIntersect(const LineSegment& line) const;
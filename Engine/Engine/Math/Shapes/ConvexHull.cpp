@@ -0,0 +1,172 @@
+#include "ConvexHull.h"
+
+#include "../../Renderer/Model/Vertex.h"
+
+#include <algorithm>
+
+namespace
+{
+	float Cross2D(const glm::vec2& o, const glm::vec2& a, const glm::vec2& b)
+	{
+		return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+	}
+}
+
+ConvexHull::ConvexHull(const std::vector<Vertex>& vertices) :
+	ConvexHull(Math::PositionSoA(vertices))
+{
+}
+
+ConvexHull::ConvexHull(const Math::PositionSoA& initialPoints) :
+	points(initialPoints),
+	localOrigin(0.0f),
+	origin(0.0f),
+	transform(1.0f),
+	directionToLocal(1.0f)
+{
+	RemoveDuplicates();
+
+	glm::mat3 covariance;
+	points.GetCovariance(localOrigin, covariance);
+	origin = localOrigin;
+}
+
+ConvexHull::~ConvexHull()
+{
+}
+
+const glm::vec3& ConvexHull::GetOrigin() const
+{
+	return origin;
+}
+
+const glm::mat4& ConvexHull::GetTransform() const
+{
+	return transform;
+}
+
+void ConvexHull::Transform(const glm::mat4& newTransform)
+{
+	transform = newTransform;
+	directionToLocal = glm::transpose(glm::mat3(newTransform));
+	origin = newTransform * glm::vec4(localOrigin, 1.0f);
+}
+
+glm::vec3 ConvexHull::Support(const glm::vec3& direction) const
+{
+	if (points.Size() == 0)
+	{
+		return origin;
+	}
+
+	// The furthest point of a linear map of the points along d is the furthest of the points along the transpose times d.
+	float distance;
+	const unsigned int index = points.GetSupport(directionToLocal * direction, distance);
+
+	return transform * glm::vec4(points.Get(index), 1.0f);
+}
+
+void ConvexHull::SupportFace(const glm::vec3& direction, float tolerance, std::vector<glm::vec3>& polygon) const
+{
+	polygon.clear();
+
+	if (points.Size() == 0)
+	{
+		return;
+	}
+
+	const glm::vec3 normal = glm::normalize(direction);
+	const glm::vec3 localDirection = directionToLocal * normal;
+
+	float maxDistance;
+	points.GetSupport(localDirection, maxDistance);
+
+	// Distances along localDirection are world distances along normal, so the tolerance needs no scaling.
+	std::vector<glm::vec3> facePoints;
+
+	for (unsigned int i = 0; i < points.Size(); i++)
+	{
+		const glm::vec3 point = points.Get(i);
+
+		if (glm::dot(point, localDirection) >= maxDistance - tolerance)
+		{
+			facePoints.push_back(transform * glm::vec4(point, 1.0f));
+		}
+	}
+
+	if (facePoints.size() < 3)
+	{
+		polygon = facePoints;
+		return;
+	}
+
+	// Ordered around the face with a monotone chain hull in the face's plane, which also drops the points inside it.
+	const glm::vec3 tangent = glm::normalize(fabsf(normal.x) > 0.57735f ? glm::vec3(normal.y, -normal.x, 0.0f) : glm::vec3(0.0f, normal.z, -normal.y));
+	const glm::vec3 bitangent = glm::cross(normal, tangent);
+
+	std::vector<std::pair<glm::vec2, unsigned int>> projected(facePoints.size());
+
+	for (unsigned int i = 0; i < facePoints.size(); i++)
+	{
+		projected[i] = std::make_pair(glm::vec2(glm::dot(facePoints[i], tangent), glm::dot(facePoints[i], bitangent)), i);
+	}
+
+	std::sort(projected.begin(), projected.end(), [](const std::pair<glm::vec2, unsigned int>& a, const std::pair<glm::vec2, unsigned int>& b)
+	{
+		return (a.first.x != b.first.x) ? a.first.x < b.first.x : a.first.y < b.first.y;
+	});
+
+	std::vector<std::pair<glm::vec2, unsigned int>> chain(projected.size() * 2);
+	unsigned int count = 0;
+
+	for (unsigned int i = 0; i < projected.size(); i++)
+	{
+		while (count >= 2 && Cross2D(chain[count - 2].first, chain[count - 1].first, projected[i].first) <= 0.0f)
+		{
+			count--;
+		}
+
+		chain[count++] = projected[i];
+	}
+
+	for (int i = static_cast<int>(projected.size()) - 2, lower = count + 1; i >= 0; i--)
+	{
+		while (count >= static_cast<unsigned int>(lower) && Cross2D(chain[count - 2].first, chain[count - 1].first, projected[i].first) <= 0.0f)
+		{
+			count--;
+		}
+
+		chain[count++] = projected[i];
+	}
+
+	// The chain ends where it started.
+	for (unsigned int i = 0; i + 1 < count; i++)
+	{
+		polygon.push_back(facePoints[chain[i].second]);
+	}
+}
+
+unsigned int ConvexHull::GetPointCount() const
+{
+	return points.Size();
+}
+
+void ConvexHull::RemoveDuplicates()
+{
+	// Models repeat positions for every normal and texture coordinate seam.
+	std::vector<glm::vec3> unique(points.Size());
+
+	for (unsigned int i = 0; i < points.Size(); i++)
+	{
+		unique[i] = points.Get(i);
+	}
+
+	std::sort(unique.begin(), unique.end(), [](const glm::vec3& a, const glm::vec3& b)
+	{
+		return (a.x != b.x) ? a.x < b.x : (a.y != b.y) ? a.y < b.y : a.z < b.z;
+	});
+
+	unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+	points = Math::PositionSoA(unique);
+}
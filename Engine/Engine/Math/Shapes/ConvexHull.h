@@ -0,0 +1,66 @@
+#ifndef CONVEXHULL_H
+#define CONVEXHULL_H
+
+#include "../PositionSoA.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class Vertex;
+
+// The convex hull of a set of points, like a model's vertices, known only through its support function. The hull's faces
+// are never built, GJK needs no more than the point furthest in a direction. Built in local space and moved into the world
+// with Transform like the other shapes.
+class ConvexHull
+{
+public:
+
+	ConvexHull(const std::vector<Vertex>& vertices);
+
+	ConvexHull(const Math::PositionSoA& points);
+
+	~ConvexHull();
+
+	// The mean of the points, which is inside the hull.
+	const glm::vec3& GetOrigin() const;
+
+	const glm::mat4& GetTransform() const;
+
+	void Transform(const glm::mat4& transform);
+
+	// The point of the hull furthest along direction.
+	glm::vec3 Support(const glm::vec3& direction) const;
+
+	// The face of the hull facing direction as an ordered convex polygon, the points within tolerance of the support plane.
+	// A single point or an edge where the hull has no face facing that way.
+	void SupportFace(const glm::vec3& direction, float tolerance, std::vector<glm::vec3>& polygon) const;
+
+	unsigned int GetPointCount() const;
+
+private:
+
+	ConvexHull(const ConvexHull&) = delete;
+
+	ConvexHull& operator=(const ConvexHull&) = delete;
+
+	ConvexHull(ConvexHull&&) = delete;
+
+	ConvexHull& operator=(ConvexHull&&) = delete;
+
+	void RemoveDuplicates();
+
+	Math::PositionSoA points;
+
+	glm::vec3 localOrigin;
+
+	glm::vec3 origin;
+
+	glm::mat4 transform;
+
+	// Brings world directions into local space, where the support point is found.
+	glm::mat3 directionToLocal;
+
+};
+
+#endif // CONVEXHULL_H
@@ -47,6 +47,17 @@ float LineSegment::GetLengthSq() const
 	return glm::dot(lengthVector, lengthVector);
 }
 
+void LineSegment::GetBounds(glm::vec2& min, glm::vec2& max) const
+{
+	min = max = points[0];
+
+	for (const glm::vec2& point : points)
+	{
+		min = glm::min(min, point);
+		max = glm::max(max, point);
+	}
+}
+
 bool LineSegment::PointIntersect(const glm::vec2& point)
 {
 	// Find the slope.
@@ -27,6 +27,9 @@ public:
 
 	float GetLengthSq() const;
 
+	// The box around every point of the line.
+	void GetBounds(glm::vec2& min, glm::vec2& max) const;
+
 	bool PointIntersect(const glm::vec2& point);
 
 private:
@@ -1,19 +1,95 @@
 #include "OrientedBoundingBox.h"
 
-#include "../SAT/Interval3D.h"
+#include "../PositionSoA.h"
 #include "../../Renderer/Model/Vertex.h"
 
+#include <cfloat>
+
+namespace
+{
+    // Rotates the symmetric matrix a into a diagonal one of its eigenvalues, collecting the rotations as the eigenvectors
+    // in the columns of vectors. Cyclic Jacobi, which converges in a few sweeps for 3x3.
+    void SymmetricEigen(glm::mat3 a, glm::mat3& vectors)
+    {
+        vectors = glm::mat3(1.0f);
+
+        for (unsigned int sweep = 0; sweep < 16; ++sweep)
+        {
+            const float offDiagonal = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+            const float diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+
+            if (offDiagonal <= diagonal * 1e-12f)
+                break;
+
+            for (unsigned int p = 0; p < 2; ++p)
+            {
+                for (unsigned int q = p + 1; q < 3; ++q)
+                {
+                    if (fabsf(a[p][q]) < FLT_MIN)
+                        continue;
+
+                    // The rotation in the pq plane that zeroes a[p][q].
+                    const float theta = (a[q][q] - a[p][p]) / (2.0f * a[p][q]);
+                    const float t = (theta >= 0.0f ? 1.0f : -1.0f) / (fabsf(theta) + sqrtf(theta * theta + 1.0f));
+                    const float c = 1.0f / sqrtf(t * t + 1.0f);
+                    const float s = t * c;
+
+                    glm::mat3 rotation(1.0f);
+                    rotation[p][p] = c;
+                    rotation[q][q] = c;
+                    rotation[q][p] = s;
+                    rotation[p][q] = -s;
+
+                    a = glm::transpose(rotation) * a * rotation;
+                    vectors = vectors * rotation;
+                }
+            }
+        }
+    }
+
+    float HalfSurfaceArea(const glm::vec3& halfSize)
+    {
+        return halfSize.x * halfSize.y + halfSize.y * halfSize.z + halfSize.z * halfSize.x;
+    }
+}
+
 OrientedBoundingBox::OrientedBoundingBox(const glm::vec3& initialOrigin, const glm::vec3& initialSize, const glm::mat4& initialOrientation) :
     origin(initialOrigin),
+    offset(initialOrigin),
     size(initialSize),
-    orientation(initialOrientation)
+    localSize(initialSize),
+    orientation(initialOrientation),
+    localOrientation(initialOrientation)
 {
+    SetOrientation(initialOrientation);
 }
 
 OrientedBoundingBox::OrientedBoundingBox(const std::vector<Vertex>& vertices, const glm::mat4& initialOrientation) :
-    orientation(initialOrientation)
+    OrientedBoundingBox(Math::PositionSoA(vertices), initialOrientation)
 {
-    SizeToMesh(vertices);
+}
+
+OrientedBoundingBox::OrientedBoundingBox(const Math::PositionSoA& points, const glm::mat4& initialOrientation) :
+    orientation(initialOrientation),
+    localOrientation(initialOrientation)
+{
+    if (initialOrientation == glm::mat4(1.0f))
+    {
+        glm::mat3 fittedAxes;
+        Fit(points, offset, fittedAxes, size);
+        localSize = size;
+
+        localOrientation = glm::mat4(fittedAxes);
+        SetOrientation(localOrientation);
+    }
+    else
+    {
+        SetOrientation(initialOrientation);
+        SizeToMesh(points);
+    }
+
+    // Untransformed, the box sits on the mesh.
+    origin = offset;
 }
 
 OrientedBoundingBox::~OrientedBoundingBox()
@@ -35,6 +111,11 @@ const glm::mat4& OrientedBoundingBox::GetOrientation() const
     return orientation;
 }
 
+const glm::mat3& OrientedBoundingBox::GetAxes() const
+{
+    return axes;
+}
+
 const glm::vec3& OrientedBoundingBox::GetOffset() const
 {
     return offset;
@@ -51,7 +132,7 @@ bool OrientedBoundingBox::PointIntersect(const glm::vec3& point) const
 
     for (unsigned int i = 0; i < 3; ++i)
     {
-        glm::vec3 axis = glm::normalize(orientation[i]);
+        const glm::vec3& axis = axes[i];
 
         float distance = glm::dot(dir, axis);
 
@@ -67,77 +148,128 @@ bool OrientedBoundingBox::PointIntersect(const glm::vec3& point) const
 
 bool OrientedBoundingBox::OrientedBoundingBoxIntersect(const OrientedBoundingBox& other) const
 {
-    const glm::mat4& otherRot = other.GetOrientation();
-    const glm::mat4& rot = orientation;
+    return SeparatingAxisTest(origin, axes, size, other.origin, other.axes, other.size);
+}
 
-    glm::vec3 test[15] =
+bool OrientedBoundingBox::SeparatingAxisTest(const glm::vec3& originA, const glm::mat3& axesA, const glm::vec3& sizeA, const glm::vec3& originB, const glm::mat3& axesB, const glm::vec3& sizeB)
+{
+    // Keeps the edge axes of nearly parallel boxes, whose cross products are close to zero, from separating them.
+    const float epsilon = 1e-6f;
+
+    // B's axes in A's frame, and the center distance in A's frame.
+    float r[3][3];
+    float absR[3][3];
+    bool parallel = false;
+
+    for (unsigned int i = 0; i < 3; ++i)
     {
-        otherRot[0],
-        otherRot[1],
-        otherRot[2],
-        rot[0],
-        rot[1],
-        rot[2]
-    };
-
-    for (unsigned int i = 0; i < 3U; ++i)
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            r[i][j] = glm::dot(axesA[i], axesB[j]);
+            absR[i][j] = fabsf(r[i][j]) + epsilon;
+            parallel = parallel || absR[i][j] >= 1.0f;
+        }
+    }
+
+    const glm::vec3 distance = originB - originA;
+    const float t[3] = { glm::dot(distance, axesA[0]), glm::dot(distance, axesA[1]), glm::dot(distance, axesA[2]) };
+
+    // A's face axes.
+    for (unsigned int i = 0; i < 3; ++i)
     {
-        test[6 + i * 3 + 0] = glm::cross(test[i], test[0]);
-        test[6 + i * 3 + 1] = glm::cross(test[i], test[1]);
-        test[6 + i * 3 + 2] = glm::cross(test[i], test[2]);
+        const float radiusB = sizeB[0] * absR[i][0] + sizeB[1] * absR[i][1] + sizeB[2] * absR[i][2];
+
+        if (fabsf(t[i]) > sizeA[i] + radiusB)
+            return false;
     }
 
-    for (unsigned int i = 0; i < 15; ++i)
+    // B's face axes.
+    for (unsigned int j = 0; j < 3; ++j)
     {
-        if (!OverlapOnAxis(other, test[i]))
+        const float radiusA = sizeA[0] * absR[0][j] + sizeA[1] * absR[1][j] + sizeA[2] * absR[2][j];
+
+        if (fabsf(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]) > radiusA + sizeB[j])
             return false;
     }
 
+    if (parallel)
+        return true;
+
+    // The cross products of A's axis i with B's axis j.
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const unsigned int i1 = (i + 1) % 3;
+        const unsigned int i2 = (i + 2) % 3;
+
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            const unsigned int j1 = (j + 1) % 3;
+            const unsigned int j2 = (j + 2) % 3;
+
+            const float radiusA = sizeA[i1] * absR[i2][j] + sizeA[i2] * absR[i1][j];
+            const float radiusB = sizeB[j1] * absR[i][j2] + sizeB[j2] * absR[i][j1];
+
+            if (fabsf(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > radiusA + radiusB)
+                return false;
+        }
+    }
+
     return true;
 }
 
-void OrientedBoundingBox::SizeToMesh(const std::vector<Vertex>& verts)
+void OrientedBoundingBox::Fit(const Math::PositionSoA& points, glm::vec3& center, glm::mat3& axes, glm::vec3& halfSize)
 {
-    glm::vec3 min(FLT_MAX, FLT_MAX, FLT_MAX);
-    glm::vec3 max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    glm::vec3 min;
+    glm::vec3 max;
+    points.GetBounds(min, max);
 
-    glm::vec3 point;
+    center = (min + max) * 0.5f;
+    axes = glm::mat3(1.0f);
+    halfSize = (max - min) * 0.5f;
 
-    for (const Vertex& x : verts)
-    {
-         point = x.GetPosition();
+    if (points.Size() < 3)
+        return;
 
-        if (point.x >= max.x) max.x = point.x;
-        if (point.x <= min.x) min.x = point.x;
+    glm::vec3 mean;
+    glm::mat3 covariance;
+    points.GetCovariance(mean, covariance);
 
-        if (point.y >= max.y) max.y = point.y;
-        if (point.y <= min.y) min.y = point.y;
+    glm::mat3 principalAxes;
+    SymmetricEigen(covariance, principalAxes);
 
-        if (point.z >= max.z) max.z = point.z;
-        if (point.z <= min.z) min.z = point.z;
-    }
+    principalAxes[0] = glm::normalize(principalAxes[0]);
+    principalAxes[1] = glm::normalize(principalAxes[1] - principalAxes[0] * glm::dot(principalAxes[0], principalAxes[1]));
+    principalAxes[2] = glm::cross(principalAxes[0], principalAxes[1]);
+
+    points.Project(principalAxes, min, max);
 
-    // Eight vertices of the bounding box.
-    glm::vec3 vertex[8] =
+    const glm::vec3 principalHalfSize = (max - min) * 0.5f;
+
+    // Symmetric meshes, a cube say, have no single principal direction and the axes found can be worse than none. Surface
+    // area rather than volume so flat meshes still compare.
+    if (HalfSurfaceArea(principalHalfSize) < HalfSurfaceArea(halfSize))
     {
-        glm::vec3(min.x, max.y, max.z),
-        glm::vec3(min.x, max.y, min.z),
-        glm::vec3(min.x, min.y, max.z),
-        min,
-        max,
-        glm::vec3(max.x, max.y, min.z),
-        glm::vec3(max.x, min.y, max.z),
-        glm::vec3(max.x, min.y, min.z)
-    };
-    
-    // Half-length of sides
-    float halfWidth = glm::length(min - vertex[7]) / 2.0f;
-    float halfDepth = glm::length(min - vertex[2]) / 2.0f;
-    float halfHeight = glm::length(min - vertex[1]) / 2.0f;
+        center = principalAxes * ((min + max) * 0.5f);
+        axes = principalAxes;
+        halfSize = principalHalfSize;
+    }
+}
+
+void OrientedBoundingBox::SizeToMesh(const std::vector<Vertex>& verts)
+{
+    SizeToMesh(Math::PositionSoA(verts));
+}
+
+void OrientedBoundingBox::SizeToMesh(const Math::PositionSoA& points)
+{
+    glm::vec3 min;
+    glm::vec3 max;
+    points.Project(axes, min, max);
 
-    size = glm::vec3(halfWidth, halfHeight, halfDepth);
+    size = (max - min) * 0.5f;
+    localSize = size;
 
-    offset = min + ((max - min) / 2.f);
+    offset = axes * ((min + max) * 0.5f);
 }
 
 void OrientedBoundingBox::UpdateOrigin(const glm::mat4& mat)
@@ -148,11 +280,38 @@ void OrientedBoundingBox::UpdateOrigin(const glm::mat4& mat)
 void OrientedBoundingBox::SetSize(const glm::vec3& newSize)
 {
     size = newSize;
+    localSize = newSize;
+}
+
+void OrientedBoundingBox::Transform(const glm::mat4& transform)
+{
+    origin = transform * glm::vec4(offset, 1.0f);
+
+    // Scale in the transform grows the box, the axes stay unit length.
+    const glm::mat3 linear(transform);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const glm::vec3 axis = linear * glm::vec3(localOrientation[i]);
+        const float length = glm::length(axis);
+
+        axes[i] = (length > 0.0f) ? axis / length : axis;
+        size[i] = localSize[i] * length;
+    }
+
+    orientation = glm::mat4(axes);
 }
 
 void OrientedBoundingBox::SetOrientation(const glm::mat4& newOrientation)
 {
     orientation = newOrientation;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const glm::vec3 axis(orientation[i]);
+        const float length = glm::length(axis);
+        axes[i] = (length > 0.0f) ? axis / length : axis;
+    }
 }
 
 glm::vec3 OrientedBoundingBox::ClosestPoint(const glm::vec3& point) const
@@ -163,7 +322,7 @@ glm::vec3 OrientedBoundingBox::ClosestPoint(const glm::vec3& point) const
 
     for (unsigned int i = 0; i < 3; ++i)
     {
-        glm::vec3 axis = glm::normalize(orientation[i]);
+        const glm::vec3& axis = axes[i];
 
         float distance = glm::dot(dir, axis);
 
@@ -178,10 +337,3 @@ glm::vec3 OrientedBoundingBox::ClosestPoint(const glm::vec3& point) const
 
     return result;
 }
-
-bool OrientedBoundingBox::OverlapOnAxis(const OrientedBoundingBox& other, glm::vec3& axis) const
-{
-    Interval3D a(*this, axis);
-    Interval3D b(other, axis);
-    return ((b.GetMin() <= a.GetMax()) && (a.GetMin() <= b.GetMax()));
-}
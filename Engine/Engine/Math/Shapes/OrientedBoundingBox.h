@@ -7,14 +7,22 @@
 
 class Vertex;
 
+namespace Math
+{
+	class PositionSoA;
+}
+
 class OrientedBoundingBox
 {
 public:
 
 	OrientedBoundingBox(const glm::vec3& initialOrigin, const glm::vec3& initialSize, const glm::mat4& initialOrientation);
 
+	// Without an orientation the box's axes are fitted to the points, with one the box is sized along its axes.
 	OrientedBoundingBox(const std::vector<Vertex>& vertices, const glm::mat4& initialOrientation = glm::mat4(1.0f));
 
+	OrientedBoundingBox(const Math::PositionSoA& points, const glm::mat4& initialOrientation = glm::mat4(1.0f));
+
 	~OrientedBoundingBox();
 
 	const glm::vec3& GetOrigin() const;
@@ -23,6 +31,9 @@ public:
 
 	const glm::mat4& GetOrientation() const;
 
+	// The orientation's columns normalized, the box's local axes in world space.
+	const glm::mat3& GetAxes() const;
+
 	const glm::vec3& GetOffset() const;
 
 	void SetOrigin(const glm::vec3& newOrigin);
@@ -31,14 +42,30 @@ public:
 
 	void SetOrientation(const glm::mat4& newOrientation);
 
+	// Places the box, as it was built in local space, in the world with transform. Origin, size and orientation
+	// become the world state and the local box is kept, so this can be called every frame with a new transform.
+	void Transform(const glm::mat4& transform);
+
 	glm::vec3 ClosestPoint(const glm::vec3& point) const;
 
 	bool PointIntersect(const glm::vec3& point) const;
 
 	bool OrientedBoundingBoxIntersect(const OrientedBoundingBox& other) const;
 
+	// Separating axis test between two boxes given by their centers, axes and half sizes. The distance between the
+	// centers is projected on each of the 15 axes instead of the corners, and the edge axes are skipped when two
+	// axes are parallel since the face axes already decide it.
+	static bool SeparatingAxisTest(const glm::vec3& originA, const glm::mat3& axesA, const glm::vec3& sizeA, const glm::vec3& originB, const glm::mat3& axesB, const glm::vec3& sizeB);
+
+	// A tight box around points. The axes follow the principal components of the points, or the coordinate axes when
+	// that box turns out larger, and are right handed.
+	static void Fit(const Math::PositionSoA& points, glm::vec3& center, glm::mat3& axes, glm::vec3& halfSize);
+
+	// Sizes and centers the box around the vertices along its current axes, as if untransformed.
 	void SizeToMesh(const std::vector<Vertex>& vertices);
 
+	void SizeToMesh(const Math::PositionSoA& points);
+
 	void UpdateOrigin(const glm::mat4& mat);
 
 private:
@@ -51,16 +78,20 @@ private:
 
 	OrientedBoundingBox& operator=(OrientedBoundingBox&&) = delete;
 
-	bool OverlapOnAxis(const OrientedBoundingBox& other, glm::vec3& axis) const;
-
 	glm::vec3 origin;
 
 	glm::vec3 offset;
 
 	glm::vec3 size;
 
+	glm::vec3 localSize;
+
 	glm::mat4 orientation;
 
+	glm::mat4 localOrientation;
+
+	glm::mat3 axes;
+
 };
 
 #endif // ORIENTEDBOUNDINGBOX_H
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "OrientedBoundingBoxSoA.h"
+
+#include "OrientedBoundingBox.h"
+#include "../Lanes.h"
+
+using namespace Math::Lanes;
+
+namespace
+{
+	// The single box of a batched test, broadcast to every lane once.
+	template<typename L>
+	struct BoxLanes
+	{
+		L origin[3];
+
+		L axes[3][3];
+
+		L size[3];
+	};
+
+	template<typename L>
+	inline BoxLanes<L> BroadcastBox(const glm::vec3& origin, const glm::mat3& axes, const glm::vec3& size)
+	{
+		BoxLanes<L> box;
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			box.origin[i] = L::Set(origin[i]);
+			box.size[i] = L::Set(size[i]);
+
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				box.axes[i][j] = L::Set(axes[i][j]);
+			}
+		}
+
+		return box;
+	}
+
+	// OrientedBoundingBox::SeparatingAxisTest with B spread over the lanes. Lanes cannot skip the edge axes of parallel
+	// boxes on their own, so those rely on the epsilon alone. The edge axes are only tested if a lane is still touching.
+	template<typename L>
+	inline void IntersectLanes(const BoxLanes<L>& a, const OrientedBoundingBoxSoA& boxes, bool* results, unsigned int index)
+	{
+		typedef OrientedBoundingBoxSoA::Component Component;
+
+		const L zero = L::Set(0.0f);
+		const L one = L::Set(1.0f);
+		const L epsilon = L::Set(1e-6f);
+
+		L originB[3];
+		L axesB[3][3];
+		L sizeB[3];
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			originB[i] = L::Load(boxes.GetComponent(static_cast<Component>(OrientedBoundingBoxSoA::OriginX + i)) + index);
+			sizeB[i] = L::Load(boxes.GetComponent(static_cast<Component>(OrientedBoundingBoxSoA::SizeX + i)) + index);
+
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				axesB[i][j] = L::Load(boxes.GetComponent(static_cast<Component>(OrientedBoundingBoxSoA::AxisXX + i * 3 + j)) + index);
+			}
+		}
+
+		L r[3][3];
+		L absR[3][3];
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				r[i][j] = a.axes[i][0] * axesB[j][0] + a.axes[i][1] * axesB[j][1] + a.axes[i][2] * axesB[j][2];
+				absR[i][j] = Abs(r[i][j]) + epsilon;
+			}
+		}
+
+		const L distance[3] = { originB[0] - a.origin[0], originB[1] - a.origin[1], originB[2] - a.origin[2] };
+
+		L t[3];
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			t[i] = distance[0] * a.axes[i][0] + distance[1] * a.axes[i][1] + distance[2] * a.axes[i][2];
+		}
+
+		// One in every lane where some axis separates the boxes.
+		L separated = zero;
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			const L radiusB = sizeB[0] * absR[i][0] + sizeB[1] * absR[i][1] + sizeB[2] * absR[i][2];
+			separated = Max(separated, IfLess(a.size[i] + radiusB, Abs(t[i]), one, zero));
+		}
+
+		for (unsigned int j = 0; j < 3; j++)
+		{
+			const L radiusA = a.size[0] * absR[0][j] + a.size[1] * absR[1][j] + a.size[2] * absR[2][j];
+			separated = Max(separated, IfLess(radiusA + sizeB[j], Abs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]), one, zero));
+		}
+
+		float separatedValues[L::width];
+		separated.Store(separatedValues);
+
+		bool anyTouching = false;
+		for (unsigned int lane = 0; lane < L::width; lane++)
+		{
+			anyTouching = anyTouching || separatedValues[lane] == 0.0f;
+		}
+
+		if (anyTouching)
+		{
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				const unsigned int i1 = (i + 1) % 3;
+				const unsigned int i2 = (i + 2) % 3;
+
+				for (unsigned int j = 0; j < 3; j++)
+				{
+					const unsigned int j1 = (j + 1) % 3;
+					const unsigned int j2 = (j + 2) % 3;
+
+					const L radiusA = a.size[i1] * absR[i2][j] + a.size[i2] * absR[i1][j];
+					const L radiusB = sizeB[j1] * absR[i][j2] + sizeB[j2] * absR[i][j1];
+
+					separated = Max(separated, IfLess(radiusA + radiusB, Abs(t[i2] * r[i1][j] - t[i1] * r[i2][j]), one, zero));
+				}
+			}
+
+			separated.Store(separatedValues);
+		}
+
+		for (unsigned int lane = 0; lane < L::width; lane++)
+		{
+			results[index + lane] = separatedValues[lane] == 0.0f;
+		}
+	}
+}
+
+OrientedBoundingBoxSoA::OrientedBoundingBoxSoA() :
+	size(0U)
+{
+}
+
+OrientedBoundingBoxSoA::OrientedBoundingBoxSoA(unsigned int initialSize) :
+	size(0U)
+{
+	Resize(initialSize);
+}
+
+OrientedBoundingBoxSoA::~OrientedBoundingBoxSoA()
+{
+}
+
+void OrientedBoundingBoxSoA::Resize(unsigned int newSize)
+{
+	for (unsigned int component = 0; component < ComponentCount; component++)
+	{
+		const bool one = component == AxisXX || component == AxisYY || component == AxisZZ;
+		components[component].resize(newSize, one ? 1.0f : 0.0f);
+	}
+
+	size = newSize;
+}
+
+unsigned int OrientedBoundingBoxSoA::Size() const
+{
+	return size;
+}
+
+void OrientedBoundingBoxSoA::Set(unsigned int index, const OrientedBoundingBox& obb)
+{
+	Set(index, obb.GetOrigin(), obb.GetAxes(), obb.GetSize());
+}
+
+void OrientedBoundingBoxSoA::Set(unsigned int index, const glm::vec3& origin, const glm::mat3& axes, const glm::vec3& boxSize)
+{
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		components[OriginX + i][index] = origin[i];
+		components[SizeX + i][index] = boxSize[i];
+
+		for (unsigned int j = 0; j < 3; j++)
+		{
+			components[AxisXX + i * 3 + j][index] = axes[i][j];
+		}
+	}
+}
+
+unsigned int OrientedBoundingBoxSoA::Intersect(const OrientedBoundingBox& obb, const OrientedBoundingBoxSoA& boxes, bool* results)
+{
+	return Intersect(obb.GetOrigin(), obb.GetAxes(), obb.GetSize(), boxes, results);
+}
+
+unsigned int OrientedBoundingBoxSoA::Intersect(const glm::vec3& origin, const glm::mat3& axes, const glm::vec3& boxSize, const OrientedBoundingBoxSoA& boxes, bool* results)
+{
+	const BoxLanes<WideLane> wide = BroadcastBox<WideLane>(origin, axes, boxSize);
+	const BoxLanes<ScalarLane> scalar = BroadcastBox<ScalarLane>(origin, axes, boxSize);
+
+	ForEachLane(boxes.size, [&](auto lane, unsigned int i)
+	{
+		typedef decltype(lane) L;
+
+		if constexpr (L::width == 1)
+		{
+			IntersectLanes<ScalarLane>(scalar, boxes, results, i);
+		}
+		else
+		{
+			IntersectLanes<WideLane>(wide, boxes, results, i);
+		}
+	});
+
+	unsigned int count = 0U;
+	for (unsigned int i = 0; i < boxes.size; i++)
+	{
+		count += results[i] ? 1U : 0U;
+	}
+
+	return count;
+}
+
+float* OrientedBoundingBoxSoA::GetComponent(Component component)
+{
+	return components[component].data();
+}
+
+const float* OrientedBoundingBoxSoA::GetComponent(Component component) const
+{
+	return components[component].data();
+}
@@ -0,0 +1,79 @@
+#ifndef ORIENTEDBOUNDINGBOXSOA_H
+#define ORIENTEDBOUNDINGBOXSOA_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class OrientedBoundingBox;
+
+// Oriented boxes stored one array per component, so one box can be tested against several of them at a time with SIMD.
+// Meant for sets that are tested together often, like the joint boxes of a character.
+class OrientedBoundingBoxSoA
+{
+public:
+
+	OrientedBoundingBoxSoA();
+
+	OrientedBoundingBoxSoA(unsigned int size);
+
+	~OrientedBoundingBoxSoA();
+
+	OrientedBoundingBoxSoA(const OrientedBoundingBoxSoA&) = default;
+
+	OrientedBoundingBoxSoA& operator=(const OrientedBoundingBoxSoA&) = default;
+
+	OrientedBoundingBoxSoA(OrientedBoundingBoxSoA&&) = default;
+
+	OrientedBoundingBoxSoA& operator=(OrientedBoundingBoxSoA&&) = default;
+
+	// New boxes are empty boxes at the origin.
+	void Resize(unsigned int size);
+
+	unsigned int Size() const;
+
+	void Set(unsigned int index, const OrientedBoundingBox& obb);
+
+	void Set(unsigned int index, const glm::vec3& origin, const glm::mat3& axes, const glm::vec3& size);
+
+	// results[i] = obb.OrientedBoundingBoxIntersect(boxes[i]), results must hold boxes.Size() values.
+	// Returns how many of the boxes intersect obb.
+	static unsigned int Intersect(const OrientedBoundingBox& obb, const OrientedBoundingBoxSoA& boxes, bool* results);
+
+	// The same test with the single box given by its center, normalized axes and half sizes.
+	static unsigned int Intersect(const glm::vec3& origin, const glm::mat3& axes, const glm::vec3& size, const OrientedBoundingBoxSoA& boxes, bool* results);
+
+	enum Component
+	{
+		OriginX,
+		OriginY,
+		OriginZ,
+		// AxisYZ is the z component of the box's y axis.
+		AxisXX,
+		AxisXY,
+		AxisXZ,
+		AxisYX,
+		AxisYY,
+		AxisYZ,
+		AxisZX,
+		AxisZY,
+		AxisZZ,
+		SizeX,
+		SizeY,
+		SizeZ,
+		ComponentCount
+	};
+
+	float* GetComponent(Component component);
+
+	const float* GetComponent(Component component) const;
+
+private:
+
+	std::vector<float> components[ComponentCount];
+
+	unsigned int size;
+
+};
+
+#endif // ORIENTEDBOUNDINGBOXSOA_H
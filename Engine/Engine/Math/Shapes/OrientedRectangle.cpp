@@ -39,6 +39,17 @@ const glm::vec2& OrientedRectangle::GetHalfExtents() const
 	return halfExtents;
 }
 
+void OrientedRectangle::GetBounds(glm::vec2& min, glm::vec2& max) const
+{
+	const float cosine = fabsf(cosf(rotation));
+	const float sine = fabsf(sinf(rotation));
+
+	const glm::vec2 extent(cosine * halfExtents.x + sine * halfExtents.y, sine * halfExtents.x + cosine * halfExtents.y);
+
+	min = position - extent;
+	max = position + extent;
+}
+
 bool OrientedRectangle::PointIntersect(const glm::vec3& point) const
 {
 	glm::vec2 rotVec = glm::vec2(point) - position;
@@ -23,6 +23,9 @@ public:
 
 	const glm::vec2& GetHalfExtents() const;
 
+	// The axis aligned box around the rectangle as rotated.
+	void GetBounds(glm::vec2& min, glm::vec2& max) const;
+
 	bool PointIntersect(const glm::vec3& point) const;
 
 	bool LineIntersect(const LineSegment& line) const;
@@ -3,74 +3,56 @@
 #include "AxisAlignedBoundingBox.h"
 #include "OrientedBoundingBox.h"
 #include "Plane.h"
+#include "../PositionSoA.h"
 #include "../../Renderer/Model/Vertex.h"
 
-Sphere::Sphere(const glm::vec3& initialOrigin, float initialRadius) :
-	origin(initialOrigin),
-	radius(initialRadius)
+namespace
 {
-}
-
-Sphere::Sphere(const std::vector<Vertex>& verts)
-{
-	// Find min and max on all axes.
-	glm::vec3 first = verts[0].GetPosition();
-	glm::vec3 minX = first;
-	glm::vec3 minY = first;
-	glm::vec3 minZ = first;
-	glm::vec3 maxX = first;
-	glm::vec3 maxY = first;
-	glm::vec3 maxZ = first;
-
-	for (const Vertex& vert : verts)
+	// Grows the sphere toward the farthest point until it holds every point, each step a SIMD pass over all of them.
+	void GrowToFit(const Math::PositionSoA& points, glm::vec3& center, float& radius)
 	{
-		const glm::vec3& pos = vert.GetPosition();
-		if (pos.x <= minX.x) minX = pos;
-		if (pos.x >= maxX.x) maxX = pos;
-
-		if (pos.y <= minY.y) minY = pos;
-		if (pos.y >= maxY.y) maxY = pos;
+		for (unsigned int step = 0; step < 8; step++)
+		{
+			float distanceSquared;
+			const unsigned int farthest = points.GetFarthest(center, distanceSquared);
+
+			if (distanceSquared <= radius * radius)
+			{
+				return;
+			}
+
+			// The new sphere touches the farthest point and the far side of the old one.
+			const float distance = sqrtf(distanceSquared);
+			const float newRadius = (radius + distance) * 0.5f;
+			center += (points.Get(farthest) - center) * ((newRadius - radius) / distance);
+			radius = newRadius;
+		}
 
-		if (pos.z <= minZ.z) minZ = pos;
-		if (pos.z >= maxZ.z) maxZ = pos;
+		// Round points can take many small steps, past a few the radius is simply grown to the farthest point.
+		float distanceSquared;
+		points.GetFarthest(center, distanceSquared);
+		radius = glm::max(radius, sqrtf(distanceSquared));
 	}
+}
 
-	// Determine which axis has greatest range.
-	int axis = 0; // x = 0, y = 1, z = 2
-	float max = 0, cur = 0;
-
-	if ((cur = glm::length((minX - maxX))) >= max) { axis = 0; max = cur; }
-	if ((cur = glm::length((minY - maxY))) >= max) { axis = 1; max = cur; }
-	if ((cur = glm::length((minZ - maxZ))) >= max) { axis = 2; max = cur; }
+Sphere::Sphere(const glm::vec3& initialOrigin, float initialRadius) :
+	origin(initialOrigin),
+	radius(initialRadius),
+	offset(initialOrigin),
+	localRadius(initialRadius)
+{
+}
 
-	// Determine center and radius.
-	this->radius = max / 2;
-	switch (axis)
-	{
-	case 0:
-		origin = minX + glm::normalize((maxX - minX)) * radius;
-		break;
-	case 1:
-		origin = minY + glm::normalize((maxY - minY)) * radius;
-		break;
-	case 2:
-		origin = minZ + glm::normalize((maxZ - minZ)) * radius;
-		break;
-	}
+Sphere::Sphere(const std::vector<Vertex>& verts) :
+	Sphere(Math::PositionSoA(verts))
+{
+}
 
-	// Adjust center and radius.
-	for (const Vertex& vert : verts)
-	{
-		const glm::vec3& pos = vert.GetPosition();
-		float dist;
-		glm::vec3 direction;
-		if ((dist = glm::length(direction = pos - origin)) > radius)
-		{
-			radius += (dist -= radius);
-			origin += glm::normalize(pos) * dist;
-		}
-	}
+Sphere::Sphere(const Math::PositionSoA& points)
+{
+	Fit(points, origin, radius);
 	offset = origin;
+	localRadius = radius;
 }
 
 Sphere::~Sphere()
@@ -100,6 +82,10 @@ void Sphere::SetOrigin(const glm::vec3& newOrigin)
 void Sphere::Transform(const glm::mat4& transform)
 {
 	origin = transform * glm::vec4(offset, 1.0f);
+
+	// The largest scale of the transform keeps the sphere around everything it bounded.
+	const float scale = glm::max(glm::length(glm::vec3(transform[0])), glm::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+	radius = localRadius * scale;
 }
 
 bool Sphere::PointIntersect(const glm::vec3& point) const
@@ -157,3 +143,71 @@ glm::vec3 Sphere::ClosestPoint(const glm::vec3& point) const
 	glm::vec3 toPoint = glm::normalize(point - origin);
 	return origin + toPoint * radius;
 }
+
+void Sphere::Fit(const Math::PositionSoA& points, glm::vec3& center, float& radius)
+{
+	center = glm::vec3(0.0f);
+	radius = 0.0f;
+
+	if (points.Size() == 0)
+	{
+		return;
+	}
+
+	// The most distant pair of extreme points along the coordinate axes.
+	unsigned int minIndices[3];
+	unsigned int maxIndices[3];
+	points.GetExtremes(minIndices, maxIndices);
+
+	float widest = -1.0f;
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		const glm::vec3 min = points.Get(minIndices[axis]);
+		const glm::vec3 max = points.Get(maxIndices[axis]);
+		const float lengthSquared = glm::dot(max - min, max - min);
+
+		if (lengthSquared > widest)
+		{
+			widest = lengthSquared;
+			center = (min + max) * 0.5f;
+			radius = sqrtf(lengthSquared) * 0.5f;
+		}
+	}
+
+	GrowToFit(points, center, radius);
+
+	glm::vec3 shrunkCenter = center;
+	float shrunkRadius = radius;
+
+	for (unsigned int iteration = 0; iteration < 8; iteration++)
+	{
+		shrunkRadius *= 0.95f;
+		GrowToFit(points, shrunkCenter, shrunkRadius);
+
+		if (shrunkRadius < radius)
+		{
+			center = shrunkCenter;
+			radius = shrunkRadius;
+		}
+	}
+
+	glm::vec3 min;
+	glm::vec3 max;
+	points.GetBounds(min, max);
+
+	float distanceSquared;
+	const glm::vec3 boxCenter = (min + max) * 0.5f;
+	points.GetFarthest(boxCenter, distanceSquared);
+
+	if (distanceSquared < radius * radius)
+	{
+		center = boxCenter;
+		radius = sqrtf(distanceSquared);
+		return;
+	}
+
+	// Exactly as far as the farthest point, the growing steps only bound it from above.
+	points.GetFarthest(center, distanceSquared);
+	radius = sqrtf(distanceSquared);
+}
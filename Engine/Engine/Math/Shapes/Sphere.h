@@ -10,6 +10,11 @@ class OrientedBoundingBox;
 class Plane;
 class Vertex;
 
+namespace Math
+{
+	class PositionSoA;
+}
+
 class Sphere
 {
 
@@ -19,6 +24,8 @@ public:
 
 	Sphere(const std::vector<Vertex>& vertices);
 
+	Sphere(const Math::PositionSoA& points);
+
 	~Sphere();
 
 	const glm::vec3& GetOrigin() const;
@@ -29,6 +36,7 @@ public:
 
 	void SetOrigin(const glm::vec3& newOrigin);
 
+	// Moves the sphere, as it was built in local space, into the world with transform.
 	void Transform(const glm::mat4& transform);
 
 	bool PointIntersect(const glm::vec3& point) const;
@@ -43,6 +51,10 @@ public:
 
 	glm::vec3 ClosestPoint(const glm::vec3& point) const;
 
+	// A tight sphere around points. Ritter's sphere from the extreme points, then shrunk and grown back around the
+	// farthest point a few times keeping the smallest, and never larger than the one centered on the bounding box.
+	static void Fit(const Math::PositionSoA& points, glm::vec3& center, float& radius);
+
 private:
 
 	Sphere(const Sphere&) = delete;
@@ -58,6 +70,8 @@ private:
 	float radius;
 
 	glm::vec3 offset;
+
+	float localRadius;
 };
 
 #endif // SPHERE_H
\ No newline at end of file
@@ -1,5 +1,12 @@
 #include "Triangle.h"
 
+Triangle::Triangle(const glm::vec3& intitialPoint0, const glm::vec3& initialPoint1, const glm::vec3& intitialPoint2) :
+	point0(intitialPoint0),
+	point1(initialPoint1),
+	point2(intitialPoint2)
+{
+}
+
 Triangle::~Triangle()
 {
 }
@@ -94,7 +94,7 @@ glm::vec3 Math::Transform::TransformPoint(const Transform& t, const glm::vec3& p
 	glm::vec3 out;
 
 	out = t.rotation * (t.scale * p);
-	out = t.position * out;
+	out = t.position + out;
 
 	return out;
 }
@@ -140,3 +140,18 @@ glm::vec3& Math::Transform::Scale()
 {
 	return scale;
 }
+
+const glm::vec3& Math::Transform::Position() const
+{
+	return position;
+}
+
+const glm::quat& Math::Transform::Rotation() const
+{
+	return rotation;
+}
+
+const glm::vec3& Math::Transform::Scale() const
+{
+	return scale;
+}
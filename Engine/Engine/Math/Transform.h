@@ -47,6 +47,12 @@ namespace Math
 
 		glm::vec3& Scale();
 
+		const glm::vec3& Position() const;
+
+		const glm::quat& Rotation() const;
+
+		const glm::vec3& Scale() const;
+
 	private:
 
 		glm::vec3 position;
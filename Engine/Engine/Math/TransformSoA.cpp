@@ -0,0 +1,399 @@
+#include "TransformSoA.h"
+
+#include "Lanes.h"
+
+#include <cmath>
+
+using namespace Math;
+using namespace Math::Lanes;
+
+namespace
+{
+	template<typename L>
+	struct Vec3Lanes
+	{
+		L x, y, z;
+	};
+
+	template<typename L>
+	struct QuatLanes
+	{
+		L x, y, z, w;
+	};
+
+	template<typename L>
+	struct TransformLanes
+	{
+		Vec3Lanes<L> position;
+
+		QuatLanes<L> rotation;
+
+		Vec3Lanes<L> scale;
+	};
+
+	template<typename L>
+	inline TransformLanes<L> LoadTransforms(const TransformSoA& transforms, unsigned int i)
+	{
+		TransformLanes<L> t;
+		t.position = { L::Load(transforms.GetComponent(TransformSoA::PositionX) + i), L::Load(transforms.GetComponent(TransformSoA::PositionY) + i), L::Load(transforms.GetComponent(TransformSoA::PositionZ) + i) };
+		t.rotation = { L::Load(transforms.GetComponent(TransformSoA::RotationX) + i), L::Load(transforms.GetComponent(TransformSoA::RotationY) + i), L::Load(transforms.GetComponent(TransformSoA::RotationZ) + i), L::Load(transforms.GetComponent(TransformSoA::RotationW) + i) };
+		t.scale = { L::Load(transforms.GetComponent(TransformSoA::ScaleX) + i), L::Load(transforms.GetComponent(TransformSoA::ScaleY) + i), L::Load(transforms.GetComponent(TransformSoA::ScaleZ) + i) };
+		return t;
+	}
+
+	template<typename L>
+	inline void StoreTransforms(const TransformLanes<L>& t, TransformSoA& transforms, unsigned int i)
+	{
+		t.position.x.Store(transforms.GetComponent(TransformSoA::PositionX) + i);
+		t.position.y.Store(transforms.GetComponent(TransformSoA::PositionY) + i);
+		t.position.z.Store(transforms.GetComponent(TransformSoA::PositionZ) + i);
+		t.rotation.x.Store(transforms.GetComponent(TransformSoA::RotationX) + i);
+		t.rotation.y.Store(transforms.GetComponent(TransformSoA::RotationY) + i);
+		t.rotation.z.Store(transforms.GetComponent(TransformSoA::RotationZ) + i);
+		t.rotation.w.Store(transforms.GetComponent(TransformSoA::RotationW) + i);
+		t.scale.x.Store(transforms.GetComponent(TransformSoA::ScaleX) + i);
+		t.scale.y.Store(transforms.GetComponent(TransformSoA::ScaleY) + i);
+		t.scale.z.Store(transforms.GetComponent(TransformSoA::ScaleZ) + i);
+	}
+
+	// glm's cross.
+	template<typename L>
+	inline Vec3Lanes<L> Cross(const Vec3Lanes<L>& a, const Vec3Lanes<L>& b)
+	{
+		return { a.y * b.z - b.y * a.z, a.z * b.x - b.z * a.x, a.x * b.y - b.x * a.y };
+	}
+
+	// glm's quat * vec3.
+	template<typename L>
+	inline Vec3Lanes<L> Rotate(const QuatLanes<L>& q, const Vec3Lanes<L>& v)
+	{
+		const Vec3Lanes<L> quatVector = { q.x, q.y, q.z };
+		const Vec3Lanes<L> uv = Cross(quatVector, v);
+		const Vec3Lanes<L> uuv = Cross(quatVector, uv);
+		const L two = L::Set(2.0f);
+
+		return { v.x + ((uv.x * q.w) + uuv.x) * two, v.y + ((uv.y * q.w) + uuv.y) * two, v.z + ((uv.z * q.w) + uuv.z) * two };
+	}
+
+	// glm's quat * quat.
+	template<typename L>
+	inline QuatLanes<L> Multiply(const QuatLanes<L>& p, const QuatLanes<L>& q)
+	{
+		QuatLanes<L> result;
+		result.w = p.w * q.w - p.x * q.x - p.y * q.y - p.z * q.z;
+		result.x = p.w * q.x + p.x * q.w + p.y * q.z - p.z * q.y;
+		result.y = p.w * q.y + p.y * q.w + p.z * q.x - p.x * q.z;
+		result.z = p.w * q.z + p.z * q.w + p.x * q.y - p.y * q.x;
+		return result;
+	}
+
+	// glm's quaternion dot.
+	template<typename L>
+	inline L Dot(const QuatLanes<L>& a, const QuatLanes<L>& b)
+	{
+		return (a.w * b.w + a.x * b.x) + (a.y * b.y + a.z * b.z);
+	}
+
+	template<typename L>
+	inline Vec3Lanes<L> Lerp(const Vec3Lanes<L>& a, const Vec3Lanes<L>& b, L t)
+	{
+		const L oneMinusT = L::Set(1.0f) - t;
+		return { a.x * oneMinusT + b.x * t, a.y * oneMinusT + b.y * t, a.z * oneMinusT + b.z * t };
+	}
+
+	// glm::normalize, including its identity result for a zero length quaternion.
+	template<typename L>
+	inline QuatLanes<L> Normalize(const QuatLanes<L>& q)
+	{
+		const L zero = L::Set(0.0f);
+		const L length = Sqrt(Dot(q, q));
+		const L oneOverLength = L::Set(1.0f) / length;
+
+		QuatLanes<L> result;
+		result.x = IfLess(zero, length, q.x * oneOverLength, zero);
+		result.y = IfLess(zero, length, q.y * oneOverLength, zero);
+		result.z = IfLess(zero, length, q.z * oneOverLength, zero);
+		result.w = IfLess(zero, length, q.w * oneOverLength, L::Set(1.0f));
+		return result;
+	}
+
+	// Math::NLerp after the same neighborhood check as Transform::Mix.
+	template<typename L>
+	inline QuatLanes<L> NLerp(const QuatLanes<L>& a, const QuatLanes<L>& b, L t)
+	{
+		const L zero = L::Set(0.0f);
+		const L dot = Dot(a, b);
+
+		QuatLanes<L> end;
+		end.x = IfLess(dot, zero, zero - b.x, b.x);
+		end.y = IfLess(dot, zero, zero - b.y, b.y);
+		end.z = IfLess(dot, zero, zero - b.z, b.z);
+		end.w = IfLess(dot, zero, zero - b.w, b.w);
+
+		QuatLanes<L> mixed;
+		mixed.x = a.x + (end.x - a.x) * t;
+		mixed.y = a.y + (end.y - a.y) * t;
+		mixed.z = a.z + (end.z - a.z) * t;
+		mixed.w = a.w + (end.w - a.w) * t;
+
+		return Normalize(mixed);
+	}
+
+	template<typename L>
+	inline void CombineLanes(const TransformSoA& a, const TransformSoA& b, TransformSoA& out, unsigned int i)
+	{
+		const TransformLanes<L> first = LoadTransforms<L>(a, i);
+		const TransformLanes<L> second = LoadTransforms<L>(b, i);
+
+		TransformLanes<L> result;
+		result.scale = { first.scale.x * second.scale.x, first.scale.y * second.scale.y, first.scale.z * second.scale.z };
+		result.rotation = Multiply(first.rotation, second.rotation);
+
+		const Vec3Lanes<L> scaledPosition = { first.scale.x * second.position.x, first.scale.y * second.position.y, first.scale.z * second.position.z };
+		const Vec3Lanes<L> rotatedPosition = Rotate(first.rotation, scaledPosition);
+		result.position = { first.position.x + rotatedPosition.x, first.position.y + rotatedPosition.y, first.position.z + rotatedPosition.z };
+
+		StoreTransforms(result, out, i);
+	}
+
+	template<typename L>
+	inline void MixLanes(const TransformSoA& a, const TransformSoA& b, L positionTime, L rotationTime, L scaleTime, TransformSoA& out, unsigned int i)
+	{
+		const TransformLanes<L> first = LoadTransforms<L>(a, i);
+		const TransformLanes<L> second = LoadTransforms<L>(b, i);
+
+		TransformLanes<L> result;
+		result.position = Lerp(first.position, second.position, positionTime);
+		result.rotation = NLerp(first.rotation, second.rotation, rotationTime);
+		result.scale = Lerp(first.scale, second.scale, scaleTime);
+
+		StoreTransforms(result, out, i);
+	}
+
+	template<typename L>
+	inline void AddLanes(const TransformSoA& base, const TransformSoA& additive, const TransformSoA& reference, L weight, TransformSoA& out, unsigned int i)
+	{
+		const TransformLanes<L> b = LoadTransforms<L>(base, i);
+		const TransformLanes<L> a = LoadTransforms<L>(additive, i);
+		const TransformLanes<L> r = LoadTransforms<L>(reference, i);
+		const L zero = L::Set(0.0f);
+		const L one = L::Set(1.0f);
+
+		TransformLanes<L> result;
+		result.position = { b.position.x + (a.position.x - r.position.x) * weight, b.position.y + (a.position.y - r.position.y) * weight, b.position.z + (a.position.z - r.position.z) * weight };
+
+		const Vec3Lanes<L> scaleDelta = { a.scale.x / r.scale.x, a.scale.y / r.scale.y, a.scale.z / r.scale.z };
+		const Vec3Lanes<L> weightedScale = Lerp(Vec3Lanes<L>{ one, one, one }, scaleDelta, weight);
+		result.scale = { b.scale.x * weightedScale.x, b.scale.y * weightedScale.y, b.scale.z * weightedScale.z };
+
+		// The reference rotation is a unit quaternion, so its conjugate is its inverse.
+		const QuatLanes<L> inverseReference = { zero - r.rotation.x, zero - r.rotation.y, zero - r.rotation.z, r.rotation.w };
+		const QuatLanes<L> rotationDelta = NLerp(QuatLanes<L>{ zero, zero, zero, one }, Multiply(inverseReference, a.rotation), weight);
+		result.rotation = Normalize(Multiply(b.rotation, rotationDelta));
+
+		StoreTransforms(result, out, i);
+	}
+
+	template<typename L>
+	inline void ToMat4Lanes(const TransformSoA& transforms, glm::mat4* outMatrices, unsigned int i)
+	{
+		const TransformLanes<L> t = LoadTransforms<L>(transforms, i);
+		const L zero = L::Set(0.0f);
+		const L one = L::Set(1.0f);
+
+		const Vec3Lanes<L> x = Rotate(t.rotation, Vec3Lanes<L>{ one, zero, zero });
+		const Vec3Lanes<L> y = Rotate(t.rotation, Vec3Lanes<L>{ zero, one, zero });
+		const Vec3Lanes<L> z = Rotate(t.rotation, Vec3Lanes<L>{ zero, zero, one });
+
+		// Column major like glm, the matrices are written back one at a time.
+		const L columns[12] =
+		{
+			x.x * t.scale.x, x.y * t.scale.x, x.z * t.scale.x,
+			y.x * t.scale.y, y.y * t.scale.y, y.z * t.scale.y,
+			z.x * t.scale.z, z.y * t.scale.z, z.z * t.scale.z,
+			t.position.x, t.position.y, t.position.z
+		};
+
+		float values[12][L::width];
+		for (unsigned int c = 0; c < 12; c++)
+		{
+			columns[c].Store(values[c]);
+		}
+
+		for (unsigned int lane = 0; lane < L::width; lane++)
+		{
+			glm::mat4& m = outMatrices[i + lane];
+			m[0] = glm::vec4(values[0][lane], values[1][lane], values[2][lane], 0.0f);
+			m[1] = glm::vec4(values[3][lane], values[4][lane], values[5][lane], 0.0f);
+			m[2] = glm::vec4(values[6][lane], values[7][lane], values[8][lane], 0.0f);
+			m[3] = glm::vec4(values[9][lane], values[10][lane], values[11][lane], 1.0f);
+		}
+	}
+
+	template<typename L>
+	inline void TransformLanesOf(const TransformSoA& transforms, const glm::vec3* in, glm::vec3* out, unsigned int i, bool translate)
+	{
+		const TransformLanes<L> t = LoadTransforms<L>(transforms, i);
+
+		float inValues[3][L::width];
+		for (unsigned int lane = 0; lane < L::width; lane++)
+		{
+			inValues[0][lane] = in[i + lane].x;
+			inValues[1][lane] = in[i + lane].y;
+			inValues[2][lane] = in[i + lane].z;
+		}
+
+		const Vec3Lanes<L> scaled = { t.scale.x * L::Load(inValues[0]), t.scale.y * L::Load(inValues[1]), t.scale.z * L::Load(inValues[2]) };
+		Vec3Lanes<L> result = Rotate(t.rotation, scaled);
+
+		if (translate)
+		{
+			result = { t.position.x + result.x, t.position.y + result.y, t.position.z + result.z };
+		}
+
+		float outValues[3][L::width];
+		result.x.Store(outValues[0]);
+		result.y.Store(outValues[1]);
+		result.z.Store(outValues[2]);
+
+		for (unsigned int lane = 0; lane < L::width; lane++)
+		{
+			out[i + lane] = glm::vec3(outValues[0][lane], outValues[1][lane], outValues[2][lane]);
+		}
+	}
+}
+
+TransformSoA::TransformSoA() :
+	size(0U)
+{
+}
+
+TransformSoA::TransformSoA(unsigned int initialSize) :
+	size(0U)
+{
+	Resize(initialSize);
+}
+
+TransformSoA::~TransformSoA()
+{
+}
+
+void TransformSoA::Resize(unsigned int newSize)
+{
+	for (unsigned int component = 0; component < ComponentCount; component++)
+	{
+		const bool one = component == RotationW || component == ScaleX || component == ScaleY || component == ScaleZ;
+		components[component].resize(newSize, one ? 1.0f : 0.0f);
+	}
+
+	size = newSize;
+}
+
+unsigned int TransformSoA::Size() const
+{
+	return size;
+}
+
+void TransformSoA::Set(unsigned int index, const Transform& transform)
+{
+	const glm::vec3& position = transform.Position();
+	const glm::quat& rotation = transform.Rotation();
+	const glm::vec3& scale = transform.Scale();
+
+	components[PositionX][index] = position.x;
+	components[PositionY][index] = position.y;
+	components[PositionZ][index] = position.z;
+	components[RotationX][index] = rotation.x;
+	components[RotationY][index] = rotation.y;
+	components[RotationZ][index] = rotation.z;
+	components[RotationW][index] = rotation.w;
+	components[ScaleX][index] = scale.x;
+	components[ScaleY][index] = scale.y;
+	components[ScaleZ][index] = scale.z;
+}
+
+Transform TransformSoA::Get(unsigned int index) const
+{
+	return Transform(
+		glm::vec3(components[PositionX][index], components[PositionY][index], components[PositionZ][index]),
+		glm::quat(components[RotationW][index], components[RotationX][index], components[RotationY][index], components[RotationZ][index]),
+		glm::vec3(components[ScaleX][index], components[ScaleY][index], components[ScaleZ][index])
+	);
+}
+
+void TransformSoA::Combine(const TransformSoA& a, const TransformSoA& b, TransformSoA& out)
+{
+	out.Resize(a.size);
+
+	ForEachLane(a.size, [&](auto lane, unsigned int i)
+	{
+		CombineLanes<decltype(lane)>(a, b, out, i);
+	});
+}
+
+void TransformSoA::Mix(const TransformSoA& a, const TransformSoA& b, float time, TransformSoA& out)
+{
+	out.Resize(a.size);
+
+	ForEachLane(a.size, [&](auto lane, unsigned int i)
+	{
+		typedef decltype(lane) L;
+		MixLanes<L>(a, b, L::Set(time), L::Set(time), L::Set(time), out, i);
+	});
+}
+
+void TransformSoA::Mix(const TransformSoA& a, const TransformSoA& b, const float* positionTimes, const float* rotationTimes, const float* scaleTimes, TransformSoA& out)
+{
+	out.Resize(a.size);
+
+	ForEachLane(a.size, [&](auto lane, unsigned int i)
+	{
+		typedef decltype(lane) L;
+		MixLanes<L>(a, b, L::Load(positionTimes + i), L::Load(rotationTimes + i), L::Load(scaleTimes + i), out, i);
+	});
+}
+
+void TransformSoA::Add(const TransformSoA& base, const TransformSoA& additive, const TransformSoA& reference, const float* weights, TransformSoA& out)
+{
+	out.Resize(base.size);
+
+	ForEachLane(base.size, [&](auto lane, unsigned int i)
+	{
+		typedef decltype(lane) L;
+		AddLanes<L>(base, additive, reference, L::Load(weights + i), out, i);
+	});
+}
+
+void TransformSoA::ToMat4(const TransformSoA& transforms, glm::mat4* outMatrices)
+{
+	ForEachLane(transforms.size, [&](auto lane, unsigned int i)
+	{
+		ToMat4Lanes<decltype(lane)>(transforms, outMatrices, i);
+	});
+}
+
+void TransformSoA::TransformPoints(const TransformSoA& transforms, const glm::vec3* points, glm::vec3* outPoints)
+{
+	ForEachLane(transforms.size, [&](auto lane, unsigned int i)
+	{
+		TransformLanesOf<decltype(lane)>(transforms, points, outPoints, i, true);
+	});
+}
+
+void TransformSoA::TransformVectors(const TransformSoA& transforms, const glm::vec3* vectors, glm::vec3* outVectors)
+{
+	ForEachLane(transforms.size, [&](auto lane, unsigned int i)
+	{
+		TransformLanesOf<decltype(lane)>(transforms, vectors, outVectors, i, false);
+	});
+}
+
+float* TransformSoA::GetComponent(Component component)
+{
+	return components[component].data();
+}
+
+const float* TransformSoA::GetComponent(Component component) const
+{
+	return components[component].data();
+}
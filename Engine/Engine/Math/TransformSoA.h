@@ -0,0 +1,91 @@
+#ifndef TRANSFORMSOA_H
+#define TRANSFORMSOA_H
+
+#include "Transform.h"
+
+#include <vector>
+
+namespace Math
+{
+	// Transforms stored one array per component so batches of them can be processed several at a time with SIMD.
+	// The kernels use AVX2, SSE2 or NEON when the compiler targets them and plain scalar code otherwise, and follow the
+	// operation order of the matching Transform functions.
+	class TransformSoA
+	{
+
+	public:
+
+		TransformSoA();
+
+		TransformSoA(unsigned int size);
+
+		~TransformSoA();
+
+		TransformSoA(const TransformSoA&) = default;
+
+		TransformSoA& operator=(const TransformSoA&) = default;
+
+		TransformSoA(TransformSoA&&) = default;
+
+		TransformSoA& operator=(TransformSoA&&) = default;
+
+		// New transforms are identities.
+		void Resize(unsigned int size);
+
+		unsigned int Size() const;
+
+		void Set(unsigned int index, const Transform& transform);
+
+		Transform Get(unsigned int index) const;
+
+		// out[i] = Transform::Combine(a[i], b[i]).
+		static void Combine(const TransformSoA& a, const TransformSoA& b, TransformSoA& out);
+
+		// out[i] = Transform::Mix(a[i], b[i], time).
+		static void Mix(const TransformSoA& a, const TransformSoA& b, float time, TransformSoA& out);
+
+		// Mix with a separate time per transform and per channel, each array holding Size() values.
+		static void Mix(const TransformSoA& a, const TransformSoA& b, const float* positionTimes, const float* rotationTimes, const float* scaleTimes, TransformSoA& out);
+
+		// Layers the difference between additive[i] and reference[i] onto base[i], scaled by weights[i]. Positions add, scales
+		// multiply and rotations are applied after the base rotation. Reference scales must not be zero.
+		static void Add(const TransformSoA& base, const TransformSoA& additive, const TransformSoA& reference, const float* weights, TransformSoA& out);
+
+		// outMatrices[i] = transforms[i].ToMat4(), outMatrices must hold Size() matrices.
+		static void ToMat4(const TransformSoA& transforms, glm::mat4* outMatrices);
+
+		// outPoints[i] = Transform::TransformPoint(transforms[i], points[i]), both arrays hold Size() points.
+		static void TransformPoints(const TransformSoA& transforms, const glm::vec3* points, glm::vec3* outPoints);
+
+		// outVectors[i] = Transform::TransformVector(transforms[i], vectors[i]).
+		static void TransformVectors(const TransformSoA& transforms, const glm::vec3* vectors, glm::vec3* outVectors);
+
+		enum Component
+		{
+			PositionX,
+			PositionY,
+			PositionZ,
+			RotationX,
+			RotationY,
+			RotationZ,
+			RotationW,
+			ScaleX,
+			ScaleY,
+			ScaleZ,
+			ComponentCount
+		};
+
+		float* GetComponent(Component component);
+
+		const float* GetComponent(Component component) const;
+
+	private:
+
+		std::vector<float> components[ComponentCount];
+
+		unsigned int size;
+
+	};
+};
+
+#endif // TRANSFORMSOA_H
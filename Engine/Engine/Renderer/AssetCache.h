@@ -0,0 +1,531 @@
+#ifndef ASSETCACHE_H
+#define ASSETCACHE_H
+
+#include "../Utils/Logger.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <limits>
+
+struct AssetResidentSize
+{
+	size_t cpuBytes = 0;
+
+	size_t gpuBytes = 0;
+};
+
+template<typename T>
+struct AssetEntry
+{
+	std::string name;
+
+	T* asset = nullptr;
+
+	std::atomic<unsigned int> references = 0;
+
+	AssetResidentSize residentSize;
+
+	unsigned long long lastUse = 0;
+
+	// Pinned assets are never evicted, used for engine defaults.
+	bool pinned = false;
+
+	// Set by the first handle. A batch of loads can go over budget before anything is made from them, so until then
+	// the asset is not evicted.
+	std::atomic<bool> acquired = false;
+};
+
+// A counted reference to an asset owned by an AssetCache. While any handle to an asset exists it will not be evicted.
+template<typename T>
+class AssetHandle
+{
+
+public:
+
+	AssetHandle();
+
+	explicit AssetHandle(AssetEntry<T>* entry);
+
+	~AssetHandle();
+
+	AssetHandle(const AssetHandle& other);
+
+	AssetHandle& operator=(const AssetHandle& other);
+
+	AssetHandle(AssetHandle&& other) noexcept;
+
+	AssetHandle& operator=(AssetHandle&& other) noexcept;
+
+	T* Get() const;
+
+	T* operator->() const;
+
+	explicit operator bool() const;
+
+	const std::string& GetName() const;
+
+	void Release();
+
+private:
+
+	AssetEntry<T>* entry;
+
+};
+
+// Owns named assets, tracks their resident size and evicts the least recently used unreferenced ones when over budget.
+// Assets that have never been acquired are not evicted. Evicted assets are only deleted by DeleteEvicted(), so ones the
+// GPU may still be reading are freed at a point the renderer chooses.
+template<typename T>
+class AssetCache
+{
+
+public:
+
+	AssetCache() = delete;
+
+	AssetCache(const std::string& assetTypeName, std::function<AssetResidentSize(const T&)> measure);
+
+	~AssetCache();
+
+	AssetCache(const AssetCache&) = delete;
+
+	AssetCache& operator=(const AssetCache&) = delete;
+
+	AssetCache(AssetCache&&) = delete;
+
+	AssetCache& operator=(AssetCache&&) = delete;
+
+	// Takes ownership of asset. Returns false and leaves ownership with the caller if the name is in use.
+	bool Insert(const std::string& name, T* asset, bool pinned = false);
+
+	bool Contains(const std::string& name) const;
+
+	// With pin the asset is never evicted, for callers that keep the pointer without a handle.
+	T* Find(const std::string& name, bool pin = false);
+
+	// Calls function for every asset while the cache is locked. The function must not call back into the cache.
+	void ForEach(const std::function<void(const std::string&, T&)>& function);
+
+	AssetHandle<T> Acquire(const std::string& name);
+
+	AssetHandle<T> Acquire(const T* const asset);
+
+	// Evicts the asset now. Fails if anything still holds a handle to it.
+	bool Remove(const std::string& name);
+
+	// Measure the asset again after it changed in place.
+	void Remeasure(const std::string& name);
+
+	AssetResidentSize GetResidentSize(const std::string& name) const;
+
+	AssetResidentSize GetTotalResidentSize() const;
+
+	unsigned int GetReferenceCount(const std::string& name) const;
+
+	void SetBudget(size_t cpuBytes, size_t gpuBytes);
+
+	// Evict unreferenced assets that have been acquired before, least recently used first, until the totals fit the budget.
+	void Trim();
+
+	// Deletes the assets evicted since the last call.
+	void DeleteEvicted();
+
+private:
+
+	void Evict(AssetEntry<T>* entry);
+
+	std::string typeName;
+
+	std::function<AssetResidentSize(const T&)> measureFunction;
+
+	std::unordered_map<std::string, AssetEntry<T>*> entries;
+
+	std::unordered_map<const T*, AssetEntry<T>*> entriesByAsset;
+
+	std::vector<T*> evicted;
+
+	AssetResidentSize total;
+
+	AssetResidentSize budget;
+
+	unsigned long long useCounter;
+
+	mutable std::mutex mutex;
+
+};
+
+template<typename T>
+AssetHandle<T>::AssetHandle() :
+	entry(nullptr)
+{
+}
+
+template<typename T>
+AssetHandle<T>::AssetHandle(AssetEntry<T>* e) :
+	entry(e)
+{
+	if (entry != nullptr)
+	{
+		entry->references++;
+		entry->acquired = true;
+	}
+}
+
+template<typename T>
+AssetHandle<T>::~AssetHandle()
+{
+	Release();
+}
+
+template<typename T>
+AssetHandle<T>::AssetHandle(const AssetHandle& other) :
+	entry(other.entry)
+{
+	if (entry != nullptr)
+	{
+		entry->references++;
+	}
+}
+
+template<typename T>
+AssetHandle<T>& AssetHandle<T>::operator=(const AssetHandle& other)
+{
+	if (this != &other)
+	{
+		Release();
+		entry = other.entry;
+
+		if (entry != nullptr)
+		{
+			entry->references++;
+		}
+	}
+
+	return *this;
+}
+
+template<typename T>
+AssetHandle<T>::AssetHandle(AssetHandle&& other) noexcept :
+	entry(other.entry)
+{
+	other.entry = nullptr;
+}
+
+template<typename T>
+AssetHandle<T>& AssetHandle<T>::operator=(AssetHandle&& other) noexcept
+{
+	if (this != &other)
+	{
+		Release();
+		entry = other.entry;
+		other.entry = nullptr;
+	}
+
+	return *this;
+}
+
+template<typename T>
+T* AssetHandle<T>::Get() const
+{
+	return entry != nullptr ? entry->asset : nullptr;
+}
+
+template<typename T>
+T* AssetHandle<T>::operator->() const
+{
+	return Get();
+}
+
+template<typename T>
+AssetHandle<T>::operator bool() const
+{
+	return Get() != nullptr;
+}
+
+template<typename T>
+const std::string& AssetHandle<T>::GetName() const
+{
+	static const std::string defaultReturn;
+	return entry != nullptr ? entry->name : defaultReturn;
+}
+
+template<typename T>
+void AssetHandle<T>::Release()
+{
+	if (entry != nullptr)
+	{
+		entry->references--;
+		entry = nullptr;
+	}
+}
+
+template<typename T>
+AssetCache<T>::AssetCache(const std::string& assetTypeName, std::function<AssetResidentSize(const T&)> measure) :
+	typeName(assetTypeName),
+	measureFunction(measure),
+	entries(std::unordered_map<std::string, AssetEntry<T>*>()),
+	entriesByAsset(std::unordered_map<const T*, AssetEntry<T>*>()),
+	evicted(std::vector<T*>()),
+	total(),
+	budget({ std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max() }),
+	useCounter(0)
+{
+}
+
+template<typename T>
+AssetCache<T>::~AssetCache()
+{
+	for (auto& entry : entries)
+	{
+		if (entry.second->references > 0)
+		{
+			Logger::Log(typeName + std::string(" ") + entry.first + " is still referenced at shutdown.", Logger::Category::Warning);
+		}
+
+		delete entry.second->asset;
+		delete entry.second;
+	}
+
+	for (T* asset : evicted)
+	{
+		delete asset;
+	}
+}
+
+template<typename T>
+bool AssetCache<T>::Insert(const std::string& name, T* asset, bool pinned)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (entries.find(name) != entries.end())
+		{
+			return false;
+		}
+
+		AssetEntry<T>* entry = new AssetEntry<T>();
+		entry->name = name;
+		entry->asset = asset;
+		entry->residentSize = measureFunction(*asset);
+		entry->lastUse = ++useCounter;
+		entry->pinned = pinned;
+
+		entries[name] = entry;
+		entriesByAsset[asset] = entry;
+
+		total.cpuBytes += entry->residentSize.cpuBytes;
+		total.gpuBytes += entry->residentSize.gpuBytes;
+	}
+
+	Trim();
+
+	return true;
+}
+
+template<typename T>
+bool AssetCache<T>::Contains(const std::string& name) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return entries.find(name) != entries.end();
+}
+
+template<typename T>
+T* AssetCache<T>::Find(const std::string& name, bool pin)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = entries.find(name);
+	if (found == entries.end())
+	{
+		return nullptr;
+	}
+
+	found->second->lastUse = ++useCounter;
+	found->second->pinned = found->second->pinned || pin;
+	return found->second->asset;
+}
+
+template<typename T>
+void AssetCache<T>::ForEach(const std::function<void(const std::string&, T&)>& function)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	for (auto& entry : entries)
+	{
+		function(entry.first, *entry.second->asset);
+	}
+}
+
+template<typename T>
+AssetHandle<T> AssetCache<T>::Acquire(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = entries.find(name);
+	if (found == entries.end())
+	{
+		return AssetHandle<T>();
+	}
+
+	found->second->lastUse = ++useCounter;
+	return AssetHandle<T>(found->second);
+}
+
+template<typename T>
+AssetHandle<T> AssetCache<T>::Acquire(const T* const asset)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = entriesByAsset.find(asset);
+	if (found == entriesByAsset.end())
+	{
+		return AssetHandle<T>();
+	}
+
+	found->second->lastUse = ++useCounter;
+	return AssetHandle<T>(found->second);
+}
+
+template<typename T>
+bool AssetCache<T>::Remove(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = entries.find(name);
+	if (found == entries.end())
+	{
+		return false;
+	}
+
+	if (found->second->references > 0)
+	{
+		Logger::Log(std::string("Cannot unload ") + typeName + " " + name + ". It is still referenced.", Logger::Category::Warning);
+		return false;
+	}
+
+	Evict(found->second);
+	return true;
+}
+
+template<typename T>
+void AssetCache<T>::Remeasure(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = entries.find(name);
+	if (found != entries.end())
+	{
+		AssetEntry<T>* entry = found->second;
+		total.cpuBytes -= entry->residentSize.cpuBytes;
+		total.gpuBytes -= entry->residentSize.gpuBytes;
+		entry->residentSize = measureFunction(*entry->asset);
+		total.cpuBytes += entry->residentSize.cpuBytes;
+		total.gpuBytes += entry->residentSize.gpuBytes;
+	}
+}
+
+template<typename T>
+AssetResidentSize AssetCache<T>::GetResidentSize(const std::string& name) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = entries.find(name);
+	return found != entries.end() ? found->second->residentSize : AssetResidentSize();
+}
+
+template<typename T>
+AssetResidentSize AssetCache<T>::GetTotalResidentSize() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return total;
+}
+
+template<typename T>
+unsigned int AssetCache<T>::GetReferenceCount(const std::string& name) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = entries.find(name);
+	return found != entries.end() ? found->second->references.load() : 0U;
+}
+
+template<typename T>
+void AssetCache<T>::SetBudget(size_t cpuBytes, size_t gpuBytes)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		budget.cpuBytes = cpuBytes;
+		budget.gpuBytes = gpuBytes;
+	}
+
+	Trim();
+}
+
+template<typename T>
+void AssetCache<T>::Trim()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (total.cpuBytes <= budget.cpuBytes && total.gpuBytes <= budget.gpuBytes)
+	{
+		return;
+	}
+
+	std::vector<AssetEntry<T>*> candidates;
+	for (auto& entry : entries)
+	{
+		if (!entry.second->pinned && entry.second->acquired && entry.second->references == 0)
+		{
+			candidates.push_back(entry.second);
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(), [](AssetEntry<T>* a, AssetEntry<T>* b) { return a->lastUse < b->lastUse; });
+
+	for (AssetEntry<T>* candidate : candidates)
+	{
+		if (total.cpuBytes <= budget.cpuBytes && total.gpuBytes <= budget.gpuBytes)
+		{
+			break;
+		}
+
+		Logger::Log(std::string("Evicting ") + typeName + " " + candidate->name + " to stay within the memory budget.", Logger::Category::Info);
+		Evict(candidate);
+	}
+}
+
+template<typename T>
+void AssetCache<T>::Evict(AssetEntry<T>* entry)
+{
+	total.cpuBytes -= entry->residentSize.cpuBytes;
+	total.gpuBytes -= entry->residentSize.gpuBytes;
+
+	entriesByAsset.erase(entry->asset);
+	entries.erase(entry->name);
+
+	evicted.push_back(entry->asset);
+	delete entry;
+}
+
+template<typename T>
+void AssetCache<T>::DeleteEvicted()
+{
+	std::vector<T*> deleting;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		deleting.swap(evicted);
+	}
+
+	for (T* asset : deleting)
+	{
+		delete asset;
+	}
+}
+
+#endif // ASSETCACHE_H
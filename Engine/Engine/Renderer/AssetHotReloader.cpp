@@ -0,0 +1,162 @@
+#include "AssetHotReloader.h"
+
+#include "../Utils/Logger.h"
+#include "../Utils/FileWatcher.h"
+#include "GraphicsObjects/GraphicsObjectManager.h"
+#include "Images/TextureManager.h"
+#include "Model/ModelManager.h"
+
+#include <filesystem>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
+
+AssetHotReloader* AssetHotReloader::instance = nullptr;
+
+void AssetHotReloader::Initialize()
+{
+	if (instance == nullptr)
+	{
+		instance = new AssetHotReloader();
+	}
+	else
+	{
+		Logger::Log(std::string("Calling AssetHotReloader::Initialize() before AssetHotReloader::Terminate()."), Logger::Category::Warning);
+	}
+}
+
+void AssetHotReloader::Terminate()
+{
+	if (instance != nullptr)
+	{
+		delete instance;
+	}
+	else
+	{
+		Logger::Log(std::string("Calling AssetHotReloader::Terminate() before AssetHotReloader::Initialize()."), Logger::Category::Warning);
+	}
+}
+
+void AssetHotReloader::Update()
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	for (const std::string& filePath : instance->watcher->PollChanges())
+	{
+		AssetType type = GetAssetType(filePath);
+
+		if (type == AssetType::Unknown)
+		{
+			continue;
+		}
+
+		// Every stage of a shader rebuilds the same pipeline, so shaders are keyed by name.
+		const std::string key = type == AssetType::Shader ? std::filesystem::path(filePath).stem().string() : filePath;
+
+		if (instance->rebuilds.find(key) != instance->rebuilds.end())
+		{
+			instance->requeued[key] = std::make_pair(type, filePath);
+		}
+		else
+		{
+			instance->Rebuild(key, type, filePath);
+		}
+	}
+
+	for (auto it = instance->rebuilds.begin(); it != instance->rebuilds.end();)
+	{
+		if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			++it;
+			continue;
+		}
+
+		std::function<void()> swap = it->second.get();
+		const std::string key = it->first;
+		it = instance->rebuilds.erase(it);
+
+		if (swap)
+		{
+			swap();
+		}
+
+		auto requeuedRebuild = instance->requeued.find(key);
+		if (requeuedRebuild != instance->requeued.end())
+		{
+			std::pair<AssetType, std::string> rebuild = requeuedRebuild->second;
+			instance->requeued.erase(requeuedRebuild);
+			instance->Rebuild(key, rebuild.first, rebuild.second);
+		}
+	}
+}
+
+AssetHotReloader::AssetHotReloader() :
+	watcher(new FileWatcher()),
+	rebuilds(std::unordered_map<std::string, std::future<std::function<void()>>>()),
+	requeued(std::unordered_map<std::string, std::pair<AssetType, std::string>>())
+{
+	watcher->WatchDirectory("Assets/Shaders");
+	watcher->WatchDirectory("Assets/Textures");
+	watcher->WatchDirectory("Assets/Models");
+	watcher->Start();
+}
+
+AssetHotReloader::~AssetHotReloader()
+{
+	watcher->Stop();
+	delete watcher;
+
+	// Swap in the rebuilds still running so the managers own, and later delete, what they created.
+	for (auto& rebuild : rebuilds)
+	{
+		std::function<void()> swap = rebuild.second.get();
+		if (swap)
+		{
+			swap();
+		}
+	}
+
+	instance = nullptr;
+}
+
+AssetHotReloader::AssetType AssetHotReloader::GetAssetType(const std::string& filePath)
+{
+	std::string extension = std::filesystem::path(filePath).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	if (GraphicsObjectManager::ShaderStageFromExtension(extension) != VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM)
+	{
+		return AssetType::Shader;
+	}
+	else if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp")
+	{
+		return AssetType::Texture;
+	}
+	else if (extension == ".gltf" || extension == ".glb")
+	{
+		return AssetType::Model;
+	}
+
+	return AssetType::Unknown;
+}
+
+void AssetHotReloader::Rebuild(const std::string& key, AssetType type, const std::string& filePath)
+{
+	switch (type)
+	{
+	case AssetType::Shader:
+		rebuilds[key] = std::async(std::launch::async, GraphicsObjectManager::RebuildShaderPipeline, key);
+		break;
+	case AssetType::Texture:
+		rebuilds[key] = std::async(std::launch::async, TextureManager::RebuildTexture, filePath);
+		break;
+	case AssetType::Model:
+		rebuilds[key] = std::async(std::launch::async, ModelManager::RebuildModel, filePath);
+		break;
+	default:
+		break;
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef ASSETHOTRELOADER_H
+#define ASSETHOTRELOADER_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <future>
+
+class FileWatcher;
+
+// Watches the asset directories and rebuilds shaders, textures and models that change on disk.
+// Rebuilds run on worker threads; the results are swapped in by Update on the render thread between frames.
+class AssetHotReloader
+{
+
+public:
+
+	static void Initialize();
+
+	static void Terminate();
+
+	// Call on the render thread after the previous frame's fence was waited on and before any draw is recorded.
+	static void Update();
+
+private:
+
+	enum class AssetType
+	{
+		Shader,
+		Texture,
+		Model,
+		Unknown
+	};
+
+	AssetHotReloader();
+
+	~AssetHotReloader();
+
+	AssetHotReloader(const AssetHotReloader&) = delete;
+
+	AssetHotReloader& operator=(const AssetHotReloader&) = delete;
+
+	AssetHotReloader(AssetHotReloader&&) = delete;
+
+	AssetHotReloader& operator=(AssetHotReloader&&) = delete;
+
+	static AssetType GetAssetType(const std::string& filePath);
+
+	void Rebuild(const std::string& key, AssetType type, const std::string& filePath);
+
+	static AssetHotReloader* instance;
+
+	FileWatcher* watcher;
+
+	// In flight rebuilds by shader name or file path. A key changed again while in flight is rebuilt once more when it finishes.
+	std::unordered_map<std::string, std::future<std::function<void()>>> rebuilds;
+
+	std::unordered_map<std::string, std::pair<AssetType, std::string>> requeued;
+
+};
+
+#endif // ASSETHOTRELOADER_H
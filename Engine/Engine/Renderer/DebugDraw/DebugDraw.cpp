@@ -0,0 +1,543 @@
+#include "DebugDraw.h"
+
+#include "../Renderer.h"
+#include "../Memory/VertexBuffer.h"
+#include "../Pipeline/GraphicsPipeline.h"
+#include "../Pipeline/PipelineLayout.h"
+#include "../Pipeline/Shaders/Shader.h"
+#include "../Pipeline/Shaders/ShaderPipelineStage.h"
+#include "../Pipeline/InputAssembly/InputAssemblyPipelineState.h"
+#include "../Pipeline/VertexInput/VertexInputPipelineState.h"
+#include "../Cameras/CameraManager.h"
+#include "../Cameras/Camera.h"
+#include "../../Math/Shapes/OrientedBoundingBox.h"
+#include "../../Math/Shapes/AxisAlignedBoundingBox.h"
+#include "../../Utils/Logger.h"
+
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+
+namespace
+{
+	// Sixteen segment glyphs on a 2 by 2 cell, the top and bottom bars and the middle bar are split in two halves.
+	enum Segment : uint16_t
+	{
+		TopLeft = 1 << 0,
+		TopRight = 1 << 1,
+		RightUpper = 1 << 2,
+		RightLower = 1 << 3,
+		BottomLeft = 1 << 4,
+		BottomRight = 1 << 5,
+		LeftLower = 1 << 6,
+		LeftUpper = 1 << 7,
+		MiddleLeft = 1 << 8,
+		MiddleRight = 1 << 9,
+		DiagonalUpperLeft = 1 << 10,
+		CenterUpper = 1 << 11,
+		DiagonalUpperRight = 1 << 12,
+		DiagonalLowerLeft = 1 << 13,
+		CenterLower = 1 << 14,
+		DiagonalLowerRight = 1 << 15
+	};
+
+	const uint16_t Top = TopLeft | TopRight;
+	const uint16_t Bottom = BottomLeft | BottomRight;
+	const uint16_t Middle = MiddleLeft | MiddleRight;
+	const uint16_t Left = LeftUpper | LeftLower;
+	const uint16_t Right = RightUpper | RightLower;
+	const uint16_t Center = CenterUpper | CenterLower;
+
+	// The ends of each segment in cell coordinates, in the order of the Segment bits.
+	const glm::vec2 segmentEnds[16][2] =
+	{
+		{ { 0.0f, 2.0f }, { 1.0f, 2.0f } },
+		{ { 1.0f, 2.0f }, { 2.0f, 2.0f } },
+		{ { 2.0f, 2.0f }, { 2.0f, 1.0f } },
+		{ { 2.0f, 1.0f }, { 2.0f, 0.0f } },
+		{ { 0.0f, 0.0f }, { 1.0f, 0.0f } },
+		{ { 1.0f, 0.0f }, { 2.0f, 0.0f } },
+		{ { 0.0f, 0.0f }, { 0.0f, 1.0f } },
+		{ { 0.0f, 1.0f }, { 0.0f, 2.0f } },
+		{ { 0.0f, 1.0f }, { 1.0f, 1.0f } },
+		{ { 1.0f, 1.0f }, { 2.0f, 1.0f } },
+		{ { 0.0f, 2.0f }, { 1.0f, 1.0f } },
+		{ { 1.0f, 2.0f }, { 1.0f, 1.0f } },
+		{ { 2.0f, 2.0f }, { 1.0f, 1.0f } },
+		{ { 1.0f, 1.0f }, { 0.0f, 0.0f } },
+		{ { 1.0f, 1.0f }, { 1.0f, 0.0f } },
+		{ { 1.0f, 1.0f }, { 2.0f, 0.0f } }
+	};
+
+	uint16_t GlyphSegments(char character)
+	{
+		switch (std::toupper(static_cast<unsigned char>(character)))
+		{
+		case 'A': return Top | Right | Left | Middle;
+		case 'B': return Top | Right | Bottom | Center | MiddleRight;
+		case 'C': return Top | Bottom | Left;
+		case 'D': return Top | Right | Bottom | Center;
+		case 'E': return Top | Bottom | Left | MiddleLeft;
+		case 'F': return Top | Left | MiddleLeft;
+		case 'G': return Top | RightLower | Bottom | Left | MiddleRight;
+		case 'H': return Right | Left | Middle;
+		case 'I': return Top | Bottom | Center;
+		case 'J': return Right | Bottom | LeftLower;
+		case 'K': return Left | MiddleLeft | DiagonalUpperRight | DiagonalLowerRight;
+		case 'L': return Bottom | Left;
+		case 'M': return Right | Left | DiagonalUpperLeft | DiagonalUpperRight;
+		case 'N': return Right | Left | DiagonalUpperLeft | DiagonalLowerRight;
+		case 'O': return Top | Right | Bottom | Left;
+		case 'P': return Top | RightUpper | Left | Middle;
+		case 'Q': return Top | Right | Bottom | Left | DiagonalLowerRight;
+		case 'R': return Top | RightUpper | Left | Middle | DiagonalLowerRight;
+		case 'S': return Top | RightLower | Bottom | LeftUpper | Middle;
+		case 'T': return Top | Center;
+		case 'U': return Right | Bottom | Left;
+		case 'V': return Left | DiagonalLowerLeft | DiagonalUpperRight;
+		case 'W': return Right | Left | DiagonalLowerLeft | DiagonalLowerRight;
+		case 'X': return DiagonalUpperLeft | DiagonalUpperRight | DiagonalLowerLeft | DiagonalLowerRight;
+		case 'Y': return DiagonalUpperLeft | DiagonalUpperRight | CenterLower;
+		case 'Z': return Top | Bottom | DiagonalUpperRight | DiagonalLowerLeft;
+		case '0': return Top | Right | Bottom | Left | DiagonalUpperRight | DiagonalLowerLeft;
+		case '1': return Right | DiagonalUpperRight;
+		case '2': return Top | RightUpper | Bottom | LeftLower | Middle;
+		case '3': return Top | Right | Bottom | MiddleRight;
+		case '4': return Right | LeftUpper | Middle;
+		case '5': return Top | RightLower | Bottom | LeftUpper | Middle;
+		case '6': return Top | RightLower | Bottom | Left | Middle;
+		case '7': return Top | Right;
+		case '8': return Top | Right | Bottom | Left | Middle;
+		case '9': return Top | Right | Bottom | LeftUpper | Middle;
+		case '-': return Middle;
+		case '+': return Middle | Center;
+		case '=': return Middle | Bottom;
+		case '_': return Bottom;
+		case '*': return Middle | Center | DiagonalUpperLeft | DiagonalUpperRight | DiagonalLowerLeft | DiagonalLowerRight;
+		case '/': return DiagonalUpperRight | DiagonalLowerLeft;
+		case '\\': return DiagonalUpperLeft | DiagonalLowerRight;
+		case '|': return Center;
+		case '(': case '<': return DiagonalUpperRight | DiagonalLowerRight;
+		case ')': case '>': return DiagonalUpperLeft | DiagonalLowerLeft;
+		case '[': return TopLeft | BottomLeft | Left;
+		case ']': return TopRight | BottomRight | Right;
+		case '\'': return CenterUpper;
+		case '"': return LeftUpper | CenterUpper;
+		case '.': case ',': return BottomLeft;
+		case '?': return Top | RightUpper | MiddleRight | CenterLower;
+		default: return 0;
+		}
+	}
+}
+
+DebugDraw* DebugDraw::instance = nullptr;
+
+std::mutex DebugDraw::instanceMutex = std::mutex();
+
+const std::string DebugDraw::shaderDirectoryName = std::string("Assets/Shaders/Debug/");
+
+void DebugDraw::Initialize(const Window& window)
+{
+	std::lock_guard<std::mutex> guard(instanceMutex);
+
+	if (instance == nullptr)
+	{
+		instance = new DebugDraw(window);
+		Logger::Log(std::string("Initialized DebugDraw"), Logger::Category::Success);
+	}
+	else
+	{
+		Logger::Log(std::string("Calling DebugDraw::Initialize() before DebugDraw::Terminate()."), Logger::Category::Warning);
+	}
+}
+
+void DebugDraw::Terminate()
+{
+	std::lock_guard<std::mutex> guard(instanceMutex);
+
+	if (instance != nullptr)
+	{
+		delete instance;
+		instance = nullptr;
+	}
+	else
+	{
+		Logger::Log(std::string("Calling DebugDraw::Terminate() before DebugDraw::Initialize()"), Logger::Category::Warning);
+	}
+}
+
+void DebugDraw::Line(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color)
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	const uint32_t packedColor = glm::packUnorm4x8(color);
+
+	const LineVertex line[2] = { { start, packedColor }, { end, packedColor } };
+
+	instance->AddVertices(line, 2U);
+}
+
+void DebugDraw::Ray(const glm::vec3& origin, const glm::vec3& direction, float length, const glm::vec4& color)
+{
+	Line(origin, origin + glm::normalize(direction) * length, color);
+}
+
+void DebugDraw::Box(const glm::vec3& center, const glm::mat3& axes, const glm::vec3& halfSize, const glm::vec4& color)
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	const glm::vec3 x = axes[0] * halfSize.x;
+	const glm::vec3 y = axes[1] * halfSize.y;
+	const glm::vec3 z = axes[2] * halfSize.z;
+
+	// Corner i is at the positive end of axis a when bit a of i is set.
+	glm::vec3 corners[8];
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		corners[i] = center + ((i & 1U) ? x : -x) + ((i & 2U) ? y : -y) + ((i & 4U) ? z : -z);
+	}
+
+	const uint32_t packedColor = glm::packUnorm4x8(color);
+
+	// Each edge joins two corners that differ in one bit.
+	LineVertex edges[24];
+	unsigned int count = 0U;
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		for (unsigned int bit = 1U; bit < 8U; bit <<= 1U)
+		{
+			if ((i & bit) == 0U)
+			{
+				edges[count++] = { corners[i], packedColor };
+				edges[count++] = { corners[i | bit], packedColor };
+			}
+		}
+	}
+
+	instance->AddVertices(edges, count);
+}
+
+void DebugDraw::Box(const OrientedBoundingBox& obb, const glm::vec4& color)
+{
+	Box(obb.GetOrigin(), obb.GetAxes(), obb.GetSize(), color);
+}
+
+void DebugDraw::Box(const AxisAlignedBoundingBox& aabb, const glm::vec4& color)
+{
+	const glm::vec3 min = aabb.GetMin();
+	const glm::vec3 max = aabb.GetMax();
+
+	Box((min + max) * 0.5f, glm::mat3(1.0f), (max - min) * 0.5f, color);
+}
+
+void DebugDraw::Sphere(const glm::vec3& center, float radius, const glm::vec4& color, unsigned int segments)
+{
+	if (instance == nullptr || segments < 3U)
+	{
+		return;
+	}
+
+	const uint32_t packedColor = glm::packUnorm4x8(color);
+
+	std::vector<LineVertex> circles;
+	circles.reserve(static_cast<size_t>(segments) * 6U);
+
+	const glm::vec3 axes[3] = { glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) };
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		const glm::vec3& u = axes[(axis + 1) % 3];
+		const glm::vec3& v = axes[(axis + 2) % 3];
+
+		glm::vec3 previous = center + u * radius;
+		for (unsigned int i = 1; i <= segments; i++)
+		{
+			const float angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(segments);
+			const glm::vec3 current = center + (u * glm::cos(angle) + v * glm::sin(angle)) * radius;
+
+			circles.push_back({ previous, packedColor });
+			circles.push_back({ current, packedColor });
+
+			previous = current;
+		}
+	}
+
+	instance->AddVertices(circles.data(), static_cast<unsigned int>(circles.size()));
+}
+
+void DebugDraw::Frustum(const glm::mat4& viewProjection, const glm::vec4& color)
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+#ifdef GLM_FORCE_DEPTH_ZERO_TO_ONE
+	const float nearDepth = 0.0f;
+#else
+	const float nearDepth = -1.0f;
+#endif
+
+	const glm::mat4 inverse = glm::inverse(viewProjection);
+
+	// Corner i is at positive x, y and far depth for bits 0, 1 and 2 of i.
+	glm::vec3 corners[8];
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		const glm::vec4 corner = inverse * glm::vec4((i & 1U) ? 1.0f : -1.0f, (i & 2U) ? 1.0f : -1.0f, (i & 4U) ? 1.0f : nearDepth, 1.0f);
+		corners[i] = glm::vec3(corner) / corner.w;
+	}
+
+	const uint32_t packedColor = glm::packUnorm4x8(color);
+
+	LineVertex edges[24];
+	unsigned int count = 0U;
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		for (unsigned int bit = 1U; bit < 8U; bit <<= 1U)
+		{
+			if ((i & bit) == 0U)
+			{
+				edges[count++] = { corners[i], packedColor };
+				edges[count++] = { corners[i | bit], packedColor };
+			}
+		}
+	}
+
+	instance->AddVertices(edges, count);
+}
+
+void DebugDraw::Text3D(const glm::vec3& position, const std::string& text, float height, const glm::vec4& color)
+{
+	if (instance == nullptr || text.empty())
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->submitMutex);
+	instance->texts.push_back({ position, text, height, color });
+}
+
+void DebugDraw::AddSource(const std::function<void()>* const source)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling DebugDraw::AddSource() before DebugDraw::Initialize()"), Logger::Category::Warning);
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->sourceMutex);
+	instance->sources.push_back(source);
+}
+
+void DebugDraw::RemoveSource(const std::function<void()>* const source)
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->sourceMutex);
+
+	std::vector<const std::function<void()>*>& sources = instance->sources;
+	sources.erase(std::remove(sources.begin(), sources.end(), source), sources.end());
+}
+
+void DebugDraw::Draw(VkCommandBuffer& buffer)
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(instance->sourceMutex);
+
+		for (const std::function<void()>* const source : instance->sources)
+		{
+			(*source)();
+		}
+	}
+
+	instance->drawVertices.clear();
+	instance->drawTexts.clear();
+
+	{
+		std::lock_guard<std::mutex> guard(instance->submitMutex);
+		instance->vertices.swap(instance->drawVertices);
+		instance->texts.swap(instance->drawTexts);
+	}
+
+	if (instance->pipeline == nullptr)
+	{
+		instance->lineCount = 0U;
+		return;
+	}
+
+	const Camera& cam = CameraManager::GetActiveCamera();
+
+	if (!instance->drawTexts.empty())
+	{
+		// The rows of the view rotation are the camera's right and up in world space.
+		const glm::mat4& view = cam.GetView();
+		const glm::vec3 right(view[0][0], view[1][0], view[2][0]);
+		const glm::vec3 up(view[0][1], view[1][1], view[2][1]);
+
+		for (const Text& text : instance->drawTexts)
+		{
+			instance->AddTextLines(text, right, up);
+		}
+	}
+
+	const unsigned int vertexCount = static_cast<unsigned int>(instance->drawVertices.size());
+	instance->lineCount = vertexCount / 2U;
+
+	if (vertexCount == 0U)
+	{
+		return;
+	}
+
+	// Only one frame is in flight and its fence has been waited on, so the buffer the last frame read can be replaced.
+	if (vertexCount > instance->vertexCapacity)
+	{
+		delete instance->vertexBuffer;
+
+		instance->vertexCapacity = std::max(vertexCount, instance->vertexCapacity * 2U);
+		instance->vertexBuffer = new VertexBuffer(instance->vertexCapacity * static_cast<unsigned int>(sizeof(LineVertex)), true);
+	}
+
+	instance->vertexBuffer->SetData(instance->drawVertices.data(), 0U, vertexCount * static_cast<unsigned int>(sizeof(LineVertex)));
+
+	glm::mat4 viewProjection = cam.GetProjection();
+	viewProjection[1][1] *= -1;
+	viewProjection = viewProjection * cam.GetView();
+
+	VkDeviceSize offsets[] = { 0 };
+	vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, **instance->pipeline);
+	vkCmdPushConstants(buffer, **instance->pipeline->GetPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &viewProjection);
+	vkCmdBindVertexBuffers(buffer, 0, 1, &(*instance->vertexBuffer)(), offsets);
+	vkCmdDraw(buffer, vertexCount, 1, 0, 0);
+}
+
+unsigned int DebugDraw::GetLineCount()
+{
+	if (instance == nullptr)
+	{
+		return 0U;
+	}
+
+	return instance->lineCount;
+}
+
+DebugDraw::DebugDraw(const Window& window) :
+	vertexBuffer(nullptr),
+	vertexCapacity(0U),
+	shaderPipelineStage(nullptr),
+	pipeline(nullptr),
+	lineCount(0U)
+{
+	CreatePipeline(window);
+}
+
+DebugDraw::~DebugDraw()
+{
+	delete vertexBuffer;
+	delete pipeline;
+	delete shaderPipelineStage;
+}
+
+void DebugDraw::CreatePipeline(const Window& window)
+{
+	// Kept out of the shader directory so GraphicsObjectManager does not build a Vertex pipeline for it.
+	const std::filesystem::path vertexShaderPath = std::filesystem::path(shaderDirectoryName) / "DebugLine.vertspv";
+	const std::filesystem::path fragmentShaderPath = std::filesystem::path(shaderDirectoryName) / "DebugLine.fragspv";
+
+	if (!std::filesystem::exists(vertexShaderPath) || !std::filesystem::exists(fragmentShaderPath))
+	{
+		Logger::Log(std::string("DebugDraw shaders are not compiled into ") + shaderDirectoryName + std::string(", debug lines will not be drawn."), Logger::Category::Warning);
+		return;
+	}
+
+	shaderPipelineStage = new ShaderPipelineStage();
+	shaderPipelineStage->AddShader(VK_SHADER_STAGE_VERTEX_BIT, new Shader(std::filesystem::directory_entry(vertexShaderPath), Renderer::GetVulkanPhysicalDevice()));
+	shaderPipelineStage->AddShader(VK_SHADER_STAGE_FRAGMENT_BIT, new Shader(std::filesystem::directory_entry(fragmentShaderPath), Renderer::GetVulkanPhysicalDevice()));
+	shaderPipelineStage->CreateDescriptorSetLayout();
+
+	VkVertexInputBindingDescription binding{};
+	binding.binding = 0;
+	binding.stride = sizeof(LineVertex);
+	binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+	std::vector<VkVertexInputAttributeDescription> attributes(2);
+	attributes[0].binding = 0;
+	attributes[0].location = 0;
+	attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+	attributes[0].offset = offsetof(LineVertex, position);
+	attributes[1].binding = 0;
+	attributes[1].location = 1;
+	attributes[1].format = VK_FORMAT_R8G8B8A8_UNORM;
+	attributes[1].offset = offsetof(LineVertex, color);
+
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(glm::mat4);
+
+	const InputAssemblyPipelineState* const inputAssembly = new InputAssemblyPipelineState(VK_PRIMITIVE_TOPOLOGY_LINE_LIST);
+	const VertexInputPipelineState* const vertexInput = new VertexInputPipelineState(binding, attributes);
+
+	pipeline = new GraphicsPipeline(*shaderPipelineStage, *inputAssembly, *vertexInput, pushConstantRange, window);
+}
+
+void DebugDraw::AddVertices(const LineVertex* lineVertices, unsigned int count)
+{
+	std::lock_guard<std::mutex> guard(submitMutex);
+	vertices.insert(vertices.end(), lineVertices, lineVertices + count);
+}
+
+void DebugDraw::AddTextLines(const Text& text, const glm::vec3& right, const glm::vec3& up)
+{
+	// A cell is 2 by 2 units with glyphs twice as tall as wide, a unit across and 2 down between characters and lines.
+	const float unit = text.height / 6.0f;
+	const glm::vec3 across = right * unit;
+	const glm::vec3 down = -up * unit;
+	const uint32_t packedColor = glm::packUnorm4x8(text.color);
+
+	glm::vec3 lineStart = text.position;
+	glm::vec3 cursor = lineStart;
+
+	for (char character : text.text)
+	{
+		if (character == '\n')
+		{
+			lineStart += down * 6.0f;
+			cursor = lineStart;
+			continue;
+		}
+
+		const uint16_t segments = GlyphSegments(character);
+
+		for (unsigned int segment = 0; segment < 16; segment++)
+		{
+			if ((segments & (1U << segment)) != 0U)
+			{
+				for (const glm::vec2& end : segmentEnds[segment])
+				{
+					drawVertices.push_back({ cursor + across * end.x - down * (end.y * 2.0f), packedColor });
+				}
+			}
+		}
+
+		cursor += across * 3.0f;
+	}
+}
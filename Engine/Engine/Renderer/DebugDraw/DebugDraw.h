@@ -0,0 +1,140 @@
+#ifndef DEBUGDRAW_H
+#define DEBUGDRAW_H
+
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <cstdint>
+#include <functional>
+
+class Window;
+class VertexBuffer;
+class ShaderPipelineStage;
+class GraphicsPipeline;
+class OrientedBoundingBox;
+class AxisAlignedBoundingBox;
+
+// Immediate mode debug lines. Anything submitted from any thread is drawn by the next frame, all of it with one draw out
+// of one vertex buffer, and then forgotten, so whatever should stay visible is submitted again every frame. Things updated
+// less often than frames are drawn, such as shapes moved by the simulation, submit from a source instead.
+class DebugDraw
+{
+
+public:
+
+	static void Initialize(const Window& window);
+
+	static void Terminate();
+
+	static void Line(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color = glm::vec4(1.0f));
+
+	static void Ray(const glm::vec3& origin, const glm::vec3& direction, float length, const glm::vec4& color = glm::vec4(1.0f));
+
+	// axes are the box's normalized axes and halfSize its extent along each of them.
+	static void Box(const glm::vec3& center, const glm::mat3& axes, const glm::vec3& halfSize, const glm::vec4& color = glm::vec4(1.0f));
+
+	static void Box(const OrientedBoundingBox& obb, const glm::vec4& color = glm::vec4(1.0f));
+
+	static void Box(const AxisAlignedBoundingBox& aabb, const glm::vec4& color = glm::vec4(1.0f));
+
+	// A circle around each axis.
+	static void Sphere(const glm::vec3& center, float radius, const glm::vec4& color = glm::vec4(1.0f), unsigned int segments = 24U);
+
+	// The edges of the volume a view projection matrix sees, like a camera's projection * view.
+	static void Frustum(const glm::mat4& viewProjection, const glm::vec4& color = glm::vec4(1.0f));
+
+	// Text facing the camera in a segmented line font. position is the bottom left of the first character and height the
+	// height of a line in world units. Letters are drawn upper case, characters the font does not have as spaces.
+	static void Text3D(const glm::vec3& position, const std::string& text, float height, const glm::vec4& color = glm::vec4(1.0f));
+
+	// Called on the render thread at the start of every frame's draw to submit lines, until it is removed. A source must
+	// not add or remove sources.
+	static void AddSource(const std::function<void()>* const source);
+
+	// Once this returns the source is not being called and will not be again.
+	static void RemoveSource(const std::function<void()>* const source);
+
+	// Records the draw of everything submitted since the last call. Called by the window inside its render pass.
+	static void Draw(VkCommandBuffer& buffer);
+
+	// The lines drawn by the last Draw.
+	static unsigned int GetLineCount();
+
+private:
+
+	DebugDraw(const Window& window);
+
+	~DebugDraw();
+
+	DebugDraw(const DebugDraw&) = delete;
+
+	DebugDraw& operator=(const DebugDraw&) = delete;
+
+	DebugDraw(DebugDraw&&) = delete;
+
+	DebugDraw& operator=(DebugDraw&&) = delete;
+
+	struct LineVertex
+	{
+		glm::vec3 position;
+
+		// RGBA8, unpacked by the vertex input.
+		uint32_t color;
+	};
+
+	struct Text
+	{
+		glm::vec3 position;
+
+		std::string text;
+
+		float height;
+
+		glm::vec4 color;
+	};
+
+	void CreatePipeline(const Window& window);
+
+	void AddVertices(const LineVertex* lineVertices, unsigned int count);
+
+	// Text is turned into lines when drawn, once the camera it faces is known.
+	void AddTextLines(const Text& text, const glm::vec3& right, const glm::vec3& up);
+
+	static DebugDraw* instance;
+
+	static std::mutex instanceMutex;
+
+	static const std::string shaderDirectoryName;
+
+	// Written by the submitting threads.
+	std::vector<LineVertex> vertices;
+
+	std::vector<Text> texts;
+
+	std::mutex submitMutex;
+
+	std::vector<const std::function<void()>*> sources;
+
+	std::mutex sourceMutex;
+
+	// What the current frame draws, swapped with vertices so both keep their capacity.
+	std::vector<LineVertex> drawVertices;
+
+	std::vector<Text> drawTexts;
+
+	VertexBuffer* vertexBuffer;
+
+	unsigned int vertexCapacity;
+
+	ShaderPipelineStage* shaderPipelineStage;
+
+	GraphicsPipeline* pipeline;
+
+	unsigned int lineCount;
+
+};
+
+#endif // DEBUGDRAW_H
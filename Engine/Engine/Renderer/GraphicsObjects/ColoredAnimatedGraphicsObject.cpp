@@ -43,14 +43,21 @@ void ColoredAnimatedGraphicsObject::Update()
 	mvp.projection = cam->GetProjection();
 	mvp.projection[1][1] *= -1;
 
-	animation->Update(anim.pose);
+	bool leafJointsAtRest = false;
+	const AnimationLOD::Level lod = AnimationLOD::Select(*cam, *model, mvp.model, leafJointsAtRest);
+	animation->Update(anim.pose, lod, leafJointsAtRest);
 
 	light.color = glm::vec4(dirLight->GetColor(), 1.0f);
 	light.direction = glm::vec4(dirLight->GetDirection(), 0.0f);
 	light.ambient = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
 
 	uniformBuffers[0]->SetData(&mvp);
-	uniformBuffers[1]->SetData(&anim);
+
+	if (lod != AnimationLOD::Level::Frozen)
+	{
+		uniformBuffers[1]->SetData(&anim);
+	}
+
 	uniformBuffers[2]->SetData(&light);
 	uniformBuffers[3]->SetData(&color);
 }
@@ -64,9 +71,30 @@ void ColoredAnimatedGraphicsObject::SetClip(unsigned int clipIndex)
 {
 	Animation* oldAnimation = animation;
 	animation = new Animation(model->GetBakedAnimation(clipIndex));
+	animation->SetSpeed(oldAnimation->GetSpeed());
 	delete oldAnimation;
 }
 
+void ColoredAnimatedGraphicsObject::CrossFadeToClip(unsigned int clipIndex, float fadeDuration)
+{
+	animation->CrossFade(model->GetBakedAnimation(clipIndex), fadeDuration);
+}
+
+Animation& ColoredAnimatedGraphicsObject::GetAnimation()
+{
+	return *animation;
+}
+
+void ColoredAnimatedGraphicsObject::OnModelReloaded()
+{
+	for (unsigned int i = 0; i < model->GetArmature()->GetInvBindPose().size(); i++)
+	{
+		anim.invBindPose[i] = model->GetArmature()->GetInvBindPose()[i];
+	}
+
+	SetClip(0);
+}
+
 const glm::mat4* const ColoredAnimatedGraphicsObject::GetAnimPoseArray()
 {
 	return anim.pose;
@@ -22,6 +22,12 @@ public:
 
 	void SetClip(unsigned int clipIndex);
 
+	// Fades from the playing clip to clipIndex over fadeDuration seconds.
+	void CrossFadeToClip(unsigned int clipIndex, float fadeDuration);
+
+	// For layers and blend spaces beyond playing a single clip.
+	Animation& GetAnimation();
+
 	const glm::mat4* const GetAnimPoseArray();
 
 	const glm::mat4* const GetAnimInvBindPoseArray();
@@ -36,6 +42,8 @@ private:
 
 	void CreateUniformBuffers() override;
 
+	void OnModelReloaded() override;
+
 	ColoredAnimatedGraphicsObject(const ColoredAnimatedGraphicsObject&) = delete;
 
 	ColoredAnimatedGraphicsObject& operator=(const ColoredAnimatedGraphicsObject&) = delete;
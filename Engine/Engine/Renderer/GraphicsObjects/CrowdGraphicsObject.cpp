@@ -0,0 +1,269 @@
+#include "CrowdGraphicsObject.h"
+
+#include "../../Animation/BakedAnimation.h"
+#include "../../Animation/BakedJointMatrices.h"
+#include "../../Animation/Armature.h"
+#include "../Model/Model.h"
+#include "../../Time/TimeManager.h"
+#include "../../Utils/Logger.h"
+#include "../Cameras/CameraManager.h"
+#include "../Memory/UniformBuffer.h"
+#include "../Memory/StorageBuffer.h"
+#include "../Memory/StagingBuffer.h"
+#include "../Images/Texture.h"
+#include "../Lights/LightManager.h"
+#include "../Lights/DirectionalLight.h"
+
+#include <algorithm>
+
+CrowdGraphicsObject::CrowdGraphicsObject(const Model* const m, Texture* const tex, unsigned int max) :
+	GraphicsObject(m),
+	texture(tex),
+	jointMatrices(nullptr),
+	maxInstances(std::max(1U, max)),
+	instances(),
+	instancesDirty(false),
+	uploadedInstanceCount(0U)
+{
+	type = ObjectTypes::GraphicsObjectType::Crowd;
+	crowd.model = glm::mat4(1.0f);
+	shaderName = "Crowd";
+
+	instances.reserve(maxInstances);
+
+	// The descriptor sets point at the baked matrices, so they are baked first.
+	BakeJointMatrices();
+	InitializeDescriptorSets();
+
+	dirLight = LightManager::GetDirectionalLight("MainDirLight");
+}
+
+CrowdGraphicsObject::~CrowdGraphicsObject()
+{
+	delete jointMatrices;
+}
+
+unsigned int CrowdGraphicsObject::AddInstance(const glm::mat4& transform, unsigned int clip, float timeOffset, float speed)
+{
+	std::lock_guard<std::mutex> guard(instancesMutex);
+
+	if (instances.size() >= maxInstances)
+	{
+		Logger::Log(std::string("Calling CrowdGraphicsObject::AddInstance() on a full crowd."), Logger::Category::Warning);
+		return maxInstances;
+	}
+
+	Instance instance = {};
+	instance.transform = transform;
+	instance.clip = std::min(clip, GetClipCount() - 1U);
+	instance.timeOffset = timeOffset;
+	instance.speed = speed;
+
+	instances.push_back(instance);
+	instancesDirty = true;
+
+	return static_cast<unsigned int>(instances.size() - 1);
+}
+
+void CrowdGraphicsObject::RemoveInstance(unsigned int index)
+{
+	std::lock_guard<std::mutex> guard(instancesMutex);
+
+	if (index < instances.size())
+	{
+		instances[index] = instances.back();
+		instances.pop_back();
+		instancesDirty = true;
+	}
+}
+
+void CrowdGraphicsObject::SetInstance(unsigned int index, const Instance& instance)
+{
+	std::lock_guard<std::mutex> guard(instancesMutex);
+
+	if (index < instances.size())
+	{
+		instances[index] = instance;
+		instances[index].clip = std::min(instance.clip, GetClipCount() - 1U);
+		instancesDirty = true;
+	}
+}
+
+CrowdGraphicsObject::Instance CrowdGraphicsObject::GetInstance(unsigned int index) const
+{
+	std::lock_guard<std::mutex> guard(instancesMutex);
+
+	if (index < instances.size())
+	{
+		return instances[index];
+	}
+
+	return Instance();
+}
+
+void CrowdGraphicsObject::SetInstanceTransform(unsigned int index, const glm::mat4& transform)
+{
+	std::lock_guard<std::mutex> guard(instancesMutex);
+
+	if (index < instances.size())
+	{
+		instances[index].transform = transform;
+		instancesDirty = true;
+	}
+}
+
+void CrowdGraphicsObject::SetInstanceClip(unsigned int index, unsigned int clip, float timeOffset)
+{
+	std::lock_guard<std::mutex> guard(instancesMutex);
+
+	if (index < instances.size())
+	{
+		// The shader plays from the crowd's time, offsetting by it restarts the clip now.
+		instances[index].clip = std::min(clip, GetClipCount() - 1U);
+		instances[index].timeOffset = timeOffset - TimeManager::SecondsSinceStart() * instances[index].speed;
+		instancesDirty = true;
+	}
+}
+
+unsigned int CrowdGraphicsObject::GetInstanceCount() const
+{
+	return uploadedInstanceCount;
+}
+
+unsigned int CrowdGraphicsObject::GetMaxInstances() const
+{
+	return maxInstances;
+}
+
+unsigned int CrowdGraphicsObject::GetClipCount() const
+{
+	return std::max(1U, static_cast<unsigned int>(jointMatrices->GetClips().size()));
+}
+
+void CrowdGraphicsObject::CreateTextures()
+{
+	AddTexture(texture);
+	texture->SetBinding(1U);
+}
+
+void CrowdGraphicsObject::CreateUniformBuffers()
+{
+	// The binding for the texture sampler is 1.
+
+	UniformBuffer* crowdUniformBuffer = new UniformBuffer(sizeof(crowd), 0);
+	crowdUniformBuffer->PersistentMap();
+	uniformBuffers.push_back(crowdUniformBuffer);
+
+	UniformBuffer* lightsUniformBuffer = new UniformBuffer(sizeof(light), 5);
+	lightsUniformBuffer->PersistentMap();
+	uniformBuffers.push_back(lightsUniformBuffer);
+
+	// Bindings 2 and 3 are the baked joint matrices and the clip table, written once.
+	UploadJointMatrices();
+
+	storageBuffers.push_back(new StorageBuffer(static_cast<unsigned int>(sizeof(Instance) * maxInstances), 4, true));
+}
+
+void CrowdGraphicsObject::Update()
+{
+	Camera* cam = &CameraManager::GetActiveCamera();
+
+	crowd.model = translation * rotation * scale;
+
+	crowd.view = cam->GetView();
+	crowd.projection = cam->GetProjection();
+	crowd.projection[1][1] *= -1;
+
+	// Every instance derives its clip time from this in the vertex shader.
+	crowd.time = TimeManager::SecondsSinceStart();
+	crowd.jointCount = jointMatrices->GetJointCount();
+	crowd.clipCount = static_cast<uint32_t>(jointMatrices->GetClips().size());
+
+	light.color = glm::vec4(dirLight->GetColor(), 1.0f);
+	light.direction = glm::vec4(dirLight->GetDirection(), 0.0f);
+	light.ambient = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
+
+	uniformBuffers[0]->SetData(&crowd);
+	uniformBuffers[1]->SetData(&light);
+
+	std::lock_guard<std::mutex> guard(instancesMutex);
+
+	if (instancesDirty)
+	{
+		if (!instances.empty())
+		{
+			storageBuffers.back()->SetData(instances.data(), 0U, static_cast<unsigned int>(sizeof(Instance) * instances.size()));
+		}
+
+		// Without clips the shader has no clip range to read, so nothing is drawn until a reload brings some.
+		uploadedInstanceCount = jointMatrices->GetClips().empty() ? 0U : static_cast<unsigned int>(instances.size());
+		instancesDirty = false;
+	}
+}
+
+void CrowdGraphicsObject::OnModelReloaded()
+{
+	BakeJointMatrices();
+
+	// The new bake may differ in size, so the buffers and the descriptor set pointing at them are replaced.
+	for (unsigned int i = 0; i < 2 && !storageBuffers.empty(); i++)
+	{
+		delete storageBuffers.front();
+		storageBuffers.erase(storageBuffers.begin());
+	}
+
+	UploadJointMatrices();
+	RecreateDescriptorSet();
+
+	std::lock_guard<std::mutex> guard(instancesMutex);
+
+	for (Instance& instance : instances)
+	{
+		instance.clip = std::min(instance.clip, GetClipCount() - 1U);
+	}
+
+	instancesDirty = true;
+}
+
+void CrowdGraphicsObject::BakeJointMatrices()
+{
+	delete jointMatrices;
+
+	std::vector<const BakedAnimation*> clips;
+	for (unsigned int i = 0; i < model->GetAnimationClips().size(); i++)
+	{
+		clips.push_back(&model->GetBakedAnimation(i));
+	}
+
+	if (clips.empty())
+	{
+		Logger::Log(std::string("Creating a CrowdGraphicsObject from a model without animation clips."), Logger::Category::Warning);
+	}
+
+	jointMatrices = new BakedJointMatrices(clips, model->GetArmature()->GetInvBindPose());
+
+	Logger::Log(std::string("Baked ") + std::to_string(clips.size()) + std::string(" clips into ") + std::to_string(jointMatrices->GetFrameCount()) + std::string(" crowd frames, ") + std::to_string(jointMatrices->GetSizeInBytes() / 1024) + std::string(" KB."), Logger::Category::Success);
+}
+
+void CrowdGraphicsObject::UploadJointMatrices()
+{
+	auto upload = [this](const void* source, unsigned int sizeInBytes, unsigned int binding)
+		{
+			// Storage buffers cannot be empty, a clipless crowd still gets one element.
+			const unsigned int bufferSize = std::max(sizeInBytes, 16U);
+
+			StorageBuffer* const storageBuffer = new StorageBuffer(bufferSize, binding, false);
+
+			if (sizeInBytes > 0U)
+			{
+				StagingBuffer stagingBuffer(bufferSize);
+				stagingBuffer.Map(source, sizeInBytes);
+				storageBuffer->CopyFrom(stagingBuffer);
+			}
+
+			storageBuffers.insert(storageBuffers.begin() + (binding - 2U), storageBuffer);
+		};
+
+	upload(jointMatrices->GetRows().data(), static_cast<unsigned int>(sizeof(glm::vec4) * jointMatrices->GetRows().size()), 2);
+	upload(jointMatrices->GetClips().data(), static_cast<unsigned int>(sizeof(BakedJointMatrices::ClipRange) * jointMatrices->GetClips().size()), 3);
+}
@@ -0,0 +1,130 @@
+#ifndef CROWDGRAPHICSOBJECT_H
+#define CROWDGRAPHICSOBJECT_H
+
+#include "GraphicsObject.h"
+#include "3DTransformable.h"
+
+#include <mutex>
+#include <cstdint>
+
+class Model;
+class Texture;
+class DirectionalLight;
+class BakedJointMatrices;
+
+// Many copies of an animated model drawn with one instanced call. The clips are baked once into joint matrices on the
+// GPU and each instance picks its clip and time there, so animating an instance costs nothing on the CPU after it is added.
+// The transformable part moves the whole crowd, instance transforms are relative to it.
+class CrowdGraphicsObject : public GraphicsObject, public Graphics3DTransformable
+{
+public:
+
+	// Matches the std430 layout of the instance buffer in the crowd shaders.
+	struct Instance
+	{
+		glm::mat4 transform;
+
+		uint32_t clip;
+
+		// Seconds added to the crowd's time, so instances playing the same clip are not in step.
+		float timeOffset;
+
+		float speed;
+
+		float padding;
+	};
+
+	CrowdGraphicsObject() = delete;
+
+	CrowdGraphicsObject(const Model* const model, Texture* const texture, unsigned int maxInstances);
+
+	~CrowdGraphicsObject();
+
+	CrowdGraphicsObject(const CrowdGraphicsObject&) = delete;
+
+	CrowdGraphicsObject& operator=(const CrowdGraphicsObject&) = delete;
+
+	CrowdGraphicsObject(CrowdGraphicsObject&&) = delete;
+
+	CrowdGraphicsObject& operator=(CrowdGraphicsObject&&) = delete;
+
+	// Returns the index of the new instance, or GetMaxInstances() if the crowd is full.
+	unsigned int AddInstance(const glm::mat4& transform, unsigned int clip, float timeOffset = 0.0f, float speed = 1.0f);
+
+	// Moves the last instance into index, so the last index is no longer valid.
+	void RemoveInstance(unsigned int index);
+
+	void SetInstance(unsigned int index, const Instance& instance);
+
+	Instance GetInstance(unsigned int index) const;
+
+	void SetInstanceTransform(unsigned int index, const glm::mat4& transform);
+
+	// Restarts the instance on clip, timeOffset seconds in.
+	void SetInstanceClip(unsigned int index, unsigned int clip, float timeOffset = 0.0f);
+
+	virtual unsigned int GetInstanceCount() const override;
+
+	unsigned int GetMaxInstances() const;
+
+	unsigned int GetClipCount() const;
+
+protected:
+
+	struct CrowdUniformBuffer
+	{
+		glm::mat4 model;
+		glm::mat4 view;
+		glm::mat4 projection;
+		float time;
+		uint32_t jointCount;
+		uint32_t clipCount;
+		float padding;
+	};
+
+	struct LightUniformBuffer
+	{
+		glm::vec4 ambient;
+		glm::vec4 direction;
+		glm::vec4 color;
+	};
+
+	virtual void CreateTextures() override;
+
+	virtual void CreateUniformBuffers() override;
+
+	virtual void Update() override;
+
+	virtual void OnModelReloaded() override;
+
+	void BakeJointMatrices();
+
+	void UploadJointMatrices();
+
+	CrowdUniformBuffer crowd;
+
+	LightUniformBuffer light;
+
+	Texture* texture;
+
+	DirectionalLight* dirLight;
+
+	BakedJointMatrices* jointMatrices;
+
+	const unsigned int maxInstances;
+
+	std::vector<Instance> instances;
+
+	mutable std::mutex instancesMutex;
+
+	// The instances changed since they were last written to the instance buffer.
+	bool instancesDirty;
+
+	// Instances in the instance buffer, what the draw uses even while more are being added.
+	unsigned int uploadedInstanceCount;
+
+private:
+
+};
+
+#endif // CROWDGRAPHICSOBJECT_H
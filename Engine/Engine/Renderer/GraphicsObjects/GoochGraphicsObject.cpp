@@ -15,7 +15,7 @@ void GoochGraphicsObject::CreateUniformBuffers()
 
 void GoochGraphicsObject::CreateTextures()
 {
-	textures.push_back(texture);
+	AddTexture(texture);
 	texture->SetBinding(1U);
 }
 
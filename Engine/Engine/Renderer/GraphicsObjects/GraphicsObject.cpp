@@ -5,6 +5,7 @@
 #include "../Windows/WindowManager.h"
 #include "../Windows/Window.h"
 #include "../Memory/UniformBuffer.h"
+#include "../Memory/StorageBuffer.h"
 #include "../Pipeline/Shaders/DescriptorSet.h"
 #include "../Pipeline/Shaders/DescriptorSetManager.h"
 #include "../Memory/VertexBuffer.h"
@@ -20,14 +21,18 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <chrono>
+#include <algorithm>
 
 GraphicsObject::GraphicsObject() :
 	model(ModelManager::GetModel("DefaultRectangle")),
+	modelReference(ModelManager::AcquireModel(model)),
 	modelVertexBuffer(new VertexBuffer(static_cast<unsigned int>(sizeof(Vertex) * model->GetVertices().size()))),
 	modelIndexBuffer(new IndexBuffer(static_cast<unsigned int>(sizeof(unsigned int) * model->GetIndices().size()))),
 	uniformBuffers(std::vector<UniformBuffer*>()),
+	storageBuffers(std::vector<StorageBuffer*>()),
 	descriptorSet(nullptr),
 	textures(std::vector<Texture*>()),
+	textureReferences(std::vector<TextureHandle>()),
 	type(),
 	loaded(false)
 {
@@ -36,11 +41,14 @@ GraphicsObject::GraphicsObject() :
 
 GraphicsObject::GraphicsObject(const Model* const m) :
 	model(m),
+	modelReference(ModelManager::AcquireModel(model)),
 	modelVertexBuffer(new VertexBuffer(static_cast<unsigned int>(sizeof(Vertex) * model->GetVertices().size()))),
 	modelIndexBuffer(new IndexBuffer(static_cast<unsigned int>(sizeof(unsigned int) * model->GetIndices().size()))),
 	uniformBuffers(std::vector<UniformBuffer*>()),
+	storageBuffers(std::vector<StorageBuffer*>()),
 	descriptorSet(nullptr),
 	textures(std::vector<Texture*>()),
+	textureReferences(std::vector<TextureHandle>()),
 	loaded(false)
 {
 	InitializeBuffers();
@@ -60,6 +68,13 @@ GraphicsObject::~GraphicsObject()
 	}
 
 	uniformBuffers.clear();
+
+	for (StorageBuffer* const buffer : storageBuffers)
+	{
+		delete buffer;
+	}
+
+	storageBuffers.clear();
 }
 
 const DescriptorSet& GraphicsObject::GetDescriptorSet() const
@@ -82,6 +97,16 @@ const Model* const GraphicsObject::GetModel() const
 	return model;
 }
 
+unsigned int GraphicsObject::GetIndexCount() const
+{
+	return static_cast<unsigned int>(model->GetIndices().size());
+}
+
+unsigned int GraphicsObject::GetInstanceCount() const
+{
+	return 1U;
+}
+
 const UniformBuffer* const GraphicsObject::GetUniformBuffer(unsigned int binding) const
 {
 	for (UniformBuffer* const buffer : uniformBuffers)
@@ -95,6 +120,19 @@ const UniformBuffer* const GraphicsObject::GetUniformBuffer(unsigned int binding
 	return nullptr;
 }
 
+const StorageBuffer* const GraphicsObject::GetStorageBuffer(unsigned int binding) const
+{
+	for (StorageBuffer* const buffer : storageBuffers)
+	{
+		if (buffer->Binding() == binding)
+		{
+			return buffer;
+		}
+	}
+
+	return nullptr;
+}
+
 const Image* const GraphicsObject::GetImage(unsigned int binding) const
 {
 	for (Texture* texture : textures)
@@ -107,6 +145,12 @@ const Image* const GraphicsObject::GetImage(unsigned int binding) const
 	return nullptr;
 }
 
+void GraphicsObject::AddTexture(Texture* const texture)
+{
+	textures.push_back(texture);
+	textureReferences.push_back(TextureManager::AcquireTexture(texture));
+}
+
 ObjectTypes::GraphicsObjectType GraphicsObject::GetGraphicsObjectType() const
 {
 	return type;
@@ -135,6 +179,34 @@ void GraphicsObject::InitializeBuffers()
 	modelIndexBuffer->CopyFrom(indexStagingBuffer);
 }
 
+void GraphicsObject::RebuildBuffers()
+{
+	delete modelIndexBuffer;
+	delete modelVertexBuffer;
+
+	modelVertexBuffer = new VertexBuffer(static_cast<unsigned int>(sizeof(Vertex) * model->GetVertices().size()));
+	modelIndexBuffer = new IndexBuffer(static_cast<unsigned int>(sizeof(unsigned int) * model->GetIndices().size()));
+
+	InitializeBuffers();
+}
+
+void GraphicsObject::RecreateDescriptorSet()
+{
+	delete descriptorSet;
+	descriptorSet = nullptr;
+
+	CreateDescriptorSets();
+}
+
+bool GraphicsObject::UsesTexture(const Texture* const texture) const
+{
+	return std::find(textures.begin(), textures.end(), texture) != textures.end();
+}
+
+void GraphicsObject::OnModelReloaded()
+{
+}
+
 void GraphicsObject::Load()
 {
 	loaded.store(true);
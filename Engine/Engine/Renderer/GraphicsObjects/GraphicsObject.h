@@ -2,6 +2,8 @@
 #define GRAPHICSOBJECT_H
 
 #include "GraphicsObjectTypes.h"
+#include "../Model/ModelManager.h"
+#include "../Images/TextureManager.h"
 
 #include <glm/glm.hpp>
 #include <vector>
@@ -10,6 +12,7 @@
 
 class Model;
 class UniformBuffer;
+class StorageBuffer;
 class DescriptorSet;
 class DescriptorSetLayout;
 class VertexBuffer;
@@ -46,8 +49,15 @@ public:
 
 	virtual void Update() = 0;
 
+	virtual unsigned int GetIndexCount() const;
+
+	// Objects drawing many copies of their model in one call return how many.
+	virtual unsigned int GetInstanceCount() const;
+
 	virtual const UniformBuffer* const GetUniformBuffer(unsigned int binding) const;
 
+	virtual const StorageBuffer* const GetStorageBuffer(unsigned int binding) const;
+
 	virtual const Image* const GetImage(unsigned int binding) const;
 
 	ObjectTypes::GraphicsObjectType GetGraphicsObjectType() const;
@@ -63,16 +73,31 @@ protected:
 
 	virtual void CreateUniformBuffers() = 0;
 
+	// Adds the texture and holds a reference to it for the lifetime of this object.
+	void AddTexture(Texture* const texture);
+
+	// Called on the render thread after the model was reloaded in place.
+	virtual void OnModelReloaded();
+
+	// Replaces the descriptor set, for when the buffers or images it points at were replaced.
+	void RecreateDescriptorSet();
+
 	const Model* const model;
 
+	ModelHandle modelReference;
+
 	VertexBuffer* modelVertexBuffer;
 	
 	IndexBuffer* modelIndexBuffer;
 
 	std::vector<Texture*> textures;
 
+	std::vector<TextureHandle> textureReferences;
+
 	std::vector<UniformBuffer*> uniformBuffers;
 
+	std::vector<StorageBuffer*> storageBuffers;
+
 	DescriptorSet* descriptorSet;
 
 	std::string shaderName;
@@ -89,6 +114,10 @@ private:
 	void CreateDescriptorSets();
 
 	void InitializeBuffers();
+
+	void RebuildBuffers();
+
+	bool UsesTexture(const Texture* const texture) const;
 };
 
 #endif // GRAPHICSOBJECT_H
\ No newline at end of file
@@ -6,8 +6,10 @@
 #include "LitTexturedStaticGraphicsObject.h"
 #include "GoochGraphicsObject.h"
 #include "TexturedStatic2DGraphicsObject.h"
+#include "TextGraphicsObject.h"
 #include "ColoredStaticGraphicsObject.h"
 #include "ColoredAnimatedGraphicsObject.h"
+#include "CrowdGraphicsObject.h"
 #include "../Pipeline/Shaders/DescriptorSet.h"
 #include "../Pipeline/Shaders/DescriptorSetManager.h"
 #include "../Windows/Window.h"
@@ -17,12 +19,17 @@
 #include "../Memory/VertexBuffer.h"
 #include "../Memory/IndexBuffer.h"
 #include "../Model/Model.h"
+#include "../Model/ModelManager.h"
+#include "../Images/TextureManager.h"
 #include "../Pipeline/PipelineLayout.h"
 #include "../Pipeline/Shaders/ShaderPipelineStage.h"
 #include "../Pipeline/Rasterizer/WireFrameRasterizerPipelineState.h"
+#include "../Pipeline/ColorBlending/AlphaBlendingPipelineState.h"
 #include "../Pipeline/Shaders/Shader.h"
 #include "../Renderer.h"
 #include "../Vulkan/VulkanPhysicalDevice.h"
+#include "../../Animation/PoseCache.h"
+#include "../../Animation/AnimationLOD.h"
 #include "SPIRV-Reflect/spirv_reflect.h"
 
 #include <filesystem>
@@ -33,6 +40,9 @@ GraphicsObjectManager* GraphicsObjectManager::instance = nullptr;
 
 bool GraphicsObjectManager::shouldUpdate = false;
 
+// 2D objects and text are drawn over the scene.
+const std::unordered_set<std::string> GraphicsObjectManager::blendedPipelineKeys = { std::string("Blended_TexturedStatic") };
+
 const std::string GraphicsObjectManager::shaderDirectoryName = std::string("Assets/Shaders/");
 
 void GraphicsObjectManager::Initialize(const Window& window)
@@ -83,7 +93,13 @@ void GraphicsObjectManager::CreateGraphicsPipelines()
 
 	for (auto& graphicsPipeline : graphicsPipelines)
 	{
-		if (!IsPipelineFromShader(graphicsPipeline.first))
+		if (IsBlendedPipeline(graphicsPipeline.first))
+		{
+			const RasterizerPipelineState* const rasterizer = new RasterizerPipelineState();
+			const AlphaBlendingPipelineState* const alphaBlending = new AlphaBlendingPipelineState();
+			graphicsPipeline.second.second = new GraphicsPipeline(*graphicsPipeline.second.first, *rasterizer, *alphaBlending, window);
+		}
+		else if (!IsPipelineFromShader(graphicsPipeline.first))
 		{
 			const WireFrameRasterizerPipelineState* const wireFrameRasterizer = new WireFrameRasterizerPipelineState();
 			graphicsPipeline.second.second = new GraphicsPipeline(*graphicsPipeline.second.first, *wireFrameRasterizer, window);
@@ -106,39 +122,11 @@ void GraphicsObjectManager::LoadShaders()
 			{
 				if (dirEntry.path().has_extension())
 				{
-					static const std::string vert(".vertspv");
-					static const std::string frag(".fragspv");
-					static const std::string geo(".geospv");
-					static const std::string tessE(".tessespv");
-					static const std::string tessC(".tesscspv");
-
 					// Get the file name without the extension.
 					std::string fileName = dirEntry.path().stem().string();
 
 					// Get the shader stage for this shader file if it is a shader file.
-					std::string extension = dirEntry.path().extension().string();
-					VkShaderStageFlagBits shaderStage = VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM;
-					if (extension == vert)
-					{
-						shaderStage = VkShaderStageFlagBits::VK_SHADER_STAGE_VERTEX_BIT;
-					}
-					else if (extension == frag)
-					{
-						shaderStage = VkShaderStageFlagBits::VK_SHADER_STAGE_FRAGMENT_BIT;
-
-					}
-					else if (extension == geo)
-					{
-						shaderStage = VkShaderStageFlagBits::VK_SHADER_STAGE_GEOMETRY_BIT;
-					}
-					else if (extension == tessE)
-					{
-						shaderStage = VkShaderStageFlagBits::VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
-					}
-					else if (extension == tessC)
-					{
-						shaderStage = VkShaderStageFlagBits::VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
-					}
+					VkShaderStageFlagBits shaderStage = ShaderStageFromExtension(dirEntry.path().extension().string());
 
 					// Is this a shader file?
 					if (shaderStage != VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM)
@@ -154,6 +142,11 @@ void GraphicsObjectManager::LoadShaders()
 							shaderPipelineStage = new ShaderPipelineStage();
 							graphicsPipelines.insert(std::pair<std::string, std::pair<ShaderPipelineStage*, GraphicsPipeline*>>(fileName, std::pair<ShaderPipelineStage*, GraphicsPipeline*>(shaderPipelineStage, nullptr)));
 							graphicsPipelines.insert(std::pair<std::string, std::pair<ShaderPipelineStage*, GraphicsPipeline*>>(std::string("WireFrame_") + fileName, std::pair<ShaderPipelineStage*, GraphicsPipeline*>(shaderPipelineStage, nullptr)));
+
+							if (HasBlendedPipeline(fileName))
+							{
+								graphicsPipelines.insert(std::pair<std::string, std::pair<ShaderPipelineStage*, GraphicsPipeline*>>(std::string("Blended_") + fileName, std::pair<ShaderPipelineStage*, GraphicsPipeline*>(shaderPipelineStage, nullptr)));
+							}
 						}
 
 						// Create and add the shader to the ShaderPipelineStage.
@@ -168,6 +161,260 @@ void GraphicsObjectManager::LoadShaders()
 	}
 }
 
+VkShaderStageFlagBits GraphicsObjectManager::ShaderStageFromExtension(const std::string& extension)
+{
+	static const std::string vert(".vertspv");
+	static const std::string frag(".fragspv");
+	static const std::string geo(".geospv");
+	static const std::string tessE(".tessespv");
+	static const std::string tessC(".tesscspv");
+
+	if (extension == vert)
+	{
+		return VkShaderStageFlagBits::VK_SHADER_STAGE_VERTEX_BIT;
+	}
+	else if (extension == frag)
+	{
+		return VkShaderStageFlagBits::VK_SHADER_STAGE_FRAGMENT_BIT;
+	}
+	else if (extension == geo)
+	{
+		return VkShaderStageFlagBits::VK_SHADER_STAGE_GEOMETRY_BIT;
+	}
+	else if (extension == tessE)
+	{
+		return VkShaderStageFlagBits::VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+	}
+	else if (extension == tessC)
+	{
+		return VkShaderStageFlagBits::VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+	}
+
+	return VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM;
+}
+
+std::function<void()> GraphicsObjectManager::RebuildShaderPipeline(const std::string& shaderName)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling GraphicsObjectManager::RebuildShaderPipeline() before GraphicsObjectManager::Initialize()."), Logger::Category::Warning);
+		return std::function<void()>();
+	}
+
+	ShaderPipelineStage* shaderPipelineStage = new ShaderPipelineStage();
+	GraphicsPipeline* solidPipeline = nullptr;
+	GraphicsPipeline* wireFramePipeline = nullptr;
+	std::vector<Shader*> stageShaders;
+
+	try
+	{
+		for (auto& dirEntry : std::filesystem::directory_iterator(std::filesystem::path(shaderDirectoryName)))
+		{
+			if (dirEntry.is_regular_file() && dirEntry.path().stem().string() == shaderName)
+			{
+				VkShaderStageFlagBits shaderStage = ShaderStageFromExtension(dirEntry.path().extension().string());
+
+				if (shaderStage != VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM)
+				{
+					Shader* shader = new Shader(dirEntry, Renderer::GetVulkanPhysicalDevice());
+					shaderPipelineStage->AddShader(shaderStage, shader);
+					stageShaders.push_back(shader);
+				}
+			}
+		}
+
+		if (stageShaders.empty())
+		{
+			delete shaderPipelineStage;
+			return std::function<void()>();
+		}
+
+		shaderPipelineStage->CreateDescriptorSetLayout();
+		solidPipeline = new GraphicsPipeline(*shaderPipelineStage, instance->window);
+
+		const WireFrameRasterizerPipelineState* const wireFrameRasterizer = new WireFrameRasterizerPipelineState();
+		wireFramePipeline = new GraphicsPipeline(*shaderPipelineStage, *wireFrameRasterizer, instance->window);
+
+		GraphicsPipeline* blendedPipeline = nullptr;
+		if (HasBlendedPipeline(shaderName))
+		{
+			const RasterizerPipelineState* const rasterizer = new RasterizerPipelineState();
+			const AlphaBlendingPipelineState* const alphaBlending = new AlphaBlendingPipelineState();
+			blendedPipeline = new GraphicsPipeline(*shaderPipelineStage, *rasterizer, *alphaBlending, instance->window);
+		}
+
+		return [shaderName, shaderPipelineStage, solidPipeline, wireFramePipeline, blendedPipeline, stageShaders]()
+		{
+			if (instance != nullptr)
+			{
+				instance->SwapShaderPipeline(shaderName, shaderPipelineStage, solidPipeline, wireFramePipeline, blendedPipeline, stageShaders);
+			}
+		};
+	}
+	catch (const std::exception& exception)
+	{
+		// A half written shader file fails here, the next write triggers another rebuild.
+		Logger::Log(std::string("Failed to rebuild shader pipeline ") + shaderName + ". " + exception.what(), Logger::Category::Error);
+		delete wireFramePipeline;
+		delete solidPipeline;
+		delete shaderPipelineStage;
+		return std::function<void()>();
+	}
+}
+
+void GraphicsObjectManager::SwapShaderPipeline(const std::string& shaderName, ShaderPipelineStage* stage, GraphicsPipeline* solidPipeline, GraphicsPipeline* wireFramePipeline, GraphicsPipeline* blendedPipeline, const std::vector<Shader*>& stageShaders)
+{
+	auto solid = graphicsPipelines.find(shaderName);
+	auto wireFrame = graphicsPipelines.find(std::string("WireFrame_") + shaderName);
+	auto blended = graphicsPipelines.find(std::string("Blended_") + shaderName);
+
+	if (solid != graphicsPipelines.end())
+	{
+		ShaderPipelineStage* oldStage = solid->second.first;
+
+		shaders.erase(std::remove_if(shaders.begin(), shaders.end(), [oldStage](Shader* shader)
+			{
+				return oldStage->GetShader(VK_SHADER_STAGE_VERTEX_BIT) == shader ||
+					oldStage->GetShader(VK_SHADER_STAGE_FRAGMENT_BIT) == shader ||
+					oldStage->GetShader(VK_SHADER_STAGE_GEOMETRY_BIT) == shader ||
+					oldStage->GetShader(VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT) == shader ||
+					oldStage->GetShader(VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT) == shader;
+			}), shaders.end());
+
+		// The previous frame has been waited on before commands are executed, so nothing in flight still uses these.
+		delete solid->second.second;
+		if (wireFrame != graphicsPipelines.end())
+		{
+			delete wireFrame->second.second;
+		}
+		if (blended != graphicsPipelines.end())
+		{
+			delete blended->second.second;
+		}
+		delete oldStage;
+	}
+
+	graphicsPipelines[shaderName] = std::make_pair(stage, solidPipeline);
+	graphicsPipelines[std::string("WireFrame_") + shaderName] = std::make_pair(stage, wireFramePipeline);
+	if (blendedPipeline != nullptr)
+	{
+		graphicsPipelines[std::string("Blended_") + shaderName] = std::make_pair(stage, blendedPipeline);
+	}
+	shaders.insert(shaders.end(), stageShaders.begin(), stageShaders.end());
+
+	ForEachGraphicsObject([&shaderName](GraphicsObject* graphicsObject)
+		{
+			if (graphicsObject->shaderName == shaderName)
+			{
+				graphicsObject->RecreateDescriptorSet();
+			}
+		});
+
+	Logger::Log(std::string("Reloaded shader pipeline ") + shaderName, Logger::Category::Success);
+}
+
+void GraphicsObjectManager::RefreshGraphicsObjectsUsingTexture(const Texture* const texture)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling GraphicsObjectManager::RefreshGraphicsObjectsUsingTexture() before GraphicsObjectManager::Initialize()."), Logger::Category::Warning);
+		return;
+	}
+
+	instance->ForEachGraphicsObject([texture](GraphicsObject* graphicsObject)
+		{
+			if (graphicsObject->UsesTexture(texture))
+			{
+				graphicsObject->RecreateDescriptorSet();
+			}
+		});
+}
+
+void GraphicsObjectManager::RefreshGraphicsObjectsUsingModel(const Model* const model)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling GraphicsObjectManager::RefreshGraphicsObjectsUsingModel() before GraphicsObjectManager::Initialize()."), Logger::Category::Warning);
+		return;
+	}
+
+	instance->ForEachGraphicsObject([model](GraphicsObject* graphicsObject)
+		{
+			if (graphicsObject->GetModel() == model)
+			{
+				graphicsObject->RebuildBuffers();
+				graphicsObject->OnModelReloaded();
+			}
+		});
+}
+
+void GraphicsObjectManager::ForEachGraphicsObject(const std::function<void(GraphicsObject*)>& function)
+{
+	std::lock_guard<std::mutex> guard(updateMutex);
+
+	auto forEachInVector = [&function](std::vector<GraphicsObject*>& goArray)
+	{
+		for (GraphicsObject* obj : goArray)
+		{
+			if (obj != nullptr)
+				function(obj);
+		}
+	};
+
+	auto forEachInWireFrameVector = [&function](std::vector<std::pair<GraphicsObject*, unsigned int>>& goArray)
+	{
+		for (std::pair<GraphicsObject*, unsigned int>& obj : goArray)
+		{
+			if (obj.first != nullptr)
+				function(obj.first);
+		}
+	};
+
+	auto forEachInList = [&function](std::list<std::pair<GraphicsObject*, unsigned int>>& goList)
+	{
+		for (std::pair<GraphicsObject*, unsigned int>& obj : goList)
+		{
+			if (obj.first != nullptr)
+				function(obj.first);
+		}
+	};
+
+	forEachInVector(texturedStaticGraphicsObjects);
+	forEachInVector(animatedTexturedGraphicsObjects);
+	forEachInVector(goochGraphicsObjects);
+	forEachInVector(litTexturedStaticGraphicsObjects);
+	forEachInVector(texturedStatic2DGraphicsObjects);
+	forEachInVector(coloredStaticGraphicsObjects);
+	forEachInVector(coloredAnimatedGraphicsObjects);
+	forEachInVector(crowdGraphicsObjects);
+
+	forEachInWireFrameVector(texturedStaticGraphicsObjectsWireFrame);
+	forEachInWireFrameVector(animatedTexturedGraphicsObjectsWireFrame);
+	forEachInWireFrameVector(goochGraphicsObjectsWireFrame);
+	forEachInWireFrameVector(litTexturedStaticGraphicsObjectsWireFrame);
+	forEachInWireFrameVector(texturedStatic2DGraphicsObjectsWireFrame);
+	forEachInWireFrameVector(coloredStaticGraphicsObjectsWireFrame);
+	forEachInWireFrameVector(coloredAnimatedGraphicsObjectsWireFrame);
+	forEachInWireFrameVector(crowdGraphicsObjectsWireFrame);
+
+	forEachInList(disabledTexturedStaticGraphicsObjects);
+	forEachInList(disabledAnimatedTexturedGraphicsObjects);
+	forEachInList(disabledGoochGraphicsObjects);
+	forEachInList(disabledLitTexturedStaticGraphicsObjects);
+	forEachInList(disabledTexturedStatic2DGraphicsObjects);
+	forEachInList(disabledColoredStaticGraphicsObjects);
+	forEachInList(disabledColoredAnimatedGraphicsObjects);
+	forEachInList(disabledCrowdGraphicsObjects);
+	forEachInList(disabledTexturedStaticGraphicsObjectsWireFrame);
+	forEachInList(disabledAnimatedTexturedGraphicsObjectsWireFrame);
+	forEachInList(disabledGoochGraphicsObjectsWireFrame);
+	forEachInList(disabledLitTexturedStaticGraphicsObjectsWireFrame);
+	forEachInList(disabledTexturedStatic2DGraphicsObjectsWireFrame);
+	forEachInList(disabledColoredStaticGraphicsObjectsWireFrame);
+	forEachInList(disabledColoredAnimatedGraphicsObjectsWireFrame);
+	forEachInList(disabledCrowdGraphicsObjectsWireFrame);
+}
+
 void GraphicsObjectManager::CreateQueuedGraphicsObjects()
 {
 	for (const auto& graphicsCreateFunction : graphicsObjectCreateQueue)
@@ -213,7 +460,17 @@ bool GraphicsObjectManager::IsPipelineFromShader(const std::string& pipelineKey)
 	size_t pieplineKeySize = pipelineKey.size();
 	const std::string wireFrame("WireFrame_");
 	const std::string pipelineKeyPrefix((pipelineKey.size() > wireFrame.size()) ? std::string(pipelineKey.begin(), pipelineKey.begin() + wireFrame.size()) : "");
-	return pipelineKeyPrefix.compare(wireFrame);
+	return pipelineKeyPrefix.compare(wireFrame) && !IsBlendedPipeline(pipelineKey);
+}
+
+bool GraphicsObjectManager::IsBlendedPipeline(const std::string& pipelineKey)
+{
+	return pipelineKey.rfind(std::string("Blended_"), 0) == 0;
+}
+
+bool GraphicsObjectManager::HasBlendedPipeline(const std::string& shaderName)
+{
+	return blendedPipelineKeys.find(std::string("Blended_") + shaderName) != blendedPipelineKeys.end();
 }
 
 void GraphicsObjectManager::CreateTexturedStaticGraphicsObject(const Model* const model, Texture* const texture, std::function<void(TexturedStaticGraphicsObject*)> callback)
@@ -227,7 +484,10 @@ void GraphicsObjectManager::CreateTexturedStaticGraphicsObject(const Model* cons
 
 	std::lock_guard<std::mutex> guard(instance->enqueueStaticMutex);
 
-	std::function<void()> create = [model, texture, callback]()
+	const ModelHandle modelReference = ModelManager::AcquireModel(model);
+	const TextureHandle textureReference = TextureManager::AcquireTexture(texture);
+
+	std::function<void()> create = [model, texture, modelReference, textureReference, callback]()
 	{
 		TexturedStaticGraphicsObject* newGraphicsObject = nullptr;
 
@@ -253,7 +513,10 @@ void GraphicsObjectManager::CreateTexturedAnimatedGraphicsObject(const Model* co
 
 	std::lock_guard<std::mutex> guard(instance->enqueueAnimatedMutex);
 
-	std::function<void()> create = [model, texture, callback]()
+	const ModelHandle modelReference = ModelManager::AcquireModel(model);
+	const TextureHandle textureReference = TextureManager::AcquireTexture(texture);
+
+	std::function<void()> create = [model, texture, modelReference, textureReference, callback]()
 	{
 		TexturedAnimatedGraphicsObject* newGraphicsObject = nullptr;
 		
@@ -279,7 +542,10 @@ void GraphicsObjectManager::CreateGoochGraphicsObject(const Model* const model,
 
 	std::lock_guard<std::mutex> guard(instance->enqueueGoochMutex);
 
-	std::function<void()> create = [model, texture, callback]()
+	const ModelHandle modelReference = ModelManager::AcquireModel(model);
+	const TextureHandle textureReference = TextureManager::AcquireTexture(texture);
+
+	std::function<void()> create = [model, texture, modelReference, textureReference, callback]()
 	{
 		GoochGraphicsObject* newGraphicsObject = nullptr;
 
@@ -305,7 +571,10 @@ void GraphicsObjectManager::CreateLitTexturedStaticGraphicsObject(const Model* c
 
 	std::lock_guard<std::mutex> guard(instance->enqueueLitStaticMutex);
 
-	std::function<void()> create = [model, texture, callback]()
+	const ModelHandle modelReference = ModelManager::AcquireModel(model);
+	const TextureHandle textureReference = TextureManager::AcquireTexture(texture);
+
+	std::function<void()> create = [model, texture, modelReference, textureReference, callback]()
 	{
 		LitTexturedStaticGraphicsObject* newGraphicsObject = nullptr;
 
@@ -331,7 +600,10 @@ void GraphicsObjectManager::CreateTexturedStatic2DGraphicsObject(const Model* co
 
 	std::lock_guard<std::mutex> guard(instance->enqueueStatic2DMutex);
 
-	std::function<void()> create = [model, texture, callback]()
+	const ModelHandle modelReference = ModelManager::AcquireModel(model);
+	const TextureHandle textureReference = TextureManager::AcquireTexture(texture);
+
+	std::function<void()> create = [model, texture, modelReference, textureReference, callback]()
 	{
 		TexturedStatic2DGraphicsObject* newGraphicsObject = nullptr;
 
@@ -347,6 +619,34 @@ void GraphicsObjectManager::CreateTexturedStatic2DGraphicsObject(const Model* co
 	instance->graphicsObjectCreateQueue.push_back(create);
 }
 
+void GraphicsObjectManager::CreateTextGraphicsObject(const std::shared_ptr<TextMesh>& mesh, Texture* const fontAtlas, std::function<void(TextGraphicsObject*)> callback)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling GraphicsObjectManager::CreateTextGraphicsObject() before GraphicsObjectManager::Initialize()."), Logger::Category::Warning);
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->enqueueStatic2DMutex);
+
+	const TextureHandle fontAtlasReference = TextureManager::AcquireTexture(fontAtlas);
+
+	std::function<void()> create = [mesh, fontAtlas, fontAtlasReference, callback]()
+	{
+		TextGraphicsObject* newGraphicsObject = nullptr;
+
+		if (mesh != nullptr && fontAtlas != nullptr)
+		{
+			newGraphicsObject = new TextGraphicsObject(mesh, fontAtlas);
+			newGraphicsObject->Load();
+			instance->texturedStatic2DGraphicsObjects.push_back(newGraphicsObject);
+			callback(newGraphicsObject);
+		}
+	};
+
+	instance->graphicsObjectCreateQueue.push_back(create);
+}
+
 void GraphicsObjectManager::CreateColoredStaticGraphicsObject(const Model* const model, const glm::vec4& color, std::function<void(ColoredStaticGraphicsObject*)> callback)
 {
 	if (instance == nullptr)
@@ -357,7 +657,9 @@ void GraphicsObjectManager::CreateColoredStaticGraphicsObject(const Model* const
 
 	std::lock_guard<std::mutex> guard(instance->enqueueColoredStaticMutex);
 
-	std::function<void()> create = [model, callback, color]()
+	const ModelHandle modelReference = ModelManager::AcquireModel(model);
+
+	std::function<void()> create = [model, modelReference, callback, color]()
 		{
 			ColoredStaticGraphicsObject* newGraphicsObject = nullptr;
 
@@ -383,7 +685,9 @@ void GraphicsObjectManager::CreateColoredAnimatedGraphicsObject(const Model* con
 
 	std::lock_guard<std::mutex> guard(instance->enqueueColoredAnimatedMutex);
 
-	std::function<void()> create = [model, callback, color]()
+	const ModelHandle modelReference = ModelManager::AcquireModel(model);
+
+	std::function<void()> create = [model, modelReference, callback, color]()
 		{
 			ColoredAnimatedGraphicsObject* newGraphicsObject = nullptr;
 
@@ -399,6 +703,35 @@ void GraphicsObjectManager::CreateColoredAnimatedGraphicsObject(const Model* con
 	instance->graphicsObjectCreateQueue.push_back(create);
 }
 
+void GraphicsObjectManager::CreateCrowdGraphicsObject(const Model* const model, Texture* const texture, unsigned int maxInstances, std::function<void(CrowdGraphicsObject*)> callback)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling GraphicsObjectManager::CreateCrowdGraphicsObject() before GraphicsObjectManager::Initialize()."), Logger::Category::Warning);
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->enqueueCrowdMutex);
+
+	const ModelHandle modelReference = ModelManager::AcquireModel(model);
+	const TextureHandle textureReference = TextureManager::AcquireTexture(texture);
+
+	std::function<void()> create = [model, texture, modelReference, textureReference, maxInstances, callback]()
+		{
+			CrowdGraphicsObject* newGraphicsObject = nullptr;
+
+			if (model != nullptr && texture != nullptr)
+			{
+				newGraphicsObject = new CrowdGraphicsObject(model, texture, maxInstances);
+				newGraphicsObject->Load();
+				instance->crowdGraphicsObjects.push_back(newGraphicsObject);
+				callback(newGraphicsObject);
+			}
+		};
+
+	instance->graphicsObjectCreateQueue.push_back(create);
+}
+
 void GraphicsObjectManager::WireFrame(GraphicsObject* obj, ObjectTypes::GraphicsObjectType type)
 {
 	std::function<void()> wireFrameCall = [obj, type]()
@@ -459,6 +792,9 @@ void GraphicsObjectManager::WireFrame(GraphicsObject* obj, ObjectTypes::Graphics
 		case ObjectTypes::GraphicsObjectType::ColoredAnimated:
 			moveToWireFrame(instance->coloredAnimatedGraphicsObjects, instance->coloredAnimatedGraphicsObjectsWireFrame, obj);
 			break;
+		case ObjectTypes::GraphicsObjectType::Crowd:
+			moveToWireFrame(instance->crowdGraphicsObjects, instance->crowdGraphicsObjectsWireFrame, obj);
+			break;
 		}
 	};
 
@@ -507,6 +843,9 @@ void GraphicsObjectManager::Solid(GraphicsObject* obj, ObjectTypes::GraphicsObje
 		case ObjectTypes::GraphicsObjectType::ColoredAnimated:
 			moveToSolid(instance->coloredAnimatedGraphicsObjects, instance->coloredAnimatedGraphicsObjectsWireFrame, obj);
 			break;
+		case ObjectTypes::GraphicsObjectType::Crowd:
+			moveToSolid(instance->crowdGraphicsObjects, instance->crowdGraphicsObjectsWireFrame, obj);
+			break;
 		}
 	};
 
@@ -657,6 +996,9 @@ void GraphicsObjectManager::ToggleGraphicsObjectDraw(GraphicsObject* const graph
 		case ObjectTypes::GraphicsObjectType::ColoredAnimated:
 			toggleGraphicsObject(instance->coloredAnimatedGraphicsObjects, instance->disabledColoredAnimatedGraphicsObjects, instance->coloredStaticGraphicsObjectsWireFrame, instance->disabledColoredAnimatedGraphicsObjectsWireFrame);
 			break;
+		case ObjectTypes::GraphicsObjectType::Crowd:
+			toggleGraphicsObject(instance->crowdGraphicsObjects, instance->disabledCrowdGraphicsObjects, instance->crowdGraphicsObjectsWireFrame, instance->disabledCrowdGraphicsObjectsWireFrame);
+			break;
 		default:
 			break;
 		}
@@ -711,6 +1053,10 @@ void GraphicsObjectManager::UpdateObjects()
 				});
 		};
 
+	// Animated objects share poses through the cache and count their levels of detail, both start over every frame.
+	PoseCache::BeginFrame();
+	AnimationLOD::BeginFrame();
+
 	updateObjects(instance->texturedStatic2DGraphicsObjects);
 	updateObjects(instance->animatedTexturedGraphicsObjects);
 	updateObjects(instance->texturedStaticGraphicsObjects);
@@ -718,6 +1064,7 @@ void GraphicsObjectManager::UpdateObjects()
 	updateObjects(instance->goochGraphicsObjects);
 	updateObjects(instance->coloredStaticGraphicsObjects);
 	updateObjects(instance->coloredAnimatedGraphicsObjects);
+	updateObjects(instance->crowdGraphicsObjects);
 
 	updateWireFrameObjects(instance->texturedStatic2DGraphicsObjectsWireFrame);
 	updateWireFrameObjects(instance->animatedTexturedGraphicsObjectsWireFrame);
@@ -726,6 +1073,7 @@ void GraphicsObjectManager::UpdateObjects()
 	updateWireFrameObjects(instance->litTexturedStaticGraphicsObjectsWireFrame);
 	updateWireFrameObjects(instance->coloredStaticGraphicsObjectsWireFrame);
 	updateWireFrameObjects(instance->coloredAnimatedGraphicsObjectsWireFrame);
+	updateWireFrameObjects(instance->crowdGraphicsObjectsWireFrame);
 }
 
 void GraphicsObjectManager::DrawObjects(VkCommandBuffer& buffer, unsigned int imageIndex)
@@ -735,6 +1083,10 @@ void GraphicsObjectManager::DrawObjects(VkCommandBuffer& buffer, unsigned int im
 
 	auto drawObjects = [&buffer](const std::string& pipelineName, std::vector<GraphicsObject*>& objects)
 	{
+		// Nothing to draw, or a pipeline whose shaders were not compiled into the shader directory.
+		if (objects.empty() || instance->graphicsPipelines.find(pipelineName) == instance->graphicsPipelines.end())
+			return;
+
 		VkDeviceSize offsets[] = { 0 };
 		vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, **instance->graphicsPipelines.find(pipelineName)->second.second);
 
@@ -746,13 +1098,16 @@ void GraphicsObjectManager::DrawObjects(VkCommandBuffer& buffer, unsigned int im
 				vkCmdBindDescriptorSets(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, **(instance->graphicsPipelines.find(pipelineName)->second.second->GetPipelineLayout()), 0, 1, &obj->GetDescriptorSet()(), 0, nullptr);
 				vkCmdBindVertexBuffers(buffer, 0, 1, &obj->GetVertexBuffer()(), offsets);
 				vkCmdBindIndexBuffer(buffer, obj->GetIndexBuffer()(), 0, VK_INDEX_TYPE_UINT32);
-				vkCmdDrawIndexed(buffer, static_cast<unsigned int>(obj->GetModel()->GetIndices().size()), 1, 0, 0, 0);
+				vkCmdDrawIndexed(buffer, obj->GetIndexCount(), obj->GetInstanceCount(), 0, 0, 0);
 			}
 		}
 	};
 
 	auto drawWireFrameObjects = [&buffer](const std::string& pipelineName, std::vector<std::pair<GraphicsObject*, unsigned int>>& objects)
 		{
+			if (objects.empty() || instance->graphicsPipelines.find(pipelineName) == instance->graphicsPipelines.end())
+				return;
+
 			VkDeviceSize offsets[] = { 0 };
 			vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, **instance->graphicsPipelines.find(pipelineName)->second.second);
 
@@ -764,18 +1119,19 @@ void GraphicsObjectManager::DrawObjects(VkCommandBuffer& buffer, unsigned int im
 					vkCmdBindDescriptorSets(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, **(instance->graphicsPipelines.find(pipelineName)->second.second->GetPipelineLayout()), 0, 1, &obj.first->GetDescriptorSet()(), 0, nullptr);
 					vkCmdBindVertexBuffers(buffer, 0, 1, &obj.first->GetVertexBuffer()(), offsets);
 					vkCmdBindIndexBuffer(buffer, obj.first->GetIndexBuffer()(), 0, VK_INDEX_TYPE_UINT32);
-					vkCmdDrawIndexed(buffer, static_cast<unsigned int>(obj.first->GetModel()->GetIndices().size()), 1, 0, 0, 0);
+					vkCmdDrawIndexed(buffer, obj.first->GetIndexCount(), obj.first->GetInstanceCount(), 0, 0, 0);
 				}
 			}
 		};
 	
 	drawObjects(std::string("TexturedAnimated"), instance->animatedTexturedGraphicsObjects);
 	drawObjects(std::string("TexturedStatic"), instance->texturedStaticGraphicsObjects);
-	drawObjects(std::string("TexturedStatic"), instance->texturedStatic2DGraphicsObjects);
+	drawObjects(std::string("Blended_TexturedStatic"), instance->texturedStatic2DGraphicsObjects);
 	drawObjects(std::string("Gooch"), instance->goochGraphicsObjects);
 	drawObjects(std::string("LitTexturedStatic"), instance->litTexturedStaticGraphicsObjects);
 	drawObjects(std::string("ColoredStatic"), instance->coloredStaticGraphicsObjects);
 	drawObjects(std::string("ColoredAnimated"), instance->coloredAnimatedGraphicsObjects);
+	drawObjects(std::string("Crowd"), instance->crowdGraphicsObjects);
 	
 	drawWireFrameObjects(std::string("WireFrame_TexturedAnimated"), instance->animatedTexturedGraphicsObjectsWireFrame);
 	drawWireFrameObjects(std::string("WireFrame_TexturedStatic"), instance->texturedStatic2DGraphicsObjectsWireFrame);
@@ -784,6 +1140,7 @@ void GraphicsObjectManager::DrawObjects(VkCommandBuffer& buffer, unsigned int im
 	drawWireFrameObjects(std::string("WireFrame_LitTexturedStatic"), instance->litTexturedStaticGraphicsObjectsWireFrame);
 	drawWireFrameObjects(std::string("WireFrame_ColoredStatic"), instance->coloredStaticGraphicsObjectsWireFrame);
 	drawWireFrameObjects(std::string("WireFrame_ColoredAnimated"), instance->coloredAnimatedGraphicsObjectsWireFrame);
+	drawWireFrameObjects(std::string("WireFrame_Crowd"), instance->crowdGraphicsObjectsWireFrame);
 }
 
 const ShaderPipelineStage* const GraphicsObjectManager::GetShaderPipelineStage(const std::string& shaderName)
@@ -864,6 +1221,8 @@ void GraphicsObjectManager::DeleteGraphicsObject(GraphicsObject* go)
 		deleteWireFrameObjectFromDrawVector(instance->enqueueColoredStaticMutex, instance->coloredStaticGraphicsObjectsWireFrame);
 		deleteObjectFromDrawVector(instance->enqueueColoredAnimatedMutex, instance->coloredAnimatedGraphicsObjects);
 		deleteWireFrameObjectFromDrawVector(instance->enqueueColoredAnimatedMutex, instance->coloredAnimatedGraphicsObjectsWireFrame);
+		deleteObjectFromDrawVector(instance->enqueueCrowdMutex, instance->crowdGraphicsObjects);
+		deleteWireFrameObjectFromDrawVector(instance->enqueueCrowdMutex, instance->crowdGraphicsObjectsWireFrame);
 	};
 
 	instance->graphicsObjectDeleteQueue.push_back(deleteFunc);
@@ -912,6 +1271,7 @@ GraphicsObjectManager::~GraphicsObjectManager()
 	deleteGraphicsObjectArray(texturedStatic2DGraphicsObjects);
 	deleteGraphicsObjectArray(coloredStaticGraphicsObjects);
 	deleteGraphicsObjectArray(coloredAnimatedGraphicsObjects);
+	deleteGraphicsObjectArray(crowdGraphicsObjects);
 
 	auto deleteGraphicsObjectWireFrameArray = [](std::vector<std::pair<GraphicsObject*, unsigned int>>& goArray)
 		{
@@ -932,6 +1292,7 @@ GraphicsObjectManager::~GraphicsObjectManager()
 	deleteGraphicsObjectWireFrameArray(texturedStatic2DGraphicsObjectsWireFrame);
 	deleteGraphicsObjectWireFrameArray(coloredStaticGraphicsObjectsWireFrame);
 	deleteGraphicsObjectWireFrameArray(coloredAnimatedGraphicsObjectsWireFrame);
+	deleteGraphicsObjectWireFrameArray(crowdGraphicsObjectsWireFrame);
 
 	auto deleteGraphicsObjectList = [](std::list<std::pair<GraphicsObject*, unsigned int>>& goList)
 	{
@@ -952,6 +1313,7 @@ GraphicsObjectManager::~GraphicsObjectManager()
 	deleteGraphicsObjectList(disabledTexturedStatic2DGraphicsObjects);
 	deleteGraphicsObjectList(disabledColoredStaticGraphicsObjects);
 	deleteGraphicsObjectList(disabledColoredAnimatedGraphicsObjects);
+	deleteGraphicsObjectList(disabledCrowdGraphicsObjects);
 	deleteGraphicsObjectList(disabledTexturedStaticGraphicsObjectsWireFrame);
 	deleteGraphicsObjectList(disabledAnimatedTexturedGraphicsObjectsWireFrame);
 	deleteGraphicsObjectList(disabledGoochGraphicsObjectsWireFrame);
@@ -959,6 +1321,7 @@ GraphicsObjectManager::~GraphicsObjectManager()
 	deleteGraphicsObjectList(disabledTexturedStatic2DGraphicsObjectsWireFrame);
 	deleteGraphicsObjectList(disabledColoredStaticGraphicsObjectsWireFrame);
 	deleteGraphicsObjectList(disabledColoredAnimatedGraphicsObjectsWireFrame);
+	deleteGraphicsObjectList(disabledCrowdGraphicsObjectsWireFrame);
 
 	for (auto& graphicsPipeline : graphicsPipelines)
 	{
@@ -6,10 +6,12 @@
 #include <vector>
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <vulkan/vulkan.h>
 #include <mutex>
 #include <functional>
+#include <memory>
 #include <glm/glm.hpp>
 
 class GraphicsObject;
@@ -19,7 +21,10 @@ class TexturedAnimatedGraphicsObject;
 class LitTexturedStaticGraphicsObject;
 class ColoredStaticGraphicsObject;
 class ColoredAnimatedGraphicsObject;
+class CrowdGraphicsObject;
 class GoochGraphicsObject;
+class TextGraphicsObject;
+class TextMesh;
 class Model;
 class DescriptorSetLayout;
 class GraphicsPipeline;
@@ -37,6 +42,8 @@ public:
 
 	static void Terminate();
 
+	// The Create functions queue the object for the next frame and hold a handle to its model and texture until then,
+	// so they cannot be evicted in between.
 	static void CreateTexturedStaticGraphicsObject(const Model* const model, Texture* const texture, std::function<void(TexturedStaticGraphicsObject*)> callback);
 
 	static void CreateTexturedAnimatedGraphicsObject(const Model* const model, Texture* const texture, std::function<void(TexturedAnimatedGraphicsObject*)> callback);
@@ -47,10 +54,16 @@ public:
 
 	static void CreateTexturedStatic2DGraphicsObject(const Model* const model, Texture* const texture, std::function<void(TexturedStatic2DGraphicsObject*)> callback);
 
+	// Drawn with the TexturedStatic2D objects, the glyph quads come from the mesh instead of a model.
+	static void CreateTextGraphicsObject(const std::shared_ptr<TextMesh>& mesh, Texture* const fontAtlas, std::function<void(TextGraphicsObject*)> callback);
+
 	static void CreateColoredStaticGraphicsObject(const Model* const model, const glm::vec4& color, std::function<void(ColoredStaticGraphicsObject*)> callback);
 
 	static void CreateColoredAnimatedGraphicsObject(const Model* const model, const glm::vec4& color, std::function<void(ColoredAnimatedGraphicsObject*)> callback);
 
+	// Up to maxInstances copies of an animated model in one draw, animated on the GPU from its baked clips.
+	static void CreateCrowdGraphicsObject(const Model* const model, Texture* const texture, unsigned int maxInstances, std::function<void(CrowdGraphicsObject*)> callback);
+
 	static void WireFrame(GraphicsObject* obj, ObjectTypes::GraphicsObjectType type);
 
 	static void Solid(GraphicsObject* obj, ObjectTypes::GraphicsObjectType type);
@@ -73,6 +86,19 @@ public:
 
 	static void DeleteGraphicsObject(GraphicsObject* go);
 
+	// Maps a compiled shader file extension such as ".vertspv" to its stage. Returns VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM for other files.
+	static VkShaderStageFlagBits ShaderStageFromExtension(const std::string& extension);
+
+	// Builds a new ShaderPipelineStage and its solid, wireframe and, where it has one, blended pipelines from the files for shaderName. Safe to call off the render thread.
+	// The returned function swaps them in and must run on the render thread between frames. It is empty if the build failed.
+	static std::function<void()> RebuildShaderPipeline(const std::string& shaderName);
+
+	// Rewrites the descriptor sets of objects drawing with texture after its image was replaced. Render thread only.
+	static void RefreshGraphicsObjectsUsingTexture(const Texture* const texture);
+
+	// Reuploads the buffers of objects drawing model after it was reloaded in place. Render thread only.
+	static void RefreshGraphicsObjectsUsingModel(const Model* const model);
+
 private:
 
 	GraphicsObjectManager() = delete;
@@ -105,10 +131,22 @@ private:
 
 	bool IsPipelineFromShader(const std::string& pipelineKey);
 
+	static bool IsBlendedPipeline(const std::string& pipelineKey);
+
+	// Whether shaderName also gets an alpha blended pipeline, for objects drawn over the scene.
+	static bool HasBlendedPipeline(const std::string& shaderName);
+
+	void SwapShaderPipeline(const std::string& shaderName, ShaderPipelineStage* stage, GraphicsPipeline* solidPipeline, GraphicsPipeline* wireFramePipeline, GraphicsPipeline* blendedPipeline, const std::vector<Shader*>& stageShaders);
+
+	void ForEachGraphicsObject(const std::function<void(GraphicsObject*)>& function);
+
 	static GraphicsObjectManager* instance;
 
 	static bool shouldUpdate;
 
+	// Pipeline keys drawn alpha blended over the scene, each built from the shader named after its "Blended_" prefix.
+	static const std::unordered_set<std::string> blendedPipelineKeys;
+
 	std::mutex enqueueStaticMutex;
 
 	std::mutex enqueueStatic2DMutex;
@@ -123,6 +161,8 @@ private:
 
 	std::mutex enqueueColoredAnimatedMutex;
 
+	std::mutex enqueueCrowdMutex;
+
 	std::mutex updateMutex;
 
 	std::vector<GraphicsObject*> texturedStaticGraphicsObjects;
@@ -181,6 +221,14 @@ private:
 
 	std::list<std::pair<GraphicsObject*, unsigned int>> disabledColoredAnimatedGraphicsObjectsWireFrame;
 
+	std::vector<GraphicsObject*> crowdGraphicsObjects;
+
+	std::list<std::pair<GraphicsObject*, unsigned int>> disabledCrowdGraphicsObjects;
+
+	std::vector<std::pair<GraphicsObject*, unsigned int>> crowdGraphicsObjectsWireFrame;
+
+	std::list<std::pair<GraphicsObject*, unsigned int>> disabledCrowdGraphicsObjectsWireFrame;
+
 	const Window& window;
 
 	std::unordered_map<std::string, std::pair<ShaderPipelineStage*, GraphicsPipeline*>> graphicsPipelines;
@@ -11,7 +11,8 @@ namespace ObjectTypes
 		Gooch,
 		AnimatedTextured,
 		ColoredStatic,
-		ColoredAnimated
+		ColoredAnimated,
+		Crowd
 	};
 };
 
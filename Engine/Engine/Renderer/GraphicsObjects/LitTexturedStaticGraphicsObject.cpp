@@ -24,7 +24,7 @@ LitTexturedStaticGraphicsObject::~LitTexturedStaticGraphicsObject()
 
 void LitTexturedStaticGraphicsObject::CreateTextures()
 {
-	textures.push_back(texture);
+	AddTexture(texture);
 	texture->SetBinding(1U);
 }
 
@@ -0,0 +1,85 @@
+#include "TextGraphicsObject.h"
+
+#include "../../UI/TextMesh.h"
+#include "../Model/ModelManager.h"
+#include "../Memory/VertexBuffer.h"
+#include "../Memory/IndexBuffer.h"
+
+#include <vector>
+
+TextGraphicsObject::TextGraphicsObject(const std::shared_ptr<TextMesh>& m, Texture* const fontAtlas) :
+	TexturedStatic2DGraphicsObject(ModelManager::GetModel("DefaultRectangle"), fontAtlas),
+	mesh(m),
+	quadCapacity(0U),
+	drawnQuadCount(0U)
+{
+	// Start with room for a short label, the buffers double when the text outgrows them.
+	Reserve(32U);
+}
+
+TextGraphicsObject::~TextGraphicsObject()
+{
+}
+
+void TextGraphicsObject::Update()
+{
+	drawnQuadCount = mesh->Flush(
+		[this](unsigned int quadCount)
+		{
+			return Reserve(quadCount);
+		},
+		[this](const Vertex* const vertices, unsigned int firstQuad, unsigned int quadCount)
+		{
+			const unsigned int quadSize = static_cast<unsigned int>(sizeof(Vertex)) * TextMesh::verticesPerQuad;
+			modelVertexBuffer->SetData(vertices, firstQuad * quadSize, quadCount * quadSize);
+		});
+
+	TexturedStatic2DGraphicsObject::Update();
+}
+
+unsigned int TextGraphicsObject::GetIndexCount() const
+{
+	return drawnQuadCount * TextMesh::indicesPerQuad;
+}
+
+void TextGraphicsObject::OnModelReloaded()
+{
+	// The rebuild replaced the glyph buffers with the placeholder model's, the next Update reallocates and rewrites them.
+	quadCapacity = 0U;
+	drawnQuadCount = 0U;
+}
+
+bool TextGraphicsObject::Reserve(unsigned int quadCount)
+{
+	if (quadCount <= quadCapacity)
+	{
+		return false;
+	}
+
+	unsigned int newCapacity = quadCapacity > 0U ? quadCapacity : 1U;
+	while (newCapacity < quadCount)
+	{
+		newCapacity *= 2U;
+	}
+
+	// Runs on the render thread after the previous frame finished, nothing in flight uses the old buffers.
+	delete modelVertexBuffer;
+	delete modelIndexBuffer;
+
+	modelVertexBuffer = new VertexBuffer(static_cast<unsigned int>(sizeof(Vertex)) * TextMesh::verticesPerQuad * newCapacity, true);
+	modelIndexBuffer = new IndexBuffer(static_cast<unsigned int>(sizeof(unsigned int)) * TextMesh::indicesPerQuad * newCapacity, true);
+
+	// The index pattern only depends on the capacity, so it is written once here.
+	std::vector<unsigned int> indices(static_cast<size_t>(TextMesh::indicesPerQuad) * newCapacity);
+	for (unsigned int quad = 0; quad < newCapacity; quad++)
+	{
+		const unsigned int first = quad * TextMesh::verticesPerQuad;
+		const unsigned int quadIndices[] = { first, first + 1, first + 2, first + 2, first + 3, first };
+		std::copy(std::begin(quadIndices), std::end(quadIndices), indices.begin() + static_cast<size_t>(quad) * TextMesh::indicesPerQuad);
+	}
+
+	modelIndexBuffer->SetData(indices.data(), 0U, static_cast<unsigned int>(indices.size() * sizeof(unsigned int)));
+
+	quadCapacity = newCapacity;
+	return true;
+}
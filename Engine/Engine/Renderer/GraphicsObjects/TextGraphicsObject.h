@@ -0,0 +1,47 @@
+#ifndef TEXTGRAPHICSOBJECT_H
+#define TEXTGRAPHICSOBJECT_H
+
+#include "TexturedStatic2DGraphicsObject.h"
+
+#include <memory>
+
+class TextMesh;
+
+// Draws every glyph of a Text block with one call from a host visible vertex buffer that is rewritten only where the TextMesh changed.
+class TextGraphicsObject : public TexturedStatic2DGraphicsObject
+{
+public:
+
+	TextGraphicsObject() = delete;
+
+	TextGraphicsObject(const std::shared_ptr<TextMesh>& mesh, Texture* const fontAtlas);
+
+	~TextGraphicsObject();
+
+	TextGraphicsObject(const TextGraphicsObject&) = delete;
+
+	TextGraphicsObject& operator=(const TextGraphicsObject&) = delete;
+
+	TextGraphicsObject(TextGraphicsObject&&) = delete;
+
+	TextGraphicsObject& operator=(TextGraphicsObject&&) = delete;
+
+	void Update() override;
+
+	unsigned int GetIndexCount() const override;
+
+private:
+
+	void OnModelReloaded() override;
+
+	// Reallocates the buffers when they cannot hold quadCount quads. Returns true if they were reallocated.
+	bool Reserve(unsigned int quadCount);
+
+	std::shared_ptr<TextMesh> mesh;
+
+	unsigned int quadCapacity;
+
+	unsigned int drawnQuadCount;
+};
+
+#endif // TEXTGRAPHICSOBJECT_H
@@ -42,7 +42,7 @@ TexturedAnimatedGraphicsObject::~TexturedAnimatedGraphicsObject()
 
 void TexturedAnimatedGraphicsObject::CreateTextures()
 {
-	textures.push_back(texture);
+	AddTexture(texture);
 	texture->SetBinding(1U);
 }
 
@@ -73,14 +73,21 @@ void TexturedAnimatedGraphicsObject::Update()
 	mvp.projection = cam->GetProjection();
 	mvp.projection[1][1] *= -1;
 
-	animation->Update(anim.pose);
+	bool leafJointsAtRest = false;
+	const AnimationLOD::Level lod = AnimationLOD::Select(*cam, *model, mvp.model, leafJointsAtRest);
+	animation->Update(anim.pose, lod, leafJointsAtRest);
 
 	light.color = glm::vec4(dirLight->GetColor(), 1.0f);
 	light.direction = glm::vec4(dirLight->GetDirection(), 0.0f);
 	light.ambient = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
 
 	uniformBuffers[0]->SetData(&mvp);
-	uniformBuffers[1]->SetData(&anim);
+
+	if (lod != AnimationLOD::Level::Frozen)
+	{
+		uniformBuffers[1]->SetData(&anim);
+	}
+
 	uniformBuffers[2]->SetData(&light);
 }
 
@@ -99,9 +106,31 @@ void TexturedAnimatedGraphicsObject::SetClip(unsigned int clipIndex)
 	clip = clipIndex;
 	Animation* oldAnimation = animation;
 	animation = new Animation(model->GetBakedAnimation(clipIndex));
+	animation->SetSpeed(oldAnimation->GetSpeed());
 	delete oldAnimation;
 }
 
+void TexturedAnimatedGraphicsObject::CrossFadeToClip(unsigned int clipIndex, float fadeDuration)
+{
+	clip = clipIndex;
+	animation->CrossFade(model->GetBakedAnimation(clipIndex), fadeDuration);
+}
+
+Animation& TexturedAnimatedGraphicsObject::GetAnimation()
+{
+	return *animation;
+}
+
+void TexturedAnimatedGraphicsObject::OnModelReloaded()
+{
+	for (unsigned int i = 0; i < model->GetArmature()->GetInvBindPose().size(); i++)
+	{
+		anim.invBindPose[i] = model->GetArmature()->GetInvBindPose()[i];
+	}
+
+	SetClip(clip);
+}
+
 unsigned int TexturedAnimatedGraphicsObject::GetClip() const
 {
 	return clip;
@@ -37,6 +37,12 @@ public:
 
 	void SetClip(unsigned int clipIndex);
 
+	// Fades from the playing clip to clipIndex over fadeDuration seconds.
+	void CrossFadeToClip(unsigned int clipIndex, float fadeDuration);
+
+	// For layers and blend spaces beyond playing a single clip.
+	Animation& GetAnimation();
+
 	unsigned int GetClip() const;
 
 	float GetAnimationSpeed() const;
@@ -73,6 +79,8 @@ protected:
 
 	virtual void Update() override;
 
+	virtual void OnModelReloaded() override;
+
 	MVPUniformBuffer mvp;
 
 	AnimUniformBuffer anim;
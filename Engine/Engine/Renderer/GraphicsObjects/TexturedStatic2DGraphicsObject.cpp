@@ -49,7 +49,7 @@ void TexturedStatic2DGraphicsObject::Update()
 
 void TexturedStatic2DGraphicsObject::CreateTextures()
 {
-	textures.push_back(texture);
+	AddTexture(texture);
 	texture->SetBinding(1U);
 }
 
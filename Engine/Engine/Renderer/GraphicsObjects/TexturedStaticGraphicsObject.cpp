@@ -19,7 +19,7 @@ void TexturedStaticGraphicsObject::Update()
 
 void TexturedStaticGraphicsObject::CreateTextures()
 {
-	textures.push_back(texture);
+	AddTexture(texture);
 	texture->SetBinding(1U);
 }
 
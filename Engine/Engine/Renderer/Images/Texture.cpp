@@ -3,20 +3,27 @@
 #include "../../Utils/Logger.h"
 #include "../Memory/StagingBuffer.h"
 #include "../Memory/Image.h"
+#include "../Renderer.h"
+#include "../Vulkan/VulkanPhysicalDevice.h"
+#include "TextureCooker.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image/stb-master/stb_image.h>
 
 Texture::Texture() :
 	path("../Engine/Engine/Renderer/Images/Woman.png"),
-	binding(1)
+	image(nullptr),
+	binding(1),
+	compress(true)
 {
 	LoadTexture();
 }
 
-Texture::Texture(const std::string& p, unsigned int imageBinding) :
+Texture::Texture(const std::string& p, unsigned int imageBinding, bool c) :
 	path(p),
-	binding(imageBinding)
+	image(nullptr),
+	binding(imageBinding),
+	compress(c)
 {
 	LoadTexture();
 }
@@ -51,20 +58,50 @@ int Texture::GetHeight() const
 	return height;
 }
 
+size_t Texture::GetSizeInBytes() const
+{
+	return image != nullptr ? image->GetSizeInBytes() : 0;
+}
+
+const std::string& Texture::GetPath() const
+{
+	return path;
+}
+
+bool Texture::IsCompressible() const
+{
+	return compress;
+}
+
+void Texture::Reload(const CookedTexture& cookedTexture)
+{
+	width = static_cast<int>(cookedTexture.width);
+	height = static_cast<int>(cookedTexture.height);
+
+	StagingBuffer stagingBuffer(static_cast<unsigned int>(cookedTexture.data.size()));
+	stagingBuffer.Map(cookedTexture.data.data(), stagingBuffer.Size());
+
+	Image* oldImage = image;
+	image = new Image(cookedTexture, stagingBuffer, oldImage != nullptr ? oldImage->Binding() : binding);
+	delete oldImage;
+}
+
 void Texture::LoadTexture()
 {
-	stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+	const bool compressionSupported = Renderer::GetVulkanPhysicalDevice()->GetFeatures().textureCompressionBC == VK_TRUE;
 
-	if (!pixels)
+	CookedTexture cookedTexture;
+	if (!TextureCooker::LoadOrCook(path, cookedTexture, compress && compressionSupported))
 	{
-		Logger::Log(std::string("Failed to load image ") + path, Logger::Category::Error);
 		return;
 	}
 
-	StagingBuffer stagingBuffer(width * height * 4);
-	stagingBuffer.Map(pixels, stagingBuffer.Size());
+	width = static_cast<int>(cookedTexture.width);
+	height = static_cast<int>(cookedTexture.height);
+	channels = 4;
 
-	free(pixels);
+	StagingBuffer stagingBuffer(static_cast<unsigned int>(cookedTexture.data.size()));
+	stagingBuffer.Map(cookedTexture.data.data(), stagingBuffer.Size());
 
-	image = new Image(width, height, stagingBuffer, binding);
+	image = new Image(cookedTexture, stagingBuffer, binding);
 }
@@ -4,6 +4,7 @@
 #include <string>
 
 class Image;
+struct CookedTexture;
 
 class Texture
 {
@@ -12,7 +13,8 @@ public:
 
 	Texture();
 
-	Texture(const std::string& path, unsigned int imageBinding);
+	// Without compress the image stays uncompressed even where the device supports block compression.
+	Texture(const std::string& path, unsigned int imageBinding, bool compress = true);
 
 	~Texture();
 
@@ -34,6 +36,15 @@ public:
 
 	int GetHeight() const;
 
+	size_t GetSizeInBytes() const;
+
+	const std::string& GetPath() const;
+
+	bool IsCompressible() const;
+
+	// Replace the image with a freshly cooked one, keeping the binding. Must run on the render thread while no frame is in flight.
+	void Reload(const CookedTexture& cookedTexture);
+
 private:
 
 	void LoadTexture();
@@ -49,6 +60,8 @@ private:
 	Image* image;
 
 	unsigned int binding;
+
+	bool compress;
 };
 
 
@@ -0,0 +1,413 @@
+#include "TextureCooker.h"
+
+#include "../../Utils/Logger.h"
+
+#include <filesystem>
+#include <fstream>
+#include <execution>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cstring>
+#include <bit>
+
+#include <stb_image/stb-master/stb_image.h>
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb_image/stb-master/stb_dxt.h>
+
+const uint32_t TextureCooker::cacheMagic = 0x58455443; // "CTEX"
+
+const uint32_t TextureCooker::cacheVersion = 1;
+
+namespace
+{
+	// Mips are averaged in linear space so the chain matches what a blit on an sRGB image would produce.
+	struct SRGBTables
+	{
+		SRGBTables()
+		{
+			for (unsigned int i = 0; i < 256; i++)
+			{
+				float c = i / 255.0f;
+				toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+
+			for (unsigned int i = 0; i < 4096; i++)
+			{
+				float l = i / 4095.0f;
+				float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+				toSRGB[i] = static_cast<unsigned char>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+			}
+		}
+
+		float toLinear[256];
+
+		unsigned char toSRGB[4096];
+	};
+
+	const SRGBTables& GetSRGBTables()
+	{
+		static const SRGBTables tables;
+		return tables;
+	}
+
+	std::vector<uint32_t> MakeIndexRange(uint32_t count)
+	{
+		std::vector<uint32_t> indices(count);
+		std::iota(indices.begin(), indices.end(), 0U);
+		return indices;
+	}
+
+	uint64_t BlockSize(CookedTexture::Format format)
+	{
+		switch (format)
+		{
+		case CookedTexture::Format::BC1:
+			return 8;
+		case CookedTexture::Format::BC3:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	uint64_t LevelSize(CookedTexture::Format format, uint32_t width, uint32_t height)
+	{
+		if (format == CookedTexture::Format::RGBA8)
+		{
+			return static_cast<uint64_t>(width) * height * 4;
+		}
+
+		return static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4) * BlockSize(format);
+	}
+
+	template<typename T>
+	void WriteValue(std::ofstream& file, const T& value)
+	{
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	bool ReadValue(std::ifstream& file, T& value)
+	{
+		file.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return static_cast<bool>(file);
+	}
+}
+
+VkFormat CookedTexture::GetVulkanFormat() const
+{
+	switch (format)
+	{
+	case Format::BC1:
+		return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+	case Format::BC3:
+		return VK_FORMAT_BC3_SRGB_BLOCK;
+	default:
+		return VK_FORMAT_R8G8B8A8_SRGB;
+	}
+}
+
+bool TextureCooker::LoadOrCook(const std::string& sourcePath, CookedTexture& outTexture, bool allowCompression)
+{
+	const std::string cachePath = GetCachePath(sourcePath);
+
+	std::error_code error;
+	bool cacheIsCurrent = std::filesystem::exists(cachePath, error) && std::filesystem::exists(sourcePath, error) &&
+		std::filesystem::last_write_time(cachePath, error) >= std::filesystem::last_write_time(sourcePath, error);
+
+	// A cache without a source is still usable, it lets shipped builds drop the original images.
+	if (!cacheIsCurrent && !std::filesystem::exists(sourcePath, error) && std::filesystem::exists(cachePath, error))
+	{
+		cacheIsCurrent = true;
+	}
+
+	if (cacheIsCurrent && ReadCache(cachePath, outTexture))
+	{
+		if (allowCompression || outTexture.format == CookedTexture::Format::RGBA8)
+		{
+			return true;
+		}
+	}
+
+	if (!Cook(sourcePath, outTexture, allowCompression))
+	{
+		return false;
+	}
+
+	// Only compressed results are worth caching, an uncompressed fallback is rebuilt for the device that needs it.
+	if (outTexture.format != CookedTexture::Format::RGBA8)
+	{
+		WriteCache(cachePath, outTexture);
+	}
+
+	return true;
+}
+
+bool TextureCooker::Cook(const std::string& sourcePath, CookedTexture& outTexture, bool allowCompression)
+{
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+
+	stbi_uc* pixels = stbi_load(sourcePath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+
+	if (!pixels)
+	{
+		Logger::Log(std::string("Failed to load image ") + sourcePath, Logger::Category::Error);
+		return false;
+	}
+
+	std::vector<std::vector<unsigned char>> levels;
+	levels.emplace_back(pixels, pixels + static_cast<size_t>(width) * height * 4);
+	stbi_image_free(pixels);
+
+	std::vector<CookedTexture::MipLevel> levelSizes;
+	levelSizes.push_back({ static_cast<uint32_t>(width), static_cast<uint32_t>(height), 0, 0 });
+
+	BuildMipChain(levels, levelSizes);
+
+	CookedTexture::Format format = CookedTexture::Format::RGBA8;
+	if (allowCompression)
+	{
+		const std::vector<unsigned char>& base = levels[0];
+
+		bool opaque = true;
+		for (size_t i = 3; i < base.size(); i += 4)
+		{
+			if (base[i] != 255)
+			{
+				opaque = false;
+				break;
+			}
+		}
+
+		format = opaque ? CookedTexture::Format::BC1 : CookedTexture::Format::BC3;
+	}
+
+	uint64_t totalSize = 0;
+	for (CookedTexture::MipLevel& level : levelSizes)
+	{
+		level.offset = totalSize;
+		level.size = LevelSize(format, level.width, level.height);
+		totalSize += level.size;
+	}
+
+	outTexture.format = format;
+	outTexture.width = static_cast<uint32_t>(width);
+	outTexture.height = static_cast<uint32_t>(height);
+	outTexture.mipLevels = levelSizes;
+	outTexture.data.resize(static_cast<size_t>(totalSize));
+
+	std::vector<uint32_t> levelIndices = MakeIndexRange(static_cast<uint32_t>(levels.size()));
+	std::for_each(std::execution::par, levelIndices.begin(), levelIndices.end(),
+		[&](uint32_t i)
+		{
+			const CookedTexture::MipLevel& level = outTexture.mipLevels[i];
+			CompressLevel(levels[i], level.width, level.height, format, outTexture.data.data() + level.offset);
+		});
+
+	return true;
+}
+
+bool TextureCooker::WriteCache(const std::string& cachePath, const CookedTexture& texture)
+{
+	std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		Logger::Log(std::string("Failed to open texture cache for writing ") + cachePath, Logger::Category::Warning);
+		return false;
+	}
+
+	WriteValue(file, cacheMagic);
+	WriteValue(file, cacheVersion);
+	WriteValue(file, static_cast<uint32_t>(texture.format));
+	WriteValue(file, texture.width);
+	WriteValue(file, texture.height);
+	WriteValue(file, static_cast<uint32_t>(texture.mipLevels.size()));
+
+	for (const CookedTexture::MipLevel& level : texture.mipLevels)
+	{
+		WriteValue(file, level);
+	}
+
+	WriteValue(file, static_cast<uint64_t>(texture.data.size()));
+	file.write(reinterpret_cast<const char*>(texture.data.data()), static_cast<std::streamsize>(texture.data.size()));
+
+	return static_cast<bool>(file);
+}
+
+bool TextureCooker::ReadCache(const std::string& cachePath, CookedTexture& outTexture)
+{
+	std::ifstream file(cachePath, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t format = 0;
+	uint32_t levelCount = 0;
+	uint64_t dataSize = 0;
+
+	if (!ReadValue(file, magic) || magic != cacheMagic || !ReadValue(file, version) || version != cacheVersion)
+	{
+		Logger::Log(std::string("Ignoring stale or invalid texture cache ") + cachePath, Logger::Category::Warning);
+		return false;
+	}
+
+	if (!ReadValue(file, format) || format > static_cast<uint32_t>(CookedTexture::Format::BC3) ||
+		!ReadValue(file, outTexture.width) || !ReadValue(file, outTexture.height) || !ReadValue(file, levelCount))
+	{
+		return false;
+	}
+
+	// A full chain halves down to 1x1, a cache claiming more levels than that is corrupt.
+	const uint32_t maxLevelCount = static_cast<uint32_t>(std::bit_width(std::max(outTexture.width, outTexture.height)));
+
+	if (outTexture.width == 0 || outTexture.height == 0 || levelCount == 0 || levelCount > maxLevelCount)
+	{
+		Logger::Log(std::string("Ignoring stale or invalid texture cache ") + cachePath, Logger::Category::Warning);
+		return false;
+	}
+
+	outTexture.format = static_cast<CookedTexture::Format>(format);
+	outTexture.mipLevels.resize(levelCount);
+
+	for (CookedTexture::MipLevel& level : outTexture.mipLevels)
+	{
+		if (!ReadValue(file, level))
+		{
+			return false;
+		}
+	}
+
+	std::error_code error;
+	const uint64_t fileSize = static_cast<uint64_t>(std::filesystem::file_size(cachePath, error));
+
+	if (!ReadValue(file, dataSize) || error || dataSize > fileSize - static_cast<uint64_t>(file.tellg()))
+	{
+		Logger::Log(std::string("Ignoring stale or invalid texture cache ") + cachePath, Logger::Category::Warning);
+		return false;
+	}
+
+	// Every level has to be the size its format and extent need and lie inside the data, the upload copies them as they are.
+	uint32_t expectedWidth = outTexture.width;
+	uint32_t expectedHeight = outTexture.height;
+
+	for (const CookedTexture::MipLevel& level : outTexture.mipLevels)
+	{
+		if (level.width != expectedWidth || level.height != expectedHeight || level.size != LevelSize(outTexture.format, level.width, level.height) ||
+			level.offset > dataSize || level.size > dataSize - level.offset)
+		{
+			Logger::Log(std::string("Ignoring stale or invalid texture cache ") + cachePath, Logger::Category::Warning);
+			return false;
+		}
+
+		expectedWidth = expectedWidth > 1 ? expectedWidth / 2 : 1;
+		expectedHeight = expectedHeight > 1 ? expectedHeight / 2 : 1;
+	}
+
+	outTexture.data.resize(static_cast<size_t>(dataSize));
+	file.read(reinterpret_cast<char*>(outTexture.data.data()), static_cast<std::streamsize>(dataSize));
+
+	return static_cast<bool>(file);
+}
+
+std::string TextureCooker::GetCachePath(const std::string& sourcePath)
+{
+	return sourcePath + ".ctex";
+}
+
+void TextureCooker::BuildMipChain(std::vector<std::vector<unsigned char>>& levels, std::vector<CookedTexture::MipLevel>& levelSizes)
+{
+	const SRGBTables& tables = GetSRGBTables();
+
+	while (levelSizes.back().width > 1 || levelSizes.back().height > 1)
+	{
+		const uint32_t srcWidth = levelSizes.back().width;
+		const uint32_t srcHeight = levelSizes.back().height;
+		const uint32_t dstWidth = srcWidth > 1 ? srcWidth / 2 : 1;
+		const uint32_t dstHeight = srcHeight > 1 ? srcHeight / 2 : 1;
+
+		const std::vector<unsigned char>& src = levels.back();
+		std::vector<unsigned char> dst(static_cast<size_t>(dstWidth) * dstHeight * 4);
+
+		// Each level depends on the previous one, rows within a level are independent.
+		std::vector<uint32_t> rows = MakeIndexRange(dstHeight);
+		std::for_each(std::execution::par, rows.begin(), rows.end(),
+			[&](uint32_t y)
+			{
+				const uint32_t y0 = std::min(y * 2, srcHeight - 1);
+				const uint32_t y1 = std::min(y * 2 + 1, srcHeight - 1);
+
+				for (uint32_t x = 0; x < dstWidth; x++)
+				{
+					const uint32_t x0 = std::min(x * 2, srcWidth - 1);
+					const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+
+					const unsigned char* texels[4] =
+					{
+						&src[(static_cast<size_t>(y0) * srcWidth + x0) * 4],
+						&src[(static_cast<size_t>(y0) * srcWidth + x1) * 4],
+						&src[(static_cast<size_t>(y1) * srcWidth + x0) * 4],
+						&src[(static_cast<size_t>(y1) * srcWidth + x1) * 4]
+					};
+
+					unsigned char* out = &dst[(static_cast<size_t>(y) * dstWidth + x) * 4];
+
+					for (unsigned int c = 0; c < 3; c++)
+					{
+						float sum = tables.toLinear[texels[0][c]] + tables.toLinear[texels[1][c]] + tables.toLinear[texels[2][c]] + tables.toLinear[texels[3][c]];
+						out[c] = tables.toSRGB[static_cast<unsigned int>(sum * 0.25f * 4095.0f + 0.5f)];
+					}
+
+					out[3] = static_cast<unsigned char>((texels[0][3] + texels[1][3] + texels[2][3] + texels[3][3] + 2) / 4);
+				}
+			});
+
+		levels.push_back(std::move(dst));
+		levelSizes.push_back({ dstWidth, dstHeight, 0, 0 });
+	}
+}
+
+void TextureCooker::CompressLevel(const std::vector<unsigned char>& rgba, uint32_t width, uint32_t height, CookedTexture::Format format, unsigned char* out)
+{
+	if (format == CookedTexture::Format::RGBA8)
+	{
+		memcpy(out, rgba.data(), rgba.size());
+		return;
+	}
+
+	const uint32_t blocksWide = (width + 3) / 4;
+	const uint32_t blocksHigh = (height + 3) / 4;
+	const uint64_t blockSize = BlockSize(format);
+	const int alpha = format == CookedTexture::Format::BC3 ? 1 : 0;
+
+	std::vector<uint32_t> blockRows = MakeIndexRange(blocksHigh);
+	std::for_each(std::execution::par, blockRows.begin(), blockRows.end(),
+		[&](uint32_t by)
+		{
+			unsigned char block[16 * 4];
+
+			for (uint32_t bx = 0; bx < blocksWide; bx++)
+			{
+				// Edge blocks of small or odd sized levels repeat the last texel.
+				for (uint32_t y = 0; y < 4; y++)
+				{
+					const uint32_t sy = std::min(by * 4 + y, height - 1);
+					for (uint32_t x = 0; x < 4; x++)
+					{
+						const uint32_t sx = std::min(bx * 4 + x, width - 1);
+						memcpy(&block[(y * 4 + x) * 4], &rgba[(static_cast<size_t>(sy) * width + sx) * 4], 4);
+					}
+				}
+
+				stb_compress_dxt_block(out + (static_cast<uint64_t>(by) * blocksWide + bx) * blockSize, block, alpha, STB_DXT_HIGHQUAL);
+			}
+		});
+}
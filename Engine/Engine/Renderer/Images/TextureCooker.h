@@ -0,0 +1,87 @@
+#ifndef TEXTURECOOKER_H
+#define TEXTURECOOKER_H
+
+#include <vulkan/vulkan.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+struct CookedTexture
+{
+	enum class Format : uint32_t
+	{
+		// Uncompressed, used when the device has no BC support.
+		RGBA8,
+		// 4bpp, opaque images.
+		BC1,
+		// 8bpp, images with alpha.
+		BC3
+	};
+
+	struct MipLevel
+	{
+		uint32_t width;
+
+		uint32_t height;
+
+		uint64_t offset;
+
+		uint64_t size;
+	};
+
+	VkFormat GetVulkanFormat() const;
+
+	Format format = Format::RGBA8;
+
+	uint32_t width = 0;
+
+	uint32_t height = 0;
+
+	std::vector<MipLevel> mipLevels;
+
+	std::vector<unsigned char> data;
+};
+
+class TextureCooker
+{
+
+public:
+
+	// Load the cooked cache for sourcePath if it is up to date, otherwise cook the source and write the cache.
+	static bool LoadOrCook(const std::string& sourcePath, CookedTexture& outTexture, bool allowCompression = true);
+
+	// Build the full mip chain on the CPU and compress it.
+	static bool Cook(const std::string& sourcePath, CookedTexture& outTexture, bool allowCompression = true);
+
+	static bool WriteCache(const std::string& cachePath, const CookedTexture& texture);
+
+	static bool ReadCache(const std::string& cachePath, CookedTexture& outTexture);
+
+	static std::string GetCachePath(const std::string& sourcePath);
+
+private:
+
+	TextureCooker() = delete;
+
+	~TextureCooker() = delete;
+
+	TextureCooker(const TextureCooker&) = delete;
+
+	TextureCooker& operator=(const TextureCooker&) = delete;
+
+	TextureCooker(TextureCooker&&) = delete;
+
+	TextureCooker& operator=(TextureCooker&&) = delete;
+
+	static void BuildMipChain(std::vector<std::vector<unsigned char>>& levels, std::vector<CookedTexture::MipLevel>& levelSizes);
+
+	static void CompressLevel(const std::vector<unsigned char>& rgba, uint32_t width, uint32_t height, CookedTexture::Format format, unsigned char* out);
+
+	static const uint32_t cacheMagic;
+
+	static const uint32_t cacheVersion;
+
+};
+
+#endif // TEXTURECOOKER_H
@@ -2,6 +2,13 @@
 
 #include "../../Utils/Logger.h"
 #include "Texture.h"
+#include "TextureCooker.h"
+#include "../Renderer.h"
+#include "../Vulkan/VulkanPhysicalDevice.h"
+#include "../GraphicsObjects/GraphicsObjectManager.h"
+
+#include <filesystem>
+#include <memory>
 
 TextureManager* TextureManager::instance = nullptr;
 
@@ -32,15 +39,15 @@ void TextureManager::Terminate()
 	}
 }
 
-Texture* const TextureManager::LoadTexture(const std::string& filePath, const std::string& name)
+Texture* const TextureManager::LoadTexture(const std::string& filePath, const std::string& name, bool compress)
 {
 	Texture* ret = nullptr;
 	if (instance != nullptr)
 	{
-		if (instance->textures.find(name) == instance->textures.end())
+		if (!instance->textures.Contains(name))
 		{
-			ret = new Texture(filePath, 1);
-			instance->textures.insert(std::make_pair(name, ret));
+			ret = new Texture(filePath, 1, compress);
+			instance->textures.Insert(name, ret, instance->loadingDefaults);
 			Logger::Log(std::string("Loaded Texture ") + filePath, Logger::Category::Success);
 		}
 		else
@@ -61,11 +68,7 @@ Texture* const TextureManager::GetTexture(const std::string& name)
 	Texture* ret = nullptr;
 	if (instance != nullptr)
 	{
-		if (instance->textures.find(name) != instance->textures.end())
-		{
-			ret = instance->textures.find(name)->second;
-		}
-		else
+		if ((ret = instance->textures.Find(name, true)) == nullptr)
 		{
 			Logger::Log(std::string("A texture with the name ") + name + " deos not exists. TextureManager::GetTexture.", Logger::Category::Warning);
 		}
@@ -78,14 +81,42 @@ Texture* const TextureManager::GetTexture(const std::string& name)
 	return ret;
 }
 
+TextureHandle TextureManager::AcquireTexture(const std::string& name)
+{
+	TextureHandle ret;
+	if (instance != nullptr)
+	{
+		if (!(ret = instance->textures.Acquire(name)))
+		{
+			Logger::Log(std::string("A texture with the name ") + name + " deos not exists. TextureManager::AcquireTexture.", Logger::Category::Warning);
+		}
+	}
+	else
+	{
+		Logger::Log(std::string("Calling TextureManager::AcquireTexture() before TextureManager::Initialize()."), Logger::Category::Warning);
+	}
+
+	return ret;
+}
+
+TextureHandle TextureManager::AcquireTexture(const Texture* const texture)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling TextureManager::AcquireTexture() before TextureManager::Initialize()."), Logger::Category::Warning);
+		return TextureHandle();
+	}
+
+	return instance->textures.Acquire(texture);
+}
+
 void TextureManager::UnloadTexture(const std::string& name)
 {
 	if (instance != nullptr)
 	{
-		if (instance->textures.find(name) != instance->textures.end())
+		if (instance->textures.Contains(name))
 		{
-			delete instance->textures.find(name)->second;
-			instance->textures.erase(instance->textures.find(name));
+			instance->textures.Remove(name);
 		}
 		else
 		{
@@ -98,25 +129,119 @@ void TextureManager::UnloadTexture(const std::string& name)
 	}
 }
 
-TextureManager::TextureManager() :
-	textures(std::unordered_map<std::string, Texture*>())
+AssetResidentSize TextureManager::GetResidentSize(const std::string& name)
 {
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling TextureManager::GetResidentSize() before TextureManager::Initialize()."), Logger::Category::Warning);
+		return AssetResidentSize();
+	}
 
+	return instance->textures.GetResidentSize(name);
 }
 
-TextureManager::~TextureManager()
+AssetResidentSize TextureManager::GetTotalResidentSize()
 {
-	for (const auto& texture : textures)
+	if (instance == nullptr)
 	{
-		delete texture.second;
+		Logger::Log(std::string("Calling TextureManager::GetTotalResidentSize() before TextureManager::Initialize()."), Logger::Category::Warning);
+		return AssetResidentSize();
 	}
 
-	textures.clear();
+	return instance->textures.GetTotalResidentSize();
+}
+
+void TextureManager::SetMemoryBudget(size_t cpuBytes, size_t gpuBytes)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling TextureManager::SetMemoryBudget() before TextureManager::Initialize()."), Logger::Category::Warning);
+		return;
+	}
 
+	instance->textures.SetBudget(cpuBytes, gpuBytes);
+}
+
+void TextureManager::DeleteEvictedTextures()
+{
+	if (instance != nullptr)
+	{
+		instance->textures.DeleteEvicted();
+	}
+}
+
+std::function<void()> TextureManager::RebuildTexture(const std::string& filePath)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling TextureManager::RebuildTexture() before TextureManager::Initialize()."), Logger::Category::Warning);
+		return std::function<void()>();
+	}
+
+	const bool compressionSupported = Renderer::GetVulkanPhysicalDevice()->GetFeatures().textureCompressionBC == VK_TRUE;
+
+	std::shared_ptr<CookedTexture> cookedTexture = std::make_shared<CookedTexture>();
+	if (!TextureCooker::LoadOrCook(filePath, *cookedTexture, compressionSupported))
+	{
+		return std::function<void()>();
+	}
+
+	const std::string changedPath = std::filesystem::path(filePath).lexically_normal().generic_string();
+
+	return [filePath, changedPath, cookedTexture]()
+	{
+		if (instance == nullptr)
+		{
+			return;
+		}
+
+		std::vector<std::pair<std::string, Texture*>> reloaded;
+		instance->textures.ForEach([&changedPath, &reloaded](const std::string& name, Texture& texture)
+			{
+				if (std::filesystem::path(texture.GetPath()).lexically_normal().generic_string() == changedPath)
+				{
+					reloaded.push_back(std::make_pair(name, &texture));
+				}
+			});
+
+		// Textures kept uncompressed are rare and small, they are cooked again here rather than on every rebuild.
+		std::shared_ptr<CookedTexture> uncompressedTexture = (cookedTexture->format == CookedTexture::Format::RGBA8) ? cookedTexture : nullptr;
+
+		for (std::pair<std::string, Texture*>& texture : reloaded)
+		{
+			if (!texture.second->IsCompressible() && uncompressedTexture == nullptr)
+			{
+				uncompressedTexture = std::make_shared<CookedTexture>();
+				if (!TextureCooker::Cook(filePath, *uncompressedTexture, false))
+				{
+					uncompressedTexture = nullptr;
+					continue;
+				}
+			}
+
+			texture.second->Reload(texture.second->IsCompressible() ? *cookedTexture : *uncompressedTexture);
+			instance->textures.Remeasure(texture.first);
+			GraphicsObjectManager::RefreshGraphicsObjectsUsingTexture(texture.second);
+			Logger::Log(std::string("Reloaded Texture ") + texture.first, Logger::Category::Success);
+		}
+	};
+}
+
+TextureManager::TextureManager() :
+	textures("texture", [](const Texture& texture) { return AssetResidentSize({ 0, texture.GetSizeInBytes() }); }),
+	loadingDefaults(false)
+{
+
+}
+
+TextureManager::~TextureManager()
+{
 	instance = nullptr;
 }
 
 void TextureManager::LoadDefaultTextures()
 {
+	loadingDefaults = true;
 	LoadTexture("Assets/Textures/DefaultFontTexture.png", "DefaultFontTexture");
+	loadingDefaults = false;
 }
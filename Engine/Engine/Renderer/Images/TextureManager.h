@@ -1,12 +1,16 @@
 #ifndef TEXTUREMANAGER_H
 #define TEXTUREMANAGER_H
 
-#include <unordered_map>
+#include "../AssetCache.h"
+
 #include <unordered_set>
 #include <string>
+#include <functional>
 
 class Texture;
 
+typedef AssetHandle<Texture> TextureHandle;
+
 class TextureManager
 {
 public:
@@ -15,12 +19,31 @@ public:
 
 	static void Terminate();
 
-	static Texture* const LoadTexture(const std::string& filePath, const std::string& name);
+	// compress is passed on to the Texture.
+	static Texture* const LoadTexture(const std::string& filePath, const std::string& name, bool compress = true);
 
+	// Pins the texture, it is never evicted since the returned pointer may be kept. Use AcquireTexture for textures that may be.
 	static Texture* const GetTexture(const std::string& name);
 
+	static TextureHandle AcquireTexture(const std::string& name);
+
+	static TextureHandle AcquireTexture(const Texture* const texture);
+
 	static void UnloadTexture(const std::string& name);
 
+	static AssetResidentSize GetResidentSize(const std::string& name);
+
+	static AssetResidentSize GetTotalResidentSize();
+
+	static void SetMemoryBudget(size_t cpuBytes, size_t gpuBytes);
+
+	// Frees the textures evicted or unloaded since the last call. Called on the render thread once the last frame has finished.
+	static void DeleteEvictedTextures();
+
+	// Cooks filePath again. Safe to call off the render thread.
+	// The returned function swaps the new image into every texture loaded from filePath and must run on the render thread between frames.
+	static std::function<void()> RebuildTexture(const std::string& filePath);
+
 private:
 
 	TextureManager();
@@ -41,7 +64,9 @@ private:
 
 	static std::unordered_set<std::string> defaultTextureNames;
 
-	std::unordered_map<std::string, Texture*> textures;
+	AssetCache<Texture> textures;
+
+	bool loadingDefaults;
 };
 
 
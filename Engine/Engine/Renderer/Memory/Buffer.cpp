@@ -79,7 +79,7 @@ unsigned int Buffer::FindMemoryType(unsigned int typeFilter, VkMemoryPropertyFla
     return 0;
 }
 
-void Buffer::Map(void* inData, unsigned int sizeInBytes)
+void Buffer::Map(const void* inData, unsigned int sizeInBytes)
 {
     if ((memoryPropertyFlags & VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT))
     {
@@ -133,6 +133,17 @@ void Buffer::SetData(void* inData)
     memcpy(data, inData, static_cast<size_t>(bufferCreateInfo.size));
 }
 
+void Buffer::SetData(const void* inData, unsigned int offsetInBytes, unsigned int sizeInBytes)
+{
+    if (data == nullptr || static_cast<uint64_t>(offsetInBytes) + sizeInBytes > bufferCreateInfo.size)
+    {
+        Logger::Log(std::string("Calling Buffer::SetData() on a range that is not mapped."), Logger::Category::Error);
+        return;
+    }
+
+    memcpy(static_cast<char*>(data) + offsetInBytes, inData, static_cast<size_t>(sizeInBytes));
+}
+
 void Buffer::CopyFrom(const Buffer& otherBuffer)
 {
     int x = usageFlags & VK_BUFFER_USAGE_TRANSFER_DST_BIT;
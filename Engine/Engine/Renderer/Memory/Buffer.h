@@ -10,7 +10,7 @@ public:
 
 	virtual const VkBuffer& operator()() const;
 
-	void Map(void* data, unsigned int sizeInBytes);
+	void Map(const void* data, unsigned int sizeInBytes);
 
 	void PersistentMap();
 
@@ -18,6 +18,9 @@ public:
 
 	void SetData(void* data);
 
+	// Write part of a persistently mapped buffer.
+	void SetData(const void* data, unsigned int offsetInBytes, unsigned int sizeInBytes);
+
 	void CopyFrom(const Buffer& buffer);
 
 	unsigned int Size() const;
@@ -5,6 +5,7 @@
 #include "../Renderer.h"
 #include "../Vulkan/VulkanPhysicalDevice.h"
 #include "StagingBuffer.h"
+#include "../Images/TextureCooker.h"
 
 
 
@@ -12,13 +13,26 @@ Image::Image(int width, int height, const StagingBuffer& stagingBuffer, unsigned
 	image(VK_NULL_HANDLE),
 	createInfo({}),
 	binding(b),
-	mipLevels(static_cast<unsigned int>(std::floor(std::log2(std::max(width, height)))) + 1U)
+	mipLevels(static_cast<unsigned int>(std::floor(std::log2(std::max(width, height)))) + 1U),
+	format(VK_FORMAT_R8G8B8A8_SRGB)
 {
 	CreateImage(width, height, stagingBuffer);
 	CreateImageView();
 	CreateSampler();
 }
 
+Image::Image(const CookedTexture& cookedTexture, const StagingBuffer& stagingBuffer, unsigned int b) :
+	image(VK_NULL_HANDLE),
+	createInfo({}),
+	binding(b),
+	mipLevels(static_cast<unsigned int>(cookedTexture.mipLevels.size())),
+	format(cookedTexture.GetVulkanFormat())
+{
+	CreateImage(cookedTexture, stagingBuffer);
+	CreateImageView();
+	CreateSampler();
+}
+
 Image::~Image()
 {
 	vkDestroySampler(Renderer::GetVulkanPhysicalDevice()->GetLogicalDevice(), sampler, nullptr);
@@ -46,6 +60,13 @@ void Image::SetBinding(unsigned int newBinding)
 	binding = newBinding;
 }
 
+size_t Image::GetSizeInBytes() const
+{
+	VmaAllocationInfo allocationInfo{};
+	vmaGetAllocationInfo(MemoryManager::GetAllocator(), imageAllocation, &allocationInfo);
+	return static_cast<size_t>(allocationInfo.size);
+}
+
 void Image::CreateImage(int width, int height, const StagingBuffer& stagingBuffer)
 {
 	createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -132,13 +153,103 @@ void Image::CreateImage(int width, int height, const StagingBuffer& stagingBuffe
 	vkQueueWaitIdle(graphicsQueue);
 }
 
+void Image::CreateImage(const CookedTexture& cookedTexture, const StagingBuffer& stagingBuffer)
+{
+	createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	createInfo.imageType = VK_IMAGE_TYPE_2D;
+	createInfo.extent.width = cookedTexture.width;
+	createInfo.extent.height = cookedTexture.height;
+	createInfo.extent.depth = 1;
+	createInfo.mipLevels = mipLevels;
+	createInfo.arrayLayers = 1;
+	createInfo.format = format;
+	createInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	createInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+	createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	createInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	createInfo.flags = 0;
+
+	imageAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+	imageAllocInfo.flags = 0;
+
+	VkResult result = vmaCreateImage(MemoryManager::GetAllocator(), &createInfo, &imageAllocInfo, &image, &imageAllocation, nullptr);
+	VulkanUtils::CheckResult(result, true, true, "Failed to create an image.");
+
+	const VkCommandBuffer& transferBuffer = CommandManager::GetTransferCommandBuffer();
+
+	VkCommandBufferBeginInfo beginInfo = {};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	result = vkBeginCommandBuffer(transferBuffer, &beginInfo);
+	VulkanUtils::CheckResult(result, true, true, "Failed to begin transfer command buffer Image().");
+
+	VkImageMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = image;
+	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier.subresourceRange.baseMipLevel = 0;
+	barrier.subresourceRange.levelCount = mipLevels;
+	barrier.subresourceRange.baseArrayLayer = 0;
+	barrier.subresourceRange.layerCount = 1;
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+	vkCmdPipelineBarrier(transferBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	std::vector<VkBufferImageCopy> regions(mipLevels);
+	for (unsigned int i = 0; i < mipLevels; i++)
+	{
+		const CookedTexture::MipLevel& level = cookedTexture.mipLevels[i];
+
+		VkBufferImageCopy& region = regions[i];
+		region = {};
+		region.bufferOffset = level.offset;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = i;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = { 0, 0, 0 };
+		region.imageExtent = { level.width, level.height, 1U };
+	}
+
+	vkCmdCopyBufferToImage(transferBuffer, stagingBuffer(), image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+
+	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	vkCmdPipelineBarrier(transferBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	result = vkEndCommandBuffer(transferBuffer);
+	VulkanUtils::CheckResult(result, true, true, "Failed to end transfer command buffer Image().");
+
+	VkSubmitInfo submitInfo = {};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &transferBuffer;
+
+	const VkQueue& graphicsQueue = Renderer::GetVulkanPhysicalDevice()->GetGraphicsQueue();
+	result = vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+	VulkanUtils::CheckResult(result, true, true, "Failed to submit transfer command buffer Image().");
+	vkQueueWaitIdle(graphicsQueue);
+}
+
 void Image::CreateImageView()
 {
 	VkImageViewCreateInfo imageViewCreateInfo{};
 	imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
 	imageViewCreateInfo.image = image;
 	imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-	imageViewCreateInfo.format = VK_FORMAT_R8G8B8A8_SRGB;
+	imageViewCreateInfo.format = format;
 	imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 	imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
 	imageViewCreateInfo.subresourceRange.levelCount = mipLevels;
@@ -6,6 +6,7 @@
 #include <vulkan/vulkan.h>
 
 class StagingBuffer;
+struct CookedTexture;
 
 class Image
 {
@@ -16,6 +17,9 @@ public:
 
 	Image(int width, int height, const StagingBuffer& stagingBuffer, unsigned int binding);
 
+	// Upload a prebuilt mip chain, every level comes from the staging buffer so no blits are recorded.
+	Image(const CookedTexture& cookedTexture, const StagingBuffer& stagingBuffer, unsigned int binding);
+
 	~Image();
 
 	Image(const Image&) = delete;
@@ -34,10 +38,14 @@ public:
 
 	void SetBinding(unsigned int newBinding);
 
+	size_t GetSizeInBytes() const;
+
 private:
 
 	void CreateImage(int width, int height, const StagingBuffer& stagingBuffer);
 
+	void CreateImage(const CookedTexture& cookedTexture, const StagingBuffer& stagingBuffer);
+
 	void CreateImageView();
 
 	void CreateSampler();
@@ -60,6 +68,8 @@ private:
 
 	unsigned int mipLevels;
 
+	VkFormat format;
+
 };
 
 
@@ -6,7 +6,19 @@ IndexBuffer::IndexBuffer(unsigned int sizeInBytes) :
 
 }
 
-IndexBuffer::~IndexBuffer()
+IndexBuffer::IndexBuffer(unsigned int sizeInBytes, bool hostVisible) :
+	Buffer(sizeInBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, hostVisible ? VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT : static_cast<VmaAllocationCreateFlagBits>(0))
 {
+	if (hostVisible)
+	{
+		PersistentMap();
+	}
+}
 
+IndexBuffer::~IndexBuffer()
+{
+	if (data != nullptr)
+	{
+		Unmap();
+	}
 }
\ No newline at end of file
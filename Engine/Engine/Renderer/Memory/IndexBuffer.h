@@ -12,6 +12,9 @@ public:
 
 	IndexBuffer(unsigned int sizeInBytes);
 
+	// Host visible buffers stay mapped and are written with SetData instead of a staging copy, for geometry that changes often.
+	IndexBuffer(unsigned int sizeInBytes, bool hostVisible);
+
 	~IndexBuffer();
 
 	IndexBuffer(const IndexBuffer&) = delete;
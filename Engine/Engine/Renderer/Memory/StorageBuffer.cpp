@@ -0,0 +1,24 @@
+#include "StorageBuffer.h"
+
+StorageBuffer::StorageBuffer(unsigned int sizeInBytes, unsigned int b, bool hostVisible) :
+	Buffer(sizeInBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, hostVisible ? VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT : static_cast<VmaAllocationCreateFlagBits>(0)),
+	binding(b)
+{
+	if (hostVisible)
+	{
+		PersistentMap();
+	}
+}
+
+StorageBuffer::~StorageBuffer()
+{
+	if (data != nullptr)
+	{
+		Unmap();
+	}
+}
+
+unsigned int StorageBuffer::Binding() const
+{
+	return binding;
+}
@@ -0,0 +1,36 @@
+#ifndef STORAGEBUFFER_H
+#define STORAGEBUFFER_H
+
+#include "Buffer.h"
+
+#include <vulkan/vulkan.h>
+
+class StorageBuffer : public Buffer
+{
+
+public:
+
+	StorageBuffer() = delete;
+
+	// Device local buffers are filled once with CopyFrom a staging buffer. Host visible ones stay mapped and are written with SetData.
+	StorageBuffer(unsigned int sizeInBytes, unsigned int binding, bool hostVisible);
+
+	~StorageBuffer();
+
+	StorageBuffer(const StorageBuffer&) = delete;
+
+	StorageBuffer& operator=(const StorageBuffer&) = delete;
+
+	StorageBuffer(StorageBuffer&&) = delete;
+
+	StorageBuffer& operator=(StorageBuffer&&) = delete;
+
+	unsigned int Binding() const;
+
+private:
+
+	unsigned int binding;
+
+};
+
+#endif // STORAGEBUFFER_H
@@ -13,7 +13,19 @@ VertexBuffer::VertexBuffer(unsigned int sizeInBytes) :
 	
 }
 
+VertexBuffer::VertexBuffer(unsigned int sizeInBytes, bool hostVisible) :
+	Buffer(sizeInBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, hostVisible ? VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT : static_cast<VmaAllocationCreateFlagBits>(0))
+{
+	if (hostVisible)
+	{
+		PersistentMap();
+	}
+}
+
 VertexBuffer::~VertexBuffer()
 {
-	
+	if (data != nullptr)
+	{
+		Unmap();
+	}
 }
@@ -15,6 +15,9 @@ public:
 
 	VertexBuffer(unsigned int sizeInBytes);
 
+	// Host visible buffers stay mapped and are written with SetData instead of a staging copy, for geometry that changes often.
+	VertexBuffer(unsigned int sizeInBytes, bool hostVisible);
+
 	~VertexBuffer();
 
 	VertexBuffer(const VertexBuffer&) = delete;
@@ -4,12 +4,23 @@
 #include "../../Animation/Armature.h"
 #include "../../Animation/Pose.h"
 #include "../../Animation/BakedAnimation.h"
+#include "../../Math/TransformSoA.h"
+#include "../../Math/PositionSoA.h"
+#include "../../Math/Shapes/Sphere.h"
+#include "../../Math/Shapes/OrientedBoundingBox.h"
+#include "../AssetCache.h"
+#include "../../Collision/MeshBVH.h"
 
 #pragma warning(disable : 4996)
 #define _CRT_SECURE_NO_WARNINGS
 #define CGLTF_IMPLEMENTATION
 #include <cgltf/cgltf.h>
 #include <filesystem>
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <optional>
+#include <chrono>
 
 namespace GLTFHelpers
 {
@@ -32,10 +43,14 @@ namespace GLTFHelpers
 };
 
 Model::Model() :
+	path(),
 	vertices(std::vector<Vertex>()),
 	indices(std::vector<unsigned int>()),
 	animationClips(std::vector<Clip>()),
-	armature(new Armature())
+	armature(new Armature()),
+	boundingSphereCenter(0.0f),
+	boundingSphereRadius(0.0f),
+	bvh(new MeshBVH())
 {
 	// Default rectangle.
 	vertices = {
@@ -46,21 +61,34 @@ Model::Model() :
 	};
 
 	indices = { 0,1,2,2,3,0 };
+
+	CalculateBounds();
+	bvh->Build(vertices, indices);
 }
 
 Model::Model(const std::vector<Vertex>& v, const std::vector<unsigned int>& i) :
+	path(),
 	vertices(v),
 	indices(i),
 	animationClips(std::vector<Clip>()),
-	armature(new Armature())
+	armature(new Armature()),
+	boundingSphereCenter(0.0f),
+	boundingSphereRadius(0.0f),
+	bvh(new MeshBVH())
 {
+	CalculateBounds();
+	bvh->Build(vertices, indices);
 }
 
-Model::Model(const std::string& path) :
+Model::Model(const std::string& p) :
+	path(p),
 	vertices(std::vector<Vertex>()),
 	indices(std::vector<unsigned int>()),
 	animationClips(std::vector<Clip>()),
-	armature(new Armature())
+	armature(new Armature()),
+	boundingSphereCenter(0.0f),
+	boundingSphereRadius(0.0f),
+	bvh(new MeshBVH())
 {
 	if (std::filesystem::exists(path.c_str()))
 	{
@@ -97,6 +125,8 @@ Model::Model(const std::string& path) :
 		cgltf_free(data);
 
 		BakeAnimations();
+		CalculateBounds();
+		bvh->Build(vertices, indices);
 
 		Logger::Log(std::string("Loaded model from file path ") + path, Logger::Category::Success);
 	}
@@ -108,6 +138,7 @@ Model::Model(const std::string& path) :
 
 Model::~Model()
 {
+	delete bvh;
 	delete armature;
 }
 
@@ -131,6 +162,47 @@ const std::vector<Clip>& Model::GetAnimationClips() const
 	return animationClips;
 }
 
+const glm::vec3& Model::GetBoundingSphereCenter() const
+{
+	return boundingSphereCenter;
+}
+
+float Model::GetBoundingSphereRadius() const
+{
+	return boundingSphereRadius;
+}
+
+const std::vector<Model::JointBox>& Model::GetJointBoxes() const
+{
+	return jointBoxes;
+}
+
+const MeshBVH& Model::GetBVH() const
+{
+	return *bvh;
+}
+
+const std::string& Model::GetPath() const
+{
+	return path;
+}
+
+void Model::SwapContents(Model& other)
+{
+	std::swap(vertices, other.vertices);
+	std::swap(indices, other.indices);
+	std::swap(armature, other.armature);
+	std::swap(animationClips, other.animationClips);
+	std::swap(bakedAnimations, other.bakedAnimations);
+	std::swap(skinnedPosition, other.skinnedPosition);
+	std::swap(skinnedNormal, other.skinnedNormal);
+	std::swap(posePalette, other.posePalette);
+	std::swap(boundingSphereCenter, other.boundingSphereCenter);
+	std::swap(boundingSphereRadius, other.boundingSphereRadius);
+	std::swap(jointBoxes, other.jointBoxes);
+	std::swap(bvh, other.bvh);
+}
+
 Pose GLTFHelpers::LoadRestPose(cgltf_data* data)
 {
 	unsigned int boneCount = static_cast<unsigned int>(data->nodes_count);
@@ -178,6 +250,25 @@ const BakedAnimation& Model::GetBakedAnimation(unsigned int index) const
 		return bakedAnimations[0];
 }
 
+AssetResidentSize Model::GetResidentSize() const
+{
+	AssetResidentSize size;
+
+	size.cpuBytes += vertices.size() * sizeof(Vertex);
+	size.cpuBytes += indices.size() * sizeof(unsigned int);
+
+	for (const BakedAnimation& bakedAnimation : bakedAnimations)
+	{
+		size.cpuBytes += bakedAnimation.GetSizeInBytes();
+	}
+
+	size.cpuBytes += bvh->GetSizeInBytes();
+	size.cpuBytes += jointBoxes.size() * sizeof(JointBox);
+
+	// Vertex and index buffers are owned by each GraphicsObject, so a model holds no GPU memory itself.
+	return size;
+}
+
 void Model::CPUSkin(Armature& armature, Pose& pose)
 {
 	unsigned int numVerts = static_cast<unsigned int>(vertices.size());
@@ -186,34 +277,88 @@ void Model::CPUSkin(Armature& armature, Pose& pose)
 		return;
 	}
 
-	skinnedPosition.resize(numVerts);
-	skinnedNormal.resize(numVerts);
+	skinnedPosition.assign(numVerts, glm::vec3(0.0f));
+	skinnedNormal.assign(numVerts, glm::vec3(0.0f));
 
-	Pose& bindPose = const_cast<Pose&>(armature.GetBindPose());
+	const Pose& bindPose = armature.GetBindPose();
 
+	// Each joint's skin transform is computed once instead of once per vertex influence.
+	std::vector<Math::Transform> jointSkins(pose.Size());
+	for (unsigned int joint = 0; joint < jointSkins.size(); joint++)
+	{
+		jointSkins[joint] = Math::Transform::Combine(pose.GetGlobalTransform(joint), Math::Transform::Inverse(bindPose.GetGlobalTransform(joint)));
+	}
+
+	std::vector<glm::vec3> bindPositions(numVerts);
+	std::vector<glm::vec3> bindNormals(numVerts);
 	for (unsigned int i = 0; i < numVerts; ++i)
 	{
-		glm::ivec4& joint = vertices[i].GetInfluences();
-		glm::vec4& weight = vertices[i].GetWeights();
+		bindPositions[i] = vertices[i].GetPosition();
+		bindNormals[i] = vertices[i].GetNormal();
+	}
 
-		Math::Transform skin0 = Math::Transform::Combine(pose[joint.x], Math::Transform::Inverse(bindPose[joint.x]));
-		glm::vec3 p0 = Math::Transform::TransformPoint(skin0, vertices[i].GetPosition());
-		glm::vec3 n0 = Math::Transform::TransformVector(skin0, vertices[i].GetNormal());
+	Math::TransformSoA vertexSkins(numVerts);
+	std::vector<glm::vec3> influencePositions(numVerts);
+	std::vector<glm::vec3> influenceNormals(numVerts);
 
-		Math::Transform skin1 = Math::Transform::Combine(pose[joint.y], Math::Transform::Inverse(bindPose[joint.y]));
-		glm::vec3 p1 = Math::Transform::TransformPoint(skin1, vertices[i].GetPosition());
-		glm::vec3 n1 = Math::Transform::TransformVector(skin1, vertices[i].GetNormal());
+	// One batch per influence slot, every vertex transformed by its slot's joint and weighted into the result.
+	for (unsigned int influence = 0; influence < 4; influence++)
+	{
+		for (unsigned int i = 0; i < numVerts; ++i)
+		{
+			vertexSkins.Set(i, jointSkins[vertices[i].GetInfluences()[influence]]);
+		}
 
-		Math::Transform skin2 = Math::Transform::Combine(pose[joint.z], Math::Transform::Inverse(bindPose[joint.z]));
-		glm::vec3 p2 = Math::Transform::TransformPoint(skin2, vertices[i].GetPosition());
-		glm::vec3 n2 = Math::Transform::TransformVector(skin2, vertices[i].GetNormal());
+		Math::TransformSoA::TransformPoints(vertexSkins, bindPositions.data(), influencePositions.data());
+		Math::TransformSoA::TransformVectors(vertexSkins, bindNormals.data(), influenceNormals.data());
 
-		Math::Transform skin3 = Math::Transform::Combine(pose[joint.w], Math::Transform::Inverse(bindPose[joint.w]));
-		glm::vec3 p3 = Math::Transform::TransformPoint(skin3, vertices[i].GetPosition());
-		glm::vec3 n3 = Math::Transform::TransformVector(skin3, vertices[i].GetNormal());
+		for (unsigned int i = 0; i < numVerts; ++i)
+		{
+			const float weight = vertices[i].GetWeights()[influence];
+			skinnedPosition[i] += influencePositions[i] * weight;
+			skinnedNormal[i] += influenceNormals[i] * weight;
+		}
+	}
+}
+
+void Model::CalculateBounds()
+{
+	Sphere::Fit(Math::PositionSoA(vertices), boundingSphereCenter, boundingSphereRadius);
+
+	const std::vector<std::string>& jointNames = armature->GetJointNames();
+
+	// The vertices of each joint gathered by the joint that weighs on them most.
+	std::vector<Math::PositionSoA> jointPoints(jointNames.size());
+
+	for (const Vertex& vertex : vertices)
+	{
+		unsigned int jointWithMostInfluence = 0;
+		float influence = vertex.GetWeights()[jointWithMostInfluence];
+
+		for (unsigned int i = 1; i < 4; ++i)
+		{
+			if (vertex.GetWeights()[i] > influence)
+			{
+				jointWithMostInfluence = i;
+				influence = vertex.GetWeights()[i];
+			}
+		}
+
+		const unsigned int joint = static_cast<unsigned int>(vertex.GetInfluences()[jointWithMostInfluence]);
+
+		if (joint < jointPoints.size())
+		{
+			jointPoints[joint].Add(vertex.GetPosition());
+		}
+	}
+
+	jointBoxes.assign(jointNames.size(), JointBox());
 
-		vertices[i].GetPosition() = p0 * weight.x + p1 * weight.y + p2 * weight.z + p3 * weight.w;
-		skinnedNormal[i] = n0 * weight.x + n1 * weight.y + n2 * weight.z + n3 * weight.w;
+	for (unsigned int joint = 0; joint < jointBoxes.size(); ++joint)
+	{
+		JointBox& box = jointBoxes[joint];
+		box.vertexCount = jointPoints[joint].Size();
+		OrientedBoundingBox::Fit(jointPoints[joint], box.center, box.axes, box.halfSize);
 	}
 }
 
@@ -223,6 +368,9 @@ void Model::SetZforAllVerts(float newZ)
 	{
 		const_cast<glm::vec3&>(vert.GetPosition()).z = newZ;
 	}
+
+	CalculateBounds();
+	bvh->Build(vertices, indices);
 }
 
 void Model::FlipTriangleWindingOrder()
@@ -253,6 +401,8 @@ void Model::FlipTriangleWindingOrder()
 
 			threeCount++;
 		}
+
+		bvh->Build(vertices, indices);
 	}
 }
 
@@ -293,11 +443,15 @@ void Model::LoadAnimationClips(cgltf_data* data)
 	unsigned long long numNodes = data->nodes_count;
 	animationClips.resize(numClips);
 
-	for (unsigned long long i = 0; i < numClips; i++)
+	std::vector<unsigned long long> clipIndices(numClips);
+	std::iota(clipIndices.begin(), clipIndices.end(), 0ULL);
+
+	// Clips only read the gltf data and each writes its own tracks, so they are imported in parallel.
+	std::for_each(std::execution::par, clipIndices.begin(), clipIndices.end(), [this, data, numNodes](unsigned long long i)
 	{
 		animationClips[i].SetName(data->animations[i].name);
 
-		unsigned long long numChannels = data->animations->channels_count;
+		unsigned long long numChannels = data->animations[i].channels_count;
 
 		for (unsigned long long j = 0; j < numChannels; j++)
 		{
@@ -326,16 +480,50 @@ void Model::LoadAnimationClips(cgltf_data* data)
 		}
 
 		animationClips[i].RecalculateDuration();
-	}
-
+	});
 }
 
 void Model::BakeAnimations()
 {
-	bakedAnimations.reserve(animationClips.size());
-	for (unsigned int i = 0; i < animationClips.size(); i++)
+	const unsigned int clipCount = static_cast<unsigned int>(animationClips.size());
+
+	// Each clip bakes on its own worker into its own slot, the slots are moved into place once all are done.
+	std::vector<std::optional<BakedAnimation>> baked(clipCount);
+	std::vector<double> bakeMilliseconds(clipCount, 0.0);
+
+	std::vector<unsigned int> clipIndices(clipCount);
+	std::iota(clipIndices.begin(), clipIndices.end(), 0U);
+
+	const std::chrono::steady_clock::time_point bakeStart = std::chrono::steady_clock::now();
+
+	std::for_each(std::execution::par, clipIndices.begin(), clipIndices.end(), [this, &baked, &bakeMilliseconds](unsigned int i)
 	{
-		bakedAnimations.push_back(BakedAnimation(&animationClips[i], GetArmature()));
+		const std::chrono::steady_clock::time_point clipStart = std::chrono::steady_clock::now();
+		baked[i].emplace(&animationClips[i], GetArmature());
+		bakeMilliseconds[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - clipStart).count();
+	});
+
+	const double totalMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - bakeStart).count();
+
+	bakedAnimations.clear();
+	bakedAnimations.reserve(clipCount);
+
+	double serialMilliseconds = 0.0;
+	for (unsigned int i = 0; i < clipCount; i++)
+	{
+		bakedAnimations.push_back(std::move(*baked[i]));
+		serialMilliseconds += bakeMilliseconds[i];
+
+		// Logged here rather than by the bakes, so the clips are listed once and in order.
+		const BakedAnimation& clip = bakedAnimations.back();
+		const size_t uncompressedSize = static_cast<size_t>(clip.GetFrameCount()) * clip.GetRestPose().Size() * sizeof(glm::mat4);
+
+		Logger::Log(std::string("Baked clip ") + std::to_string(i + 1) + "/" + std::to_string(clipCount) + " " + animationClips[i].GetName() + " in " + std::to_string(bakeMilliseconds[i]) + " ms: " + std::to_string(clip.GetFrameCount()) + " frames, " + std::to_string(clip.GetSizeInBytes() / 1024) + " KB instead of " + std::to_string(uncompressedSize / 1024) + " KB.", Logger::Category::Info);
+	}
+
+	if (clipCount > 0U)
+	{
+		Logger::Log(std::string("Baked ") + std::to_string(clipCount) + " clips of " + path + " in " + std::to_string(totalMilliseconds) + " ms, " + std::to_string(serialMilliseconds) + " ms of baking work.", Logger::Category::Info);
 	}
 }
 
@@ -493,12 +681,10 @@ int GLTFHelpers::GetNodeIndex(cgltf_node* const target, cgltf_node* const allNod
 		return -1;
 	}
 
-	for (unsigned int i = 0; i < numNodes; i++)
+	// Nodes live in one array, so a node's index is its offset into it.
+	if (target >= allNodes && target < allNodes + numNodes)
 	{
-		if (target == &allNodes[i])
-		{
-			return static_cast<int>(i);
-		}
+		return static_cast<int>(target - allNodes);
 	}
 
 	return -1;
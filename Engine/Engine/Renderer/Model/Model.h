@@ -9,8 +9,10 @@
 #include <vector>
 
 class Pose;
+class MeshBVH;
 class Armature;
 class BakedAnimation;
+struct AssetResidentSize;
 
 struct cgltf_data;
 struct cgltf_attribute;
@@ -22,6 +24,19 @@ class Model
 
 public:
 
+	// A box around the vertices that follow a joint most, in model space as loaded.
+	struct JointBox
+	{
+		glm::vec3 center = glm::vec3(0.0f);
+
+		glm::mat3 axes = glm::mat3(1.0f);
+
+		glm::vec3 halfSize = glm::vec3(0.0f);
+
+		// Zero for joints that no vertex follows most, which have no box.
+		unsigned int vertexCount = 0;
+	};
+
 	Model();
 
 	Model(const std::vector<Vertex>& verices, const std::vector<unsigned int>& indices);
@@ -48,6 +63,26 @@ public:
 
 	const BakedAnimation& GetBakedAnimation(unsigned int index) const;
 
+	AssetResidentSize GetResidentSize() const;
+
+	// A sphere around every vertex as loaded, in model space.
+	const glm::vec3& GetBoundingSphereCenter() const;
+
+	float GetBoundingSphereRadius() const;
+
+	// One per joint of the armature, fitted with the bounding sphere so colliders built on the model share them.
+	const std::vector<JointBox>& GetJointBoxes() const;
+
+	// Over the triangles as loaded, in model space. Built with the model, CPU skinning does not move it.
+	const MeshBVH& GetBVH() const;
+
+	// Empty for models that were not loaded from a file.
+	const std::string& GetPath() const;
+
+	// Exchange all loaded data with other. Used to reload a model in place so existing pointers to it stay valid, references
+	// to its data, like an Animation's clip, point into other afterwards.
+	void SwapContents(Model& other);
+
 	void CPUSkin(Armature& armature, Pose& pose);
 
 	void SetZforAllVerts(float newZ);
@@ -60,6 +95,8 @@ private:
 
 	void CPUSkinMatrices(Armature& armature, Pose& pose);
 
+	void CalculateBounds();
+
 	void LoadAnimationClips(cgltf_data* data);
 
 	void BakeAnimations();
@@ -68,6 +105,8 @@ private:
 
 	void LoadMeshFromGLTF(cgltf_data* data);
 
+	std::string path;
+
 	std::vector<Vertex> vertices;
 
 	std::vector<unsigned int> indices;
@@ -84,6 +123,14 @@ private:
 
 	std::vector<glm::mat4> posePalette;
 
+	glm::vec3 boundingSphereCenter;
+
+	float boundingSphereRadius;
+
+	std::vector<JointBox> jointBoxes;
+
+	MeshBVH* bvh;
+
 };
 
 #endif // MODEL_H
\ No newline at end of file
@@ -3,8 +3,13 @@
 #include "../../Utils/Logger.h"
 #include "Model.h"
 #include "../../UI/Text.h"
+#include "../GraphicsObjects/GraphicsObjectManager.h"
+#include "../../Simulation/Simulation.h"
 
 #include <stdexcept>
+#include <filesystem>
+#include <memory>
+#include <algorithm>
 
 ModelManager* ModelManager::instance = nullptr;
 
@@ -34,13 +39,20 @@ Model* const ModelManager::LoadModel(const std::string& name, const std::string&
 		return nullptr;
 	}
 
-	if (instance->models.find(name) != instance->models.end())
+	if (instance->models.Contains(name))
 	{
 		Logger::Log(std::string("Cannot load model with name ") + name + std::string(". This name is already being used."), Logger::Category::Warning);
 		return nullptr;
 	}
 
-	return instance->models[name] = new Model(path);
+	Model* newModel = new Model(path);
+	if (!instance->models.Insert(name, newModel))
+	{
+		delete newModel;
+		return nullptr;
+	}
+
+	return newModel;
 }
 
 Model* const ModelManager::LoadModel(const std::string& name, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
@@ -51,16 +63,23 @@ Model* const ModelManager::LoadModel(const std::string& name, const std::vector<
 		return nullptr;
 	}
 
-	if (instance->models.find(name) == instance->models.end())
+	if (instance->models.Contains(name))
 	{
 		Logger::Log(std::string("Cannot load model with name ") + name + std::string(". This name is already being used."), Logger::Category::Warning);
 		return nullptr;
 	}
 
-	return instance->models[name] = new Model(vertices, indices);
+	Model* newModel = new Model(vertices, indices);
+	if (!instance->models.Insert(name, newModel))
+	{
+		delete newModel;
+		return nullptr;
+	}
+
+	return newModel;
 }
 
-Model* const ModelManager::GetModel(std::string modelName)
+Model* const ModelManager::GetModel(const std::string& modelName)
 {
 	if (instance == nullptr)
 	{
@@ -68,34 +87,222 @@ Model* const ModelManager::GetModel(std::string modelName)
 		return nullptr;
 	}
 
-	if (instance->models.find(modelName) == instance->models.end())
+	Model* model = instance->models.Find(modelName, true);
+
+	if (model == nullptr)
 	{
 		Logger::Log(std::string("Could not find model ") + modelName, Logger::Category::Error);
-		return nullptr;
 	}
 
-	return instance->models[modelName];
+	return model;
 }
 
-ModelManager::ModelManager() :
-	models(std::unordered_map<std::string, Model*>())
+ModelHandle ModelManager::AcquireModel(const std::string& modelName)
 {
-	
+	if (instance == nullptr)
+	{
+		Logger::LogAndThrow(std::string("Calling ModelManager::AcquireModel() before ModelManager::Initialize()."));
+		return ModelHandle();
+	}
+
+	ModelHandle handle = instance->models.Acquire(modelName);
+
+	if (!handle)
+	{
+		Logger::Log(std::string("Could not find model ") + modelName, Logger::Category::Error);
+	}
+
+	return handle;
 }
 
-ModelManager::~ModelManager()
+ModelHandle ModelManager::AcquireModel(const Model* const model)
+{
+	if (instance == nullptr)
+	{
+		Logger::LogAndThrow(std::string("Calling ModelManager::AcquireModel() before ModelManager::Initialize()."));
+		return ModelHandle();
+	}
+
+	return instance->models.Acquire(model);
+}
+
+void ModelManager::UnloadModel(const std::string& modelName)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling ModelManager::UnloadModel() before ModelManager::Initialize()."), Logger::Category::Warning);
+		return;
+	}
+
+	if (!instance->models.Contains(modelName))
+	{
+		Logger::Log(std::string("A model with the name ") + modelName + " does not exist. ModelManager::UnloadModel.", Logger::Category::Warning);
+		return;
+	}
+
+	instance->models.Remove(modelName);
+}
+
+AssetResidentSize ModelManager::GetResidentSize(const std::string& modelName)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling ModelManager::GetResidentSize() before ModelManager::Initialize()."), Logger::Category::Warning);
+		return AssetResidentSize();
+	}
+
+	return instance->models.GetResidentSize(modelName);
+}
+
+AssetResidentSize ModelManager::GetTotalResidentSize()
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling ModelManager::GetTotalResidentSize() before ModelManager::Initialize()."), Logger::Category::Warning);
+		return AssetResidentSize();
+	}
+
+	return instance->models.GetTotalResidentSize();
+}
+
+void ModelManager::SetMemoryBudget(size_t cpuBytes, size_t gpuBytes)
 {
-	for (auto& model : models)
+	if (instance == nullptr)
 	{
-		delete model.second;
+		Logger::Log(std::string("Calling ModelManager::SetMemoryBudget() before ModelManager::Initialize()."), Logger::Category::Warning);
+		return;
 	}
 
+	instance->models.SetBudget(cpuBytes, gpuBytes);
+}
+
+void ModelManager::DeleteEvictedModels()
+{
+	if (instance != nullptr)
+	{
+		instance->models.DeleteEvicted();
+	}
+}
+
+std::function<void()> ModelManager::RebuildModel(const std::string& filePath)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling ModelManager::RebuildModel() before ModelManager::Initialize()."), Logger::Category::Warning);
+		return std::function<void()>();
+	}
+
+	std::shared_ptr<Model> reloadedModel = std::make_shared<Model>(filePath);
+
+	// Keep the old data if the file failed to parse, it is probably still being written.
+	if (reloadedModel->GetVertices().empty())
+	{
+		return std::function<void()>();
+	}
+
+	const std::string changedPath = std::filesystem::path(filePath).lexically_normal().generic_string();
+
+	return [changedPath, reloadedModel]()
+	{
+		if (instance == nullptr)
+		{
+			return;
+		}
+
+		std::vector<std::pair<std::string, Model*>> reloaded;
+		instance->models.ForEach([&changedPath, &reloaded](const std::string& name, Model& model)
+			{
+				if (!model.GetPath().empty() && std::filesystem::path(model.GetPath()).lexically_normal().generic_string() == changedPath)
+				{
+					reloaded.push_back(std::make_pair(name, &model));
+				}
+			});
+
+		// The first model takes the new data, any others loaded from the same file get a fresh parse. Each holds the old data
+		// until every consumer has been moved off it.
+		std::vector<std::unique_ptr<Model>> replaced;
+		for (unsigned int i = 1; i < reloaded.size(); i++)
+		{
+			replaced.push_back(std::make_unique<Model>(changedPath));
+		}
+
+		Simulation::RunBetweenSteps([&reloaded, &reloadedModel, &replaced]()
+			{
+				std::lock_guard<std::mutex> guard(instance->reloadCallbacksMutex);
+
+				for (unsigned int i = 0; i < reloaded.size(); i++)
+				{
+					Model* const model = reloaded[i].second;
+					model->SwapContents(i == 0 ? *reloadedModel : *replaced[i - 1]);
+
+					instance->models.Remeasure(reloaded[i].first);
+					GraphicsObjectManager::RefreshGraphicsObjectsUsingModel(model);
+
+					for (std::pair<std::string, std::function<void(const Model*)>*>& reloadCallback : instance->reloadCallbacks)
+					{
+						(*reloadCallback.second)(model);
+					}
+
+					Logger::Log(std::string("Reloaded Model ") + reloaded[i].first, Logger::Category::Success);
+				}
+			});
+	};
+}
+
+void ModelManager::RegisterReloadCallback(std::function<void(const Model*)>* const callback, const std::string& name)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling ModelManager::RegisterReloadCallback() before ModelManager::Initialize()."), Logger::Category::Warning);
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->reloadCallbacksMutex);
+
+	for (std::pair<std::string, std::function<void(const Model*)>*>& reloadCallback : instance->reloadCallbacks)
+	{
+		if (reloadCallback.first == name)
+		{
+			reloadCallback.second = callback;
+			return;
+		}
+	}
+
+	instance->reloadCallbacks.push_back(std::make_pair(name, callback));
+}
+
+void ModelManager::DeregisterReloadCallback(const std::string& name)
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->reloadCallbacksMutex);
+
+	std::vector<std::pair<std::string, std::function<void(const Model*)>*>>& reloadCallbacks = instance->reloadCallbacks;
+
+	reloadCallbacks.erase(std::remove_if(reloadCallbacks.begin(), reloadCallbacks.end(), [&name](const std::pair<std::string, std::function<void(const Model*)>*>& reloadCallback)
+	{
+		return reloadCallback.first == name;
+	}), reloadCallbacks.end());
+}
+
+ModelManager::ModelManager() :
+	models("model", [](const Model& model) { return model.GetResidentSize(); }),
+	reloadCallbacks(std::vector<std::pair<std::string, std::function<void(const Model*)>*>>())
+{
+	
+}
+
+ModelManager::~ModelManager()
+{
 	instance = nullptr;
 }
 
 void ModelManager::LoadDefaultModels()
 {
-	models.insert(std::make_pair(std::string("DefaultRectangle"), new Model()));
+	models.Insert(std::string("DefaultRectangle"), new Model(), true);
 
 
 	// Default rectangle.
@@ -108,7 +315,7 @@ void ModelManager::LoadDefaultModels()
 
 	std::vector<unsigned int> indices = { 0,1,2,2,3,0 };
 
-	models.insert(std::make_pair(std::string("DefaultRectangleWithDepth"), new Model(rectangleVertices, indices)));
+	models.Insert(std::string("DefaultRectangleWithDepth"), new Model(rectangleVertices, indices), true);
 
 	// Default triangle
 	std::vector<Vertex> triangleVertices = {
@@ -119,10 +326,10 @@ void ModelManager::LoadDefaultModels()
 
 	std::vector<unsigned int> triangleIndices = { 0,2,1 };
 
-	models.insert(std::make_pair(std::string("DefaultTriangle"), new Model(triangleVertices, triangleIndices)));
+	models.Insert(std::string("DefaultTriangle"), new Model(triangleVertices, triangleIndices), true);
 
 	std::vector<Vertex> nullVertices;
 	std::vector<unsigned int> nullIndices;
 
-	models.insert(std::make_pair(std::string("Null"), new Model(nullVertices, nullIndices)));
+	models.Insert(std::string("Null"), new Model(nullVertices, nullIndices), true);
 }
@@ -1,12 +1,18 @@
 #ifndef MODELMANAGER_H
 #define MODELMANAGER_H
 
+#include "../AssetCache.h"
+
 #include <string>
-#include <unordered_map>
+#include <vector>
+#include <functional>
+#include <mutex>
 
 class Model;
 class Vertex;
 
+typedef AssetHandle<Model> ModelHandle;
+
 class ModelManager
 {
 public:
@@ -19,7 +25,34 @@ public:
 
 	static Model* const LoadModel(const std::string& name, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
 
-	static Model* const GetModel(std::string ModelName);
+	// Pins the model, it is never evicted since the returned pointer may be kept. Use AcquireModel for models that may be.
+	static Model* const GetModel(const std::string& modelName);
+
+	static ModelHandle AcquireModel(const std::string& modelName);
+
+	static ModelHandle AcquireModel(const Model* const model);
+
+	static void UnloadModel(const std::string& modelName);
+
+	static AssetResidentSize GetResidentSize(const std::string& modelName);
+
+	static AssetResidentSize GetTotalResidentSize();
+
+	static void SetMemoryBudget(size_t cpuBytes, size_t gpuBytes);
+
+	// Frees the models evicted or unloaded since the last call. Called on the render thread once the last frame has finished.
+	static void DeleteEvictedModels();
+
+	// Parses filePath again. Safe to call off the render thread.
+	// The returned function swaps the new data into every model loaded from filePath and must run on the render thread between frames.
+	// The swap happens while no simulation step runs, so only the render thread and step callbacks may read a model's data.
+	static std::function<void()> RebuildModel(const std::string& filePath);
+
+	// Called with each model reloaded in place, right after its graphics objects were refreshed and before its old data is
+	// freed, for anything else that keeps data derived from the model. Runs on the render thread while no simulation step runs.
+	static void RegisterReloadCallback(std::function<void(const Model*)>* const callback, const std::string& name);
+
+	static void DeregisterReloadCallback(const std::string& name);
 
 private:
 
@@ -39,7 +72,11 @@ private:
 
 	static ModelManager* instance;
 
-	std::unordered_map<std::string, Model*> models;
+	AssetCache<Model> models;
+
+	std::vector<std::pair<std::string, std::function<void(const Model*)>*>> reloadCallbacks;
+
+	std::mutex reloadCallbacksMutex;
 
 };
 
@@ -0,0 +1,12 @@
+#include "AlphaBlendingPipelineState.h"
+
+AlphaBlendingPipelineState::AlphaBlendingPipelineState()
+{
+	colorBlendAttachment.blendEnable = VK_TRUE;
+	colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+	colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+}
+
+AlphaBlendingPipelineState::~AlphaBlendingPipelineState()
+{
+}
@@ -0,0 +1,28 @@
+#ifndef ALPHA_BLENDING_PIPELINE_STATE_H
+#define ALPHA_BLENDING_PIPELINE_STATE_H
+
+#include "ColorBlendingPipelineState.h"
+
+// Standard alpha blending for 2D objects and text drawn over the scene, glyph quads carry their coverage in alpha.
+class AlphaBlendingPipelineState : public ColorBlendingPipelineState
+{
+
+public:
+
+	AlphaBlendingPipelineState();
+
+	~AlphaBlendingPipelineState();
+
+private:
+
+	AlphaBlendingPipelineState(const AlphaBlendingPipelineState&) = delete;
+
+	AlphaBlendingPipelineState& operator=(const AlphaBlendingPipelineState&) = delete;
+
+	AlphaBlendingPipelineState(const AlphaBlendingPipelineState&&) = delete;
+
+	AlphaBlendingPipelineState& operator=(const AlphaBlendingPipelineState&&) = delete;
+
+};
+
+#endif // ALPHA_BLENDING_PIPELINE_STATE_H
\ No newline at end of file
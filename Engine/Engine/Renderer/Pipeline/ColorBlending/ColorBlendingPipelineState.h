@@ -14,6 +14,13 @@ public:
 
 	const VkPipelineColorBlendStateCreateInfo& operator*() const;
 
+protected:
+
+	VkPipelineColorBlendStateCreateInfo createInfo{};
+
+	// This is per frame buffer.
+	VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+
 private:
 
 	ColorBlendingPipelineState(const ColorBlendingPipelineState&) = delete;
@@ -24,10 +31,6 @@ private:
 
 	ColorBlendingPipelineState& operator=(const ColorBlendingPipelineState&&) = delete;
 
-	VkPipelineColorBlendStateCreateInfo createInfo{};
-
-	// This is per frame buffer.
-	VkPipelineColorBlendAttachmentState colorBlendAttachment{};
 };
 
 #endif // COLOR_BLENDING_PIPELINE_STATE_H
\ No newline at end of file
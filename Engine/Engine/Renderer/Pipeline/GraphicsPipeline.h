@@ -25,6 +25,13 @@ public:
 
 	GraphicsPipeline(const ShaderPipelineStage& shaderPipelineStage, const RasterizerPipelineState& rasterizerPipelineState, const Window& window);
 
+	// Takes ownership of the color blending state as well as the rasterizer.
+	GraphicsPipeline(const ShaderPipelineStage& shaderPipelineStage, const RasterizerPipelineState& rasterizerPipelineState, const ColorBlendingPipelineState& colorBlendingPipelineState, const Window& window);
+
+	// For pipelines with their own vertex layout and topology whose shaders read push constants. Takes ownership of the
+	// input assembly and vertex input states like the other constructor does of the rasterizer.
+	GraphicsPipeline(const ShaderPipelineStage& shaderPipelineStage, const InputAssemblyPipelineState& inputAssemblyPipelineState, const VertexInputPipelineState& vertexInputPipelineState, const VkPushConstantRange& pushConstantRange, const Window& window);
+
 	~GraphicsPipeline();
 
 	const VkPipeline& operator*() const { return graphicsPipeline; };
@@ -49,11 +56,11 @@ private:
 	// The info used to create this graphics pipeline.
 	VkGraphicsPipelineCreateInfo createInfo{};
 
-	InputAssemblyPipelineState* const inputAssembly;
-	VertexInputPipelineState* const vertexInput;
+	const InputAssemblyPipelineState* const inputAssembly;
+	const VertexInputPipelineState* const vertexInput;
 	const RasterizerPipelineState* const rasterizer;
 	MultisamplingPipelineState* const multisampling;
-	ColorBlendingPipelineState* const colorBlending;
+	const ColorBlendingPipelineState* const colorBlending;
 	DynamicPipelineState* const dynamic;
 	DepthStencilPipelineState* const depthStencil;
 	PipelineLayout* const layout;
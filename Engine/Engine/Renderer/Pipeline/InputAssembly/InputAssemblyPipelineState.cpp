@@ -13,6 +13,13 @@ InputAssemblyPipelineState::InputAssemblyPipelineState()
 	createInfo.primitiveRestartEnable = VK_FALSE;
 }
 
+InputAssemblyPipelineState::InputAssemblyPipelineState(VkPrimitiveTopology topology)
+{
+	createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	createInfo.topology = topology;
+	createInfo.primitiveRestartEnable = VK_FALSE;
+}
+
 InputAssemblyPipelineState::~InputAssemblyPipelineState()
 {
 }
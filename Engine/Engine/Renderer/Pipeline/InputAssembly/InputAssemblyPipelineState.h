@@ -10,6 +10,8 @@ public:
 
 	InputAssemblyPipelineState();
 
+	InputAssemblyPipelineState(VkPrimitiveTopology topology);
+
 	~InputAssemblyPipelineState();
 
 	const VkPipelineInputAssemblyStateCreateInfo& operator*() const;
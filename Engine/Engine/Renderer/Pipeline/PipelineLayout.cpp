@@ -26,6 +26,25 @@ PipelineLayout::PipelineLayout(VulkanPhysicalDevice* d, const DescriptorSetLayou
 	}
 }
 
+PipelineLayout::PipelineLayout(VulkanPhysicalDevice* d, const DescriptorSetLayout* const descriptorSetLayout, const VkPushConstantRange& pushConstantRange) :
+	device(d)
+{
+	VkPipelineLayoutCreateInfo createInfo{};
+	createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	createInfo.setLayoutCount = 1;
+	createInfo.pSetLayouts = &(*descriptorSetLayout)();
+	createInfo.pushConstantRangeCount = 1;
+	createInfo.pPushConstantRanges = &pushConstantRange;
+
+	VkResult result = vkCreatePipelineLayout(device->GetLogicalDevice(), &createInfo, nullptr, &layout);
+
+	if (result != VK_SUCCESS)
+	{
+		Logger::Log(std::string("Failed to create pipeline layout in PipelineLayout::PipelineLayout"), Logger::Category::Error);
+		throw std::runtime_error("Failed to create pipeline layout in PipelineLayout::PipelineLayout");
+	}
+}
+
 PipelineLayout::~PipelineLayout()
 {
 	vkDestroyPipelineLayout(device->GetLogicalDevice(), layout, nullptr);
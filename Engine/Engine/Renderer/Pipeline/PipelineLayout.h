@@ -13,6 +13,8 @@ public:
 
 	PipelineLayout(VulkanPhysicalDevice* device, const DescriptorSetLayout* const descriptorSetLayout);
 
+	PipelineLayout(VulkanPhysicalDevice* device, const DescriptorSetLayout* const descriptorSetLayout, const VkPushConstantRange& pushConstantRange);
+
 	~PipelineLayout();
 
 	const VkPipelineLayout& operator*() const;
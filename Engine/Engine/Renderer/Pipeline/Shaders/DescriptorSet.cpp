@@ -5,6 +5,7 @@
 #include "../../Renderer.h"
 #include "../../Vulkan/VulkanPhysicalDevice.h"
 #include "../../Memory/UniformBuffer.h"
+#include "../../Memory/StorageBuffer.h"
 #include "../../Memory/Image.h"
 #include "../../GraphicsObjects/GraphicsObject.h"
 #include "ShaderPipelineStage.h"
@@ -35,6 +36,7 @@ DescriptorSet::DescriptorSet(const VkDescriptorPool& descriptorPool, const Shade
 	for (const VkDescriptorSetLayoutBinding& binding : shader.GetDescriptorSetLayout().GetLayoutBindings())
 	{
 		const UniformBuffer* uniformBuffer = nullptr;
+		const StorageBuffer* storageBuffer = nullptr;
 		const Image* image = nullptr;
 		switch (binding.descriptorType)
 		{
@@ -62,6 +64,30 @@ DescriptorSet::DescriptorSet(const VkDescriptorPool& descriptorPool, const Shade
 				writes.push_back(bufferWrite);
 			}
 			break;
+		case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+			storageBuffer = graphicsObject->GetStorageBuffer(binding.binding);
+
+			if (storageBuffer != nullptr)
+			{
+				// Need to be allocated on the heap so that they don't get destroyed in local loop scope.
+				VkDescriptorBufferInfo* bufferInfo = new VkDescriptorBufferInfo();
+				bufferInfo->buffer = (*storageBuffer)();
+				bufferInfo->offset = 0;
+				bufferInfo->range = static_cast<uint64_t>(storageBuffer->Size());
+				bufferInfos.push_back(bufferInfo);
+
+				VkWriteDescriptorSet bufferWrite = {};
+				bufferWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				bufferWrite.dstSet = descriptorSet;
+				bufferWrite.dstBinding = storageBuffer->Binding();
+				bufferWrite.dstArrayElement = 0;
+				bufferWrite.descriptorCount = 1;
+				bufferWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				bufferWrite.pBufferInfo = bufferInfo;
+
+				writes.push_back(bufferWrite);
+			}
+			break;
 		case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
 			image = graphicsObject->GetImage(binding.binding);
 
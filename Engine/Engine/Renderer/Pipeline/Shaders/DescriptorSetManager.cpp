@@ -54,11 +54,15 @@ void DescriptorSetManager::CreateDescriptorSetPool(unsigned int poolSize, const
 	imagePoolSizeStruct.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 	imagePoolSizeStruct.descriptorCount = poolSize;
 
-	std::vector<VkDescriptorPoolSize> sizes = {uniformPoolSizeStruct, imagePoolSizeStruct};
+	VkDescriptorPoolSize storagePoolSizeStruct = {};
+	storagePoolSizeStruct.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	storagePoolSizeStruct.descriptorCount = poolSize;
+
+	std::vector<VkDescriptorPoolSize> sizes = {uniformPoolSizeStruct, imagePoolSizeStruct, storagePoolSizeStruct};
 
 	VkDescriptorPoolCreateInfo createInfo = {};
 	createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-	createInfo.poolSizeCount = 2;
+	createInfo.poolSizeCount = static_cast<unsigned int>(sizes.size());
 	createInfo.pPoolSizes = sizes.data();
 	createInfo.maxSets = poolSize;
 
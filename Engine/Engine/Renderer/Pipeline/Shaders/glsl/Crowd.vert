@@ -0,0 +1,91 @@
+#version 460
+
+layout(binding = 0) uniform CrowdUniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 projection;
+    float time;
+    uint jointCount;
+    uint clipCount;
+    float padding;
+} ubo;
+
+// Three rows per joint per frame, the affine part of each skinning matrix.
+layout(std430, binding = 2) readonly buffer JointMatrices {
+    vec4 rows[];
+} jointMatrices;
+
+struct ClipRange {
+    uint firstFrame;
+    uint frameCount;
+    float duration;
+    uint looping;
+};
+
+layout(std430, binding = 3) readonly buffer Clips {
+    ClipRange ranges[];
+} clips;
+
+struct Instance {
+    mat4 transform;
+    uint clip;
+    float timeOffset;
+    float speed;
+    float padding;
+};
+
+layout(std430, binding = 4) readonly buffer Instances {
+    Instance instances[];
+} crowd;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inUV;
+layout(location = 3) in vec4 inWeights;
+layout(location = 4) in ivec4 inJoints;
+
+layout(location = 0) out vec3 fragNormal;
+layout(location = 1) out vec2 fragUVCoord;
+
+mat4 JointMatrix(uint frame, int joint)
+{
+    uint row = (frame * ubo.jointCount + uint(joint)) * 3;
+    return transpose(mat4(jointMatrices.rows[row], jointMatrices.rows[row + 1], jointMatrices.rows[row + 2], vec4(0.0, 0.0, 0.0, 1.0)));
+}
+
+mat4 SkinMatrix(uint frame, float weight)
+{
+    return JointMatrix(frame, inJoints.x) * inWeights.x * weight +
+        JointMatrix(frame, inJoints.y) * inWeights.y * weight +
+        JointMatrix(frame, inJoints.z) * inWeights.z * weight +
+        JointMatrix(frame, inJoints.w) * inWeights.w * weight;
+}
+
+void main(void) 
+{
+    Instance instance = crowd.instances[gl_InstanceIndex];
+    ClipRange range = clips.ranges[min(instance.clip, ubo.clipCount - 1)];
+
+    float time = ubo.time * instance.speed + instance.timeOffset;
+    if (range.looping != 0)
+    {
+        time = mod(time, max(range.duration, 0.0001));
+    }
+    else
+    {
+        time = clamp(time, 0.0, range.duration);
+    }
+
+    // Frames are spread evenly from the start to the end of the clip, the two around time are blended.
+    float frame = (range.duration > 0.0) ? time / range.duration * float(range.frameCount - 1) : 0.0;
+    uint previousFrame = min(uint(frame), range.frameCount - 1);
+    uint nextFrame = min(previousFrame + 1, range.frameCount - 1);
+    float t = frame - float(previousFrame);
+
+    mat4 skin = SkinMatrix(range.firstFrame + previousFrame, 1.0 - t) + SkinMatrix(range.firstFrame + nextFrame, t);
+
+    mat4 world = ubo.model * instance.transform * skin;
+    gl_Position = ubo.projection * ubo.view * world * vec4(inPosition, 1.0);
+    fragNormal = vec3(world * vec4(inNormal, 0.0f));
+    fragUVCoord = inUV;
+}
@@ -0,0 +1,16 @@
+#version 460
+
+layout(push_constant) uniform DebugLinePushConstants {
+    mat4 viewProjection;
+} pc;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 fragColor;
+
+void main(void) 
+{
+    gl_Position = pc.viewProjection * vec4(inPosition, 1.0);
+    fragColor = inColor;
+}
\ No newline at end of file
@@ -15,6 +15,19 @@ VertexInputPipelineState::VertexInputPipelineState()
 	createInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 }
 
+VertexInputPipelineState::VertexInputPipelineState(const VkVertexInputBindingDescription& binding, const std::vector<VkVertexInputAttributeDescription>& attributes) :
+	bindingDescription(binding),
+	attributeDescriptions(attributes)
+{
+	createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+	createInfo.vertexBindingDescriptionCount = 1;
+	createInfo.pVertexBindingDescriptions = &bindingDescription;
+
+	createInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+	createInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+}
+
 VertexInputPipelineState::~VertexInputPipelineState()
 {
 }
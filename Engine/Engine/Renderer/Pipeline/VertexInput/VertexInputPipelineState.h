@@ -3,6 +3,8 @@
 
 #include <vulkan/vulkan.h>
 
+#include <vector>
+
 class VertexInputPipelineState
 {
 
@@ -10,6 +12,9 @@ public:
 
 	VertexInputPipelineState();
 
+	// For pipelines whose vertices are not Vertex. The descriptions are copied.
+	VertexInputPipelineState(const VkVertexInputBindingDescription& binding, const std::vector<VkVertexInputAttributeDescription>& attributes);
+
 	~VertexInputPipelineState();
 
 	const VkPipelineVertexInputStateCreateInfo& operator*() const;
@@ -25,6 +30,10 @@ private:
 	VertexInputPipelineState& operator=(const VertexInputPipelineState&&) = delete;
 
 	VkPipelineVertexInputStateCreateInfo createInfo{};
+
+	VkVertexInputBindingDescription bindingDescription{};
+
+	std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
 };
 
 #endif // VERTEX_INPUT_PIPELINE_STATE_H
\ No newline at end of file
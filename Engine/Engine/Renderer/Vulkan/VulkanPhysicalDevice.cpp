@@ -201,6 +201,7 @@ void VulkanPhysicalDevice::CreateLogicalDevice()
 	deviceFeatures.samplerAnisotropy = VK_TRUE;
 	deviceFeatures.fillModeNonSolid = VK_TRUE;
 	deviceFeatures.wideLines = VK_TRUE;
+	deviceFeatures.textureCompressionBC = features.textureCompressionBC;
 
 	const char* extensions[] = {"VK_KHR_swapchain"};
 
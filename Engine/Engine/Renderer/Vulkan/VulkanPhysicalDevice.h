@@ -43,6 +43,8 @@ public:
 
 	const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const { return memoryProperties; };
 
+	const VkPhysicalDeviceFeatures& GetFeatures() const { return features; };
+
 	void GetDisplayProperties();
 
 	bool FindPresentationQueueFamily(const VkSurfaceKHR& surface);
@@ -37,8 +37,11 @@
 #include "../Memory/MemoryManager.h"
 #include "../../Time/TimeManager.h"
 #include "../Images/TextureManager.h"
+#include "../AssetHotReloader.h"
+#include "../DebugDraw/DebugDraw.h"
 #include "../../Input/InputManager.h"
 #include "../../UI/UserInterfaceManager.h"
+#include "../../Animation/PoseCache.h"
 #include "../../UI/Editor/Editor.h"
 #include "../../Engine.h"
 
@@ -75,8 +78,11 @@ Window::~Window()
 
 	CleanupSwapchain();
 	
+	AssetHotReloader::Terminate();
 	UserInterfaceManager::Terminate();
+	DebugDraw::Terminate();
 	GraphicsObjectManager::Terminate();
+	PoseCache::Terminate();
 	TextureManager::Terminate();
 	MemoryManager::Terminate();
 
@@ -131,7 +137,10 @@ void Window::Initialize()
 		viewportPipelineState = new ViewportPipelineState(*this);
 		TextureManager::Initialize();
 		GraphicsObjectManager::Initialize(*this);
+		DebugDraw::Initialize(*this);
+		PoseCache::Initialize();
 		UserInterfaceManager::Initialize();
+		AssetHotReloader::Initialize();
 
 		firstWindow = false;
 	}
@@ -697,9 +706,15 @@ void Window::RecordCommands(int imageIndex)
 
 	vkCmdBeginRenderPass(buffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
+	// The in flight fence was waited on in Draw, so reloaded assets can replace the ones the last frame used and evicted
+	// ones can be freed.
+	AssetHotReloader::Update();
+	ModelManager::DeleteEvictedModels();
+	TextureManager::DeleteEvictedTextures();
 	GraphicsObjectManager::ExecutePendingCommands();
 	GraphicsObjectManager::UpdateObjects();
 	GraphicsObjectManager::DrawObjects(buffer, imageIndex);
+	DebugDraw::Draw(buffer);
 	
 	vkCmdEndRenderPass(buffer);
 
@@ -0,0 +1,55 @@
+#include "InterpolatedTransform.h"
+
+#include "Simulation.h"
+
+#include <algorithm>
+
+InterpolatedTransform::InterpolatedTransform(const Math::Transform& initial) :
+	previous(initial),
+	latest(initial),
+	latestTime(0.0)
+{
+}
+
+InterpolatedTransform::~InterpolatedTransform()
+{
+}
+
+void InterpolatedTransform::Publish(const Math::Transform& state)
+{
+	const double stepTime = Simulation::GetStepTime();
+
+	std::lock_guard<std::mutex> guard(stateMutex);
+	previous = latest;
+	latest = state;
+	latestTime = stepTime;
+}
+
+void InterpolatedTransform::Reset(const Math::Transform& state)
+{
+	std::lock_guard<std::mutex> guard(stateMutex);
+	previous = state;
+	latest = state;
+}
+
+Math::Transform InterpolatedTransform::Get(double time) const
+{
+	const double stepSeconds = Simulation::GetStepSeconds();
+
+	std::lock_guard<std::mutex> guard(stateMutex);
+
+	const float alpha = (stepSeconds > 0.0) ? static_cast<float>(std::clamp((time - latestTime) / stepSeconds, 0.0, 1.0)) : 1.0f;
+
+	return Math::Transform::Mix(previous, latest, alpha);
+}
+
+glm::mat4 InterpolatedTransform::GetMatrix(double time) const
+{
+	return Get(time).ToMat4();
+}
+
+Math::Transform InterpolatedTransform::GetLatest() const
+{
+	std::lock_guard<std::mutex> guard(stateMutex);
+	return latest;
+}
@@ -0,0 +1,55 @@
+#ifndef INTERPOLATEDTRANSFORM_H
+#define INTERPOLATEDTRANSFORM_H
+
+#include "../Math/Transform.h"
+
+#include <mutex>
+
+// The last two states of something the simulation moves. The simulation publishes a state at the end of each step and
+// the renderer draws a mix of the two, so motion is smooth at any frame rate while the simulation runs at a fixed one.
+class InterpolatedTransform
+{
+
+public:
+
+	InterpolatedTransform(const Math::Transform& initial = Math::Transform());
+
+	~InterpolatedTransform();
+
+	InterpolatedTransform(const InterpolatedTransform&) = delete;
+
+	InterpolatedTransform& operator=(const InterpolatedTransform&) = delete;
+
+	InterpolatedTransform(InterpolatedTransform&&) = delete;
+
+	InterpolatedTransform& operator=(InterpolatedTransform&&) = delete;
+
+	// The state the step ended in, the previous one becomes the one interpolated from. Called from a step callback, the
+	// state is stamped with the time that step simulates up to, so how far to interpolate never depends on whether the
+	// rest of the step has finished.
+	void Publish(const Math::Transform& state);
+
+	// Sets both states, for teleports that should not be drawn sliding across the world.
+	void Reset(const Math::Transform& state);
+
+	// The state to draw at time, in seconds since the TimeManager started. Drawing runs a step behind, the previous state
+	// is shown at the latest one's time and the latest a step later.
+	Math::Transform Get(double time) const;
+
+	glm::mat4 GetMatrix(double time) const;
+
+	Math::Transform GetLatest() const;
+
+private:
+
+	mutable std::mutex stateMutex;
+
+	Math::Transform previous;
+
+	Math::Transform latest;
+
+	double latestTime;
+
+};
+
+#endif // INTERPOLATEDTRANSFORM_H
@@ -0,0 +1,230 @@
+#include "Simulation.h"
+
+#include "InterpolatedTransform.h"
+#include "../Time/TimeManager.h"
+#include "../Renderer/GraphicsObjects/3DTransformable.h"
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+
+Simulation* Simulation::instance = nullptr;
+
+std::mutex Simulation::instanceMutex = std::mutex();
+
+void Simulation::Initialize(float stepsPerSecond)
+{
+	std::lock_guard<std::mutex> guard(instanceMutex);
+
+	if (instance == nullptr)
+	{
+		instance = new Simulation(stepsPerSecond);
+		Logger::Log(std::string("Initialized Simulation"), Logger::Category::Success);
+	}
+	else
+	{
+		Logger::Log(std::string("Calling Simulation::Initialize() before Simulation::Terminate()."), Logger::Category::Warning);
+	}
+}
+
+void Simulation::Terminate()
+{
+	std::lock_guard<std::mutex> guard(instanceMutex);
+
+	if (instance != nullptr)
+	{
+		delete instance;
+		instance = nullptr;
+		Logger::Log(std::string("Terminated Simulation"), Logger::Category::Success);
+	}
+	else
+	{
+		Logger::Log(std::string("Calling Simulation::Terminate() before Simulation::Initialize()"), Logger::Category::Warning);
+	}
+}
+
+bool Simulation::Operating()
+{
+	return instance != nullptr;
+}
+
+void Simulation::RegisterStepCallback(std::function<void(float stepSeconds)>* const callback, const std::string& name)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling Simulation::RegisterStepCallback before Simulation::Initialize"), Logger::Category::Warning);
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->stepMutex);
+
+	for (std::pair<std::string, std::function<void(float)>*>& stepCallback : instance->stepCallbacks)
+	{
+		if (stepCallback.first == name)
+		{
+			stepCallback.second = callback;
+			return;
+		}
+	}
+
+	instance->stepCallbacks.push_back(std::make_pair(name, callback));
+}
+
+void Simulation::DeregisterStepCallback(const std::string& name)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling Simulation::DeregisterStepCallback before Simulation::Initialize"), Logger::Category::Warning);
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->stepMutex);
+
+	std::vector<std::pair<std::string, std::function<void(float)>*>>& stepCallbacks = instance->stepCallbacks;
+
+	stepCallbacks.erase(std::remove_if(stepCallbacks.begin(), stepCallbacks.end(), [&name](const std::pair<std::string, std::function<void(float)>*>& stepCallback)
+	{
+		return stepCallback.first == name;
+	}), stepCallbacks.end());
+}
+
+void Simulation::RunBetweenSteps(const std::function<void()>& function)
+{
+	if (instance == nullptr)
+	{
+		function();
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->stepMutex);
+	function();
+}
+
+void Simulation::Follow(Graphics3DTransformable* const graphics, const InterpolatedTransform* const transform)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling Simulation::Follow before Simulation::Initialize"), Logger::Category::Warning);
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->followMutex);
+	instance->followed[graphics] = transform;
+}
+
+void Simulation::Unfollow(Graphics3DTransformable* const graphics)
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->followMutex);
+	instance->followed.erase(graphics);
+}
+
+void Simulation::Interpolate()
+{
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	const double now = TimeManager::PreciseSecondsSinceStart();
+
+	std::lock_guard<std::mutex> guard(instance->followMutex);
+
+	for (const std::pair<Graphics3DTransformable* const, const InterpolatedTransform*>& follow : instance->followed)
+	{
+		follow.first->SetTransform(follow.second->GetMatrix(now));
+	}
+}
+
+float Simulation::GetStepSeconds()
+{
+	if (instance != nullptr)
+	{
+		return instance->stepSeconds;
+	}
+
+	return 0.0f;
+}
+
+unsigned long long Simulation::GetStepCount()
+{
+	if (instance != nullptr)
+	{
+		return instance->stepCount.load();
+	}
+
+	return 0ULL;
+}
+
+double Simulation::GetStepTime()
+{
+	if (instance != nullptr)
+	{
+		return instance->stepTime.load();
+	}
+
+	return 0.0;
+}
+
+Simulation::Simulation(float stepsPerSecond) :
+	stepSeconds(1.0f / stepsPerSecond),
+	stepCount(0ULL),
+	stepTime(TimeManager::PreciseSecondsSinceStart()),
+	running(true)
+{
+	thread = std::thread(&Simulation::Run, this);
+}
+
+Simulation::~Simulation()
+{
+	running = false;
+
+	if (thread.joinable())
+	{
+		thread.join();
+	}
+}
+
+void Simulation::Run()
+{
+	double previousTime = TimeManager::PreciseSecondsSinceStart();
+	double accumulator = 0.0;
+
+	while (running)
+	{
+		const double now = TimeManager::PreciseSecondsSinceStart();
+		accumulator = std::min(accumulator + (now - previousTime), static_cast<double>(stepSeconds) * maxCatchUpSteps);
+		previousTime = now;
+
+		// Each step is stamped with the time it simulates up to, time dropped by the catch up limit is skipped over.
+		double time = now - accumulator;
+
+		while (accumulator >= stepSeconds)
+		{
+			time += stepSeconds;
+			Step(time);
+			accumulator -= stepSeconds;
+		}
+
+		// Sleeping can overshoot by a few milliseconds, the accumulator makes up for it on the next pass.
+		std::this_thread::sleep_for(std::chrono::duration<double>(stepSeconds - accumulator));
+	}
+}
+
+void Simulation::Step(double time)
+{
+	std::lock_guard<std::mutex> guard(stepMutex);
+
+	stepTime = time;
+
+	for (const std::pair<std::string, std::function<void(float)>*>& stepCallback : stepCallbacks)
+	{
+		(*stepCallback.second)(stepSeconds);
+	}
+
+	stepCount++;
+}
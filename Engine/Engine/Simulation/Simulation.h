@@ -0,0 +1,103 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+
+class InterpolatedTransform;
+class Graphics3DTransformable;
+
+// Steps collision and gameplay physics at a fixed rate on a thread of its own. Time from the TimeManager fills an
+// accumulator that is drained one fixed step at a time, so the results of a step never depend on the frame rate and
+// its cost is paid once per step rather than once per frame. The renderer draws what the simulation moves a step
+// behind, interpolated between the last two steps.
+class Simulation
+{
+
+public:
+
+	static void Initialize(float stepsPerSecond = 60.0f);
+
+	static void Terminate();
+
+	static bool Operating();
+
+	// Called on the simulation thread once per step with the step's length, in the order they were registered. Both must
+	// not be called from inside a step callback.
+	static void RegisterStepCallback(std::function<void(float stepSeconds)>* const callback, const std::string& name);
+
+	static void DeregisterStepCallback(const std::string& name);
+
+	// Runs function on the calling thread while no step is running, for replacing data step callbacks read. Must not be
+	// called from inside a step callback.
+	static void RunBetweenSteps(const std::function<void()>& function);
+
+	// Draws graphics where transform is interpolated to, until it is unfollowed. The transform of a followed object belongs to
+	// the simulation, and it must be unfollowed before either is deleted.
+	static void Follow(Graphics3DTransformable* const graphics, const InterpolatedTransform* const transform);
+
+	static void Unfollow(Graphics3DTransformable* const graphics);
+
+	// Moves the followed graphics for the frame about to be drawn. Called by the engine on the render thread.
+	static void Interpolate();
+
+	static float GetStepSeconds();
+
+	static unsigned long long GetStepCount();
+
+	// The time the step being run simulates up to, in seconds since the TimeManager started. For step callbacks.
+	static double GetStepTime();
+
+private:
+
+	Simulation(float stepsPerSecond);
+
+	~Simulation();
+
+	Simulation(const Simulation&) = delete;
+
+	Simulation& operator=(const Simulation&) = delete;
+
+	Simulation(Simulation&&) = delete;
+
+	Simulation& operator=(Simulation&&) = delete;
+
+	void Run();
+
+	void Step(double time);
+
+	static Simulation* instance;
+
+	static std::mutex instanceMutex;
+
+	// After a stall, a breakpoint or a step slower than real time the backlog is dropped past this many steps, rather than
+	// taking longer to step than the time it covers.
+	static const unsigned int maxCatchUpSteps = 5;
+
+	const float stepSeconds;
+
+	std::vector<std::pair<std::string, std::function<void(float)>*>> stepCallbacks;
+
+	std::mutex stepMutex;
+
+	std::unordered_map<Graphics3DTransformable*, const InterpolatedTransform*> followed;
+
+	std::mutex followMutex;
+
+	std::atomic<unsigned long long> stepCount;
+
+	// The time the current or last step simulates up to, in seconds since the TimeManager started.
+	std::atomic<double> stepTime;
+
+	std::atomic<bool> running;
+
+	std::thread thread;
+
+};
+
+#endif // SIMULATION_H
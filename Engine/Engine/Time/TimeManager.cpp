@@ -45,6 +45,20 @@ float TimeManager::SecondsSinceStart()
 	return 0.0f;
 }
 
+double TimeManager::PreciseSecondsSinceStart()
+{
+	if (instance != nullptr)
+	{
+		return std::chrono::duration<double, std::chrono::seconds::period>(std::chrono::high_resolution_clock::now() - instance->startTime).count();
+	}
+	else
+	{
+		Logger::Log(std::string("Calling TimeManager::PreciseSecondsSinceStart() before TimeManager::Initialize()"), Logger::Category::Warning);
+	}
+
+	return 0.0;
+}
+
 float TimeManager::DeltaTime()
 {
 	if (instance != nullptr)
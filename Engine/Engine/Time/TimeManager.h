@@ -14,6 +14,9 @@ public:
 
 	static float SecondsSinceStart();
 
+	// For accumulating time over a long run, a float of seconds loses milliseconds after a few hours.
+	static double PreciseSecondsSinceStart();
+
 	static float DeltaTime();
 
 	static void RecordUpdateTime();
@@ -0,0 +1,397 @@
+#include "Font.h"
+
+#include "../Utils/Logger.h"
+#include "../Renderer/Model/Vertex.h"
+#include "../Renderer/Images/TextureManager.h"
+
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <cstring>
+#include <cmath>
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb_image/stb-master/stb_truetype.h>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image/stb-master/stb_image_write.h>
+
+namespace
+{
+	const uint32_t fontCacheMagic = 0x544E4F46; // "FONT"
+	const uint32_t fontCacheVersion = 1;
+
+	struct FontCacheHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		float pixelHeight;
+		uint32_t signedDistanceField;
+		float ascent;
+		float descent;
+		float lineGap;
+		uint32_t atlasWidth;
+		uint32_t atlasHeight;
+		uint32_t glyphCount;
+	};
+
+	uint32_t NextPowerOfTwo(uint32_t value)
+	{
+		uint32_t result = 1;
+		while (result < value)
+		{
+			result <<= 1;
+		}
+		return result;
+	}
+}
+
+Font::Font(const std::string& fontName, const std::string& fontFilePath, float height, bool sdf) :
+	name(fontName),
+	pixelHeight(height),
+	signedDistanceField(sdf),
+	loaded(false),
+	ascent(0.0f),
+	descent(0.0f),
+	lineGap(0.0f),
+	atlasWidth(0),
+	atlasHeight(0),
+	glyphs(std::vector<Glyph>()),
+	texture()
+{
+	const std::string cacheBase = fontFilePath + "." + std::to_string(static_cast<int>(pixelHeight)) + (signedDistanceField ? ".sdf" : "");
+	const std::string cachePath = cacheBase + ".glyphs";
+	const std::string atlasPath = cacheBase + ".png";
+
+	std::error_code error;
+	const bool sourceExists = std::filesystem::exists(fontFilePath, error);
+	const bool cacheExists = std::filesystem::exists(cachePath, error) && std::filesystem::exists(atlasPath, error);
+	const bool cacheIsCurrent = cacheExists && (!sourceExists || std::filesystem::last_write_time(cachePath, error) >= std::filesystem::last_write_time(fontFilePath, error));
+
+	if (!cacheIsCurrent || !ReadCache(cachePath))
+	{
+		if (!sourceExists)
+		{
+			Logger::Log(std::string("Failed to load font ") + name + ". The file " + fontFilePath + " does not exist.", Logger::Category::Error);
+			return;
+		}
+
+		std::vector<unsigned char> atlasPixels;
+		if (!Rasterize(fontFilePath, atlasPixels))
+		{
+			Logger::Log(std::string("Failed to rasterize font ") + fontFilePath, Logger::Category::Error);
+			return;
+		}
+
+		if (stbi_write_png(atlasPath.c_str(), static_cast<int>(atlasWidth), static_cast<int>(atlasHeight), 4, atlasPixels.data(), static_cast<int>(atlasWidth * 4)) == 0 ||
+			!WriteCache(cachePath))
+		{
+			Logger::Log(std::string("Failed to write the font cache for ") + fontFilePath, Logger::Category::Error);
+			return;
+		}
+	}
+
+	const std::string textureName = std::string("Font_") + name;
+	// The atlas stays uncompressed, block compression blurs the glyph edges. A font of the same name may have loaded it
+	// already, then it is shared.
+	TextureManager::LoadTexture(atlasPath, textureName, false);
+	texture = TextureManager::AcquireTexture(textureName);
+
+	loaded = static_cast<bool>(texture);
+
+	if (loaded)
+	{
+		Logger::Log(std::string("Loaded font ") + name + " from " + fontFilePath, Logger::Category::Success);
+	}
+}
+
+Font::~Font()
+{
+}
+
+bool Font::IsLoaded() const
+{
+	return loaded;
+}
+
+const std::string& Font::GetName() const
+{
+	return name;
+}
+
+float Font::GetPixelHeight() const
+{
+	return pixelHeight;
+}
+
+bool Font::IsSignedDistanceField() const
+{
+	return signedDistanceField;
+}
+
+const Font::Glyph* const Font::GetGlyph(char character) const
+{
+	const uint32_t index = static_cast<uint32_t>(static_cast<unsigned char>(character)) - firstCharacter;
+
+	if (!loaded || index >= characterCount)
+	{
+		return nullptr;
+	}
+
+	return &glyphs[index];
+}
+
+Texture* const Font::GetTexture() const
+{
+	return texture.Get();
+}
+
+bool Font::GetGlyphQuad(char character, const glm::vec2& offset, Vertex* const quad) const
+{
+	const Glyph* const glyph = GetGlyph(character);
+
+	if (glyph == nullptr)
+	{
+		return false;
+	}
+
+	const float unitsPerPixel = 0.9f / (ascent - descent);
+	const float baseline = 0.15f;
+
+	const float left = offset.x + (static_cast<float>(glyph->xOffset) - glyph->advance * 0.5f) * unitsPerPixel;
+	const float right = left + static_cast<float>(glyph->width) * unitsPerPixel;
+	const float top = offset.y + baseline + static_cast<float>(glyph->yOffset) * unitsPerPixel;
+	const float bottom = top + static_cast<float>(glyph->height) * unitsPerPixel;
+
+	const float u0 = static_cast<float>(glyph->x) / static_cast<float>(atlasWidth);
+	const float v0 = static_cast<float>(glyph->y) / static_cast<float>(atlasHeight);
+	const float u1 = static_cast<float>(glyph->x + glyph->width) / static_cast<float>(atlasWidth);
+	const float v1 = static_cast<float>(glyph->y + glyph->height) / static_cast<float>(atlasHeight);
+
+	quad[0] = Vertex(glm::vec3(left, top, 0.2f), glm::vec3(1.0f, 1.0f, 1.0f), glm::vec2(u0, v0));
+	quad[1] = Vertex(glm::vec3(right, top, 0.2f), glm::vec3(1.0f, 1.0f, 1.0f), glm::vec2(u1, v0));
+	quad[2] = Vertex(glm::vec3(right, bottom, 0.2f), glm::vec3(1.0f, 1.0f, 1.0f), glm::vec2(u1, v1));
+	quad[3] = Vertex(glm::vec3(left, bottom, 0.2f), glm::vec3(1.0f, 1.0f, 1.0f), glm::vec2(u0, v1));
+
+	return true;
+}
+
+uint32_t Font::GetAtlasWidth() const
+{
+	return atlasWidth;
+}
+
+uint32_t Font::GetAtlasHeight() const
+{
+	return atlasHeight;
+}
+
+float Font::GetAscent() const
+{
+	return ascent;
+}
+
+float Font::GetDescent() const
+{
+	return descent;
+}
+
+float Font::GetLineGap() const
+{
+	return lineGap;
+}
+
+bool Font::ReadCache(const std::string& cachePath)
+{
+	std::ifstream file(cachePath, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	FontCacheHeader header = {};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+	if (!file || header.magic != fontCacheMagic || header.version != fontCacheVersion || header.glyphCount != characterCount ||
+		header.pixelHeight != pixelHeight || (header.signedDistanceField != 0) != signedDistanceField)
+	{
+		return false;
+	}
+
+	std::vector<Glyph> cachedGlyphs(header.glyphCount);
+	file.read(reinterpret_cast<char*>(cachedGlyphs.data()), cachedGlyphs.size() * sizeof(Glyph));
+
+	if (!file)
+	{
+		return false;
+	}
+
+	ascent = header.ascent;
+	descent = header.descent;
+	lineGap = header.lineGap;
+	atlasWidth = header.atlasWidth;
+	atlasHeight = header.atlasHeight;
+	glyphs = std::move(cachedGlyphs);
+
+	return true;
+}
+
+bool Font::WriteCache(const std::string& cachePath) const
+{
+	std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	FontCacheHeader header = { fontCacheMagic, fontCacheVersion, pixelHeight, signedDistanceField ? 1U : 0U, ascent, descent, lineGap, atlasWidth, atlasHeight, static_cast<uint32_t>(glyphs.size()) };
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(glyphs.data()), glyphs.size() * sizeof(Glyph));
+
+	return static_cast<bool>(file);
+}
+
+bool Font::Rasterize(const std::string& fontFilePath, std::vector<unsigned char>& atlasPixels)
+{
+	std::ifstream file(fontFilePath, std::ios::binary);
+	std::vector<unsigned char> fontData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	stbtt_fontinfo info;
+	if (fontData.empty() || !stbtt_InitFont(&info, fontData.data(), stbtt_GetFontOffsetForIndex(fontData.data(), 0)))
+	{
+		return false;
+	}
+
+	const float scale = stbtt_ScaleForPixelHeight(&info, pixelHeight);
+
+	int fontAscent = 0;
+	int fontDescent = 0;
+	int fontLineGap = 0;
+	stbtt_GetFontVMetrics(&info, &fontAscent, &fontDescent, &fontLineGap);
+
+	ascent = static_cast<float>(fontAscent) * scale;
+	descent = static_cast<float>(fontDescent) * scale;
+	lineGap = static_cast<float>(fontLineGap) * scale;
+
+	// Distance fields need room outside the outline to fall off in.
+	const int padding = signedDistanceField ? 4 : 0;
+
+	struct GlyphBitmap
+	{
+		std::vector<unsigned char> pixels;
+		int width = 0;
+		int height = 0;
+		int xOffset = 0;
+		int yOffset = 0;
+		float advance = 0.0f;
+	};
+
+	std::vector<GlyphBitmap> bitmaps(characterCount);
+	std::vector<uint32_t> order(characterCount);
+	std::iota(order.begin(), order.end(), 0U);
+
+	std::for_each(std::execution::par, order.begin(), order.end(), [&](uint32_t index)
+		{
+			const int codepoint = static_cast<int>(index + firstCharacter);
+			GlyphBitmap& bitmap = bitmaps[index];
+
+			int advance = 0;
+			int leftSideBearing = 0;
+			stbtt_GetCodepointHMetrics(&info, codepoint, &advance, &leftSideBearing);
+			bitmap.advance = static_cast<float>(advance) * scale;
+
+			unsigned char* pixels = nullptr;
+			if (signedDistanceField)
+			{
+				pixels = stbtt_GetCodepointSDF(&info, scale, codepoint, padding, 128, 128.0f / static_cast<float>(padding), &bitmap.width, &bitmap.height, &bitmap.xOffset, &bitmap.yOffset);
+			}
+			else
+			{
+				pixels = stbtt_GetCodepointBitmap(&info, scale, scale, codepoint, &bitmap.width, &bitmap.height, &bitmap.xOffset, &bitmap.yOffset);
+			}
+
+			if (pixels != nullptr)
+			{
+				bitmap.pixels.assign(pixels, pixels + static_cast<size_t>(bitmap.width) * bitmap.height);
+				signedDistanceField ? stbtt_FreeSDF(pixels, nullptr) : stbtt_FreeBitmap(pixels, nullptr);
+			}
+			else
+			{
+				bitmap.width = bitmap.height = 0;
+			}
+		});
+
+	// Shelf pack the tallest glyphs first, with a one pixel gap so filtering does not bleed between neighbours.
+	const uint32_t gap = 1;
+
+	size_t area = 0;
+	for (const GlyphBitmap& bitmap : bitmaps)
+	{
+		area += static_cast<size_t>(bitmap.width + gap) * (bitmap.height + gap);
+	}
+
+	atlasWidth = std::max(64U, NextPowerOfTwo(static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(area) * 1.2)))));
+
+	std::sort(order.begin(), order.end(), [&bitmaps](uint32_t a, uint32_t b) { return bitmaps[a].height > bitmaps[b].height; });
+
+	glyphs.assign(characterCount, Glyph());
+
+	uint32_t penX = gap;
+	uint32_t penY = gap;
+	uint32_t shelfHeight = 0;
+
+	for (uint32_t index : order)
+	{
+		const GlyphBitmap& bitmap = bitmaps[index];
+
+		if (penX + bitmap.width + gap > atlasWidth)
+		{
+			penX = gap;
+			penY += shelfHeight + gap;
+			shelfHeight = 0;
+		}
+
+		Glyph& glyph = glyphs[index];
+		glyph.x = static_cast<uint16_t>(penX);
+		glyph.y = static_cast<uint16_t>(penY);
+		glyph.width = static_cast<uint16_t>(bitmap.width);
+		glyph.height = static_cast<uint16_t>(bitmap.height);
+		glyph.xOffset = static_cast<int16_t>(bitmap.xOffset);
+		glyph.yOffset = static_cast<int16_t>(bitmap.yOffset);
+		glyph.advance = bitmap.advance;
+
+		penX += bitmap.width + gap;
+		shelfHeight = std::max(shelfHeight, static_cast<uint32_t>(bitmap.height));
+	}
+
+	atlasHeight = NextPowerOfTwo(penY + shelfHeight + gap);
+
+	// White glyphs with the coverage, or the distance, in alpha so the atlas works with the textured 2D pipeline.
+	atlasPixels.assign(static_cast<size_t>(atlasWidth) * atlasHeight * 4, 0);
+	for (size_t pixel = 0; pixel < atlasPixels.size(); pixel += 4)
+	{
+		atlasPixels[pixel] = atlasPixels[pixel + 1] = atlasPixels[pixel + 2] = 255;
+	}
+
+	for (uint32_t index = 0; index < characterCount; index++)
+	{
+		const GlyphBitmap& bitmap = bitmaps[index];
+		const Glyph& glyph = glyphs[index];
+
+		for (int row = 0; row < bitmap.height; row++)
+		{
+			for (int column = 0; column < bitmap.width; column++)
+			{
+				const size_t atlasPixel = (static_cast<size_t>(glyph.y + row) * atlasWidth + glyph.x + column) * 4;
+				atlasPixels[atlasPixel + 3] = bitmap.pixels[static_cast<size_t>(row) * bitmap.width + column];
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,117 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "../Renderer/Images/TextureManager.h"
+
+#include <glm/glm.hpp>
+
+class Texture;
+class Vertex;
+
+// A TrueType font rasterized once into a glyph atlas texture. The atlas and the glyph table are cached next to the font file.
+class Font
+{
+
+public:
+
+	// Printable ASCII is baked into the atlas.
+	static const uint32_t firstCharacter = 32;
+
+	static const uint32_t characterCount = 95;
+
+	struct Glyph
+	{
+		// Rectangle in the atlas, in pixels.
+		uint16_t x;
+
+		uint16_t y;
+
+		uint16_t width;
+
+		uint16_t height;
+
+		// Offset from the pen position on the baseline to the top left of the rectangle, y down.
+		int16_t xOffset;
+
+		int16_t yOffset;
+
+		float advance;
+	};
+
+	Font(const std::string& name, const std::string& fontFilePath, float pixelHeight, bool signedDistanceField = false);
+
+	~Font();
+
+	Font(const Font&) = delete;
+
+	Font& operator=(const Font&) = delete;
+
+	Font(Font&&) = delete;
+
+	Font& operator=(Font&&) = delete;
+
+	bool IsLoaded() const;
+
+	const std::string& GetName() const;
+
+	float GetPixelHeight() const;
+
+	bool IsSignedDistanceField() const;
+
+	// Returns nullptr for characters that are not in the atlas.
+	const Glyph* const GetGlyph(char character) const;
+
+	Texture* const GetTexture() const;
+
+	// Writes the four corners of the glyph's atlas rectangle to quad, moved by offset. Returns false for characters not in the atlas.
+	// Sized so the font's line height is 0.9 units, centered on x and with the baseline at y = 0.15, like the old glyph models.
+	bool GetGlyphQuad(char character, const glm::vec2& offset, Vertex* const quad) const;
+
+	uint32_t GetAtlasWidth() const;
+
+	uint32_t GetAtlasHeight() const;
+
+	float GetAscent() const;
+
+	float GetDescent() const;
+
+	float GetLineGap() const;
+
+private:
+
+	bool ReadCache(const std::string& cachePath);
+
+	bool WriteCache(const std::string& cachePath) const;
+
+	bool Rasterize(const std::string& fontFilePath, std::vector<unsigned char>& atlasPixels);
+
+	std::string name;
+
+	float pixelHeight;
+
+	bool signedDistanceField;
+
+	bool loaded;
+
+	float ascent;
+
+	float descent;
+
+	float lineGap;
+
+	uint32_t atlasWidth;
+
+	uint32_t atlasHeight;
+
+	std::vector<Glyph> glyphs;
+
+	// Held so the atlas is not evicted while the font is in use.
+	TextureHandle texture;
+
+};
+
+#endif // FONT_H
@@ -0,0 +1,100 @@
+#include "FontManager.h"
+
+#include "Font.h"
+#include "../Utils/Logger.h"
+
+FontManager* FontManager::instance = nullptr;
+
+const float FontManager::defaultPixelHeight = 48.0f;
+
+const std::string FontManager::fontDirectoryName = std::string("Assets/Fonts/");
+
+void FontManager::Initialize()
+{
+	if (instance == nullptr)
+	{
+		instance = new FontManager();
+	}
+	else
+	{
+		Logger::Log(std::string("Calling FontManager::Initialize() before FontManager::Terminate()."), Logger::Category::Warning);
+	}
+}
+
+void FontManager::Terminate()
+{
+	if (instance != nullptr)
+	{
+		delete instance;
+	}
+	else
+	{
+		Logger::Log(std::string("Calling FontManager::Terminate() before FontManager::Initialize()."), Logger::Category::Warning);
+	}
+}
+
+Font* const FontManager::LoadFont(const std::string& name, const std::string& fontFilePath, float pixelHeight, bool signedDistanceField)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling FontManager::LoadFont() before FontManager::Initialize()."), Logger::Category::Warning);
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->fontsMutex);
+
+	if (instance->fonts.find(name) != instance->fonts.end())
+	{
+		Logger::Log(std::string("A font with the name ") + name + " already exists. FontManager::LoadFont.", Logger::Category::Warning);
+		return nullptr;
+	}
+
+	return instance->AddFont(name, fontFilePath, pixelHeight, signedDistanceField);
+}
+
+Font* const FontManager::GetFont(const std::string& name)
+{
+	if (instance == nullptr)
+	{
+		Logger::Log(std::string("Calling FontManager::GetFont() before FontManager::Initialize()."), Logger::Category::Warning);
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> guard(instance->fontsMutex);
+
+	auto font = instance->fonts.find(name);
+	if (font != instance->fonts.end())
+	{
+		return font->second;
+	}
+
+	return instance->AddFont(name, fontDirectoryName + name + ".ttf", defaultPixelHeight, false);
+}
+
+Font* const FontManager::AddFont(const std::string& name, const std::string& fontFilePath, float pixelHeight, bool signedDistanceField)
+{
+	Font* font = new Font(name, fontFilePath, pixelHeight, signedDistanceField);
+
+	if (!font->IsLoaded())
+	{
+		delete font;
+		return nullptr;
+	}
+
+	return fonts[name] = font;
+}
+
+FontManager::FontManager() :
+	fonts(std::unordered_map<std::string, Font*>())
+{
+}
+
+FontManager::~FontManager()
+{
+	for (auto& font : fonts)
+	{
+		delete font.second;
+	}
+
+	instance = nullptr;
+}
@@ -0,0 +1,52 @@
+#ifndef FONTMANAGER_H
+#define FONTMANAGER_H
+
+#include <string>
+#include <unordered_map>
+#include <mutex>
+
+class Font;
+
+class FontManager
+{
+public:
+
+	static void Initialize();
+
+	static void Terminate();
+
+	// Rasterize, or read from the cache, a font under name. Returns nullptr if the name is in use or the font failed to load.
+	static Font* const LoadFont(const std::string& name, const std::string& fontFilePath, float pixelHeight = defaultPixelHeight, bool signedDistanceField = false);
+
+	// Fonts that were not loaded explicitly are loaded from Assets/Fonts/<name>.ttf the first time they are asked for.
+	static Font* const GetFont(const std::string& name);
+
+	static const float defaultPixelHeight;
+
+private:
+
+	FontManager();
+
+	~FontManager();
+
+	FontManager(const FontManager&) = delete;
+
+	FontManager& operator=(const FontManager&) = delete;
+
+	FontManager(FontManager&&) = delete;
+
+	FontManager& operator=(FontManager&&) = delete;
+
+	Font* const AddFont(const std::string& name, const std::string& fontFilePath, float pixelHeight, bool signedDistanceField);
+
+	static FontManager* instance;
+
+	static const std::string fontDirectoryName;
+
+	std::unordered_map<std::string, Font*> fonts;
+
+	std::mutex fontsMutex;
+
+};
+
+#endif // FONTMANAGER_H
@@ -1,85 +1,66 @@
 #include "Text.h"
 
 #include "UserInterfaceManager.h"
-#include "UserInterfaceItem.h"
-#include "../Renderer/Model/ModelManager.h"
-#include "../Renderer/Model/Model.h"
+#include "FontManager.h"
+#include "Font.h"
+#include "TextMesh.h"
+#include "../Renderer/GraphicsObjects/GraphicsObjectManager.h"
+#include "../Renderer/GraphicsObjects/TextGraphicsObject.h"
 #include "../Renderer/Images/TextureManager.h"
+#include "../Renderer/Model/Vertex.h"
 #include "../Utils/Logger.h"
 
-#include <filesystem>
-#include <unordered_map>
+#include <algorithm>
 
-std::vector<std::string> Text::fontDirectories = std::vector<std::string>({ "Assets/Models/Fonts/Default/" });
-std::unordered_set<std::string> Text::fontPrefixes = std::unordered_set<std::string>();
-
-void Text::LoadFonts()
+Text::Text(const std::string& initialText, const glm::vec2& initialPosition, float z, const float& initialSize, const std::string& initialFont, float spacingH, float spacingV) :
+	position(initialPosition),
+	horizontalSpacing(spacingH),
+	verticalSpacing(spacingV),
+	size(initialSize),
+	zOrder(z),
+	fontName(initialFont),
+	font(nullptr),
+	characters(),
+	mesh(std::make_shared<TextMesh>()),
+	graphicsObject(nullptr),
+	visibility(UserInterfaceItem::Visibility::Visible),
+	graphicsObjectReadyCallbacks(std::list<std::function<void()>>())
 {
-	for (const std::string& fontDirectory : fontDirectories)
-	{
-		std::string directoryName = "";
+	if ((font = FontManager::GetFont(fontName)) == nullptr && fontName != "Default")
+		font = FontManager::GetFont(fontName = "Default");
 
-		for (unsigned int i = static_cast<unsigned int>(fontDirectory.size() - size_t(2)); i > 0; i--)
-		{
-			if (fontDirectory[i] == '/')
-			{
-				break;
-			}
-
-			directoryName = fontDirectory[i] + directoryName;
-		}
+	if (font == nullptr)
+		Logger::Log(std::string("No fonts available for Text instance."), Logger::Category::Error);
 
-		fontPrefixes.insert(directoryName);
+	std::function<void(TextGraphicsObject*)> graphicsObjectCreationCallback = [this](TextGraphicsObject* obj)
+	{
+		float width = UserInterfaceManager::GetWindowWidth();
+		float height = UserInterfaceManager::GetWindowHeight();
 
-		for (auto& dirEntry : std::filesystem::directory_iterator(fontDirectory))
-		{
-			if (dirEntry.path().extension().string() == ".gltf")
-			{
-				std::string modelFilePath = directoryName + dirEntry.path().filename().string();
-				std::string newCharacterModelName(modelFilePath.replace(modelFilePath.begin() + modelFilePath.size() - 5, modelFilePath.end(), ""));
+		obj->Translate({ (position.x > 0) ? glm::min(position.x, width) : 0.0f, (position.y > 0) ? glm::min(position.y, height) : 0.0f , 0.0f });
+		obj->Scale(glm::vec3(size, size, 0.0f));
+		obj->SetZOrder(zOrder);
 
-				Model* loadedModel = ModelManager::LoadModel(newCharacterModelName, dirEntry.path().string());
+		std::lock_guard<std::mutex> guard(graphicsObjectReadyMutex);
 
-				loadedModel->FlipTriangleWindingOrder();
+		graphicsObject = obj;
 
-				if (loadedModel != nullptr)
-				{
-					loadedModel->SetZforAllVerts(0.2f);
-				}
-			}
+		for (std::function<void()>& callback : graphicsObjectReadyCallbacks)
+		{
+			callback();
 		}
-	}
-}
 
-Text::Text(const std::string& initialText, const glm::vec2& initialPosition, float zOrder, const float& initialSize, const std::string& initialFont, float spacingH, float spacingV) :
-	position(initialPosition),
-	cursor(glm::vec2(position.x, position.y)),
-	horizontalSpacing(spacingH),
-	verticalSpacing(spacingV),
-	size(initialSize),
-	fontName("Default"),
-	characters(),
-	characterUserInterfaceItems(),
-	textItem(nullptr),
-	modelNameCounts(std::unordered_map<std::string, unsigned int>())
-{
-	if (fontPrefixes.find(initialFont) == fontPrefixes.end())
-		fontPrefixes.size() > 0 ? fontName = *fontPrefixes.begin() : fontName = "";
+		graphicsObjectReadyCallbacks.clear();
+	};
 
-	if (fontName.empty())
-		Logger::Log(std::string("No fonts available for Text instance."), Logger::Category::Error);
+	GraphicsObjectManager::CreateTextGraphicsObject(mesh, font != nullptr ? font->GetTexture() : TextureManager::GetTexture("DefaultFontTexture"), graphicsObjectCreationCallback);
 
 	Append(initialText, zOrder);
 }
 
 Text::~Text()
 {
-	for (unsigned int index = static_cast<unsigned int>(characterUserInterfaceItems.size()); index != 0; index--)
-	{
-		delete characterUserInterfaceItems[index];
-	}
-
-	characterUserInterfaceItems.clear();
+	GraphicsObjectManager::DeleteGraphicsObject(graphicsObject);
 }
 
 float Text::GetSize() const
@@ -89,282 +70,131 @@ float Text::GetSize() const
 
 void Text::SetSize(float newSize)
 {
-	if (!characters.empty())
+	if (newSize == size)
 	{
-		const std::unordered_map<std::string, UserInterfaceItem*>& subCharacterItems = textItem->GetSubItems();
-
-		for (const std::pair<std::string, UserInterfaceItem*>& characterSubItem : subCharacterItems)
-		{
-			glm::vec2 currentScale = characterSubItem.second->GetScale();
-
-			float scaleX = 1.0f / currentScale.x;
-			float scaleY = 1.0f / currentScale.y;
-
-			characterSubItem.second->Scale(scaleX, scaleY);
-			characterSubItem.second->Scale(newSize, newSize);
-		}
-
-		size = newSize;
+		return;
 	}
-}
 
-void Text::ContainCharacterModels(const std::string& characters, std::vector<Model*>& returnedCharacterModels, std::vector<std::string>& returnedCharacterModelNames) const
-{
-	std::string characterModelName("");
-	Model* unassignedModel = nullptr;
+	size = newSize;
 
-	std::unordered_set<char> containerOpenCharacterUSACIIDecimalValues = {(char)40, (char)60, (char)91, (char)123};
-	std::unordered_set<char> containerCloseCharacterUSACIIDecimalValues = {(char)41, (char)62, (char)93, (char)125};
-	std::unordered_set<char> containerBeginAndEndCharacterUSACIIDecimalValues = {(char)65, (char)90, (char)97, (char)122};
+	// Glyphs are spaced in window units, so the quads move when the scale changes.
+	WriteQuads(0U, static_cast<unsigned int>(characters.size()));
 
-	for (unsigned int i = 0; i < characters.size(); i++)
+	WhenGraphicsObjectReady([this, newSize]()
 	{
-		const char character = (char)characters.at(i);
-
-		std::string prefix = "";
-		if (character >= *containerBeginAndEndCharacterUSACIIDecimalValues.find('a') && character <= *containerBeginAndEndCharacterUSACIIDecimalValues.find('z'))
-		{
-			prefix = std::string("Lowercase");
-			const_cast<char&>(character) = std::toupper(character);
-		}
-		else if (character >= *containerBeginAndEndCharacterUSACIIDecimalValues.find('A') && character <= *containerBeginAndEndCharacterUSACIIDecimalValues.find('Z'))
-		{
-			prefix = std::string("Uppercase");
-			const_cast<char&>(character) = std::toupper(character);
-		}
-		else
-		{
-			if (containerOpenCharacterUSACIIDecimalValues.contains(character))
-			{
-				prefix = "Open";
-			}
-			else if (containerCloseCharacterUSACIIDecimalValues.contains(character))
-			{
-				prefix = "Close";
-			}
-		}
-
-		static std::unordered_map<char, std::string> signNames = std::unordered_map<char, std::string>({
-			std::make_pair('[', std::string("Braket")),
-			std::make_pair(']', std::string("Braket")),
-			std::make_pair('(', std::string("Parenthese")),
-			std::make_pair(')', std::string("Parenthese")),
-			std::make_pair('<', std::string("MagnitudeEvaluation")),
-			std::make_pair('>', std::string("MagnitudeEvaluation")),
-			std::make_pair('?', std::string("Question")),
-			std::make_pair(';', std::string("SemiColon")),
-			std::make_pair(':', std::string("Colon")),
-			std::make_pair('/"', std::string("Quotation")),
-			std::make_pair('@', std::string("At")),
-			std::make_pair('&', std::string("Ampersand")),
-			std::make_pair('*', std::string("Asterisk")),
-			std::make_pair('\\', std::string("Backward")),
-			std::make_pair('/', std::string("Forward")),
-			std::make_pair('|', std::string("Pipe")),
-			std::make_pair('$', std::string("Dollar")),
-			std::make_pair(',', std::string("Comma")),
-			std::make_pair('^', std::string("Carrot")),
-			std::make_pair('=', std::string("Equal")),
-			std::make_pair('!', std::string("Exclaimation")),
-			std::make_pair('.', std::string("Period")),
-			std::make_pair('%', std::string("Percent")),
-			std::make_pair('0', std::string("Zero")),
-			std::make_pair('1', std::string("One")),
-			std::make_pair('2', std::string("Two")),
-			std::make_pair('3', std::string("Three")),
-			std::make_pair('4', std::string("Four")),
-			std::make_pair('5', std::string("Five")),
-			std::make_pair('6', std::string("Six")),
-			std::make_pair('7', std::string("Seven")),
-			std::make_pair('8', std::string("Eight")),
-			std::make_pair('9', std::string("Nine")),
-			std::make_pair('#', std::string("Pound")),
-			std::make_pair('-', std::string("Minus")),
-			std::make_pair('+', std::string("Plus"))
-		});
-
-		returnedCharacterModelNames[i] = characterModelName = signNames.contains(character) ? fontName + prefix += (*signNames.find(character)).second : fontName + prefix + character;
-		returnedCharacterModels[i] = ((unassignedModel = ModelManager::GetModel(characterModelName)) != nullptr) ? unassignedModel : ModelManager::GetModel("DefaultRectangleWithDepth");
-	}
+		glm::vec2 currentScale = graphicsObject->GetScale();
+		graphicsObject->Scale(glm::vec3(newSize / currentScale.x, newSize / currentScale.y, 0.0f));
+	});
 }
 
-const std::string& Text::Append(const std::string& postfix, float zOrder)
+const std::string& Text::Append(const std::string& postfix, float z)
 {
-	if (!postfix.empty())
-	{
-		if (postfix == " ")
-		{
-			cursor.x += horizontalSpacing;
-		}
-		else
-		{
-			std::vector<Model*> charactersAsModels(postfix.size());
-			std::vector<std::string> charactersModelNames(postfix.size());
+	const unsigned int first = static_cast<unsigned int>(characters.size());
 
-			ContainCharacterModels(postfix, charactersAsModels, charactersModelNames);
+	characters += postfix;
 
-			AddCharacterModelsAsUserInterfaceSubItems(charactersModelNames, charactersAsModels, zOrder, true);
-		}
+	mesh->Resize(static_cast<unsigned int>(characters.size()));
+	WriteQuads(first, static_cast<unsigned int>(characters.size()));
+
+	if (z != zOrder)
+	{
+		SetZOrder(z);
 	}
-	
-	return characters = characters + postfix;
+
+	return characters;
 }
 
 const std::string& Text::Prepend(const std::string& prefix)
 {
-	std::vector<Model*> charactersAsModels(prefix.size());
-	std::vector<std::string> charactersModelNames(prefix.size());
-
-	ContainCharacterModels(prefix, charactersAsModels, charactersModelNames);
+	characters = prefix + characters;
 
-	AddCharacterModelsAsUserInterfaceSubItems(charactersModelNames, charactersAsModels, false);
+	// Every glyph after the prefix moves along the line.
+	mesh->Resize(static_cast<unsigned int>(characters.size()));
+	WriteQuads(0U, static_cast<unsigned int>(characters.size()));
 
-	return characters = prefix + characters;
+	return characters;
 }
 
 void Text::SetPosition(const glm::vec2& newPosition)
 {
-	float xSpacing = 0.0f;
-	unsigned int index = 0U;
-	for (unsigned int i = 0; i < characters.size(); i++)
-	{
-		if (characters.at(i) != ' ')
-		{
-			UserInterfaceItem* item = characterUserInterfaceItems[index++];
-			item->SetPosition(newPosition.x + xSpacing, newPosition.y);
-		}
-
-		xSpacing += horizontalSpacing;
+	position = newPosition;
 
-	}
-
-	cursor.x = newPosition.x + xSpacing;
-	cursor.y = newPosition.y;
+	// The glyphs are relative to the graphics object, moving the text only changes its transform.
+	WhenGraphicsObjectReady([this, newPosition]()
+	{
+		graphicsObject->SetTranslation(glm::vec3(-newPosition.x, -newPosition.y, graphicsObject->GetZOrder()));
+	});
 }
 
 void Text::SetVisibility(UserInterfaceItem::Visibility newVisibility)
 {
-	if (textItem != nullptr)
+	if (newVisibility == UserInterfaceItem::Visibility::Default || newVisibility == visibility)
 	{
-		const std::unordered_map<std::string, UserInterfaceItem*>& subCharacterItems = textItem->GetSubItems();
+		return;
+	}
 
-		if (!subCharacterItems.empty())
-		{
-			for (const std::pair<std::string, UserInterfaceItem*>& characterSubItem : subCharacterItems)
-			{
-				characterSubItem.second->InquireVisibility(newVisibility);
-			}
-		}
+	visibility = newVisibility;
 
-		textItem->InquireVisibility(newVisibility);
-	}
+	WhenGraphicsObjectReady([this]()
+	{
+		GraphicsObjectManager::ToggleGraphicsObjectDraw(graphicsObject, graphicsObject->GetGraphicsObjectType());
+	});
 }
 
 void Text::SetZOrder(float newZ)
 {
-	for (UserInterfaceItem* item : characterUserInterfaceItems)
+	zOrder = newZ;
+
+	WhenGraphicsObjectReady([this, newZ]()
 	{
-		item->SetZOrder(newZ);
-	}
+		graphicsObject->SetZOrder(newZ);
+	});
 }
 
 float Text::GetZOrder() const
 {
-	if (!characterUserInterfaceItems.empty())
-	{
-		return characterUserInterfaceItems[0]->GetZOrder();
-	}
-
-	return 10.0f;
+	return zOrder;
 }
 
 void Text::Backspace()
 {
-	if (characters.size() > 0)
+	if (!characters.empty())
 	{
-		if (!characterUserInterfaceItems.empty() && characters.at(characters.size() - 1) != ' ')
-		{
-			UserInterfaceItem* itemToRemove = characterUserInterfaceItems.at(characterUserInterfaceItems.size() - 1);
-
-			std::string subItemName;
-
-			for (const std::pair<std::string, UserInterfaceItem*>& subItem : textItem->GetSubItems())
-			{
-				if (subItem.second == itemToRemove)
-				{
-					subItemName = subItem.first;
-				}
-			}
-
-			textItem->RemoveSubItem(subItemName);
-			delete itemToRemove;
-			characterUserInterfaceItems.erase(std::next(characterUserInterfaceItems.begin(), characterUserInterfaceItems.size() - 1));
-		}
-		
-		cursor.x += -horizontalSpacing;
-
-		if (characters.size() == 1)
-		{
-			textItem = nullptr;
-		}
-
-		std::string charactersBefore = characters;
+		characters.pop_back();
 
-		characters.erase(std::next(characters.begin(), characters.size() - 1));
-		Logger::Log(characters + " : " + charactersBefore, Logger::Category::Warning);
+		// The last quad is simply no longer drawn, nothing is uploaded.
+		mesh->Resize(static_cast<unsigned int>(characters.size()));
 	}
 }
 
-void Text::AddCharacterModelsAsUserInterfaceSubItems(const std::vector<std::string>& charactersModelName, const std::vector<Model*>& characterModels, float z, bool appendOrPrepend)
+void Text::WriteQuads(unsigned int first, unsigned int end)
 {
-	auto createSubItemName = [this, &charactersModelName](unsigned int index) -> std::string
-		{
-			modelNameCounts[charactersModelName.at(index)]++;
-			char itoaChar[] = { '\0', '\0' , '\0' , '\0' , '\0' };
-			_itoa_s(modelNameCounts[charactersModelName.at(index)], itoaChar, 10);
-			return charactersModelName.at(index) + itoaChar;
-		};
-
-	std::string firstCharacterName = createSubItemName(0);
-
-	UserInterfaceItem* firstAppendedCharacterModelAsUserInterfaceSubItem;
-	UserInterfaceItem* lastCreatedTextItem = firstAppendedCharacterModelAsUserInterfaceSubItem = new UserInterfaceItem(charactersModelName[0], characterModels[0], TextureManager::GetTexture("DefaultFontTexture"), z, cursor, {size, size});
+	Vertex quad[TextMesh::verticesPerQuad];
 
-	if (textItem == nullptr)
-		textItem = lastCreatedTextItem;	
-
-	characterUserInterfaceItems.push_back(lastCreatedTextItem);
-
-	for (unsigned int i = 1; i < characterModels.size(); i++)
+	for (unsigned int i = first; i < end; i++)
 	{
-		cursor.x += horizontalSpacing;
-		cursor.y += verticalSpacing;
-
-		std::string subItemName = createSubItemName(i);
+		const glm::vec2 offset = glm::vec2(horizontalSpacing, verticalSpacing) * (static_cast<float>(i) / size);
 
-		UserInterfaceItem* characterUserInterfaceItem = new UserInterfaceItem(subItemName, characterModels.at(i), TextureManager::GetTexture("DefaultFontTexture"), z, cursor, {size, size});
-
-		characterUserInterfaceItems.push_back(characterUserInterfaceItem);
-
-		textItem->AddSubItem(subItemName, characterUserInterfaceItem);
+		if (font == nullptr || !font->GetGlyphQuad(characters[i], offset, quad))
+		{
+			// Spaces and characters missing from the atlas take up their place in the line without drawing anything.
+			std::fill(std::begin(quad), std::end(quad), Vertex());
+		}
 
-		lastCreatedTextItem = characterUserInterfaceItem;
+		mesh->SetQuad(i, quad);
 	}
+}
 
-	cursor.x += horizontalSpacing;
-	cursor.y += verticalSpacing;
+void Text::WhenGraphicsObjectReady(const std::function<void()>& callback)
+{
+	std::lock_guard<std::mutex> guard(graphicsObjectReadyMutex);
 
-	if (appendOrPrepend && textItem != lastCreatedTextItem)
+	if (graphicsObject != nullptr)
 	{
-		textItem->AddSubItem(firstCharacterName, firstAppendedCharacterModelAsUserInterfaceSubItem);
-		return;
+		callback();
 	}
-
-	const std::unordered_map<std::string, UserInterfaceItem*>& subCharacterItems = textItem->GetSubItems();
-
-	glm::vec2 translationIncrementor = textItem->GetTranslation();
-	for (const std::pair<std::string, UserInterfaceItem*>& characterSubItem : subCharacterItems)
+	else
 	{
-		characterSubItem.second->Translate(translationIncrementor.x += horizontalSpacing, translationIncrementor.y += verticalSpacing);
+		graphicsObjectReadyCallbacks.push_back(callback);
 	}
 }
@@ -4,20 +4,22 @@
 #include "UserInterfaceItem.h"
 
 #include <string>
-#include <vector>
-#include <unordered_set>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <functional>
 
 #include <glm/glm.hpp>
 
-class UserInterfaceItem;
-class Model;
+class Font;
+class TextMesh;
+class TextGraphicsObject;
 
+// A line of text drawn as one batched glyph mesh. Editing the text rewrites only the glyph quads that changed.
 class Text
 {
 public:
 
-	static void LoadFonts();
-
 	Text(const std::string& initialText, const glm::vec2& initialPosition = glm::vec2(100.0f, 600.0f), float zOrder = 10.0f, const float& initialSize = 25.0f, const std::string& initialFont = "Default", float horizontalSpacing = 10.0f, float verticalSpacing = 0.0f);
 
 	~Text();
@@ -52,40 +54,40 @@ protected:
 
 	Text() = delete;
 
-	void ContainCharacterModels(const std::string& characters, std::vector<Model*>& returnedCharacterModels, std::vector<std::string>& returnedCharacterModelNames) const;
-
 private:
 
-	void AddCharacterModelsAsUserInterfaceSubItems(const std::vector<std::string>& characterModelNames, const std::vector<Model*>& characterModels, float z, bool appendOrPrepend = true);
-
-	static std::vector<std::string> fontDirectories;
-
-	static std::unordered_set<std::string> fontPrefixes;
+	// Writes the quads of characters [first, end) at their place in the line.
+	void WriteQuads(unsigned int first, unsigned int end);
 
-	static std::vector<std::string> characterNames;
+	// Runs now if the graphics object exists, otherwise once it is created.
+	void WhenGraphicsObjectReady(const std::function<void()>& callback);
 
 	glm::vec2 position;
 
-	glm::vec2 cursor;
-	
 	float horizontalSpacing;
 
 	float verticalSpacing;
 
 	float size;
 
+	float zOrder;
+
 	std::string fontName;
 
+	Font* font;
+
 	std::string characters;
 
-	std::unordered_map<std::string, unsigned int> modelNameCounts;
+	std::shared_ptr<TextMesh> mesh;
 
-	std::vector<UserInterfaceItem*> characterUserInterfaceItems;
+	TextGraphicsObject* graphicsObject;
 
-	UserInterfaceItem* textItem;
+	UserInterfaceItem::Visibility visibility;
 
-public:
+	std::list<std::function<void()>> graphicsObjectReadyCallbacks;
+
+	std::mutex graphicsObjectReadyMutex;
 
 };
 
-#endif // TEXT_H
\ No newline at end of file
+#endif // TEXT_H
@@ -0,0 +1,88 @@
+#include "TextMesh.h"
+
+#include <algorithm>
+
+TextMesh::TextMesh() :
+	vertices(std::vector<Vertex>()),
+	changedBegin(0U),
+	changedEnd(0U)
+{
+}
+
+TextMesh::~TextMesh()
+{
+}
+
+void TextMesh::Resize(unsigned int quadCount)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+
+	const unsigned int previousQuadCount = static_cast<unsigned int>(vertices.size() / verticesPerQuad);
+	vertices.resize(static_cast<size_t>(quadCount) * verticesPerQuad, Vertex());
+
+	if (quadCount > previousQuadCount)
+	{
+		MarkChanged(previousQuadCount, quadCount);
+	}
+	else
+	{
+		// Nothing to upload, drawing fewer indices hides the removed quads.
+		changedEnd = std::min(changedEnd, quadCount);
+		changedBegin = std::min(changedBegin, changedEnd);
+	}
+}
+
+void TextMesh::SetQuad(unsigned int quadIndex, const Vertex* const quad)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+
+	if (static_cast<size_t>(quadIndex) * verticesPerQuad >= vertices.size())
+	{
+		return;
+	}
+
+	std::copy(quad, quad + verticesPerQuad, vertices.begin() + static_cast<size_t>(quadIndex) * verticesPerQuad);
+	MarkChanged(quadIndex, quadIndex + 1);
+}
+
+unsigned int TextMesh::GetQuadCount() const
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	return static_cast<unsigned int>(vertices.size() / verticesPerQuad);
+}
+
+unsigned int TextMesh::Flush(const std::function<bool(unsigned int quadCount)>& reserve, const std::function<void(const Vertex* const vertices, unsigned int firstQuad, unsigned int quadCount)>& write)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+
+	const unsigned int quadCount = static_cast<unsigned int>(vertices.size() / verticesPerQuad);
+
+	if (reserve(quadCount))
+	{
+		changedBegin = 0U;
+		changedEnd = quadCount;
+	}
+
+	if (changedEnd > changedBegin)
+	{
+		write(vertices.data() + static_cast<size_t>(changedBegin) * verticesPerQuad, changedBegin, changedEnd - changedBegin);
+	}
+
+	changedBegin = changedEnd = 0U;
+
+	return quadCount;
+}
+
+void TextMesh::MarkChanged(unsigned int firstQuad, unsigned int endQuad)
+{
+	if (changedEnd == changedBegin)
+	{
+		changedBegin = firstQuad;
+		changedEnd = endQuad;
+	}
+	else
+	{
+		changedBegin = std::min(changedBegin, firstQuad);
+		changedEnd = std::max(changedEnd, endQuad);
+	}
+}
@@ -0,0 +1,58 @@
+#ifndef TEXTMESH_H
+#define TEXTMESH_H
+
+#include "../Renderer/Model/Vertex.h"
+
+#include <vector>
+#include <functional>
+#include <mutex>
+
+// The glyph quads of one Text block, four vertices each. Written by the Text, read by its TextGraphicsObject on the render thread.
+// Only the quads written since the last flush are copied to the GPU.
+class TextMesh
+{
+
+public:
+
+	static const unsigned int verticesPerQuad = 4;
+
+	static const unsigned int indicesPerQuad = 6;
+
+	TextMesh();
+
+	~TextMesh();
+
+	TextMesh(const TextMesh&) = delete;
+
+	TextMesh& operator=(const TextMesh&) = delete;
+
+	TextMesh(TextMesh&&) = delete;
+
+	TextMesh& operator=(TextMesh&&) = delete;
+
+	// Grows or shrinks the mesh. New quads are degenerate until written.
+	void Resize(unsigned int quadCount);
+
+	void SetQuad(unsigned int quadIndex, const Vertex* const quad);
+
+	unsigned int GetQuadCount() const;
+
+	// Render thread. reserve is called with the quad count and returns true if the destination was reallocated, in which case every quad is written.
+	// write is called with the changed range. Returns the quad count to draw.
+	unsigned int Flush(const std::function<bool(unsigned int quadCount)>& reserve, const std::function<void(const Vertex* const vertices, unsigned int firstQuad, unsigned int quadCount)>& write);
+
+private:
+
+	void MarkChanged(unsigned int firstQuad, unsigned int endQuad);
+
+	std::vector<Vertex> vertices;
+
+	unsigned int changedBegin;
+
+	unsigned int changedEnd;
+
+	mutable std::mutex mutex;
+
+};
+
+#endif // TEXTMESH_H
@@ -31,7 +31,10 @@ UserInterfaceItem::UserInterfaceItem(const std::string& itemName, Model* const m
 	ready(false),
 	texture(tex),
 	scale(initialScale),
-	zOrder(z)
+	zOrder(z),
+	hasWindowBounds(false),
+	windowMin(0.0f),
+	windowMax(0.0f)
 {
 	std::function<void(GraphicsObject*)> graphicsObjectCreationCallback = [this](GraphicsObject* obj)
 	{
@@ -55,6 +58,8 @@ UserInterfaceItem::UserInterfaceItem(const std::string& itemName, Model* const m
 
 		graphicsObject->SetZOrder(zOrder);
 
+		UpdateWindowBounds();
+
 		ready = true;
 	};
 
@@ -63,6 +68,8 @@ UserInterfaceItem::UserInterfaceItem(const std::string& itemName, Model* const m
 
 UserInterfaceItem::~UserInterfaceItem()
 {
+	UserInterfaceManager::RemoveItemBounds(this);
+
 	GraphicsObjectManager::DeleteGraphicsObject(graphicsObject);
 }
 
@@ -116,21 +123,7 @@ void UserInterfaceItem::Hovered(std::function<void()> onHover) const
 {
 	std::function<void(const glm::vec2&)> getCursorPositionCallback = [onHover, this](const glm::vec2& position)
 	{
-		// Tirangle intersection test with transform.
-		const Model* const  modelToTest = graphicsObject->GetModel();
-		glm::mat4 modelMat4 = graphicsObject->GetModelMat4();
-
-		const Camera& mainOrthoCam = CameraManager::GetCamera(std::string("MainOrthoCamera"));
-
-		glm::mat4 projection = mainOrthoCam.GetProjection();
-		projection[1][1] *= -1.0f;
-
-		const glm::mat4& view = mainOrthoCam.GetView();
-
-		const std::vector<Vertex>& vertices = modelToTest->GetVertices();
-
-		// Compute shader?
-		if (Math::PointIn2DModel(modelToTest, view, projection, modelMat4, position, glm::vec2(UserInterfaceManager::GetWindowWidth(), UserInterfaceManager::GetWindowHeight())))
+		if (Contains(position))
 		{
 			onHover();
 		}
@@ -139,10 +132,49 @@ void UserInterfaceItem::Hovered(std::function<void()> onHover) const
 	InputManager::GetCursorPosition(getCursorPositionCallback);
 }
 
+bool UserInterfaceItem::Contains(const glm::vec2& point) const
+{
+	if (!hasWindowBounds || point.x < windowMin.x || point.y < windowMin.y || point.x > windowMax.x || point.y > windowMax.y)
+	{
+		return false;
+	}
+
+	// Tirangle intersection test with transform.
+	const Model* const  modelToTest = graphicsObject->GetModel();
+	glm::mat4 modelMat4 = graphicsObject->GetModelMat4();
+
+	const Camera& mainOrthoCam = CameraManager::GetCamera(std::string("MainOrthoCamera"));
+
+	glm::mat4 projection = mainOrthoCam.GetProjection();
+	projection[1][1] *= -1.0f;
+
+	const glm::mat4& view = mainOrthoCam.GetView();
+
+	return Math::PointIn2DModel(modelToTest, view, projection, modelMat4, point, glm::vec2(UserInterfaceManager::GetWindowWidth(), UserInterfaceManager::GetWindowHeight()));
+}
+
+void UserInterfaceItem::UpdateWindowBounds()
+{
+	if (graphicsObject == nullptr)
+	{
+		return;
+	}
+
+	const Camera& mainOrthoCam = CameraManager::GetCamera(std::string("MainOrthoCamera"));
+
+	glm::mat4 projection = mainOrthoCam.GetProjection();
+	projection[1][1] *= -1.0f;
+
+	Math::Model2DWindowBounds(graphicsObject->GetModel(), mainOrthoCam.GetView(), projection, graphicsObject->GetModelMat4(), glm::vec2(UserInterfaceManager::GetWindowWidth(), UserInterfaceManager::GetWindowHeight()), windowMin, windowMax);
+	hasWindowBounds = true;
+
+	UserInterfaceManager::UpdateItemBounds(this, windowMin, windowMax);
+}
+
 
 void UserInterfaceItem::Scale(float x, float y)
 {
-	std::function<void()> graphicsObjectReadyCallback = [this, x, y]() { graphicsObject->Scale(glm::vec3(x, y, 0.0f)); };
+	std::function<void()> graphicsObjectReadyCallback = [this, x, y]() { graphicsObject->Scale(glm::vec3(x, y, 0.0f)); UpdateWindowBounds(); };
 	
 	if (ready)
 	{
@@ -156,7 +188,7 @@ void UserInterfaceItem::Scale(float x, float y)
 
 void UserInterfaceItem::Rotate(float angle)
 {
-	std::function<void()> graphicsObjectReadyCallback = [this, angle]() { graphicsObject->Rotate(angle, glm::vec3(0.0f, 0.0f, 1.0f)); };
+	std::function<void()> graphicsObjectReadyCallback = [this, angle]() { graphicsObject->Rotate(angle, glm::vec3(0.0f, 0.0f, 1.0f)); UpdateWindowBounds(); };
 	
 	if (ready)
 	{
@@ -170,7 +202,7 @@ void UserInterfaceItem::Rotate(float angle)
 
 void UserInterfaceItem::Translate(float x, float y)
 {
-	std::function<void()> graphicsObjectReadyCallback = [this, x, y]() { graphicsObject->Translate({ x, y, 0.0f }); };
+	std::function<void()> graphicsObjectReadyCallback = [this, x, y]() { graphicsObject->Translate({ x, y, 0.0f }); UpdateWindowBounds(); };
 	
 	if (ready)
 	{
@@ -192,6 +224,7 @@ glm::vec2 UserInterfaceItem::GetScale() const
 void UserInterfaceItem::SetPosition(float x, float y)
 {
 	graphicsObject->SetTranslation(glm::vec3(-x, -y, graphicsObject->GetZOrder()));
+	UpdateWindowBounds();
 }
 
 void UserInterfaceItem::OnWindowSizeUpdate()
@@ -209,6 +242,8 @@ void UserInterfaceItem::OnWindowSizeUpdate()
 
 
 		graphicsObject->SetTranslation(glm::vec3(position, graphicsObject->GetZOrder()));
+
+		UpdateWindowBounds();
 	}
 }
 
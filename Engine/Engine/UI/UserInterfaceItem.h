@@ -49,6 +49,9 @@ public:
 
 	void Hovered(std::function<void()> onHover) const;
 
+	// Whether the item's model covers a window space point. The item's window space box is checked before its triangles.
+	bool Contains(const glm::vec2& point) const;
+
 	void Scale(float x, float y);
 
 	void Rotate(float angle);
@@ -79,6 +82,9 @@ private:
 
 	UserInterfaceItem() = delete;
 
+	// Refreshes the window space box and the item's place in the UserInterfaceManager's index, after any transform change.
+	void UpdateWindowBounds();
+
 	static std::function<void()> emptyFunctionObject;
 
 	bool transformReady;
@@ -106,6 +112,12 @@ private:
 	const Texture* texture;
 
 	float zOrder;
+
+	bool hasWindowBounds;
+
+	glm::vec2 windowMin;
+
+	glm::vec2 windowMax;
 };
 
 #endif // USERINTERFACEITEM_H
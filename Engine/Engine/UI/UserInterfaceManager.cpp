@@ -7,11 +7,16 @@
 #include "../Renderer/Windows/Window.h"
 #include "../Renderer/Windows/WindowManager.h"
 #include "../UI/Text.h"
+#include "FontManager.h"
+
+#include <algorithm>
 
 UserInterfaceManager* UserInterfaceManager::instance = nullptr;
 
 std::mutex UserInterfaceManager::instanceMutex = std::mutex();
 
+std::mutex UserInterfaceManager::itemIndexMutex = std::mutex();
+
 void UserInterfaceManager::Initialize()
 {
 	std::lock_guard<std::mutex> guard(instanceMutex);
@@ -20,7 +25,7 @@ void UserInterfaceManager::Initialize()
 	{
 		instance = new UserInterfaceManager();
 		Logger::Log(std::string("Initialized UserInterfaceManager"), Logger::Category::Success);
-		Text::LoadFonts();
+		FontManager::Initialize();
 	}
 	else
 	{
@@ -33,6 +38,7 @@ void UserInterfaceManager::Terminate()
 	if (instance != nullptr)
 	{
 		delete instance;
+		FontManager::Terminate();
 		Logger::Log(std::string("Termiated UserInterfaceManager"), Logger::Category::Success);
 	}
 	else
@@ -165,6 +171,106 @@ float UserInterfaceManager::GetPreviousWindowHeight()
 	return 0.0f;
 }
 
+void UserInterfaceManager::GetItemsAt(const glm::vec2& point, std::vector<UserInterfaceItem*>& items)
+{
+	const size_t first = items.size();
+
+	{
+		std::lock_guard<std::mutex> guard(itemIndexMutex);
+
+		if (instance == nullptr)
+		{
+			return;
+		}
+
+		instance->itemIndex.QueryPoint(point, [&items](int proxy)
+			{
+				items.push_back(static_cast<UserInterfaceItem*>(instance->itemIndex.GetUserData(proxy)));
+				return true;
+			});
+	}
+
+	// The box only says the point may be on the item, its triangles decide.
+	items.erase(std::remove_if(items.begin() + first, items.end(), [&point](const UserInterfaceItem* const item) { return !item->Contains(point); }), items.end());
+
+	std::sort(items.begin() + first, items.end(), [](const UserInterfaceItem* const a, const UserInterfaceItem* const b) { return a->GetZOrder() > b->GetZOrder(); });
+}
+
+UserInterfaceItem* const UserInterfaceManager::GetItemAt(const glm::vec2& point)
+{
+	std::vector<UserInterfaceItem*> items;
+	GetItemsAt(point, items);
+
+	return items.empty() ? nullptr : items.front();
+}
+
+void UserInterfaceManager::GetItemsIn(const glm::vec2& min, const glm::vec2& max, std::vector<UserInterfaceItem*>& items)
+{
+	std::lock_guard<std::mutex> guard(itemIndexMutex);
+
+	if (instance != nullptr)
+	{
+		instance->itemIndex.Query(min, max, [&items](int proxy)
+			{
+				items.push_back(static_cast<UserInterfaceItem*>(instance->itemIndex.GetUserData(proxy)));
+				return true;
+			});
+	}
+}
+
+void UserInterfaceManager::GetItemsAlong(const glm::vec2& start, const glm::vec2& end, std::vector<UserInterfaceItem*>& items)
+{
+	std::lock_guard<std::mutex> guard(itemIndexMutex);
+
+	if (instance != nullptr)
+	{
+		instance->itemIndex.QuerySegment(start, end, [&items](int proxy)
+			{
+				items.push_back(static_cast<UserInterfaceItem*>(instance->itemIndex.GetUserData(proxy)));
+				return true;
+			});
+	}
+}
+
+void UserInterfaceManager::UpdateItemBounds(const UserInterfaceItem* const item, const glm::vec2& min, const glm::vec2& max)
+{
+	std::lock_guard<std::mutex> guard(itemIndexMutex);
+
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	auto found = instance->itemProxies.find(item);
+
+	if (found == instance->itemProxies.end())
+	{
+		instance->itemProxies[item] = instance->itemIndex.Insert(min, max, const_cast<UserInterfaceItem*>(item));
+	}
+	else
+	{
+		instance->itemIndex.Move(found->second, min, max);
+	}
+}
+
+void UserInterfaceManager::RemoveItemBounds(const UserInterfaceItem* const item)
+{
+	std::lock_guard<std::mutex> guard(itemIndexMutex);
+
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	auto found = instance->itemProxies.find(item);
+
+	if (found != instance->itemProxies.end())
+	{
+		instance->itemIndex.Remove(found->second);
+		instance->itemProxies.erase(found);
+	}
+}
+
 void UserInterfaceManager::OnWindowSizeUpdate(const Window* const window)
 {
 	if (instance != nullptr)
@@ -189,6 +295,8 @@ void UserInterfaceManager::OnWindowSizeUpdate(const Window* const window)
 
 UserInterfaceManager::UserInterfaceManager() :
 	userInterfaceItems(std::unordered_map<std::string, UserInterfaceItem*>()),
+	itemIndex(),
+	itemProxies(std::unordered_map<const UserInterfaceItem*, int>()),
 	windowWidth(0.0f),
 	windowHeight(0.0f),
 	previousWindowWidth(windowWidth),
@@ -4,9 +4,12 @@
 #include <string>
 #include <unordered_map>
 #include <mutex>
+#include <vector>
 
 #include <glm/glm.hpp>
 
+#include "../Collision/SpatialHash2D.h"
+
 class Window;
 class Model;
 class Texture;
@@ -34,10 +37,30 @@ public:
 
 	static float GetPreviousWindowHeight();
 
+	// The items whose model covers a window space point, front first by z order. Items are kept in a spatial hash by their
+	// window space boxes, so only the few in the point's cell are tested against their triangles.
+	static void GetItemsAt(const glm::vec2& point, std::vector<UserInterfaceItem*>& items);
+
+	// The front item at a window space point, null if there is none.
+	static UserInterfaceItem* const GetItemAt(const glm::vec2& point);
+
+	// The items whose window space boxes overlap min and max.
+	static void GetItemsIn(const glm::vec2& min, const glm::vec2& max, std::vector<UserInterfaceItem*>& items);
+
+	// The items whose window space boxes the segment from start to end touches, like a drag from start to end.
+	static void GetItemsAlong(const glm::vec2& start, const glm::vec2& end, std::vector<UserInterfaceItem*>& items);
+
 private:
 	
 	friend class Window;
 
+	friend class UserInterfaceItem;
+
+	// Called by items whenever their transform or the window changes.
+	static void UpdateItemBounds(const UserInterfaceItem* const item, const glm::vec2& min, const glm::vec2& max);
+
+	static void RemoveItemBounds(const UserInterfaceItem* const item);
+
 	static void OnWindowSizeUpdate(const Window* const window);
 
 	UserInterfaceManager();
@@ -58,6 +81,13 @@ private:
 
 	static std::mutex instanceMutex;
 
+	SpatialHash2D itemIndex;
+
+	std::unordered_map<const UserInterfaceItem*, int> itemProxies;
+
+	// Separate from instanceMutex, items update their bounds while it is held for creating and destroying them.
+	static std::mutex itemIndexMutex;
+
 	float windowWidth;
 	
 	float windowHeight;
@@ -0,0 +1,197 @@
+#include "FileWatcher.h"
+
+#include "Logger.h"
+
+#include <chrono>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+FileWatcher::FileWatcher() :
+	directories(std::vector<std::string>()),
+	changes(std::unordered_set<std::string>()),
+	writeTimes(std::unordered_map<std::string, std::filesystem::file_time_type>()),
+	running(false)
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+	Stop();
+}
+
+void FileWatcher::WatchDirectory(const std::string& directory)
+{
+	if (running.load())
+	{
+		Logger::Log(std::string("Calling FileWatcher::WatchDirectory() after FileWatcher::Start()."), Logger::Category::Warning);
+		return;
+	}
+
+	std::error_code error;
+	if (!std::filesystem::is_directory(directory, error))
+	{
+		Logger::Log(std::string("FileWatcher cannot watch missing directory ") + directory, Logger::Category::Warning);
+		return;
+	}
+
+	directories.push_back(directory);
+}
+
+void FileWatcher::Start()
+{
+	if (running.exchange(true))
+	{
+		return;
+	}
+
+	watchThread = std::thread(&FileWatcher::Run, this);
+}
+
+void FileWatcher::Stop()
+{
+	if (running.exchange(false) && watchThread.joinable())
+	{
+		watchThread.join();
+	}
+}
+
+std::vector<std::string> FileWatcher::PollChanges()
+{
+	std::lock_guard<std::mutex> guard(changesMutex);
+
+	std::vector<std::string> changedFiles(changes.begin(), changes.end());
+	changes.clear();
+
+	return changedFiles;
+}
+
+void FileWatcher::RecordChange(const std::string& path)
+{
+	std::lock_guard<std::mutex> guard(changesMutex);
+	changes.insert(std::filesystem::path(path).generic_string());
+}
+
+#ifdef __linux__
+
+void FileWatcher::Run()
+{
+	int inotifyHandle = inotify_init1(IN_NONBLOCK);
+
+	if (inotifyHandle < 0)
+	{
+		Logger::Log(std::string("inotify is unavailable, FileWatcher is falling back to polling."), Logger::Category::Warning);
+		RunPolling();
+		return;
+	}
+
+	std::unordered_map<int, std::string> watchedDirectories;
+
+	auto addWatch = [&](const std::string& directory)
+	{
+		// Editors usually save through a temporary file and a rename, so moved-in files count as writes.
+		int watch = inotify_add_watch(inotifyHandle, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+		if (watch >= 0)
+		{
+			watchedDirectories[watch] = directory;
+		}
+	};
+
+	for (const std::string& directory : directories)
+	{
+		addWatch(directory);
+
+		// This runs on the watch thread, a directory that went missing or cannot be read must not throw here.
+		std::error_code error;
+		for (std::filesystem::recursive_directory_iterator dirEntry(directory, std::filesystem::directory_options::skip_permission_denied, error);
+			!error && dirEntry != std::filesystem::recursive_directory_iterator(); dirEntry.increment(error))
+		{
+			if (dirEntry->is_directory(error))
+			{
+				addWatch(dirEntry->path().string());
+			}
+		}
+	}
+
+	alignas(inotify_event) char buffer[4096];
+
+	while (running.load())
+	{
+		pollfd descriptor = { inotifyHandle, POLLIN, 0 };
+
+		// Wake up regularly so Stop() does not wait on file activity.
+		if (poll(&descriptor, 1, 100) <= 0)
+		{
+			continue;
+		}
+
+		ssize_t length = read(inotifyHandle, buffer, sizeof(buffer));
+
+		for (ssize_t offset = 0; offset < length;)
+		{
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+
+			if (event->len > 0 && !(event->mask & IN_ISDIR) && watchedDirectories.find(event->wd) != watchedDirectories.end())
+			{
+				RecordChange(watchedDirectories[event->wd] + "/" + event->name);
+			}
+
+			offset += sizeof(inotify_event) + event->len;
+		}
+	}
+
+	close(inotifyHandle);
+}
+
+#else
+
+void FileWatcher::Run()
+{
+	RunPolling();
+}
+
+#endif
+
+void FileWatcher::RunPolling()
+{
+	auto scan = [this](bool record)
+	{
+		for (const std::string& directory : directories)
+		{
+			std::error_code error;
+			for (std::filesystem::recursive_directory_iterator dirEntry(directory, std::filesystem::directory_options::skip_permission_denied, error);
+				!error && dirEntry != std::filesystem::recursive_directory_iterator(); dirEntry.increment(error))
+			{
+				if (!dirEntry->is_regular_file(error))
+				{
+					continue;
+				}
+
+				const std::string path = dirEntry->path().string();
+				const std::filesystem::file_time_type writeTime = dirEntry->last_write_time(error);
+
+				auto known = writeTimes.find(path);
+				if (known == writeTimes.end() || known->second != writeTime)
+				{
+					if (record && known != writeTimes.end())
+					{
+						RecordChange(path);
+					}
+
+					writeTimes[path] = writeTime;
+				}
+			}
+		}
+	};
+
+	scan(false);
+
+	while (running.load())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(250));
+		scan(true);
+	}
+}
@@ -0,0 +1,64 @@
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+// Watches directories on a background thread and collects the paths of files that were written.
+// Uses inotify on Linux and falls back to polling modification times elsewhere.
+class FileWatcher
+{
+
+public:
+
+	FileWatcher();
+
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	FileWatcher(FileWatcher&&) = delete;
+
+	FileWatcher& operator=(FileWatcher&&) = delete;
+
+	// Must be called before Start.
+	void WatchDirectory(const std::string& directory);
+
+	void Start();
+
+	void Stop();
+
+	// Returns every file changed since the last call, each path once.
+	std::vector<std::string> PollChanges();
+
+private:
+
+	void Run();
+
+	void RunPolling();
+
+	void RecordChange(const std::string& path);
+
+	std::vector<std::string> directories;
+
+	std::unordered_set<std::string> changes;
+
+	std::unordered_map<std::string, std::filesystem::file_time_type> writeTimes;
+
+	std::mutex changesMutex;
+
+	std::atomic<bool> running;
+
+	std::thread watchThread;
+
+};
+
+#endif // FILEWATCHER_H
@@ -10,8 +10,12 @@
 
 std::string Logger::logFilePath = std::string("Log.txt");
 
+std::mutex Logger::logMutex;
+
 void Logger::Log(std::string&& log, Category category, bool logToConsole, bool logToLogFile)
 {
+	std::lock_guard<std::mutex> guard(logMutex);
+
 	//TODO: Add support for color changes to log on other platforms.
 #ifdef _WIN32
 
@@ -2,6 +2,7 @@
 #define LOGGER_H
 
 #include <string>
+#include <mutex>
 #include <glm/glm.hpp>
 
 class Logger
@@ -41,6 +42,9 @@ public:
 private:
 
 	static std::string logFilePath;
+
+	// Clips bake and assets load on worker threads, their messages are written one at a time.
+	static std::mutex logMutex;
 };
 
 #endif // LOGGER_H
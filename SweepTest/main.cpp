@@ -0,0 +1,120 @@
+#include "Collision/Sweep.h"
+#include "Math/Shapes/Sphere.h"
+#include "Math/Shapes/Triangle.h"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+// Sweeps spheres into a triangle's face from the front and from the back, for both windings of the triangle. The hit
+// from one side has to mirror the hit from the other, the triangle can be hit from either side.
+
+namespace
+{
+	unsigned int failures = 0;
+
+	const float tolerance = 1e-5f;
+
+	void Fail(const std::string& test, const std::string& message)
+	{
+		std::cout << test << ": " << message << std::endl;
+		failures++;
+	}
+
+	bool Near(const glm::vec3& a, const glm::vec3& b)
+	{
+		return glm::all(glm::lessThanEqual(glm::abs(a - b), glm::vec3(tolerance)));
+	}
+
+	// The triangle lies in the z = 0 plane, the sphere starts distance away on side and moves straight at it.
+	void SweepAtFace(const std::string& test, const Triangle& triangle, const glm::vec2& across, float side)
+	{
+		const float radius = 0.5f;
+		const float distance = 2.0f;
+
+		const Sphere sphere(glm::vec3(across, side * distance), radius);
+		const glm::vec3 motion(0.0f, 0.0f, -side * 2.0f * distance);
+
+		Sweep::Hit hit;
+
+		if (!Sweep::SphereTriangle(sphere, motion, triangle, hit))
+		{
+			Fail(test, "missed the face");
+			return;
+		}
+
+		const float expectedTime = (distance - radius) / (2.0f * distance);
+
+		if (std::abs(hit.time - expectedTime) > tolerance)
+		{
+			Fail(test, "hit at " + std::to_string(hit.time) + " instead of " + std::to_string(expectedTime));
+		}
+
+		if (!Near(hit.point, glm::vec3(across, 0.0f)))
+		{
+			Fail(test, "hit the wrong point");
+		}
+
+		if (!Near(hit.normal, glm::vec3(0.0f, 0.0f, side)))
+		{
+			Fail(test, "hit normal does not point toward the sphere");
+		}
+	}
+
+	void TestBothSides()
+	{
+		const glm::vec3 p0(-1.0f, -1.0f, 0.0f);
+		const glm::vec3 p1(1.0f, -1.0f, 0.0f);
+		const glm::vec3 p2(0.0f, 1.0f, 0.0f);
+
+		const Triangle counterClockwise(p0, p1, p2);
+		const Triangle clockwise(p0, p2, p1);
+
+		const glm::vec2 points[] = { glm::vec2(0.0f, 0.0f), glm::vec2(0.5f, -0.75f), glm::vec2(-0.25f, 0.25f) };
+
+		for (const glm::vec2& point : points)
+		{
+			for (float side : { 1.0f, -1.0f })
+			{
+				const std::string where = std::string(" at (") + std::to_string(point.x) + ", " + std::to_string(point.y) + (side > 0.0f ? ") from the front" : ") from the back");
+
+				SweepAtFace("Counter clockwise" + where, counterClockwise, point, side);
+				SweepAtFace("Clockwise" + where, clockwise, point, side);
+			}
+		}
+	}
+
+	void TestMiss()
+	{
+		const Triangle triangle(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		for (float side : { 1.0f, -1.0f })
+		{
+			const Sphere sphere(glm::vec3(3.0f, 0.0f, side * 2.0f), 0.5f);
+
+			Sweep::Hit hit;
+
+			if (Sweep::SphereTriangle(sphere, glm::vec3(0.0f, 0.0f, -side * 4.0f), triangle, hit))
+			{
+				Fail(side > 0.0f ? "Miss from the front" : "Miss from the back", "hit a triangle it passes beside");
+			}
+		}
+	}
+}
+
+int main()
+{
+	TestBothSides();
+	TestMiss();
+
+	if (failures != 0)
+	{
+		std::cout << failures << " sweep checks failed." << std::endl;
+		return 1;
+	}
+
+	std::cout << "Sweeps hit the triangle from both sides." << std::endl;
+	return 0;
+}
@@ -29,70 +29,147 @@
 #include "Animation/Animation.h"
 #include "Animation/Armature.h"
 
+#include "Simulation/Simulation.h"
+#include "Simulation/InterpolatedTransform.h"
+#include "Time/TimeManager.h"
+
 Player::Player() :
 	model(ModelManager::GetModel("Woman")),
 	texture(TextureManager::GetTexture("Woman2")),
 	graphics(nullptr),
-	hoveredPress(false)
+	transform(new InterpolatedTransform()),
+	otherObb(new OrientedBoundingBoxWithVisualization(model->GetVertices())),
+	collider(new AnimatedCollider(model)),
+	colliderAnimation(new Animation(model->GetBakedAnimation(0))),
+	colliderPose(model->GetArmature()->GetInvBindPose().size(), glm::mat4(1.0f)),
+	pendingClip(-1),
+	walking(false),
+	pendingYaw(0.0f),
+	pendingVisibilityToggles(0U),
+	hoveredPress(false),
+	simulationStep(nullptr),
+	modelReloaded(nullptr)
 {
 	GraphicsObjectManager::CreateTexturedAnimatedGraphicsObject(model, texture, [this](TexturedAnimatedGraphicsObject* obj)
 		{
 			graphics = obj;
 
-			otherObb = new OrientedBoundingBoxWithVisualization(graphics->GetModel()->GetVertices());
-			collider = new AnimatedCollider(graphics);
+			Simulation::Follow(graphics, transform);
 		});
 	
 	RegisterInput();
+
+	// Movement and collision run at the simulation's fixed rate rather than as fast as the game thread spins. Input only
+	// leaves requests for the step, which is the one thread that touches the transform and the collider.
+	simulationStep = new std::function<void(float)>([this](float stepSeconds)
+		{
+			// Units per second.
+			const float walkSpeed = 0.12f;
+
+			Math::Transform state = transform->GetLatest();
+
+			const float yaw = pendingYaw.exchange(0.0f);
+
+			if (yaw != 0.0f)
+			{
+				state.Rotation() = state.Rotation() * glm::angleAxis(glm::radians(yaw), glm::vec3(0.0f, 1.0f, 0.0f));
+			}
+
+			if (walking)
+			{
+				state.Position() += glm::normalize(state.Rotation() * glm::vec3(0.0f, 0.0f, 1.0f)) * walkSpeed * stepSeconds;
+			}
+
+			transform->Publish(state);
+
+			if (pendingVisibilityToggles.exchange(0U) % 2U == 1U)
+			{
+				collider->ToggleVisibility();
+			}
+
+			const int clip = pendingClip.exchange(-1);
+
+			if (clip >= 0)
+			{
+				// Switched at once like the graphics object's clip, so both start it together.
+				colliderAnimation->CrossFade(model->GetBakedAnimation(static_cast<unsigned int>(clip)), 0.0f);
+			}
+
+			colliderAnimation->Step(stepSeconds, colliderPose.data());
+
+			collider->Update(state.ToMat4(), colliderPose.data(), model->GetArmature()->GetInvBindPose().data());
+			collider->Intersect(*otherObb);
+		});
+
+	Simulation::RegisterStepCallback(simulationStep, "PlayerCollision");
+
+	// Runs between steps, after the graphics object restarted its clip on the new data.
+	modelReloaded = new std::function<void(const Model*)>([this](const Model* reloadedModel)
+		{
+			if (reloadedModel != model)
+			{
+				return;
+			}
+
+			delete colliderAnimation;
+			colliderAnimation = new Animation(model->GetBakedAnimation(graphics != nullptr ? graphics->GetClip() : 0U));
+			colliderPose.assign(model->GetArmature()->GetInvBindPose().size(), glm::mat4(1.0f));
+			collider->OnModelReloaded();
+		});
+
+	ModelManager::RegisterReloadCallback(modelReloaded, "PlayerCollider");
 }
 
 Player::~Player()
 {
+	Simulation::DeregisterStepCallback("PlayerCollision");
+	delete simulationStep;
+
+	ModelManager::DeregisterReloadCallback("PlayerCollider");
+	delete modelReloaded;
+
+	if (graphics != nullptr)
+	{
+		Simulation::Unfollow(graphics);
+	}
+
+	delete transform;
+
 	delete wPress;
 	delete wRelease;
-	delete wPressed;
 	delete iPress;
 
+	delete collider;
+	delete colliderAnimation;
 	delete otherObb;
 }
 
 void Player::Update()
 {
 	CameraAndPlayerRotation();
-
-	if (collider)
-	{
-		collider->Update();
-		collider->Intersect(*otherObb);
-	}
 }
 
 void Player::RegisterInput()
 {
-	
-	wPressed = new std::function<void(int)>([this](int keyCode)
-		{
-			glm::mat4 cruiserTransform = graphics->GetTransform();
-			glm::vec3 cruiserForward = glm::normalize(cruiserTransform[2]);
-			graphics->Translate(cruiserForward * 0.002f);
-		});
-
 	wPress = new std::function<void(int)>([this](int keyCode)
 		{
 			graphics->SetClip(0);
+			pendingClip = 0;
+			walking = true;
 		});
 
 	wRelease = new std::function<void(int)>([this](int keyCode)
 		{
 			graphics->SetClip(4);
+			pendingClip = 4;
+			walking = false;
 		});
 
 	iPress = new std::function<void(int)>([this](int keyCode)
 		{
-			collider->ToggleVisibility();
+			pendingVisibilityToggles++;
 		});
 	
-	InputManager::RegisterCallbackForKeyState(KEY_PRESSED, KEY_W, wPressed, "playerForward");
 	InputManager::RegisterCallbackForKeyState(KEY_PRESS, KEY_W, wPress, "playerRunAnimation");
 	InputManager::RegisterCallbackForKeyState(KEY_RELEASE, KEY_W, wRelease, "playerIdleAnimation");
 	InputManager::RegisterCallbackForKeyState(KEY_PRESS, KEY_I, iPress, "circleMovement");
@@ -101,52 +178,48 @@ void Player::RegisterInput()
 
 void Player::CameraAndPlayerRotation()
 {
-	if (graphics != nullptr)
-	{
-		Camera& cam = CameraManager::GetActiveCamera();
+	Camera& cam = CameraManager::GetActiveCamera();
 
-		glm::mat4 cruiserTransform = graphics->GetTransform();
+	// Where the player is drawn this frame, the graphics themselves belong to the render thread.
+	glm::mat4 cruiserTransform = transform->GetMatrix(TimeManager::PreciseSecondsSinceStart());
 
-		glm::vec3 cruiserPosition = cruiserTransform[3];
-		glm::vec3 cruiserUp = glm::normalize(cruiserTransform[1]);
-		glm::vec3 cruiserRight = glm::normalize(cruiserTransform[0]);
-		glm::vec3 cruiserForward = glm::normalize(cruiserTransform[2]);
+	glm::vec3 cruiserPosition = cruiserTransform[3];
+	glm::vec3 cruiserUp = glm::normalize(cruiserTransform[1]);
+	glm::vec3 cruiserRight = glm::normalize(cruiserTransform[0]);
+	glm::vec3 cruiserForward = glm::normalize(cruiserTransform[2]);
 
-		cam.SetPosition(cruiserPosition + (cruiserUp * 10.0f) + (-cruiserForward * 10.0f));
-		cam.SetTarget(cruiserPosition + (cruiserForward * 3.0f));
+	cam.SetPosition(cruiserPosition + (cruiserUp * 10.0f) + (-cruiserForward * 10.0f));
+	cam.SetTarget(cruiserPosition + (cruiserForward * 3.0f));
 
-		InputManager::WhenCursorMoved([this, cruiserUp, cruiserRight, cruiserForward](const glm::vec2& newPosition)
-			{
-				static bool lastCall = true;
-
-				if (lastCall)
-				{
-					static float moveSpeed = 0.1f;
+	InputManager::WhenCursorMoved([this, cruiserUp, cruiserRight, cruiserForward](const glm::vec2& newPosition)
+		{
+			static bool lastCall = true;
 
-					static glm::vec2 lastPosition = newPosition;
+			if (lastCall)
+			{
+				static float moveSpeed = 0.1f;
 
-					float xDif = glm::max(lastPosition.x, newPosition.x) - glm::min(lastPosition.x, newPosition.x);
-					float yDif = glm::max(lastPosition.y, newPosition.y) - glm::min(lastPosition.y, newPosition.y);
+				static glm::vec2 lastPosition = newPosition;
 
-					float leftRight = (lastPosition.x > newPosition.x) ? 1.0f : -1.0f;
-					float upDown = (lastPosition.y > newPosition.y) ? 1.0f : -1.0f;
+				float xDif = glm::max(lastPosition.x, newPosition.x) - glm::min(lastPosition.x, newPosition.x);
+				float yDif = glm::max(lastPosition.y, newPosition.y) - glm::min(lastPosition.y, newPosition.y);
 
-					glm::mat4 cruiserRotation(1.0f);
-					cruiserRotation[0] = glm::vec4(cruiserRight, 0.0f);
-					cruiserRotation[1] = glm::vec4(cruiserUp, 0.0f);
-					cruiserRotation[2] = glm::vec4(cruiserForward, 0.0f);
-					cruiserRotation[2] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+				float leftRight = (lastPosition.x > newPosition.x) ? 1.0f : -1.0f;
+				float upDown = (lastPosition.y > newPosition.y) ? 1.0f : -1.0f;
 
-					glm::vec3 worldRight = glm::normalize(glm::cross(cruiserUp, cruiserForward));
-					glm::vec3 worldUp = glm::normalize(glm::cross(cruiserForward, cruiserRight));
+				glm::mat4 cruiserRotation(1.0f);
+				cruiserRotation[0] = glm::vec4(cruiserRight, 0.0f);
+				cruiserRotation[1] = glm::vec4(cruiserUp, 0.0f);
+				cruiserRotation[2] = glm::vec4(cruiserForward, 0.0f);
+				cruiserRotation[2] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 
-					graphics->Rotate(moveSpeed * xDif * leftRight, worldUp);
+				glm::vec3 worldRight = glm::normalize(glm::cross(cruiserUp, cruiserForward));
 
-					lastPosition = newPosition;
+				// Turns about the player's up, applied on the next step.
+				pendingYaw.fetch_add(moveSpeed * xDif * leftRight);
 
-				}
-			});
+				lastPosition = newPosition;
 
-		
-	}
+			}
+		});
 }
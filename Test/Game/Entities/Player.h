@@ -4,6 +4,10 @@
 #include "Entity/GameObject.h"
 
 #include<functional>
+#include<vector>
+#include<atomic>
+
+#include <glm/glm.hpp>
 
 class TexturedAnimatedGraphicsObject;
 class ColoredStaticGraphicsObject;
@@ -14,6 +18,8 @@ class Model;
 class Texture;
 class OrientedBoundingBoxWithVisualization;
 class AnimatedCollider;
+class Animation;
+class InterpolatedTransform;
 
 
 class Player : public GameObject
@@ -47,6 +53,9 @@ private:
 
 	TexturedAnimatedGraphicsObject* graphics;
 
+	// Moved by the simulation step, graphics follow it once created.
+	InterpolatedTransform* transform;
+
 	struct OBB
 	{
 		OrientedBoundingBox* obb;
@@ -60,9 +69,24 @@ private:
 
 	AnimatedCollider* collider;
 
-	bool hoveredPress;
+	// The collider's own copy of the clip, stepped with the simulation so the boxes do not depend on how often the
+	// graphics object's animation is evaluated.
+	Animation* colliderAnimation;
+
+	std::vector<glm::mat4> colliderPose;
+
+	// A clip for colliderAnimation to switch to on the next step, -1 for none.
+	std::atomic<int> pendingClip;
+
+	// Requests from the input threads, consumed by the next step.
+	std::atomic<bool> walking;
 
-	std::function<void(int)>* wPressed;
+	// Degrees to turn.
+	std::atomic<float> pendingYaw;
+
+	std::atomic<unsigned int> pendingVisibilityToggles;
+
+	bool hoveredPress;
 
 	std::function<void(int)>* wRelease;
 
@@ -71,6 +95,11 @@ private:
 	std::function<void(int)>* iPress;
 
 	std::function<void(int)>* iRelease;
+
+	std::function<void(float)>* simulationStep;
+
+	// Rebuilds the collider's animation and boxes on the model's new data.
+	std::function<void(const Model*)>* modelReloaded;
 };
 
 #endif // PLAYER_H
\ No newline at end of file
@@ -0,0 +1,316 @@
+#include "Math/TransformSoA.h"
+#include "Math/Transform.h"
+#include "Math/Math.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+#include <vector>
+#include <random>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// Checks every TransformSoA kernel against the scalar Transform function it follows. The results have to match bit for
+// bit, so the SIMD paths can be used in place of the scalar ones without changing a single pose.
+// The count is not a multiple of any lane width, so the scalar tail is checked as well as the wide lanes.
+
+using namespace Math;
+
+namespace
+{
+	const unsigned int transformCount = 1003;
+
+	unsigned int failures = 0;
+
+	std::mt19937 generator(1234);
+
+	float Random(float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(generator);
+	}
+
+	glm::vec3 RandomVec3(float min, float max)
+	{
+		return glm::vec3(Random(min, max), Random(min, max), Random(min, max));
+	}
+
+	// Unit quaternions from both hemispheres, so Mix takes both sides of its neighborhood check.
+	glm::quat RandomRotation()
+	{
+		glm::quat rotation(Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(-1.0f, 1.0f));
+		return glm::normalize(rotation);
+	}
+
+	// Scales stay away from zero since Add divides by the reference scale.
+	glm::vec3 RandomScale()
+	{
+		glm::vec3 scale = RandomVec3(0.25f, 4.0f);
+
+		if (Random(0.0f, 1.0f) < 0.1f)
+		{
+			scale.x = -scale.x;
+		}
+
+		return scale;
+	}
+
+	Transform RandomTransform()
+	{
+		return Transform(RandomVec3(-100.0f, 100.0f), RandomRotation(), RandomScale());
+	}
+
+	std::vector<Transform> RandomTransforms()
+	{
+		std::vector<Transform> transforms(transformCount);
+
+		for (Transform& transform : transforms)
+		{
+			transform = RandomTransform();
+		}
+
+		return transforms;
+	}
+
+	std::vector<float> RandomTimes()
+	{
+		std::vector<float> times(transformCount);
+
+		for (float& time : times)
+		{
+			time = Random(0.0f, 1.0f);
+		}
+
+		// The ends of the range, where the lanes and the scalar code are most likely to round differently.
+		times[0] = 0.0f;
+		times[1] = 1.0f;
+
+		return times;
+	}
+
+	TransformSoA ToSoA(const std::vector<Transform>& transforms)
+	{
+		TransformSoA soa(static_cast<unsigned int>(transforms.size()));
+
+		for (unsigned int i = 0; i < transforms.size(); i++)
+		{
+			soa.Set(i, transforms[i]);
+		}
+
+		return soa;
+	}
+
+	template<typename T>
+	bool Same(const T& a, const T& b)
+	{
+		return std::memcmp(&a, &b, sizeof(T)) == 0;
+	}
+
+	bool Same(const Transform& a, const Transform& b)
+	{
+		return Same(a.Position(), b.Position()) && Same(a.Rotation(), b.Rotation()) && Same(a.Scale(), b.Scale());
+	}
+
+	std::string ToString(const Transform& transform)
+	{
+		const glm::vec3& p = transform.Position();
+		const glm::quat& r = transform.Rotation();
+		const glm::vec3& s = transform.Scale();
+
+		return "p(" + std::to_string(p.x) + ", " + std::to_string(p.y) + ", " + std::to_string(p.z) + ") r(" +
+			std::to_string(r.x) + ", " + std::to_string(r.y) + ", " + std::to_string(r.z) + ", " + std::to_string(r.w) + ") s(" +
+			std::to_string(s.x) + ", " + std::to_string(s.y) + ", " + std::to_string(s.z) + ")";
+	}
+
+	// Reports the first few mismatches of a test, the rest only count.
+	void Check(const std::string& test, unsigned int index, bool same, const std::string& expected, const std::string& actual)
+	{
+		if (same)
+		{
+			return;
+		}
+
+		if (failures < 10)
+		{
+			std::cout << test << " differs at " << index << "\n\texpected " << expected << "\n\tgot      " << actual << std::endl;
+		}
+
+		failures++;
+	}
+
+	void CheckTransforms(const std::string& test, const std::vector<Transform>& expected, const TransformSoA& actual)
+	{
+		for (unsigned int i = 0; i < expected.size(); i++)
+		{
+			const Transform result = actual.Get(i);
+			Check(test, i, Same(expected[i], result), ToString(expected[i]), ToString(result));
+		}
+	}
+
+	void CheckVec3s(const std::string& test, const std::vector<glm::vec3>& expected, const std::vector<glm::vec3>& actual)
+	{
+		for (unsigned int i = 0; i < expected.size(); i++)
+		{
+			Check(test, i, Same(expected[i], actual[i]),
+				std::to_string(expected[i].x) + ", " + std::to_string(expected[i].y) + ", " + std::to_string(expected[i].z),
+				std::to_string(actual[i].x) + ", " + std::to_string(actual[i].y) + ", " + std::to_string(actual[i].z));
+		}
+	}
+
+	void TestSetGet()
+	{
+		const std::vector<Transform> transforms = RandomTransforms();
+		CheckTransforms("Set/Get", transforms, ToSoA(transforms));
+	}
+
+	void TestCombine()
+	{
+		const std::vector<Transform> a = RandomTransforms();
+		const std::vector<Transform> b = RandomTransforms();
+
+		std::vector<Transform> expected(transformCount);
+		for (unsigned int i = 0; i < transformCount; i++)
+		{
+			expected[i] = Transform::Combine(a[i], b[i]);
+		}
+
+		TransformSoA out;
+		TransformSoA::Combine(ToSoA(a), ToSoA(b), out);
+
+		CheckTransforms("Combine", expected, out);
+	}
+
+	void TestMix()
+	{
+		const std::vector<Transform> a = RandomTransforms();
+		const std::vector<Transform> b = RandomTransforms();
+
+		for (float time : { 0.0f, 0.25f, 0.5f, 0.8f, 1.0f })
+		{
+			std::vector<Transform> expected(transformCount);
+			for (unsigned int i = 0; i < transformCount; i++)
+			{
+				expected[i] = Transform::Mix(a[i], b[i], time);
+			}
+
+			TransformSoA out;
+			TransformSoA::Mix(ToSoA(a), ToSoA(b), time, out);
+
+			CheckTransforms("Mix at " + std::to_string(time), expected, out);
+		}
+	}
+
+	// Each channel matches Transform::Mix at that channel's time.
+	void TestMixPerChannel()
+	{
+		const std::vector<Transform> a = RandomTransforms();
+		const std::vector<Transform> b = RandomTransforms();
+		const std::vector<float> positionTimes = RandomTimes();
+		const std::vector<float> rotationTimes = RandomTimes();
+		const std::vector<float> scaleTimes = RandomTimes();
+
+		std::vector<Transform> expected(transformCount);
+		for (unsigned int i = 0; i < transformCount; i++)
+		{
+			expected[i] = Transform(
+				Transform::Mix(a[i], b[i], positionTimes[i]).Position(),
+				Transform::Mix(a[i], b[i], rotationTimes[i]).Rotation(),
+				Transform::Mix(a[i], b[i], scaleTimes[i]).Scale()
+			);
+		}
+
+		TransformSoA out;
+		TransformSoA::Mix(ToSoA(a), ToSoA(b), positionTimes.data(), rotationTimes.data(), scaleTimes.data(), out);
+
+		CheckTransforms("Mix per channel", expected, out);
+	}
+
+	// Add has no Transform counterpart, this is its documented behaviour written with the scalar math it is built from.
+	Transform Add(const Transform& base, const Transform& additive, const Transform& reference, float weight)
+	{
+		const glm::vec3 position = base.Position() + (additive.Position() - reference.Position()) * weight;
+		const glm::vec3 scale = base.Scale() * Math::Lerp(glm::vec3(1.0f), additive.Scale() / reference.Scale(), weight);
+
+		const Transform identity;
+		const Transform delta(glm::vec3(0.0f), glm::conjugate(reference.Rotation()) * additive.Rotation(), glm::vec3(1.0f));
+		const glm::quat rotation = glm::normalize(base.Rotation() * Transform::Mix(identity, delta, weight).Rotation());
+
+		return Transform(position, rotation, scale);
+	}
+
+	void TestAdd()
+	{
+		const std::vector<Transform> base = RandomTransforms();
+		const std::vector<Transform> additive = RandomTransforms();
+		const std::vector<Transform> reference = RandomTransforms();
+		const std::vector<float> weights = RandomTimes();
+
+		std::vector<Transform> expected(transformCount);
+		for (unsigned int i = 0; i < transformCount; i++)
+		{
+			expected[i] = Add(base[i], additive[i], reference[i], weights[i]);
+		}
+
+		TransformSoA out;
+		TransformSoA::Add(ToSoA(base), ToSoA(additive), ToSoA(reference), weights.data(), out);
+
+		CheckTransforms("Add", expected, out);
+	}
+
+	void TestToMat4()
+	{
+		const std::vector<Transform> transforms = RandomTransforms();
+
+		std::vector<glm::mat4> out(transformCount);
+		TransformSoA::ToMat4(ToSoA(transforms), out.data());
+
+		for (unsigned int i = 0; i < transformCount; i++)
+		{
+			Check("ToMat4", i, Same(transforms[i].ToMat4(), out[i]), ToString(transforms[i]), "a different matrix");
+		}
+	}
+
+	void TestTransformPoints()
+	{
+		const std::vector<Transform> transforms = RandomTransforms();
+
+		std::vector<glm::vec3> points(transformCount);
+		std::vector<glm::vec3> expectedPoints(transformCount);
+		std::vector<glm::vec3> expectedVectors(transformCount);
+		for (unsigned int i = 0; i < transformCount; i++)
+		{
+			points[i] = RandomVec3(-10.0f, 10.0f);
+			expectedPoints[i] = Transform::TransformPoint(transforms[i], points[i]);
+			expectedVectors[i] = Transform::TransformVector(transforms[i], points[i]);
+		}
+
+		const TransformSoA soa = ToSoA(transforms);
+
+		std::vector<glm::vec3> out(transformCount);
+		TransformSoA::TransformPoints(soa, points.data(), out.data());
+		CheckVec3s("TransformPoints", expectedPoints, out);
+
+		TransformSoA::TransformVectors(soa, points.data(), out.data());
+		CheckVec3s("TransformVectors", expectedVectors, out);
+	}
+}
+
+int main()
+{
+	TestSetGet();
+	TestCombine();
+	TestMix();
+	TestMixPerChannel();
+	TestAdd();
+	TestToMat4();
+	TestTransformPoints();
+
+	if (failures != 0)
+	{
+		std::cout << failures << " TransformSoA results differ from Transform." << std::endl;
+		return 1;
+	}
+
+	std::cout << "TransformSoA matches Transform." << std::endl;
+	return 0;
+}